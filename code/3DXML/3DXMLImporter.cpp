@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/Importer.hpp>
 #include "3DXMLParser.h"
+#include "PostProcessing/ProcessHelper.h"
 
 static const aiImporterDesc desc = {
 	"3DXML Importer",
@@ -64,7 +65,7 @@ static const aiImporterDesc desc = {
 
 namespace Assimp {
 
-	_3DXMLImporter::_3DXMLImporter() : mUseNodeMaterials(false) {
+	_3DXMLImporter::_3DXMLImporter() : mUseComplexMaterials(false), mUseNodeMaterials(false), mUseReferencesNames(false), mPreserveInstances(false), mLODSelection(0), mStructureOnly(false), mFilter() {
 
 	}
 
@@ -91,6 +92,13 @@ namespace Assimp {
 		mUseComplexMaterials = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_3DXML_USE_COMPLEX_MATERIALS, 0) != 0;
 		mUseNodeMaterials = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_3DXML_USE_NODE_MATERIALS, 0) != 0;
 		mUseReferencesNames = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_3DXML_USE_REFERENCES_NAMES, 0) != 0;
+		mPreserveInstances = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_3DXML_PRESERVE_INSTANCES, 0) != 0;
+		mLODSelection = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_3DXML_LOD, 0);
+		mStructureOnly = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_3DXML_STRUCTURE_ONLY, 0) != 0;
+
+		std::list<std::string> filter;
+		ConvertListToStrings(pImp->GetPropertyString(AI_CONFIG_IMPORT_3DXML_FILTER, ""), filter);
+		mFilter = std::set<std::string>(filter.begin(), filter.end());
 	}
 
 	// ------------------------------------------------------------------------------------------------
@@ -102,7 +110,13 @@ namespace Assimp {
 	// ------------------------------------------------------------------------------------------------
 	//	Import method.
 	void _3DXMLImporter::InternReadFile(const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler) {
-		_3DXMLParser fileParser(pIOHandler, pFile, pScene, mUseComplexMaterials, mUseNodeMaterials, mUseReferencesNames);
+		// Unknown values of the property import all the LODs
+		_3DXMLRepresentation::LODSelection lod_selection = _3DXMLRepresentation::LOD_ALL;
+		if(mLODSelection == _3DXMLRepresentation::LOD_FINEST || mLODSelection == _3DXMLRepresentation::LOD_COARSEST) {
+			lod_selection = (_3DXMLRepresentation::LODSelection) mLODSelection;
+		}
+
+		_3DXMLParser fileParser(pIOHandler, pFile, pScene, mUseComplexMaterials, mUseNodeMaterials, mUseReferencesNames, mPreserveInstances, lod_selection, mStructureOnly, mFilter);
 	}
 
 } // end of namespace Assimp
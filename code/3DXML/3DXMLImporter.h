@@ -47,6 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/BaseImporter.h>
 
+#include <set>
+
 namespace Assimp {
 
 	class _3DXMLImporter : public BaseImporter {
@@ -75,6 +77,14 @@ namespace Assimp {
 
 		bool mUseReferencesNames;
 
+		bool mPreserveInstances;
+
+		int mLODSelection;
+
+		bool mStructureOnly;
+
+		std::set<std::string> mFilter;
+
 	}; // end of class _3DXMLImporter
 
 } // end of namespace Assimp
@@ -62,7 +62,7 @@ namespace Assimp {
 
 	// ------------------------------------------------------------------------------------------------
 	// Constructor to be privately used by Importer
-	_3DXMLParser::_3DXMLParser(IOSystem* io_handler, const std::string& file, aiScene* scene, bool use_complex_materials, bool use_node_materials, bool use_references_names) : mWorkers(), mTasks(), mCondition(), mMutex(), mError(""), mUseComplexMaterials(use_complex_materials), mUseNodeMaterials(use_node_materials), mUseReferencesNames(use_references_names), mFinished(false), mArchive(new ZipArchiveIOSystem(io_handler, file)), mContent(scene, &mCondition), mHasUVR(false) {
+	_3DXMLParser::_3DXMLParser(IOSystem* io_handler, const std::string& file, aiScene* scene, bool use_complex_materials, bool use_node_materials, bool use_references_names, bool preserve_instances, _3DXMLRepresentation::LODSelection lod_selection, bool structure_only, const std::set<std::string>& filter) : mWorkers(), mTasks(), mCondition(), mMutex(), mError(""), mUseComplexMaterials(use_complex_materials), mUseNodeMaterials(use_node_materials), mUseReferencesNames(use_references_names), mPreserveInstances(preserve_instances), mLODSelection(lod_selection), mStructureOnly(structure_only), mFilter(filter), mDeferredReps(), mSkippedReps(), mNumPrototypes(0), mFinished(false), mArchive(new ZipArchiveIOSystem(io_handler, file)), mContent(scene, &mCondition), mHasUVR(false) {
 		// Load the compressed archive
 		if (! mArchive->isOpen()) {
 			ThrowException(nullptr, "Failed to open file " + file + ". The 3DXML schema must be >= 4.0." );
@@ -100,6 +100,32 @@ namespace Assimp {
 			nb_threads = 1;
 		}
 
+		// Parse the product structure, and the representations unless they must be selected first
+		RunWorkers(nb_threads);
+
+		// Load the representations used by the selected parts of the product structure
+		if(! mStructureOnly && ! mFilter.empty()) {
+			SelectRepresentations(main_file);
+
+			RunWorkers(nb_threads);
+		}
+
+		// The representations which were not selected are never parsed
+		for(auto it(mDeferredReps.begin()), end(mDeferredReps.end()); it != end; ++it) {
+			mSkippedReps.insert(it->first);
+		}
+		mDeferredReps.clear();
+
+		// Construct the materials & meshes from the parsed data
+		BuildMaterials(parser.get());
+
+		// Create the root node
+		BuildRoot(parser.get(), main_file);
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Execute the pending tasks with the given number of threads until all the work is done
+	void _3DXMLParser::RunWorkers(int nb_threads) {
 		mFinished = false;
 
 		mWorkers.resize(nb_threads);
@@ -216,12 +242,80 @@ namespace Assimp {
 		if(mError != "") {
 			throw DeadlyImportError(mError);
 		}
-		
-		// Construct the materials & meshes from the parsed data
-		BuildMaterials(parser.get());
+	}
 
-		// Create the root node
-		BuildRoot(parser.get(), main_file);
+	// ------------------------------------------------------------------------------------------------
+	// Queue the parsing of the representations used by the parts of the product structure matching the filter
+	void _3DXMLParser::SelectRepresentations(const std::string& main_file) {
+		typedef std::pair<const _3DXMLStructure::Reference3D*, bool> Node;
+
+		std::set<const _3DXMLStructure::ReferenceRep*> selected_reps;
+
+		if(mContent.ref_root_index) {
+			std::map<_3DXMLStructure::ID, _3DXMLStructure::Reference3D>::const_iterator it_root = mContent.references_node.find(_3DXMLStructure::ID(main_file, *(mContent.ref_root_index)));
+
+			if(it_root != mContent.references_node.end()) {
+				// Walk the product structure. A Reference3D may be visited twice: outside and inside of a selected subtree.
+				std::set<Node> visited;
+				std::vector<Node> stack(1, Node(&(it_root->second), IsSelected(it_root->second.name, it_root->second.id)));
+
+				while(! stack.empty()) {
+					Node node = stack.back();
+					stack.pop_back();
+
+					if(! visited.insert(node).second) {
+						continue;
+					}
+
+					const _3DXMLStructure::Reference3D& ref = *(node.first);
+
+					// The whole subtree of a selected node is loaded
+					bool selected = node.second || IsSelected(ref.name, ref.id);
+
+					if(selected) {
+						for(std::map<_3DXMLStructure::ID, _3DXMLStructure::InstanceRep>::const_iterator it_mesh(ref.meshes.begin()), end_mesh(ref.meshes.end()); it_mesh != end_mesh; ++it_mesh) {
+							if(it_mesh->second.instance_of != nullptr) {
+								selected_reps.insert(it_mesh->second.instance_of);
+							}
+						}
+					}
+
+					for(std::map<_3DXMLStructure::ID, _3DXMLStructure::Instance3D>::const_iterator it_child(ref.instances.begin()), end_child(ref.instances.end()); it_child != end_child; ++it_child) {
+						const _3DXMLStructure::Instance3D& child = it_child->second;
+
+						if(child.instance_of != nullptr) {
+							stack.push_back(Node(child.instance_of, selected || (child.node && IsSelected(child.node->mName.C_Str(), child.id))));
+						}
+					}
+				}
+			}
+		}
+
+		// Queue the selected representations, the other ones stay deferred and will never be parsed
+		std::unique_lock<std::mutex> lock(mMutex);
+			std::size_t nb_reps = mDeferredReps.size();
+
+			for(auto it(mDeferredReps.begin()); it != mDeferredReps.end(); /* increment depends on content */) {
+				if(selected_reps.find(it->first) != selected_reps.end()) {
+					mTasks.push(std::move(it->second));
+
+					it = mDeferredReps.erase(it);
+				} else {
+					++it;
+				}
+			}
+
+			std::ostringstream stream;
+			stream << "Loading " << (nb_reps - mDeferredReps.size()) << " of " << nb_reps << " representations selected by the filter.";
+
+			LogMessage(Logger::Info, stream.str());
+		lock.unlock();
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Test if a Reference3D or an Instance3D is selected by its name or its id
+	bool _3DXMLParser::IsSelected(const std::string& name, unsigned int id) const {
+		return mFilter.find(name) != mFilter.end() || mFilter.find(std::to_string(id)) != mFilter.end();
 	}
 
 	_3DXMLParser::~_3DXMLParser() {
@@ -442,6 +536,9 @@ namespace Assimp {
 			for(_3DXMLStructure::ReferenceRep::Meshes::iterator it_mesh(it_rep->second.meshes.begin()), end_mesh(it_rep->second.meshes.end()); it_mesh != end_mesh; /* increment depends on content */) {
 				// Set the names of the parsed meshes with this ReferenceRep name
 				it_mesh->second.mesh->mName = it_rep->second.name;
+				for(size_t i = 0; i < it_mesh->second.lods.size(); i++) {
+					it_mesh->second.lods[i]->mName = it_rep->second.name + "_LOD" + parser->ToString(i + 1);
+				}
 
 				// Check if the surface attributes already exist
 				std::set<_3DXMLStructure::MaterialAttributes::ID>::iterator it = mat_attributes.find(it_mesh->first);
@@ -726,9 +823,9 @@ namespace Assimp {
 			const _3DXMLStructure::InstanceRep& rep = it_mesh->second;
 
 			if(rep.instance_of != nullptr) {
-				// Get the index of material to use
+				// Get the index of material to use. When instances are preserved, the material overrides are stored in the nodes.
 				unsigned int index_mat = mixed_material_index;
-				if(material_index) {
+				if(material_index && ! mPreserveInstances) {
 					index_mat = *material_index;
 				}
 
@@ -773,20 +870,6 @@ namespace Assimp {
 				std::unique_ptr<aiMesh>* mesh = &(it_meshes->second.mesh);
 
 				if(*mesh) {
-					// Duplicate the mesh for the new material
-					aiMesh* mesh_ptr = NULL;
-
-					if(rep.nb_references == 0) {
-						mesh_ptr = mesh->release();
-					} else if(rep.nb_references > 0) {
-						SceneCombiner::Copy(&mesh_ptr, mesh->get());
-					} else {
-						ThrowException(parser, "Invalid number of references to ReferenceRep \"" + parser->ToString(rep.id) + "\".");
-					}
-
-					// Save the new mesh in the scene
-					mContent.scene->Meshes.Set(index_mesh, mesh_ptr);
-
 					// Get the index of the material
 					unsigned int index_mat = material_index;
 					if(material_index == mixed_material_index) {
@@ -794,30 +877,65 @@ namespace Assimp {
 						index_mat = (it_meshes->first ? it_meshes->first->index : 0);
 					}
 
-					// Save the index of the material to use
-					mesh_ptr->mMaterialIndex = index_mat;
-
-					// Translate the UVs based on the selected material
-					if(it_meshes->first) {
-						for(std::map<unsigned int, unsigned int>::iterator it_uv(it_meshes->first->uv_translation.begin()), end_uv(it_meshes->first->uv_translation.end()); it_uv != end_uv; ++it_uv) {
-							mesh_ptr->mNumUVComponents[it_uv->second] = mesh_ptr->mNumUVComponents[it_uv->first];
-							mesh_ptr->mTextureCoords[it_uv->second] = mesh_ptr->mTextureCoords[it_uv->first];
-
-							mesh_ptr->mNumUVComponents[it_uv->first] = 0;
-							mesh_ptr->mTextureCoords[it_uv->first] = NULL;
-						}
-					}
+					// Save the new mesh in the scene
+					aiMesh* mesh_ptr = BuildMesh(parser, rep, *mesh, it_meshes->first, index_mat);
+					mContent.scene->Meshes.Set(index_mesh, mesh_ptr);
 
 					// Save the index of the mesh depending for the special material index corresponding to mixed materials defined at the mesh level
 					list_indexes.push_back(index_mesh);
 
 					// Increment the index for the next mesh
 					index_mesh++;
+
+					// Add the levels of detail right after their mesh, they are not referenced by any node
+					std::vector<std::unique_ptr<aiMesh>>& lods = it_meshes->second.lods;
+					if(! lods.empty()) {
+						mesh_ptr->mNumLODs = (unsigned int) lods.size();
+						mesh_ptr->mLODs = new unsigned int[mesh_ptr->mNumLODs];
+
+						for(unsigned int i = 0; i < mesh_ptr->mNumLODs; i++) {
+							mContent.scene->Meshes.Set(index_mesh, BuildMesh(parser, rep, lods[i], it_meshes->first, index_mat));
+							mesh_ptr->mLODs[i] = index_mesh;
+
+							index_mesh++;
+						}
+					}
 				}
 			}
 		}
 	}
 
+	// ------------------------------------------------------------------------------------------------
+	// Duplicate or release a mesh of a ReferenceRep for the given material
+	aiMesh* _3DXMLParser::BuildMesh(const XMLParser* parser, const _3DXMLStructure::ReferenceRep& rep, std::unique_ptr<aiMesh>& mesh, const _3DXMLStructure::MaterialAttributes::ID& attributes, unsigned int material_index) {
+		// Duplicate the mesh for the new material
+		aiMesh* mesh_ptr = NULL;
+
+		if(rep.nb_references == 0) {
+			mesh_ptr = mesh.release();
+		} else if(rep.nb_references > 0) {
+			SceneCombiner::Copy(&mesh_ptr, mesh.get());
+		} else {
+			ThrowException(parser, "Invalid number of references to ReferenceRep \"" + parser->ToString(rep.id) + "\".");
+		}
+
+		// Save the index of the material to use
+		mesh_ptr->mMaterialIndex = material_index;
+
+		// Translate the UVs based on the selected material
+		if(attributes) {
+			for(std::map<unsigned int, unsigned int>::const_iterator it_uv(attributes->uv_translation.begin()), end_uv(attributes->uv_translation.end()); it_uv != end_uv; ++it_uv) {
+				mesh_ptr->mNumUVComponents[it_uv->second] = mesh_ptr->mNumUVComponents[it_uv->first];
+				mesh_ptr->mTextureCoords[it_uv->second] = mesh_ptr->mTextureCoords[it_uv->first];
+
+				mesh_ptr->mNumUVComponents[it_uv->first] = 0;
+				mesh_ptr->mTextureCoords[it_uv->first] = NULL;
+			}
+		}
+
+		return mesh_ptr;
+	}
+
 	// ------------------------------------------------------------------------------------------------
 	// Create the root node
 	void _3DXMLParser::BuildRoot(const XMLParser* parser, const std::string& main_file) {
@@ -855,7 +973,10 @@ namespace Assimp {
 
 					// Test if we have some meshes. If not, validation step will fail and it probably means that the file use the binary representation for meshes (UVR format).
 					if(mContent.scene->mNumMeshes == 0) {
-						if(mHasUVR) {
+						if(mStructureOnly || ! mFilter.empty()) {
+							// Only the product structure was requested, or no geometry was selected by the filter
+							mContent.scene->mFlags |= AI_SCENE_FLAGS_INCOMPLETE;
+						} else if(mHasUVR) {
 							ThrowException(parser, "This is a binary 3DXML file (unsupported). Please re-export your file with XML tessellation option enabled.");
 						} else {
 							ThrowException(parser, "The scene does not contain any mesh.");
@@ -924,6 +1045,36 @@ namespace Assimp {
 		ref.total_references--;
 
 		if(node != nullptr) {
+			// Whether the children of this Reference3D must be built below this node
+			bool build_children = true;
+
+			if(mPreserveInstances) {
+				// Record the material override instead of duplicating the meshes for it
+				if(material_index) {
+					if(node->mMetaData == NULL) {
+						node->mMetaData = new aiMetadata();
+					}
+					node->mMetaData->Add("3DXML_MATERIAL", static_cast<int32_t>(*material_index));
+				}
+
+				// The children of a Reference3D instantiated several times are only built for its first instance
+				if(ref.nb_references > 1 && ! ref.instances.empty()) {
+					if(node->mMetaData == NULL) {
+						node->mMetaData = new aiMetadata();
+					}
+
+					if(ref.prototype) {
+						// The other instances refer to the first one, but still hold the shared meshes
+						node->mMetaData->Add("3DXML_INSTANCE_OF", static_cast<int32_t>(*(ref.prototype)));
+
+						build_children = false;
+					} else {
+						ref.prototype = mNumPrototypes++;
+						node->mMetaData->Add("3DXML_PROTOTYPE", static_cast<int32_t>(*(ref.prototype)));
+					}
+				}
+			}
+
 			// Copy the indexes of the meshes contained into this instance into the proper aiNode
 			if(node->mNumMeshes == 0) {
 				unsigned int index_node = 0; // Because (node->mNumMeshes == 0)
@@ -934,7 +1085,7 @@ namespace Assimp {
 						if(! rep.instance_of->meshes.empty()) {
 							// Get the index of material to use
 							unsigned int index_mat = mixed_material_index;
-							if(material_index) {
+							if(material_index && ! mPreserveInstances) {
 								index_mat = *material_index;
 							}
 
@@ -952,7 +1103,7 @@ namespace Assimp {
 							} else {
 								ThrowException(parser, "No mesh corresponds to the given material \"" + parser->ToString(index_mat) + "\".");
 							}
-						} else {
+						} else if(mSkippedReps.find(rep.instance_of) == mSkippedReps.end()) {
 							// If the representation format is not supported, it is normal to have empty ReferenceRep. Therefore, we should gracefully ignore such nodes.
 							LogMessage(Logger::Warn, "No meshes defined in ReferenceRep \"" + parser->ToString(rep.instance_of->id) + "\".");
 						}
@@ -963,15 +1114,16 @@ namespace Assimp {
 			}
 
 			// Copy the children nodes of this instance into the proper node
-			if(node->mNumChildren == 0) {
+			if(build_children && node->mNumChildren == 0) {
 				for(std::map<_3DXMLStructure::ID, _3DXMLStructure::Instance3D>::iterator it_child(ref.instances.begin()), end_child(ref.instances.end()); it_child != end_child; ++it_child) {
 					_3DXMLStructure::Instance3D& child = it_child->second;
 
 					if(child.node.get() != nullptr && child.instance_of != nullptr) {
 						aiNode* child_node = nullptr;
 
-						// If the counter of references is null, this mean this instance is the last instance of this Reference3D
-						if(ref.total_references == 0) {
+						// If the counter of references is null, this mean this instance is the last instance of this Reference3D.
+						// When instances are preserved, the children of each Reference3D are built only once.
+						if(ref.total_references == 0 || mPreserveInstances) {
 							// Therefore we can copy the child node directly into the children array
 							child_node = child.node.release();
 						} else if(ref.total_references > 0) {
@@ -1383,22 +1535,29 @@ namespace Assimp {
 			// Check the representation format and call the correct parsing function accordingly
 			if(format->compare("TESSELLATED") == 0) {
 				if(uri.extension.compare("3DRep") == 0) {
-					std::unique_lock<std::mutex> lock(mMutex);
-						mTasks.emplace([this, rep, uri]() {
-							try {
-								// Parse the geometry representation
-								_3DXMLRepresentation representation(mArchive, uri.filename, rep->meshes, mContent.dependencies);
-							} catch(DeadlyImportError& error) {
-								std::ostringstream stream;
-								stream << "In ReferenceRep \"" << rep->id << "\": unable to load the representation. " << error.what();
+					std::function<void()> task = [this, rep, uri]() {
+						try {
+							// Parse the geometry representation
+							_3DXMLRepresentation representation(mArchive, uri.filename, rep->meshes, mContent.dependencies, mLODSelection);
+						} catch(DeadlyImportError& error) {
+							std::ostringstream stream;
+							stream << "In ReferenceRep \"" << rep->id << "\": unable to load the representation. " << error.what();
 
-								LogMessage(Logger::Err, stream.str());
+							LogMessage(Logger::Err, stream.str());
 
-								rep->meshes.clear();
-							}
-						});
+							rep->meshes.clear();
+						}
+					};
 
-						mCondition.notify_one();
+					std::unique_lock<std::mutex> lock(mMutex);
+						if(mStructureOnly || ! mFilter.empty()) {
+							// Wait for the product structure to be complete to know if this representation is needed
+							mDeferredReps.emplace_back(rep, std::move(task));
+						} else {
+							mTasks.emplace(std::move(task));
+
+							mCondition.notify_one();
+						}
 					lock.unlock();
 				} else {
 					ThrowException(parser, "In ReferenceRep \"" + parser->ToString(id) + "\": unsupported extension \"" + uri.extension + "\" for associated file.");
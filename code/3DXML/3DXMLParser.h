@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_3DXMLPARSER_H_INC
 
 #include <assimp/Logger.hpp>
+#include "3DXMLRepresentation.h"
 #include "3DXMLStructure.h"
 #include "XMLParser.h"
 
@@ -53,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <functional>
 #include <mutex>
 #include <queue>
+#include <set>
 #include <thread>
 
 namespace Assimp {
@@ -79,6 +81,26 @@ namespace Assimp {
 
 			bool mUseReferencesNames;
 
+			bool mPreserveInstances;
+
+			/** Which levels of detail of the PolygonalRep are imported */
+			_3DXMLRepresentation::LODSelection mLODSelection;
+
+			/** Only parse the product structure, without any representation */
+			bool mStructureOnly;
+
+			/** Names or ids of the Reference3D and Instance3D whose representations are loaded, all if empty */
+			std::set<std::string> mFilter;
+
+			/** Tasks parsing the representations, waiting for the product structure to be selected */
+			std::vector<std::pair<const _3DXMLStructure::ReferenceRep*, std::function<void()>>> mDeferredReps;
+
+			/** Representations which were not selected and are therefore empty */
+			std::set<const _3DXMLStructure::ReferenceRep*> mSkippedReps;
+
+			/** Number of Reference3D whose children are shared by several instances */
+			unsigned int mNumPrototypes;
+
 			bool mFinished;
 
 			/** The archive containing the 3DXML files */ 
@@ -93,7 +115,7 @@ namespace Assimp {
 		public:
 
 			/** Constructor from XML file */
-			_3DXMLParser(IOSystem* io_handler, const std::string& file, aiScene* scene, bool use_complex_materials, bool use_node_materials, bool use_references_names);
+			_3DXMLParser(IOSystem* io_handler, const std::string& file, aiScene* scene, bool use_complex_materials, bool use_node_materials, bool use_references_names, bool preserve_instances, _3DXMLRepresentation::LODSelection lod_selection, bool structure_only, const std::set<std::string>& filter);
 
 			virtual ~_3DXMLParser();
 			
@@ -116,8 +138,16 @@ namespace Assimp {
 
 			void BuildMaterialCount(const XMLParser* parser, _3DXMLStructure::Reference3D& ref, std::map<_3DXMLStructure::ReferenceRep*, std::set<unsigned int>>& materials_per_geometry, Optional<unsigned int> material_index);
 
+			void RunWorkers(int nb_threads);
+
+			void SelectRepresentations(const std::string& main_file);
+
+			bool IsSelected(const std::string& name, unsigned int id) const;
+
 			void BuildMeshes(const XMLParser* parser, _3DXMLStructure::ReferenceRep& rep, unsigned int material_index);
 
+			aiMesh* BuildMesh(const XMLParser* parser, const _3DXMLStructure::ReferenceRep& rep, std::unique_ptr<aiMesh>& mesh, const _3DXMLStructure::MaterialAttributes::ID& attributes, unsigned int material_index);
+
 			void BuildRoot(const XMLParser* parser, const std::string& main_file);
 
 			void UpdateReferences(const XMLParser* parser, _3DXMLStructure::Reference3D& root);
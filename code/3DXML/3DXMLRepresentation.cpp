@@ -58,7 +58,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace Assimp {
 
 	// ------------------------------------------------------------------------------------------------
-	_3DXMLRepresentation::_3DXMLRepresentation(std::shared_ptr<ZipArchiveIOSystem> archive, const std::string& filename, _3DXMLStructure::ReferenceRep::Meshes& meshes, _3DXMLStructure::Dependencies& dependencies) : mReader(archive, filename), mCurrentRep(nullptr), mMeshes(meshes), mDependencies(dependencies) {
+	_3DXMLRepresentation::_3DXMLRepresentation(std::shared_ptr<ZipArchiveIOSystem> archive, const std::string& filename, _3DXMLStructure::ReferenceRep::Meshes& meshes, _3DXMLStructure::Dependencies& dependencies, LODSelection lod_selection) : mReader(archive, filename), mCurrentRep(nullptr), mMeshes(meshes), mDependencies(dependencies), mLODSelection(lod_selection) {
 		struct Params {
 			_3DXMLRepresentation* me;
 		} params;
@@ -97,11 +97,16 @@ namespace Assimp {
 
 				if(range.first != range.second) {
 					std::map<unsigned int, std::vector<aiMesh*>> data[_3DXMLStructure::ReferenceRep::Geometry::NB_TYPES];
+					std::map<unsigned int, std::vector<std::vector<std::unique_ptr<aiMesh>>>> lods[_3DXMLStructure::ReferenceRep::Geometry::NB_TYPES];
 
 					// Sort the meshes by type of included components (normals, texture coords, etc.)
 					for(auto it(range.first); it != range.second; ++it) {
 						unsigned int index = GetMeshVFormatUnique(it->second.mesh.get());
 						data[it->second.type][index].push_back(it->second.mesh.release());
+
+						if(! it->second.lods.empty()) {
+							lods[it->second.type][index].push_back(std::move(it->second.lods));
+						}
 					}
 
 					// Merge the different meshes compatible together
@@ -116,7 +121,34 @@ namespace Assimp {
 									mesh = *(it->second.begin());
 								}
 
-								output.emplace(range.first->first, _3DXMLStructure::ReferenceRep::Geometry((_3DXMLStructure::ReferenceRep::Geometry::Type) i, mesh));
+								_3DXMLStructure::ReferenceRep::Geometry geometry((_3DXMLStructure::ReferenceRep::Geometry::Type) i, mesh);
+
+								// Merge the levels of detail the same way, keeping only the levels available in all the merged meshes
+								std::vector<std::vector<std::unique_ptr<aiMesh>>>& chains = lods[i][it->first];
+								if(! chains.empty()) {
+									size_t nb_levels = chains.front().size();
+									for(auto it_chain(chains.begin()), end_chain(chains.end()); it_chain != end_chain; ++it_chain) {
+										nb_levels = std::min(nb_levels, it_chain->size());
+									}
+
+									for(size_t level = 0; level < nb_levels; ++level) {
+										if(chains.size() > 1) {
+											std::vector<aiMesh*> lod_meshes;
+											for(auto it_chain(chains.begin()), end_chain(chains.end()); it_chain != end_chain; ++it_chain) {
+												lod_meshes.push_back((*it_chain)[level].release());
+											}
+
+											aiMesh* lod = NULL;
+											SceneCombiner::MergeMeshes(&lod, 0, lod_meshes.begin(), lod_meshes.end());
+
+											geometry.lods.emplace_back(lod);
+										} else {
+											geometry.lods.push_back(std::move(chains.front()[level]));
+										}
+									}
+								}
+
+								output.emplace(range.first->first, std::move(geometry));
 							}
 						}
 					}
@@ -325,13 +357,13 @@ namespace Assimp {
 	}
 
 	// ------------------------------------------------------------------------------------------------
-	void _3DXMLRepresentation::ParseFaces(const Face& face) {
+	void _3DXMLRepresentation::ParseFaces(const Face& face, _3DXMLStructure::ReferenceRep::Meshes& meshes) {
 		static const unsigned int nb_vertices = 3;
 
 		std::list<std::vector<unsigned int>> data;
 
 		if(face.triangles || face.strips || face.fans) {
-			auto it = mCurrentRep->meshes.emplace(face.surface_attribute,
+			auto it = meshes.emplace(face.surface_attribute,
 				_3DXMLStructure::ReferenceRep::Geometry(_3DXMLStructure::ReferenceRep::Geometry::MESH)
 			);
 
@@ -490,10 +522,10 @@ namespace Assimp {
 	}
 
 	// ------------------------------------------------------------------------------------------------
-	void _3DXMLRepresentation::ParseVertexBuffer() {
+	void _3DXMLRepresentation::ParseVertexBuffer(_3DXMLStructure::ReferenceRep::Meshes& meshes) {
 		if(mCurrentRep && mCurrentRep->vertex_buffer.mNumVertices != 0) {
 			// Duplicate the vertices to avoid different faces sharing the same (and to pass the ValidateDataStructure test...)
-			for(_3DXMLStructure::ReferenceRep::Meshes::iterator it(mCurrentRep->meshes.begin()), end(mCurrentRep->meshes.end()); it != end; ++it) {
+			for(_3DXMLStructure::ReferenceRep::Meshes::iterator it(meshes.begin()), end(meshes.end()); it != end; ++it) {
 				if(it->second.type == _3DXMLStructure::ReferenceRep::Geometry::MESH) {
 					aiMesh* mesh = it->second.mesh.get();
 
@@ -605,8 +637,71 @@ namespace Assimp {
 		}
 	}
 
+	// ------------------------------------------------------------------------------------------------
+	void _3DXMLRepresentation::ParsePolygonalLOD(PolygonalLOD& lod, size_t level) {
+		// Iterate over the groups of faces
+		for(auto it_surfaces(lod.surfaces.begin()), end_surfaces(lod.surfaces.end()); it_surfaces != end_surfaces; ++it_surfaces) {
+			PropagateAttributes(mCurrentRep->surface_attribute, it_surfaces->surface_attribute);
+
+			// Iterate over the faces in each group of faces
+			for(auto it_faces(it_surfaces->faces.begin()), end_faces(it_surfaces->faces.end()); it_faces != end_faces; ++it_faces) {
+				PropagateAttributes(it_surfaces->surface_attribute, it_faces->surface_attribute);
+
+				// Parse the current face
+				ParseFaces(*it_faces, lod.meshes);
+			}
+		}
+
+		// The LOD shares the vertex buffer of the PolygonalRep
+		ParseVertexBuffer(lod.meshes);
+
+		// Attach the LOD meshes to the first full resolution mesh using the same material, so that they can follow it when meshes are merged
+		for(auto it(lod.meshes.begin()), end(lod.meshes.end()); it != end; /* increment depends on content */) {
+			auto range = lod.meshes.equal_range(it->first);
+
+			std::vector<aiMesh*> lod_meshes;
+			for(; it != range.second; ++it) {
+				if(it->second.type == _3DXMLStructure::ReferenceRep::Geometry::MESH && it->second.mesh->mNumFaces != 0) {
+					lod_meshes.push_back(it->second.mesh.release());
+				}
+			}
+
+			if(! lod_meshes.empty()) {
+				aiMesh* mesh = NULL;
+
+				if(lod_meshes.size() > 1) {
+					SceneCombiner::MergeMeshes(&mesh, 0, lod_meshes.begin(), lod_meshes.end());
+				} else {
+					mesh = lod_meshes.front();
+				}
+
+				std::unique_ptr<aiMesh> lod_mesh(mesh);
+
+				auto base = mCurrentRep->meshes.equal_range(range.first->first);
+				for(auto it_base(base.first); it_base != base.second; ++it_base) {
+					if(it_base->second.type == _3DXMLStructure::ReferenceRep::Geometry::MESH) {
+						// Only keep the LOD if the previous levels exist too, otherwise the levels of the meshes would not match anymore
+						if(it_base->second.lods.size() == level) {
+							it_base->second.lods.push_back(std::move(lod_mesh));
+						}
+
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	// ------------------------------------------------------------------------------------------------
 	void _3DXMLRepresentation::ParsePolygonalRep() {
 		if(mCurrentRep) {
+			// Only the coarsest LOD was kept: use it in place of the full resolution faces
+			if(mLODSelection == LOD_COARSEST && ! mCurrentRep->lods.empty()) {
+				std::swap(mCurrentRep->surfaces, mCurrentRep->lods.front().surfaces);
+
+				mCurrentRep->lods.clear();
+			}
+
 			// Iterate over the groups of faces
 			for(auto it_surfaces(mCurrentRep->surfaces.begin()), end_surfaces(mCurrentRep->surfaces.end()); it_surfaces != end_surfaces; ++it_surfaces) {
 				PropagateAttributes(mCurrentRep->surface_attribute, it_surfaces->surface_attribute);
@@ -616,7 +711,7 @@ namespace Assimp {
 					PropagateAttributes(it_surfaces->surface_attribute, it_faces->surface_attribute);
 
 					// Parse the current face
-					ParseFaces(*it_faces);
+					ParseFaces(*it_faces, mCurrentRep->meshes);
 				}
 			}
 
@@ -634,7 +729,14 @@ namespace Assimp {
 			}
 
 			// Parse the vertex buffer data
-			ParseVertexBuffer();
+			ParseVertexBuffer(mCurrentRep->meshes);
+
+			// Parse the levels of detail, from the finest to the coarsest
+			mCurrentRep->lods.sort([](const PolygonalLOD& a, const PolygonalLOD& b){return a.accuracy < b.accuracy;});
+			size_t level = 0;
+			for(auto it(mCurrentRep->lods.begin()), end(mCurrentRep->lods.end()); it != end; ++it, ++level) {
+				ParsePolygonalLOD(*it, level);
+			}
 
 			// Copy the generated meshes into the global map of meshes
 			for(auto it(mCurrentRep->meshes.begin()), end(mCurrentRep->meshes.end()); it != end; ++it) {
@@ -699,13 +801,16 @@ namespace Assimp {
 			}, 0, 1));
 			
 			// Parse PolygonalLOD element
-			//map.emplace_back("PolygonalLOD", XMLParser::XSD::Element<Params>([](const XMLParser* /*parser*/, Params& params){
-			//
-			//}, 0, XMLParser::XSD::unbounded));
+			map.emplace_back("PolygonalLOD", XMLParser::XSD::Element<Params>([](const XMLParser* /*parser*/, Params& params){
+				params.me->ReadPolygonalLOD();
+			}, 0, XMLParser::XSD::unbounded));
 			
 			// Parse Faces element
 			map.emplace_back("Faces", XMLParser::XSD::Element<Params>([](const XMLParser* /*parser*/, Params& params){
-				params.me->ReadFaces();
+				// The full resolution faces are skipped when they are replaced by the coarsest LOD
+				if(params.me->mLODSelection != LOD_COARSEST || params.me->mCurrentRep->lods.empty()) {
+					params.me->ReadFaces(params.me->mCurrentRep->surfaces);
+				}
 			}, 0, XMLParser::XSD::unbounded));
 			
 			// Parse Edges element
@@ -731,7 +836,48 @@ namespace Assimp {
 	}
 
 	// ------------------------------------------------------------------------------------------------
-	void _3DXMLRepresentation::ReadFaces() {
+	void _3DXMLRepresentation::ReadPolygonalLOD() {
+		struct Params {
+			_3DXMLRepresentation* me;
+			PolygonalLOD* lod;
+		} params;
+
+		static const XMLParser::XSD::Sequence<Params> mapping(([](){
+			XMLParser::XSD::Sequence<Params>::type map;
+
+			// Parse Faces element
+			map.emplace_back("Faces", XMLParser::XSD::Element<Params>([](const XMLParser* /*parser*/, Params& params){
+				params.me->ReadFaces(params.lod->surfaces);
+			}, 0, XMLParser::XSD::unbounded));
+
+			return std::move(map);
+		})(), 1, 1);
+
+		if(mCurrentRep && mLODSelection != LOD_FINEST) {
+			float accuracy = *(mReader.GetAttribute<float>("accuracy", true));
+
+			if(mLODSelection == LOD_COARSEST) {
+				// Only keep the coarsest LOD, the finer ones are skipped without being parsed
+				if(! mCurrentRep->lods.empty() && accuracy <= mCurrentRep->lods.front().accuracy) {
+					return;
+				}
+
+				mCurrentRep->lods.clear();
+			}
+
+			// Add a new LOD to the current PolygonalRep
+			mCurrentRep->lods.emplace_back();
+
+			params.me = this;
+			params.lod = &(mCurrentRep->lods.back());
+			params.lod->accuracy = accuracy;
+
+			mReader.ParseElement(mapping, params);
+		}
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	void _3DXMLRepresentation::ReadFaces(std::list<Faces>& surfaces) {
 		struct Params {
 			_3DXMLRepresentation* me;
 			Faces* surface;
@@ -774,11 +920,11 @@ namespace Assimp {
 		})(), 1, 1);
 
 		if(mCurrentRep) {
-			// Add a new group of faces to the current PolygonalRep
-			mCurrentRep->surfaces.emplace_back();
+			// Add a new group of faces to the current PolygonalRep or PolygonalLOD
+			surfaces.emplace_back();
 
 			params.me = this;
-			params.surface = &(mCurrentRep->surfaces.back());
+			params.surface = &(surfaces.back());
 
 			mReader.ParseElement(mapping, params);
 		}
@@ -92,6 +92,16 @@ namespace Assimp {
 
 			}; // struct Edges
 
+			struct PolygonalLOD {
+
+				float accuracy;
+
+				std::list<Faces> surfaces;
+
+				_3DXMLStructure::ReferenceRep::Meshes meshes;
+
+			}; // struct PolygonalLOD
+
 			struct PolygonalRep {
 
 				_3DXMLStructure::MaterialAttributes::ID surface_attribute;
@@ -102,6 +112,8 @@ namespace Assimp {
 
 				std::list<Edges> lines;
 
+				std::list<PolygonalLOD> lods;
+
 				aiMesh vertex_buffer;
 
 				_3DXMLStructure::ReferenceRep::Meshes meshes;
@@ -122,7 +134,16 @@ namespace Assimp {
 
 		public: 
 
-			_3DXMLRepresentation(std::shared_ptr<ZipArchiveIOSystem> archive, const std::string& filename, _3DXMLStructure::ReferenceRep::Meshes& meshes, _3DXMLStructure::Dependencies& dependencies);
+			/** Which levels of detail of the PolygonalRep are imported */
+			enum LODSelection {LOD_ALL = 0, LOD_FINEST, LOD_COARSEST};
+
+		protected:
+
+			LODSelection mLODSelection;
+
+		public: 
+
+			_3DXMLRepresentation(std::shared_ptr<ZipArchiveIOSystem> archive, const std::string& filename, _3DXMLStructure::ReferenceRep::Meshes& meshes, _3DXMLStructure::Dependencies& dependencies, LODSelection lod_selection = LOD_ALL);
 
 			virtual ~_3DXMLRepresentation();
 
@@ -143,11 +164,13 @@ namespace Assimp {
 
 			void ParseTriangles(const std::string& content, std::list<std::vector<unsigned int>>& triangles) const;
 
-			void ParseFaces(const Face& face);
+			void ParseFaces(const Face& face, _3DXMLStructure::ReferenceRep::Meshes& meshes);
 
 			void ParseEdges(const Polyline& edge);
 
-			void ParseVertexBuffer();
+			void ParseVertexBuffer(_3DXMLStructure::ReferenceRep::Meshes& meshes);
+
+			void ParsePolygonalLOD(PolygonalLOD& lod, size_t level);
 
 			void ParsePolygonalRep();
 
@@ -157,7 +180,9 @@ namespace Assimp {
 
 			void ReadPolygonalRep();
 
-			void ReadFaces();
+			void ReadPolygonalLOD();
+
+			void ReadFaces(std::list<Faces>& surfaces);
 
 			void ReadEdges();
 
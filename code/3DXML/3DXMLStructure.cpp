@@ -256,27 +256,27 @@ namespace Assimp {
 	}
 
 	// ------------------------------------------------------------------------------------------------
-	_3DXMLStructure::Reference3D::Reference3D() : id(0), has_name(false), name(""), nb_references(0), total_references(0), instances(), meshes() {
+	_3DXMLStructure::Reference3D::Reference3D() : id(0), has_name(false), name(""), nb_references(0), total_references(0), prototype(), instances(), meshes() {
 	
 	}
 
 	// ------------------------------------------------------------------------------------------------
-	_3DXMLStructure::Reference3D::Reference3D(Reference3D&& other) : id(other.id), has_name(other.has_name), name(std::move(other.name)), nb_references(other.nb_references), total_references(other.total_references), instances(std::move(other.instances)), meshes(std::move(other.meshes)) {
+	_3DXMLStructure::Reference3D::Reference3D(Reference3D&& other) : id(other.id), has_name(other.has_name), name(std::move(other.name)), nb_references(other.nb_references), total_references(other.total_references), prototype(std::move(other.prototype)), instances(std::move(other.instances)), meshes(std::move(other.meshes)) {
 	
 	}
 
 	// ------------------------------------------------------------------------------------------------
-	_3DXMLStructure::ReferenceRep::Geometry::Geometry(Type type) : mesh(new aiMesh()), type(type) {
+	_3DXMLStructure::ReferenceRep::Geometry::Geometry(Type type) : mesh(new aiMesh()), type(type), lods() {
 
 	}
 
 	// ------------------------------------------------------------------------------------------------
-	_3DXMLStructure::ReferenceRep::Geometry::Geometry(Type type, aiMesh* mesh) : mesh(mesh), type(type) {
+	_3DXMLStructure::ReferenceRep::Geometry::Geometry(Type type, aiMesh* mesh) : mesh(mesh), type(type), lods() {
 
 	}
 
 	// ------------------------------------------------------------------------------------------------
-	_3DXMLStructure::ReferenceRep::Geometry::Geometry(Geometry&& other) : mesh(std::move(other.mesh)), type(other.type) {
+	_3DXMLStructure::ReferenceRep::Geometry::Geometry(Geometry&& other) : mesh(std::move(other.mesh)), type(other.type), lods(std::move(other.lods)) {
 
 	}
 
@@ -57,6 +57,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <memory>
 #include <mutex>
 #include <set>
+#include <vector>
 
 #if (defined _MSC_VER)
 #	pragma warning (disable:4503)
@@ -276,6 +277,9 @@ namespace Assimp {
 
 			int total_references;
 
+			/** Prototype number of this reference, assigned to the first instance which holds its children when instances are preserved */
+			Optional<unsigned int> prototype;
+
 			std::map<ID, Instance3D> instances;
 
 			std::map<ID, InstanceRep> meshes;
@@ -296,6 +300,9 @@ namespace Assimp {
 
 				Type type;
 
+				/** Precomputed levels of detail of the mesh, from the finest to the coarsest */
+				std::vector<std::unique_ptr<aiMesh>> lods;
+
 				Geometry(Type type);
 
 				Geometry(Type type, aiMesh* mesh);
@@ -10,12 +10,7 @@ namespace Assimp {
         */
         template<typename T>
         bool read(const Structure &s, T *p, const size_t cnt, const FileDatabase &db) {
-            for (size_t i = 0; i < cnt; ++i) {
-                T read;
-                s.Convert(read, db);
-                *p = read;
-                p++;
-            }
+            s.ConvertArray(p, cnt, db);
             return true;
         }
 
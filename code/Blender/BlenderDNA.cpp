@@ -218,6 +218,7 @@ void DNAParser::Parse ()
 
     dna.AddPrimitiveStructures();
     dna.RegisterConverters();
+    dna.CompileReadPlans();
 }
 
 
@@ -313,34 +314,50 @@ void DNA :: AddPrimitiveStructures()
     indices["int"] = structures.size();
     structures.push_back( Structure() );
     structures.back().name = "int";
+    structures.back().primitive = PrimitiveType_Int;
     structures.back().size = 4;
 
     indices["short"] = structures.size();
     structures.push_back( Structure() );
     structures.back().name = "short";
+    structures.back().primitive = PrimitiveType_Short;
     structures.back().size = 2;
 
 
     indices["char"] = structures.size();
     structures.push_back( Structure() );
     structures.back().name = "char";
+    structures.back().primitive = PrimitiveType_Char;
     structures.back().size = 1;
 
 
     indices["float"] = structures.size();
     structures.push_back( Structure() );
     structures.back().name = "float";
+    structures.back().primitive = PrimitiveType_Float;
     structures.back().size = 4;
 
 
     indices["double"] = structures.size();
     structures.push_back( Structure() );
     structures.back().name = "double";
+    structures.back().primitive = PrimitiveType_Double;
     structures.back().size = 8;
 
     // no long, seemingly.
 }
 
+// ------------------------------------------------------------------------------------------------
+void DNA :: CompileReadPlans()
+{
+    for (Structure& s : structures) {
+        for (Field& f : s.fields) {
+            std::map<std::string, size_t>::const_iterator it = indices.find(f.type);
+            f.type_index = it == indices.end() ? static_cast<size_t>(-1) : (*it).second;
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void SectionParser :: Next()
 {
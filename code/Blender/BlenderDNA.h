@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdint.h>
 #include <memory>
 #include <map>
+#include <unordered_map>
 
 // enable verbose log output. really verbose, so be careful.
 #ifdef ASSIMP_BUILD_DEBUG
@@ -183,6 +184,23 @@ struct Field {
 
     /** Any of the #FieldFlags enumerated values */
     unsigned int flags;
+
+    /** Index of the field type in DNA::structures, or -1 if the
+     *  type is not known. Resolved by DNA::CompileReadPlans(). */
+    size_t type_index;
+};
+
+// -------------------------------------------------------------------------------
+/** Primitive types the DNA knows how to convert, see
+ *  DNA::AddPrimitiveStructures(). */
+// -------------------------------------------------------------------------------
+enum PrimitiveType {
+    PrimitiveType_None,
+    PrimitiveType_Int,
+    PrimitiveType_Short,
+    PrimitiveType_Char,
+    PrimitiveType_Float,
+    PrimitiveType_Double
 };
 
 // -------------------------------------------------------------------------------
@@ -216,7 +234,8 @@ class Structure {
 
 public:
     Structure()
-    : cache_idx(static_cast<size_t>(-1) ){
+    : primitive(PrimitiveType_None)
+    , cache_idx(static_cast<size_t>(-1) ){
         // empty
     }
 
@@ -229,6 +248,10 @@ public:
 
     size_t size;
 
+    /** Set for the dummy structures of primitive types. The primitive
+     *  converters switch on this instead of comparing names. */
+    PrimitiveType primitive;
+
 public:
 
     // --------------------------------------------------------
@@ -262,6 +285,13 @@ public:
      *  @param db File database, including input stream. */
     template <typename T> void Convert (T& dest, const FileDatabase& db) const;
 
+    // --------------------------------------------------------
+    /** Convert `count` consecutive instances of the structure.
+     *  Arrays of primitives whose type matches the destination
+     *  type exactly are read without per-element dispatch. */
+    template <typename T> void ConvertArray (T* dest, size_t count,
+        const FileDatabase& db) const;
+
     // --------------------------------------------------------
     // generic converter
     template <typename T>
@@ -333,6 +363,13 @@ public:
 
 private:
 
+    // --------------------------------------------------------
+    /** Same as operator[], but remembers the result for the name
+     *  pointer. The generated converters pass string literals, so
+     *  after the first instance of a structure has been read,
+     *  looking up one of its fields is a single hash probe. */
+    inline const Field& LookupField (const char* name) const;
+
     // --------------------------------------------------------
     template <template <typename> class TOUT, typename T>
     bool ResolvePointer(TOUT<T>& out, const Pointer & ptrval,
@@ -396,6 +433,7 @@ private:
 private:
 
     mutable size_t cache_idx;
+    mutable std::unordered_map<const char*, size_t> field_lookup;
 };
 
 // --------------------------------------------------------
@@ -467,6 +505,11 @@ public:
     /** Access a structure by its index */
     inline const Structure& operator [] (const size_t i) const;
 
+    // --------------------------------------------------------
+    /** Access the structure describing the type of a field.
+     *  Raises an error if the type is not known. */
+    inline const Structure& GetFieldType (const Field& f) const;
+
 public:
 
     // --------------------------------------------------------
@@ -483,6 +526,12 @@ public:
      *  known at compile time (consier Object::data).*/
     void RegisterConverters();
 
+    // --------------------------------------------------------
+    /** Resolve the type of every field to an index into
+     *  @c structures, so reading a field needs no name lookup
+     *  of its type. Call after all structures were added. */
+    void CompileReadPlans();
+
 
     // --------------------------------------------------------
     /** Take an input blob from the stream, interpret it according to
@@ -540,6 +589,13 @@ template <> inline void Structure :: Convert<float>     (float& dest,const FileD
 template <> inline void Structure :: Convert<double>    (double& dest,const FileDatabase& db) const;
 template <> inline void Structure :: Convert<Pointer>   (Pointer& dest,const FileDatabase& db) const;
 
+// bulk converters for arrays of primitive types
+template <> inline void Structure :: ConvertArray<int>     (int* dest,size_t count,const FileDatabase& db) const;
+template <> inline void Structure :: ConvertArray<short>   (short* dest,size_t count,const FileDatabase& db) const;
+template <> inline void Structure :: ConvertArray<char>    (char* dest,size_t count,const FileDatabase& db) const;
+template <> inline void Structure :: ConvertArray<float>   (float* dest,size_t count,const FileDatabase& db) const;
+template <> inline void Structure :: ConvertArray<double>  (double* dest,size_t count,const FileDatabase& db) const;
+
 // -------------------------------------------------------------------------------
 /** Describes a master file block header. Each master file sections holds n
  *  elements of a certain SDNA structure (or otherwise unspecified data). */
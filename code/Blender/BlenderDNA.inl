@@ -73,6 +73,20 @@ const Field* Structure :: Get (const std::string& ss) const
     return it == indices.end() ? NULL : &fields[(*it).second];
 }
 
+//--------------------------------------------------------------------------------
+const Field& Structure :: LookupField (const char* name) const
+{
+    std::unordered_map<const char*, size_t>::const_iterator it = field_lookup.find(name);
+    if (it != field_lookup.end() && fields[(*it).second].name == name) {
+        return fields[(*it).second];
+    }
+
+    // missing fields are not remembered, operator[] raises the error
+    const Field& f = (*this)[name];
+    field_lookup[name] = static_cast<size_t>(&f - &fields.front());
+    return f;
+}
+
 //--------------------------------------------------------------------------------
 const Field& Structure :: operator [] (const size_t i) const
 {
@@ -99,14 +113,23 @@ template <typename T> void Structure :: Convert(
     Convert<T> (*static_cast<T*> ( in.get() ),db);
 }
 
+//--------------------------------------------------------------------------------
+template <typename T> void Structure :: ConvertArray(T* dest, size_t count,
+    const FileDatabase& db) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        Convert(dest[i],db);
+    }
+}
+
 //--------------------------------------------------------------------------------
 template <int error_policy, typename T, size_t M>
 void Structure :: ReadFieldArray(T (& out)[M], const char* name, const FileDatabase& db) const
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
-        const Structure& s = db.dna[f.type];
+        const Field& f = LookupField(name);
+        const Structure& s = db.dna.GetFieldType(f);
 
         // is the input actually an array?
         if (!(f.flags & FieldFlag_Array)) {
@@ -118,10 +141,8 @@ void Structure :: ReadFieldArray(T (& out)[M], const char* name, const FileDatab
         db.reader->IncPtr(f.offset);
 
         // size conversions are always allowed, regardless of error_policy
-        unsigned int i = 0;
-        for(; i < std::min(f.array_sizes[0],M); ++i) {
-            s.Convert(out[i],db);
-        }
+        size_t i = std::min(f.array_sizes[0],M);
+        s.ConvertArray(out,i,db);
         for(; i < M; ++i) {
             _defaultInitializer<ErrorPolicy_Igno>()(out[i]);
         }
@@ -144,8 +165,8 @@ void Structure :: ReadFieldArray2(T (& out)[M][N], const char* name, const FileD
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
-        const Structure& s = db.dna[f.type];
+        const Field& f = LookupField(name);
+        const Structure& s = db.dna.GetFieldType(f);
 
         // is the input actually an array?
         if (!(f.flags & FieldFlag_Array)) {
@@ -159,10 +180,8 @@ void Structure :: ReadFieldArray2(T (& out)[M][N], const char* name, const FileD
         // size conversions are always allowed, regardless of error_policy
         unsigned int i = 0;
         for(; i < std::min(f.array_sizes[0],M); ++i) {
-            unsigned int j = 0;
-            for(; j < std::min(f.array_sizes[1],N); ++j) {
-                s.Convert(out[i][j],db);
-            }
+            size_t j = std::min(f.array_sizes[1],N);
+            s.ConvertArray(out[i],j,db);
             for(; j < N; ++j) {
                 _defaultInitializer<ErrorPolicy_Igno>()(out[i][j]);
             }
@@ -192,7 +211,7 @@ bool Structure :: ReadFieldPtr(TOUT<T>& out, const char* name, const FileDatabas
     Pointer ptrval;
     const Field* f;
     try {
-        f = &(*this)[name];
+        f = &LookupField(name);
 
         // sanity check, should never happen if the genblenddna script is right
         if (!(f->flags & FieldFlag_Pointer)) {
@@ -237,7 +256,7 @@ bool Structure :: ReadFieldPtr(TOUT<T> (&out)[N], const char* name,
     Pointer ptrval[N];
     const Field* f;
     try {
-        f = &(*this)[name];
+        f = &LookupField(name);
 
         // sanity check, should never happen if the genblenddna script is right
         if ((FieldFlag_Pointer|FieldFlag_Pointer) != (f->flags & (FieldFlag_Pointer|FieldFlag_Pointer))) {
@@ -287,9 +306,9 @@ void Structure :: ReadField(T& out, const char* name, const FileDatabase& db) co
 {
     const StreamReaderAny::pos old = db.reader->GetCurrentPos();
     try {
-        const Field& f = (*this)[name];
+        const Field& f = LookupField(name);
         // find the structure definition pertaining to this field
-        const Structure& s = db.dna[f.type];
+        const Structure& s = db.dna.GetFieldType(f);
 
         db.reader->IncPtr(f.offset);
         s.Convert(out,db);
@@ -317,7 +336,7 @@ bool Structure::ReadCustomDataPtr(std::shared_ptr<ElemBase>&out, int cdtype, con
 	Pointer ptrval;
 	const Field* f;
 	try	{
-		f = &(*this)[name];
+		f = &LookupField(name);
 
 		// sanity check, should never happen if the genblenddna script is right
 		if (!(f->flags & FieldFlag_Pointer)) {
@@ -364,7 +383,7 @@ bool Structure::ReadFieldPtrVector(vector<TOUT<T>>&out, const char* name, const
 	Pointer ptrval;
 	const Field* f;
 	try	{
-		f = &(*this)[name];
+		f = &LookupField(name);
 
 		// sanity check, should never happen if the genblenddna script is right
 		if (!(f->flags & FieldFlag_Pointer)) {
@@ -391,7 +410,7 @@ bool Structure::ReadFieldPtrVector(vector<TOUT<T>>&out, const char* name, const
 		// FIXME: basically, this could cause problems with 64 bit pointers on 32 bit systems.
 		// I really ought to improve StreamReader to work with 64 bit indices exclusively.
 
-		const Structure& s = db.dna[f->type];
+		const Structure& s = db.dna.GetFieldType(*f);
 		for (size_t i = 0; i < block->num; ++i)	{
 			TOUT<T> p(new T);
 			s.Convert(*p, db);
@@ -419,7 +438,7 @@ bool Structure :: ResolvePointer(TOUT<T>& out, const Pointer & ptrval, const Fil
     if (!ptrval.val) {
         return false;
     }
-    const Structure& s = db.dna[f.type];
+    const Structure& s = db.dna.GetFieldType(f);
     // find the file block the pointer is pointing to
     const FileBlockHead* block = LocateFileBlockForAddress(ptrval,db);
 
@@ -454,9 +473,7 @@ bool Structure :: ResolvePointer(TOUT<T>& out, const Pointer & ptrval, const Fil
     // if the non_recursive flag is set, we don't do anything but leave
     // the cursor at the correct position to resolve the object.
     if (!non_recursive) {
-        for (size_t i = 0; i < num; ++i,++o) {
-            s.Convert(*o,db);
-        }
+        s.ConvertArray(o,num,db);
 
         db.reader->SetCurrentPos(pold);
     }
@@ -659,26 +676,51 @@ template <> struct static_cast_silent<double> {
 // ------------------------------------------------------------------------------------------------
 template <typename T> inline void ConvertDispatcher(T& out, const Structure& in,const FileDatabase& db)
 {
-    if (in.name == "int") {
+    switch (in.primitive) {
+    case PrimitiveType_Int:
         out = static_cast_silent<T>()(db.reader->GetU4());
-    }
-    else if (in.name == "short") {
+        break;
+    case PrimitiveType_Short:
         out = static_cast_silent<T>()(db.reader->GetU2());
-    }
-    else if (in.name == "char") {
+        break;
+    case PrimitiveType_Char:
         out = static_cast_silent<T>()(db.reader->GetU1());
-    }
-    else if (in.name == "float") {
+        break;
+    case PrimitiveType_Float:
         out = static_cast<T>(db.reader->GetF4());
-    }
-    else if (in.name == "double") {
+        break;
+    case PrimitiveType_Double:
         out = static_cast<T>(db.reader->GetF8());
-    }
-    else {
+        break;
+    default:
         throw DeadlyImportError("Unknown source for conversion to primitive data type: "+in.name);
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Reads a value whose type in the file matches the destination type exactly
+inline void ReadPrimitive(int& out, const FileDatabase& db)    { out = db.reader->GetI4(); }
+inline void ReadPrimitive(short& out, const FileDatabase& db)  { out = db.reader->GetI2(); }
+inline void ReadPrimitive(char& out, const FileDatabase& db)   { out = static_cast<char>(db.reader->GetI1()); }
+inline void ReadPrimitive(float& out, const FileDatabase& db)  { out = db.reader->GetF4(); }
+inline void ReadPrimitive(double& out, const FileDatabase& db) { out = db.reader->GetF8(); }
+
+// ------------------------------------------------------------------------------------------------
+template <PrimitiveType type, typename T> inline void ConvertPrimitiveArray(T* out, size_t count,
+    const Structure& in, const FileDatabase& db)
+{
+    if (in.primitive == type) {
+        // the common case, e.g. float[3] into float[3]: no dispatch per element
+        for (size_t i = 0; i < count; ++i) {
+            ReadPrimitive(out[i],db);
+        }
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        in.Convert(out[i],db);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 template <> inline void Structure :: Convert<int>    (int& dest,const FileDatabase& db) const
 {
@@ -689,7 +731,7 @@ template <> inline void Structure :: Convert<int>    (int& dest,const FileDataba
 template<> inline void Structure :: Convert<short>  (short& dest,const FileDatabase& db) const
 {
     // automatic rescaling from short to float and vice versa (seems to be used by normals)
-    if (name == "float") {
+    if (primitive == PrimitiveType_Float) {
         float f = db.reader->GetF4();
         if ( f > 1.0f )
             f = 1.0f;
@@ -697,7 +739,7 @@ template<> inline void Structure :: Convert<short>  (short& dest,const FileDatab
         //db.reader->IncPtr(-4);
         return;
     }
-    else if (name == "double") {
+    else if (primitive == PrimitiveType_Double) {
         dest = static_cast<short>(db.reader->GetF8() * 32767.);
         //db.reader->IncPtr(-8);
         return;
@@ -709,11 +751,11 @@ template<> inline void Structure :: Convert<short>  (short& dest,const FileDatab
 template <> inline void Structure :: Convert<char>   (char& dest,const FileDatabase& db) const
 {
     // automatic rescaling from char to float and vice versa (seems useful for RGB colors)
-    if (name == "float") {
+    if (primitive == PrimitiveType_Float) {
         dest = static_cast<char>(db.reader->GetF4() * 255.f);
         return;
     }
-    else if (name == "double") {
+    else if (primitive == PrimitiveType_Double) {
         dest = static_cast<char>(db.reader->GetF8() * 255.f);
         return;
     }
@@ -724,11 +766,11 @@ template <> inline void Structure :: Convert<char>   (char& dest,const FileDatab
 template <> inline void Structure::Convert<unsigned char>(unsigned char& dest, const FileDatabase& db) const
 {
 	// automatic rescaling from char to float and vice versa (seems useful for RGB colors)
-	if (name == "float") {
+	if (primitive == PrimitiveType_Float) {
 		dest = static_cast<unsigned char>(db.reader->GetF4() * 255.f);
 		return;
 	}
-	else if (name == "double") {
+	else if (primitive == PrimitiveType_Double) {
 		dest = static_cast<unsigned char>(db.reader->GetF8() * 255.f);
 		return;
 	}
@@ -740,12 +782,12 @@ template <> inline void Structure::Convert<unsigned char>(unsigned char& dest, c
 template <> inline void Structure :: Convert<float>  (float& dest,const FileDatabase& db) const
 {
     // automatic rescaling from char to float and vice versa (seems useful for RGB colors)
-    if (name == "char") {
+    if (primitive == PrimitiveType_Char) {
         dest = db.reader->GetI1() / 255.f;
         return;
     }
     // automatic rescaling from short to float and vice versa (used by normals)
-    else if (name == "short") {
+    else if (primitive == PrimitiveType_Short) {
         dest = db.reader->GetI2() / 32767.f;
         return;
     }
@@ -755,11 +797,11 @@ template <> inline void Structure :: Convert<float>  (float& dest,const FileData
 // ------------------------------------------------------------------------------------------------
 template <> inline void Structure :: Convert<double> (double& dest,const FileDatabase& db) const
 {
-    if (name == "char") {
+    if (primitive == PrimitiveType_Char) {
         dest = db.reader->GetI1() / 255.;
         return;
     }
-    else if (name == "short") {
+    else if (primitive == PrimitiveType_Short) {
         dest = db.reader->GetI2() / 32767.;
         return;
     }
@@ -778,6 +820,36 @@ template <> inline void Structure :: Convert<Pointer> (Pointer& dest,const FileD
     //db.reader->IncPtr(-4);
 }
 
+// ------------------------------------------------------------------------------------------------
+template <> inline void Structure :: ConvertArray<int> (int* dest, size_t count, const FileDatabase& db) const
+{
+    ConvertPrimitiveArray<PrimitiveType_Int>(dest,count,*this,db);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <> inline void Structure :: ConvertArray<short> (short* dest, size_t count, const FileDatabase& db) const
+{
+    ConvertPrimitiveArray<PrimitiveType_Short>(dest,count,*this,db);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <> inline void Structure :: ConvertArray<char> (char* dest, size_t count, const FileDatabase& db) const
+{
+    ConvertPrimitiveArray<PrimitiveType_Char>(dest,count,*this,db);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <> inline void Structure :: ConvertArray<float> (float* dest, size_t count, const FileDatabase& db) const
+{
+    ConvertPrimitiveArray<PrimitiveType_Float>(dest,count,*this,db);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <> inline void Structure :: ConvertArray<double> (double* dest, size_t count, const FileDatabase& db) const
+{
+    ConvertPrimitiveArray<PrimitiveType_Double>(dest,count,*this,db);
+}
+
 //--------------------------------------------------------------------------------
 const Structure& DNA :: operator [] (const std::string& ss) const
 {
@@ -810,6 +882,18 @@ const Structure& DNA :: operator [] (const size_t i) const
     return structures[i];
 }
 
+//--------------------------------------------------------------------------------
+const Structure& DNA :: GetFieldType (const Field& f) const
+{
+    if (f.type_index >= structures.size()) {
+        throw Error((Formatter::format(),
+            "BlendDNA: Did not find a structure named `",f.type,"`"
+            ));
+    }
+
+    return structures[f.type_index];
+}
+
 //--------------------------------------------------------------------------------
 template <template <typename> class TOUT> template <typename T> void ObjectCache<TOUT> :: get (
     const Structure& s,
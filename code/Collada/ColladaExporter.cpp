@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_COLLADA_EXPORTER
 
 #include "ColladaExporter.h"
+#include "Common/SceneNameIndex.h"
 #include <assimp/Bitmap.h>
 #include <assimp/MathFunctions.h>
 #include <assimp/fast_atof.h>
@@ -73,33 +74,30 @@ void ExportSceneCollada(const char* pFile, IOSystem* pIOSystem, const aiScene* p
     std::string path = DefaultIOSystem::absolutePath(std::string(pFile));
     std::string file = DefaultIOSystem::completeBaseName(std::string(pFile));
 
-    // invoke the exporter
-    ColladaExporter iDoTheExportThing( pScene, pIOSystem, path, file);
-    
-    if (iDoTheExportThing.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-
-    // we're still here - export successfully completed. Write result to the given IOSYstem
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .dae file: " + std::string(pFile));
     }
 
-    // XXX maybe use a small wrapper around IOStream that behaves like std::stringstream in order to avoid the extra copy.
-    outfile->Write( iDoTheExportThing.mOutput.str().c_str(), static_cast<size_t>(iDoTheExportThing.mOutput.tellp()),1);
+    // invoke the exporter, it writes directly to the output stream
+    ColladaExporter iDoTheExportThing( pScene, pIOSystem, outfile.get(), path, file);
+
+    iDoTheExportThing.mOutput.Flush();
+    if (iDoTheExportThing.mOutput.fail()) {
+        throw DeadlyExportError("could not write output .dae file: " + std::string(pFile));
+    }
 }
 
 } // end of namespace Assimp
 
 // ------------------------------------------------------------------------------------------------
 // Constructor for a specific scene to export
-ColladaExporter::ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file) 
-: mIOSystem(pIOSystem)
+ColladaExporter::ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, IOStream* output, const std::string& path, const std::string& file) 
+: mOutput(output)
+, mIOSystem(pIOSystem)
 , mPath(path)
 , mFile(file) {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    mOutput.imbue( std::locale("C") );
+    // BufferedTextWriter always formats numbers using the standard, C locale
     mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
 
     mScene = pScene;
@@ -1454,37 +1452,14 @@ void ColladaExporter::WriteAnimationsLibrary()
 // ------------------------------------------------------------------------------------------------
 // Helper to find a bone by name in the scene
 aiBone* findBone( const aiScene* scene, const char * name) {
-    for (size_t m=0; m<scene->mNumMeshes; m++) {
-        aiMesh * mesh = scene->mMeshes[m];
-        for (size_t b=0; b<mesh->mNumBones; b++) {
-            aiBone * bone = mesh->mBones[b];
-            if (0 == strcmp(name, bone->mName.C_Str())) {
-                return bone;
-            }
-        }
-    }
-    return NULL;
+    return GetSceneNameIndex(scene).FindBone(name);
 }
 
 // ------------------------------------------------------------------------------------------------
-const aiNode * findBoneNode( const aiNode* aNode, const aiBone* bone)
+// Helper to find the node of a bone, i.e. the first node with the same name
+const aiNode * findBoneNode( const aiScene* scene, const aiBone* bone)
 {
-	if ( aNode && bone && aNode->mName == bone->mName ) {
-		return aNode;
-	}
-	
-	if ( aNode && bone ) {
-		for (unsigned int i=0; i < aNode->mNumChildren; ++i) {
-			aiNode * aChild = aNode->mChildren[i];
-			const aiNode * foundFromChild = 0;
-			if ( aChild ) {
-				foundFromChild = findBoneNode( aChild, bone );
-				if ( foundFromChild ) return foundFromChild;
-			}
-		}
-	}
-	
-	return NULL;
+    return GetSceneNameIndex(scene).FindNode(bone->mName);
 }
 
 const aiNode * findSkeletonRootNode( const aiScene* scene, const aiMesh * mesh)
@@ -1494,7 +1469,7 @@ const aiNode * findSkeletonRootNode( const aiScene* scene, const aiMesh * mesh)
 		for (unsigned int i=0; i < mesh->mNumBones; ++i) {
 			aiBone * bone = mesh->mBones[i];
 
-			const aiNode * node = findBoneNode( scene->mRootNode, bone);
+			const aiNode * node = findBoneNode( scene, bone);
 			if ( node ) {
 				while ( node->mParent && findBone(scene, node->mParent->mName.C_Str() ) != 0 ) {
 					node = node->mParent;
@@ -1529,6 +1504,7 @@ void ColladaExporter::WriteNode( const aiScene* pScene, aiNode* pNode)
         std::stringstream ss;
         ss << "Node_" << pNode;
         pNode->mName.Set(ss.str());
+        InvalidateSceneNameIndex(pScene);
     }
 
     // If the node is associated with a bone, it is a joint node (JOINT)
@@ -51,6 +51,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/mesh.h>
 #include <assimp/light.h>
 #include <assimp/Exporter.hpp>
+#include "Common/BufferedTextWriter.h"
+
 #include <sstream>
 #include <vector>
 #include <map>
@@ -69,7 +71,7 @@ class ColladaExporter
 {
 public:
     /// Constructor for a specific scene to export
-    ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file);
+    ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, IOStream* output, const std::string& path, const std::string& file);
 
     /// Destructor
     virtual ~ColladaExporter();
@@ -147,8 +149,8 @@ protected:
     }
 
 public:
-    /// Stringstream to write all output into
-    std::stringstream mOutput;
+    /// Buffered writer for all output, flushes to the output stream in blocks
+    BufferedTextWriter mOutput;
 
     /// The IOSystem for output
     IOSystem* mIOSystem;
@@ -0,0 +1,191 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file AnimationSampler.cpp
+ *  @brief Implementation of the AnimationSampler class.
+ */
+
+#include <assimp/AnimationSampler.h>
+#include <assimp/anim.h>
+
+#include "VectorKernels.h"
+
+#include <algorithm>
+
+namespace Assimp {
+
+namespace {
+
+// Number of keys a cursor steps forward before falling back to a binary search
+const unsigned int MaxLinearSteps = 4;
+
+// ------------------------------------------------------------------------------------------------
+// Returns the index i of the key segment [i, i + 1] that contains the given time, clamped to
+// the first and last segment. The cursor is the segment found by the previous lookup.
+template <typename KeyType>
+unsigned int FindSegment(const KeyType* keys, unsigned int numKeys, double time, unsigned int cursor) {
+    const unsigned int last = numKeys - 2;
+    if (cursor <= last && keys[cursor].mTime <= time) {
+        // forward playback usually stays in the same segment or moves to one of the next
+        for (unsigned int steps = 0; steps < MaxLinearSteps; ++steps) {
+            if (cursor == last || time < keys[cursor + 1].mTime) {
+                return cursor;
+            }
+            ++cursor;
+        }
+    }
+    const KeyType* next = std::upper_bound(keys + 1, keys + numKeys - 1, time,
+            [](double t, const KeyType& key) { return t < key.mTime; });
+    return static_cast<unsigned int>(next - keys) - 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Interpolation factor of the time in the segment starting at the given key, in [0, 1]
+template <typename KeyType>
+ai_real GetFactor(const KeyType* keys, unsigned int segment, double time) {
+    const double start = keys[segment].mTime, end = keys[segment + 1].mTime;
+    if (time <= start || end <= start) {
+        return 0.f;
+    }
+    if (time >= end) {
+        return 1.f;
+    }
+    return static_cast<ai_real>((time - start) / (end - start));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sets up the interpolation of a vector track, to be done in one go for all channels
+void LookupVectorKeys(const aiVectorKey* keys, unsigned int numKeys, double time, unsigned int& cursor,
+        const aiVector3D& defaultValue, aiVector3D& start, aiVector3D& end, ai_real& factor) {
+    if (numKeys < 2) {
+        start = end = numKeys ? keys[0].mValue : defaultValue;
+        factor = 0.f;
+        return;
+    }
+    cursor = FindSegment(keys, numKeys, time, cursor);
+    factor = GetFactor(keys, cursor, time);
+    if (factor < 1.f) {
+        start = keys[cursor].mValue;
+        end = keys[cursor + 1].mValue;
+    } else {
+        // hold the last key exactly
+        start = end = keys[cursor + 1].mValue;
+        factor = 0.f;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+aiQuaternion EvaluateRotation(const aiQuatKey* keys, unsigned int numKeys, double time, unsigned int& cursor) {
+    if (numKeys < 2) {
+        return numKeys ? keys[0].mValue : aiQuaternion();
+    }
+    cursor = FindSegment(keys, numKeys, time, cursor);
+    const ai_real factor = GetFactor(keys, cursor, time);
+    if (factor <= 0.f) {
+        return keys[cursor].mValue;
+    }
+    if (factor >= 1.f) {
+        return keys[cursor + 1].mValue;
+    }
+    aiQuaternion result;
+    aiQuaternion::Interpolate(result, keys[cursor].mValue, keys[cursor + 1].mValue, factor);
+    return result;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+AnimationSampler::AnimationSampler(const aiAnimation* animation) :
+        mAnimation(animation) {
+    const unsigned int numChannels = animation ? animation->mNumChannels : 0;
+    mCursors.resize(numChannels);
+    mStart.resize(2 * numChannels);
+    mEnd.resize(2 * numChannels);
+    mFactors.resize(2 * numChannels);
+    mResult.resize(2 * numChannels);
+    Reset();
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::Reset() {
+    for (Cursor& cursor : mCursors) {
+        cursor.position = cursor.rotation = cursor.scaling = 0;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::Sample(double time, Transform* out) {
+    const unsigned int numChannels = GetNumChannels();
+    for (unsigned int i = 0; i < numChannels; ++i) {
+        const aiNodeAnim* channel = mAnimation->mChannels[i];
+        Cursor& cursor = mCursors[i];
+        LookupVectorKeys(channel->mPositionKeys, channel->mNumPositionKeys, time, cursor.position,
+                aiVector3D(), mStart[i], mEnd[i], mFactors[i]);
+        LookupVectorKeys(channel->mScalingKeys, channel->mNumScalingKeys, time, cursor.scaling,
+                aiVector3D(1.f, 1.f, 1.f), mStart[numChannels + i], mEnd[numChannels + i], mFactors[numChannels + i]);
+        out[i].rotation = EvaluateRotation(channel->mRotationKeys, channel->mNumRotationKeys, time, cursor.rotation);
+    }
+
+    InterpolateVectors(mStart.data(), mEnd.data(), mFactors.data(), mResult.data(), mResult.size());
+    for (unsigned int i = 0; i < numChannels; ++i) {
+        out[i].position = mResult[i];
+        out[i].scaling = mResult[numChannels + i];
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::Sample(double time, aiMatrix4x4* out) {
+    mTransforms.resize(GetNumChannels());
+    Sample(time, mTransforms.data());
+    for (size_t i = 0; i < mTransforms.size(); ++i) {
+        out[i] = mTransforms[i].GetMatrix();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::SampleClip(double startTime, double step, unsigned int numFrames, Transform* out) {
+    // the frames are evaluated in order, so every track is walked only once
+    for (unsigned int frame = 0; frame < numFrames; ++frame) {
+        Sample(startTime + step * frame, out + static_cast<size_t>(frame) * GetNumChannels());
+    }
+}
+
+} // Namespace Assimp
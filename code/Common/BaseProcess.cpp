@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
 #include "Importer.h"
+#include "SceneNameIndex.h"
 
 using namespace Assimp;
 
@@ -79,7 +80,10 @@ void BaseProcess::ExecuteOnScene( Importer* pImp)
     // catch exceptions thrown inside the PostProcess-Step
     try
     {
+        // the step may change the node graph, the bones, or both
+        InvalidateSceneNameIndex(pImp->Pimpl()->mScene);
         Execute(pImp->Pimpl()->mScene);
+        InvalidateSceneNameIndex(pImp->Pimpl()->mScene);
 
     } catch( const std::exception& err )    {
 
@@ -99,6 +103,13 @@ void BaseProcess::SetupProperties(const Importer* /*pImp*/)
     // the default implementation does nothing
 }
 
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::IsActiveExt(unsigned int /*pExtFlags*/) const
+{
+    // the default implementation isn't controlled by extended flags
+    return false;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool BaseProcess::RequireVerboseFormat() const
 {
@@ -230,6 +230,15 @@ public:
     */
     virtual bool IsActive( unsigned int pFlags) const = 0;
 
+    // -------------------------------------------------------------------
+    /** Returns whether the processing step is present in the extended
+     * flags, see #AI_CONFIG_PP_EXTENDED_STEPS.
+     * @param pExtFlags A bitwise combination of #aiPostProcessStepsExt.
+     * @return true if the process is present in this flag field. The
+     *   default implementation returns false.
+    */
+    virtual bool IsActiveExt( unsigned int pExtFlags) const;
+
     // -------------------------------------------------------------------
     /** Check whether this step expects its input vertex data to be
      *  in verbose format. */
@@ -0,0 +1,134 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file BufferedTextWriter.cpp
+ *  @brief Implementation of the BufferedTextWriter class.
+ */
+
+#include "Common/BufferedTextWriter.h"
+
+#include <assimp/IOStream.hpp>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+BufferedTextWriter::BufferedTextWriter(IOStream* stream, size_t blockSize)
+: mStream(stream)
+, mBuffer(blockSize > 0 ? blockSize : static_cast<size_t>(DefaultBlockSize))
+, mCursor(0)
+, mWritten(0)
+, mPrecision(6)
+, mFailed(false) {
+    ai_assert(nullptr != stream);
+}
+
+// ------------------------------------------------------------------------------------------------
+BufferedTextWriter::~BufferedTextWriter() {
+    WriteBlock();
+}
+
+// ------------------------------------------------------------------------------------------------
+void BufferedTextWriter::Flush() {
+    WriteBlock();
+    mStream->Flush();
+}
+
+// ------------------------------------------------------------------------------------------------
+void BufferedTextWriter::WriteBlock() {
+    if (0 == mCursor) {
+        return;
+    }
+    if (mStream->Write(&mBuffer[0], 1, mCursor) != mCursor) {
+        mFailed = true;
+    }
+    mWritten += mCursor;
+    mCursor = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BufferedTextWriter::write(const char* data, size_t size) {
+    while (size > 0) {
+        if (mCursor == mBuffer.size()) {
+            WriteBlock();
+        }
+        const size_t n = std::min(size, mBuffer.size() - mCursor);
+        ::memcpy(&mBuffer[mCursor], data, n);
+        mCursor += n;
+        data += n;
+        size -= n;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+BufferedTextWriter& BufferedTextWriter::operator << (const char* s) {
+    ai_assert(nullptr != s);
+    write(s, ::strlen(s));
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BufferedTextWriter::WriteFloat(double v) {
+    // Same output as std::ostream with the default float field, which is specified in
+    // terms of printf's %g conversion. Only the decimal point depends on the C locale.
+    char buffer[64];
+    const int len = ::snprintf(buffer, sizeof(buffer), "%.*g", mPrecision, v);
+    if (len <= 0) {
+        return;
+    }
+    const char point = *::localeconv()->decimal_point;
+    if ('.' != point) {
+        char* p = ::strchr(buffer, point);
+        if (nullptr != p) {
+            *p = '.';
+        }
+    }
+    write(buffer, std::min(static_cast<size_t>(len), sizeof(buffer) - 1));
+}
+
+} // Namespace Assimp
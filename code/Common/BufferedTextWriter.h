@@ -0,0 +1,221 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file BufferedTextWriter.h
+ *  @brief Buffered, locale independent text output to an IOStream.
+ */
+#pragma once
+#ifndef AI_BUFFEREDTEXTWRITER_H_INC
+#define AI_BUFFEREDTEXTWRITER_H_INC
+
+#include <assimp/defs.h>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Assimp {
+
+class IOStream;
+
+// --------------------------------------------------------------------------------------------
+/** Replacement for a std::ostringstream in text exporters.
+ *
+ *  Output is collected in a fixed-size block which is written to the IOStream whenever
+ *  it is full, so exporting large scenes doesn't require the whole file to be kept in
+ *  memory. Numbers are always formatted like a std::ostream imbued with the "C" locale
+ *  would format them (floating-point values in general notation with the precision set
+ *  through precision()), but without the overhead of the iostream locale machinery.
+ *
+ *  The writer doesn't take ownership of the stream. Pending output is written when the
+ *  writer is destroyed, call Flush() and check fail() to detect write errors.
+ */
+// --------------------------------------------------------------------------------------------
+class ASSIMP_API BufferedTextWriter {
+public:
+    /** Default size of the blocks written to the stream */
+    static const size_t DefaultBlockSize = 64 * 1024;
+
+    // ---------------------------------------------------------------------
+    /** @param stream Output stream, must stay valid until the writer is destroyed.
+     *  @param blockSize Size of the blocks written to the stream. */
+    explicit BufferedTextWriter(IOStream* stream, size_t blockSize = DefaultBlockSize);
+
+    // ---------------------------------------------------------------------
+    /** Writes all pending output to the stream. */
+    ~BufferedTextWriter();
+
+    // ---------------------------------------------------------------------
+    /** Sets the number of significant digits for floating-point values, the default is 6. */
+    void precision(int precision) {
+        mPrecision = precision;
+    }
+
+    // ---------------------------------------------------------------------
+    /** Writes all pending output to the stream and flushes the stream. */
+    void Flush();
+
+    // ---------------------------------------------------------------------
+    /** Returns true if writing to the stream failed at some point. */
+    bool fail() const {
+        return mFailed;
+    }
+
+    // ---------------------------------------------------------------------
+    /** Returns the number of bytes written so far, including pending output. */
+    size_t tellp() const {
+        return mWritten + mCursor;
+    }
+
+    // ---------------------------------------------------------------------
+    /** Writes raw bytes, for binary variants of text formats. */
+    void write(const char* data, size_t size);
+
+    BufferedTextWriter& operator << (const char* s);
+    BufferedTextWriter& operator << (const std::string& s) {
+        write(s.data(), s.length());
+        return *this;
+    }
+    BufferedTextWriter& operator << (char c) {
+        if (mCursor == mBuffer.size()) {
+            WriteBlock();
+        }
+        mBuffer[mCursor++] = c;
+        return *this;
+    }
+    BufferedTextWriter& operator << (signed char c) {
+        return *this << static_cast<char>(c);
+    }
+    BufferedTextWriter& operator << (unsigned char c) {
+        return *this << static_cast<char>(c);
+    }
+    BufferedTextWriter& operator << (bool b) {
+        return *this << (b ? '1' : '0');
+    }
+    BufferedTextWriter& operator << (short v) {
+        WriteInteger(v);
+        return *this;
+    }
+    BufferedTextWriter& operator << (unsigned short v) {
+        WriteInteger(v);
+        return *this;
+    }
+    BufferedTextWriter& operator << (int v) {
+        WriteInteger(v);
+        return *this;
+    }
+    BufferedTextWriter& operator << (unsigned int v) {
+        WriteInteger(v);
+        return *this;
+    }
+    BufferedTextWriter& operator << (long v) {
+        WriteInteger(v);
+        return *this;
+    }
+    BufferedTextWriter& operator << (unsigned long v) {
+        WriteInteger(v);
+        return *this;
+    }
+    BufferedTextWriter& operator << (long long v) {
+        WriteInteger(v);
+        return *this;
+    }
+    BufferedTextWriter& operator << (unsigned long long v) {
+        WriteInteger(v);
+        return *this;
+    }
+    BufferedTextWriter& operator << (float v) {
+        WriteFloat(v);
+        return *this;
+    }
+    BufferedTextWriter& operator << (double v) {
+        WriteFloat(v);
+        return *this;
+    }
+
+private:
+    // only signed values are compared against zero, that would always be false otherwise
+    template <typename T>
+    static bool IsNegative(T v, std::true_type) {
+        return v < 0;
+    }
+    template <typename T>
+    static bool IsNegative(T, std::false_type) {
+        return false;
+    }
+
+    template <typename T>
+    void WriteInteger(T v) {
+        // enough for 64 bit values, including the sign
+        char digits[24];
+        char* end = digits + sizeof(digits), *p = end;
+        const bool negative = IsNegative(v, std::is_signed<T>());
+        do {
+            const int d = static_cast<int>(v % 10);
+            *--p = static_cast<char>('0' + (negative ? -d : d));
+            v /= 10;
+        } while (v != 0);
+        if (negative) {
+            *--p = '-';
+        }
+        write(p, static_cast<size_t>(end - p));
+    }
+
+    void WriteFloat(double v);
+    void WriteBlock();
+
+private:
+    IOStream* mStream;
+    std::vector<char> mBuffer;
+    size_t mCursor;
+    size_t mWritten;
+    int mPrecision;
+    bool mFailed;
+
+    BufferedTextWriter(const BufferedTextWriter&);
+    BufferedTextWriter& operator = (const BufferedTextWriter&);
+};
+
+} // Namespace Assimp
+
+#endif // AI_BUFFEREDTEXTWRITER_H_INC
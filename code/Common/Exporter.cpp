@@ -66,6 +66,7 @@ Here we implement only the C++ interface (Assimp::Exporter).
 #include "Common/DefaultProgressHandler.h"
 #include "Common/BaseProcess.h"
 #include "Common/ScenePrivate.h"
+#include "Common/SceneNameIndex.h"
 #include "PostProcessing/CalcTangentsProcess.h"
 #include "PostProcessing/MakeVerboseFormat.h"
 #include "PostProcessing/JoinVerticesProcess.h"
@@ -315,6 +316,25 @@ const aiExportDataBlob* Exporter::ExportToBlob( const aiScene* pScene, const cha
     return pimpl->blob;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Deletes the working copy of a scene, detaching buffers shared with the source scene if needed
+struct SceneCopyDeleter {
+    explicit SceneCopyDeleter(const aiScene* sharedSource)
+    : mSharedSource(sharedSource) {
+        // empty
+    }
+
+    void operator()(aiScene* scene) const {
+        if (mSharedSource) {
+            SceneCombiner::DeleteSharedScene(scene, mSharedSource);
+        } else {
+            delete scene;
+        }
+    }
+
+    const aiScene* mSharedSource;
+};
+
 // ------------------------------------------------------------------------------------------------
 aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const char* pPath,
         unsigned int pPreprocessing, const ExportProperties* pProperties) {
@@ -333,14 +353,6 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
         const Exporter::ExportFormatEntry& exp = pimpl->mExporters[i];
         if (!strcmp(exp.mDescription.id,pFormatId)) {
             try {
-                // Always create a full copy of the scene. We might optimize this one day,
-                // but for now it is the most pragmatic way.
-                aiScene* scenecopy_tmp = nullptr;
-                SceneCombiner::CopyScene(&scenecopy_tmp,pScene);
-
-                pimpl->mProgressHandler->UpdateFileWrite(1, 4);
-
-                std::unique_ptr<aiScene> scenecopy(scenecopy_tmp);
                 const ScenePrivateData* const priv = ScenePriv(pScene);
 
                 // steps that are not idempotent, i.e. we might need to run them again, usually to get back to the
@@ -353,6 +365,25 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                     ? (priv->mPPStepsApplied & ~nonIdempotentSteps)
                     : 0u);
 
+                // Always create a full copy of the scene. If nothing is going to touch the meshes
+                // of the copy, their buffers may be shared with the source scene on request.
+                const bool shareMeshBuffers = nullptr != pProperties
+                    && pProperties->GetPropertyBool(AI_CONFIG_EXPORT_SHARE_MESH_BUFFERS)
+                    && !pp
+                    && (is_verbose_format || !(exp.mEnforcePP & aiProcess_JoinIdenticalVertices));
+
+                aiScene* scenecopy_tmp = nullptr;
+                if (shareMeshBuffers) {
+                    SceneCombiner::CopySceneShared(&scenecopy_tmp,pScene);
+                } else {
+                    SceneCombiner::CopyScene(&scenecopy_tmp,pScene);
+                }
+
+                pimpl->mProgressHandler->UpdateFileWrite(1, 4);
+
+                std::unique_ptr<aiScene, SceneCopyDeleter> scenecopy(scenecopy_tmp,
+                    SceneCopyDeleter(shareMeshBuffers ? pScene : nullptr));
+
                 // If no extra post-processing was specified, and we obtained this scene from an
                 // Assimp importer, apply the reverse steps automatically.
                 // TODO: either drop this, or document it. Otherwise it is just a bad surprise.
@@ -428,6 +459,7 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                                 continue;
                             }
                             p->Execute(scenecopy.get());
+                            InvalidateSceneNameIndex(scenecopy.get());
                         }
                     }
                     ScenePrivateData* const privOut = ScenePriv(scenecopy.get());
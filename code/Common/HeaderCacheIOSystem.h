@@ -0,0 +1,315 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file HeaderCacheIOSystem.h
+ *  Implements an IOSystem wrapper which reads the header of one file just once,
+ *  so that probing all importers for that file doesn't reopen it over and over.
+ */
+#pragma once
+#ifndef AI_HEADERCACHEIOSYSTEM_H_INC
+#define AI_HEADERCACHEIOSYSTEM_H_INC
+
+#include <assimp/IOSystem.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Assimp    {
+
+// ---------------------------------------------------------------------------
+/** IOSystem wrapper caching the header of a single file.
+ *
+ *  Format detection asks every registered importer whether it can read the
+ *  file, and most of them open it to look at the first few hundred bytes.
+ *  This wrapper opens the file once, keeps its first #HeaderSize bytes and
+ *  serves all further read-only opens of that file from the cached header.
+ *  Reads beyond the header transparently fall back to a real stream of the
+ *  wrapped IOSystem, so importers which scan the whole file still work.
+ *  All other files and calls are passed to the wrapped IOSystem unchanged.
+ */
+class HeaderCacheIOSystem : public IOSystem
+{
+public:
+    /** Number of bytes kept in the cache, larger than any header search. */
+    static const size_t HeaderSize = 4096;
+
+    /** Constructor. */
+    HeaderCacheIOSystem(const std::string& file, IOSystem* wrapped)
+    : mWrapped(wrapped)
+    , mFile(file)
+    , mLoaded(false)
+    , mExists(false)
+    , mFileSize(0)
+    , mHeader() {
+        ai_assert(nullptr != mWrapped);
+    }
+
+    /** Destructor. */
+    ~HeaderCacheIOSystem() {
+        // empty
+    }
+
+    // -------------------------------------------------------------------
+    /** Tests for the existence of a file at the given path. */
+    bool Exists( const char* pFile) const {
+        if (nullptr != pFile && mFile == pFile && mLoaded) {
+            return mExists;
+        }
+        return mWrapped->Exists(pFile);
+    }
+
+    // -------------------------------------------------------------------
+    /** Returns the directory separator. */
+    char getOsSeparator() const {
+        return mWrapped->getOsSeparator();
+    }
+
+    // -------------------------------------------------------------------
+    /** Open a new file with a given path. */
+    IOStream* Open( const char* pFile, const char* pMode = "rb") {
+        if ( nullptr == pFile || nullptr == pMode ) {
+            return nullptr;
+        }
+
+        // Only read-only access to the cached file is served from the header
+        if (mFile != pFile || nullptr != ::strpbrk(pMode, "wa+")) {
+            return mWrapped->Open(pFile, pMode);
+        }
+        if (!Load()) {
+            return nullptr;
+        }
+        return new CachedStream(*this);
+    }
+
+    // -------------------------------------------------------------------
+    /** Closes the given file and releases all resources associated with it. */
+    void Close( IOStream* pFile) {
+        if (nullptr != dynamic_cast<CachedStream*>(pFile)) {
+            delete pFile;
+            return;
+        }
+        mWrapped->Close(pFile);
+    }
+
+    // -------------------------------------------------------------------
+    /** Compare two paths */
+    bool ComparePaths (const char* one, const char* second) const {
+        return mWrapped->ComparePaths (one,second);
+    }
+
+    // -------------------------------------------------------------------
+    /** Pushes a new directory onto the directory stack. */
+    bool PushDirectory(const std::string &path ) {
+        return mWrapped->PushDirectory(path);
+    }
+
+    // -------------------------------------------------------------------
+    /** Returns the top directory from the stack. */
+    const std::string &CurrentDirectory() const {
+        return mWrapped->CurrentDirectory();
+    }
+
+    // -------------------------------------------------------------------
+    /** Returns the number of directories stored on the stack. */
+    size_t StackSize() const {
+        return mWrapped->StackSize();
+    }
+
+    // -------------------------------------------------------------------
+    /** Pops the top directory from the stack. */
+    bool PopDirectory() {
+        return mWrapped->PopDirectory();
+    }
+
+    // -------------------------------------------------------------------
+    /** Creates an new directory at the given path. */
+    bool CreateDirectory(const std::string &path) {
+        return mWrapped->CreateDirectory(path);
+    }
+
+    // -------------------------------------------------------------------
+    /** Will change the current directory to the given path. */
+    bool ChangeDirectory(const std::string &path) {
+        return mWrapped->ChangeDirectory(path);
+    }
+
+    // -------------------------------------------------------------------
+    /** Delete file. */
+    bool DeleteFile(const std::string &file) {
+        return mWrapped->DeleteFile(file);
+    }
+
+    // -------------------------------------------------------------------
+    /** Returns the size of the cached file, 0 if it can't be opened. */
+    size_t FileSize() {
+        Load();
+        return mFileSize;
+    }
+
+private:
+    // -------------------------------------------------------------------
+    /** Stream serving reads from the cached header, falling back to a
+     *  real stream once the consumer reads or seeks past it. */
+    class CachedStream : public IOStream {
+    public:
+        explicit CachedStream(HeaderCacheIOSystem& io)
+        : mIO(io)
+        , mPos(0)
+        , mStream(nullptr) {
+            // empty
+        }
+
+        ~CachedStream() {
+            if (nullptr != mStream) {
+                mIO.mWrapped->Close(mStream);
+            }
+        }
+
+        size_t Read(void* pvBuffer, size_t pSize, size_t pCount) {
+            if (0 == pSize || 0 == pCount) {
+                return 0;
+            }
+            const std::vector<char>& header = mIO.mHeader;
+            if (nullptr == mStream && (mPos + pSize * pCount <= header.size() || header.size() == mIO.mFileSize)) {
+                const size_t cnt = std::min(pCount, (header.size() - std::min(mPos, header.size())) / pSize);
+                if (cnt) {
+                    ::memcpy(pvBuffer, &header[mPos], cnt * pSize);
+                    mPos += cnt * pSize;
+                }
+                return cnt;
+            }
+            if (!OpenStream()) {
+                return 0;
+            }
+            return mStream->Read(pvBuffer, pSize, pCount);
+        }
+
+        size_t Write(const void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+            return 0;
+        }
+
+        aiReturn Seek(size_t pOffset, aiOrigin pOrigin) {
+            if (nullptr != mStream) {
+                return mStream->Seek(pOffset, pOrigin);
+            }
+            size_t target;
+            if (aiOrigin_SET == pOrigin) {
+                target = pOffset;
+            } else if (aiOrigin_END == pOrigin) {
+                if (pOffset > mIO.mFileSize) {
+                    return AI_FAILURE;
+                }
+                target = mIO.mFileSize - pOffset;
+            } else {
+                target = mPos + pOffset;
+            }
+            if (target > mIO.mFileSize) {
+                return AI_FAILURE;
+            }
+            mPos = target;
+            return AI_SUCCESS;
+        }
+
+        size_t Tell() const {
+            return nullptr != mStream ? mStream->Tell() : mPos;
+        }
+
+        size_t FileSize() const {
+            return mIO.mFileSize;
+        }
+
+        void Flush() {
+            // empty
+        }
+
+    private:
+        bool OpenStream() {
+            if (nullptr == mStream) {
+                mStream = mIO.mWrapped->Open(mIO.mFile.c_str(), "rb");
+                if (nullptr == mStream) {
+                    return false;
+                }
+                mStream->Seek(mPos, aiOrigin_SET);
+            }
+            return true;
+        }
+
+        HeaderCacheIOSystem& mIO;
+        size_t mPos;
+        IOStream* mStream;
+    };
+
+    // -------------------------------------------------------------------
+    /** Reads the header of the file on first use. */
+    bool Load() {
+        if (mLoaded) {
+            return mExists;
+        }
+        mLoaded = true;
+
+        IOStream* stream = mWrapped->Open(mFile.c_str(), "rb");
+        if (nullptr == stream) {
+            return false;
+        }
+        mExists = true;
+        mFileSize = stream->FileSize();
+        mHeader.resize(std::min(mFileSize, static_cast<size_t>(HeaderSize)));
+        if (!mHeader.empty()) {
+            mHeader.resize(stream->Read(&mHeader[0], 1, mHeader.size()));
+        }
+        mWrapped->Close(stream);
+        return true;
+    }
+
+    IOSystem* mWrapped;
+    std::string mFile;
+    bool mLoaded;
+    bool mExists;
+    size_t mFileSize;
+    std::vector<char> mHeader;
+};
+
+} //!ns Assimp
+
+#endif //AI_HEADERCACHEIOSYSTEM_H_INC
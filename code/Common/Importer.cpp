@@ -70,6 +70,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/ScenePreprocessor.h"
 #include "Common/ScenePrivate.h"
+#include "Common/HeaderCacheIOSystem.h"
 
 #include <assimp/BaseImporter.h>
 #include <assimp/GenericProperty.h>
@@ -588,12 +589,15 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             profiler->BeginRegion("total");
         }
 
-        // Find an worker class which can handle the file
+        // Find an worker class which can handle the file. All importers are probed
+        // through a shared, cached copy of the file header, so the file is opened
+        // just once no matter how many importers look at it.
+        HeaderCacheIOSystem detectionIO(pFile, pimpl->mIOHandler);
         BaseImporter* imp = NULL;
         SetPropertyInteger("importerIndex", -1);
         for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)  {
 
-            if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, false)) {
+            if( pimpl->mImporter[a]->CanRead( pFile, &detectionIO, false)) {
                 imp = pimpl->mImporter[a];
                 SetPropertyInteger("importerIndex", a);
                 break;
@@ -606,7 +610,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
             if (s != std::string::npos) {
                 ASSIMP_LOG_INFO("File extension not known, trying signature-based detection");
                 for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)  {
-                    if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, true)) {
+                    if( pimpl->mImporter[a]->CanRead( pFile, &detectionIO, true)) {
                         imp = pimpl->mImporter[a];
                         SetPropertyInteger("importerIndex", a);
                         break;
@@ -622,13 +626,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
         }
 
         // Get file size for progress handler
-        IOStream * fileIO = pimpl->mIOHandler->Open( pFile );
-        uint32_t fileSize = 0;
-        if (fileIO)
-        {
-            fileSize = static_cast<uint32_t>(fileIO->FileSize());
-            pimpl->mIOHandler->Close( fileIO );
-        }
+        const uint32_t fileSize = static_cast<uint32_t>(detectionIO.FileSize());
 
         // Dispatch the reading to the worker class for this format
         const aiImporterDesc *desc( imp->GetInfo() );
@@ -725,8 +723,11 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
         return NULL;
     }
 
+    // Additional steps which don't fit into the flags anymore
+    const unsigned int extFlags = static_cast<unsigned int>(GetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, 0));
+
     // If no flags are given, return the current scene with no further action
-    if (!pFlags) {
+    if (!pFlags && !extFlags) {
         return pimpl->mScene;
     }
 
@@ -765,7 +766,7 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
-        if( process->IsActive( pFlags)) {
+        if( process->IsActive( pFlags) || process->IsActiveExt( extFlags)) {
 
             if (profiler) {
                 profiler->BeginRegion("postprocess");
@@ -1122,6 +1123,23 @@ void Importer::GetMemoryRequirements(aiMemoryInfo& in) const
             }
         }
         in.meshes += (sizeof(aiFace) + 3 * sizeof(unsigned int))*mScene->mMeshes[i]->mNumFaces;
+        in.meshes += sizeof(aiMeshlet) * mScene->mMeshes[i]->mNumMeshlets;
+        in.meshes += sizeof(unsigned int) * mScene->mMeshes[i]->mNumMeshletVertices;
+        in.meshes += mScene->mMeshes[i]->mNumMeshletTriangleIndices;
+        in.meshes += sizeof(unsigned int) * mScene->mMeshes[i]->mNumLODs;
+        if (const aiQuantizedVertices* quantized = mScene->mMeshes[i]->mQuantizedVertices) {
+            const unsigned int n = quantized->mNumVertices;
+            in.meshes += sizeof(aiQuantizedVertices);
+            in.meshes += quantized->mPositions ? 3 * sizeof(unsigned short) * n : 0;
+            in.meshes += quantized->mNormals ? 2 * sizeof(short) * n : 0;
+            in.meshes += quantized->mTangents ? 2 * sizeof(short) * n : 0;
+            for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+                in.meshes += quantized->mTextureCoords[a] ? quantized->mNumUVComponents[a] * sizeof(unsigned short) * n : 0;
+            }
+            for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+                in.meshes += quantized->mColors[a] ? 4 * n : 0;
+            }
+        }
     }
     in.total += in.meshes;
 
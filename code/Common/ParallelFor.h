@@ -0,0 +1,169 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file ParallelFor.h
+ *  @brief Minimal helper to spread independent loop iterations across threads.
+ */
+#pragma once
+#ifndef AI_PARALLELFOR_H_INC
+#define AI_PARALLELFOR_H_INC
+
+#include <assimp/defs.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Returns the number of threads #ParallelFor will use at most. */
+inline unsigned int GetParallelForThreadCount() {
+    const unsigned int hw = std::thread::hardware_concurrency();
+    return hw ? hw : 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Calls func(i) for every i in [0,count), using all hardware threads.
+ *
+ *  The iterations must be independent of each other. They are handed out dynamically
+ *  in blocks of @p grain, so uneven workloads (e.g. meshes of different sizes) balance
+ *  themselves. The calling thread takes part in the work. If an iteration throws, no
+ *  further blocks are started and the first exception is rethrown on the calling thread.
+ *
+ *  @note The logger is not thread-safe in single-threaded builds, so iterations should
+ *    not write to it. Collect the messages and log them after the loop instead.
+ *  @param count Number of iterations
+ *  @param func  Callable taking the iteration index as size_t
+ *  @param grain Number of consecutive iterations handed to a thread at once */
+template <typename Func>
+inline void ParallelFor(size_t count, const Func& func, size_t grain = 1) {
+    grain = std::max<size_t>(grain, 1);
+    const size_t numBlocks = (count + grain - 1) / grain;
+    const unsigned int numThreads = static_cast<unsigned int>(
+            std::min<size_t>(GetParallelForThreadCount(), numBlocks));
+
+    if (numThreads <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> nextBlock(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        for (;;) {
+            const size_t block = nextBlock++;
+            if (block >= numBlocks || failed) {
+                return;
+            }
+            try {
+                const size_t end = std::min(count, (block + 1) * grain);
+                for (size_t i = block * grain; i < end; ++i) {
+                    func(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (unsigned int t = 1; t < numThreads; ++t) {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Calls process(i) for every i in [0,count) like #ParallelFor, then report(i, result)
+ *  for every i in ascending order on the calling thread.
+ *
+ *  This is the usual shape of a step working on independent meshes (or channels, ...):
+ *  the work runs concurrently, while everything that logs or touches shared state goes
+ *  into @p report and thus sees the same order as a sequential loop. If an iteration
+ *  throws, the exception is rethrown and @p report is not called at all.
+ *  @param count   Number of iterations
+ *  @param process Callable taking the iteration index as size_t, returning a default
+ *    constructible and assignable result
+ *  @param report  Callable taking the iteration index as size_t and a reference to the
+ *    result of the iteration
+ *  @param grain   Number of consecutive iterations handed to a thread at once */
+template <typename Process, typename Report>
+inline void ParallelForThenReport(size_t count, const Process& process, const Report& report, size_t grain = 1) {
+    // wrapped, so bool results do not end up packed into a std::vector<bool>
+    struct Result {
+        decltype(process(size_t())) mValue;
+    };
+    std::vector<Result> results(count);
+    ParallelFor(count, [&](size_t i) {
+        results[i].mValue = process(i);
+    }, grain);
+
+    for (size_t i = 0; i < count; ++i) {
+        report(i, results[i].mValue);
+    }
+}
+
+} // Namespace Assimp
+
+#endif // AI_PARALLELFOR_H_INC
@@ -134,6 +134,21 @@ corresponding preprocessor flag to selectively disable steps.
 #if (!defined ASSIMP_BUILD_NO_GENBOUNDINGBOXES_PROCESS)
 #   include "PostProcessing/GenBoundingBoxesProcess.h"
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENMESHLETS_PROCESS)
+#   include "PostProcessing/GenMeshletsProcess.h"
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENLODS_PROCESS)
+#   include "PostProcessing/GenLODsProcess.h"
+#endif
+#if (!defined ASSIMP_BUILD_NO_REDUCEKEYFRAMES_PROCESS)
+#   include "PostProcessing/ReduceKeyframesProcess.h"
+#endif
+#if (!defined ASSIMP_BUILD_NO_PACKBONEWEIGHTS_PROCESS)
+#   include "PostProcessing/PackBoneWeightsProcess.h"
+#endif
+#if (!defined ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS)
+#   include "PostProcessing/QuantizeVerticesProcess.h"
+#endif
 
 
 namespace Assimp {
@@ -146,7 +161,7 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
     // of sequence it is executed. Steps that are added here are not
     // validated - as RegisterPPStep() does - all dependencies must be given.
     // ----------------------------------------------------------------------------
-    out.reserve(31);
+    out.reserve(33);
 #if (!defined ASSIMP_BUILD_NO_MAKELEFTHANDED_PROCESS)
     out.push_back( new MakeLeftHandedProcess());
 #endif
@@ -198,6 +213,9 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_FINDINVALIDDATA_PROCESS)
     out.push_back( new FindInvalidDataProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_REDUCEKEYFRAMES_PROCESS)
+    out.push_back( new ReduceKeyframesProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_OPTIMIZEMESHES_PROCESS)
     out.push_back( new OptimizeMeshesProcess());
 #endif
@@ -247,9 +265,24 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_LIMITBONEWEIGHTS_PROCESS)
     out.push_back( new LimitBoneWeightsProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENLODS_PROCESS)
+    // the LODs are appended as further meshes, so they get the following steps as well
+    out.push_back( new GenLODsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS)
     out.push_back( new ImproveCacheLocalityProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENMESHLETS_PROCESS)
+    // meshlets reference the final vertex and face order
+    out.push_back( new GenMeshletsProcess());
+#endif
+#if (!defined ASSIMP_BUILD_NO_PACKBONEWEIGHTS_PROCESS)
+    // the packed weights follow the final vertex order as well
+    out.push_back( new PackBoneWeightsProcess());
+#endif
+#if (!defined ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS)
+    out.push_back( new QuantizeVerticesProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_GENBOUNDINGBOXES_PROCESS)
     out.push_back(new GenBoundingBoxesProcess);
 #endif
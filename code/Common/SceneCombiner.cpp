@@ -63,6 +63,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/mesh.h>
 #include <stdio.h>
 #include "ScenePrivate.h"
+#include "ParallelFor.h"
+
+#include <unordered_set>
 
 namespace Assimp {
 
@@ -90,7 +93,7 @@ void PrefixString(aiString& string,const char* prefix, unsigned int len) {
 
 // ------------------------------------------------------------------------------------------------
 // Add node identifiers to a hashing set
-void SceneCombiner::AddNodeHashes(aiNode* node, std::set<unsigned int>& hashes) {
+void SceneCombiner::AddNodeHashes(aiNode* node, std::unordered_set<unsigned int>& hashes) {
     // Add node name to hashing set if it is non-empty - empty nodes are allowed
     // and they can't have any anims assigned so its absolutely safe to duplicate them.
     if (node->mName.length) {
@@ -307,20 +310,24 @@ void SceneCombiner::MergeScenes(aiScene** _dest, aiScene* master, std::vector<At
             //}
 
             src[i].idlen = ai_snprintf(src[i].id, 32, "$%.6X$_",i);
+        }
 
-            if (flags & AI_INT_MERGE_SCENE_GEN_UNIQUE_NAMES_IF_NECESSARY) {
+        if (flags & AI_INT_MERGE_SCENE_GEN_UNIQUE_NAMES_IF_NECESSARY) {
 
-                // Compute hashes for all identifiers in this scene and store them
-                // in a sorted table (for convenience I'm using std::set). We hash
-                // just the node and animation channel names, all identifiers except
-                // the material names should be caught by doing this.
-                AddNodeHashes(src[i]->mRootNode,src[i].hashes);
+            // Compute hashes for all identifiers in each scene and store them
+            // in a hash table. We hash just the node and animation channel names,
+            // all identifiers except the material names should be caught by doing
+            // this. The scenes are only read here, so they can be processed in
+            // parallel - even duplicates.
+            ParallelFor(src.size() - 1, [&src](size_t n) {
+                SceneHelper& cur = src[n + 1];
+                AddNodeHashes(cur->mRootNode,cur.hashes);
 
-                for (unsigned int a = 0; a < src[i]->mNumAnimations;++a) {
-                    aiAnimation* anim = src[i]->mAnimations[a];
-                    src[i].hashes.insert(SuperFastHash(anim->mName.data,static_cast<uint32_t>(anim->mName.length)));
+                for (unsigned int a = 0; a < cur->mNumAnimations;++a) {
+                    aiAnimation* anim = cur->mAnimations[a];
+                    cur.hashes.insert(SuperFastHash(anim->mName.data,static_cast<uint32_t>(anim->mName.length)));
                 }
-            }
+            });
         }
     }
 
@@ -449,6 +456,11 @@ void SceneCombiner::MergeScenes(aiScene** _dest, aiScene* master, std::vector<At
 
                 // update the material index of the mesh
                 (*pip)->mMaterialIndex +=  offset[n];
+
+                // the LODs are meshes of the same scene
+                for (unsigned int l = 0; l < (*pip)->mNumLODs; ++l) {
+                    (*pip)->mLODs[l] += cnt;
+                }
                 ++pip;
             }
 
@@ -998,6 +1010,22 @@ void SceneCombiner::CopySceneFlat(aiScene** _dest,const aiScene* src) {
     ::memcpy(*_dest,src,sizeof(aiScene));
 }
 
+// ------------------------------------------------------------------------------------------------
+// Deep copy of a pointer array whose elements can be copied independently of each other
+template <typename Type, typename CopyFunc>
+inline
+void ParallelCopyPtrArray (Type**& dest, const Type* const * src, ai_uint num, const CopyFunc& copy) {
+    if (!num) {
+        dest = NULL;
+        return;
+    }
+    dest = new Type*[num];
+    std::fill(dest, dest + num, static_cast<Type*>(NULL));
+    ParallelFor(num, [dest, src, &copy](size_t i) {
+        copy(&dest[i], src[i]);
+    });
+}
+
 // ------------------------------------------------------------------------------------------------
 void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate) {
     if ( nullptr == _dest || nullptr == src ) {
@@ -1007,28 +1035,93 @@ void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate)
     if (allocate) {
         *_dest = new aiScene();
     }
-    aiScene* dest = *_dest;
-    ai_assert(nullptr != dest);
+    ai_assert(nullptr != *_dest);
+    CopySceneImpl(*_dest, src, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::CopySceneShared(aiScene** _dest,const aiScene* src) {
+    if ( nullptr == _dest || nullptr == src ) {
+        return;
+    }
+
+    *_dest = new aiScene();
+    CopySceneImpl(*_dest, src, true);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::DeleteSharedScene(aiScene* copy,const aiScene* src) {
+    if ( nullptr == copy ) {
+        return;
+    }
+
+    // Collect all buffers owned by the source scene. Post-processing may have reordered
+    // or replaced meshes of the copy, so we detach by address and not by mesh index.
+    std::unordered_set<const void*> shared;
+    for (unsigned int i = 0; src && i < src->mNumMeshes; ++i) {
+        const aiMesh* mesh = src->mMeshes[i];
+        shared.insert(mesh->mVertices);
+        shared.insert(mesh->mNormals);
+        shared.insert(mesh->mTangents);
+        shared.insert(mesh->mBitangents);
+        shared.insert(mesh->mFaces);
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+            shared.insert(mesh->mTextureCoords[n]);
+        }
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+            shared.insert(mesh->mColors[n]);
+        }
+    }
+    shared.erase(NULL);
 
+    for (unsigned int i = 0; i < copy->mNumMeshes; ++i) {
+        aiMesh* mesh = copy->mMeshes[i];
+        if (!mesh) {
+            continue;
+        }
+        if (shared.count(mesh->mVertices))   mesh->mVertices   = NULL;
+        if (shared.count(mesh->mNormals))    mesh->mNormals    = NULL;
+        if (shared.count(mesh->mTangents))   mesh->mTangents   = NULL;
+        if (shared.count(mesh->mBitangents)) mesh->mBitangents = NULL;
+        if (shared.count(mesh->mFaces)) {
+            mesh->mFaces = NULL;
+            mesh->mNumFaces = 0;
+        }
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+            if (shared.count(mesh->mTextureCoords[n])) mesh->mTextureCoords[n] = NULL;
+        }
+        for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+            if (shared.count(mesh->mColors[n])) mesh->mColors[n] = NULL;
+        }
+    }
+
+    delete copy;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::CopySceneImpl(aiScene* dest,const aiScene* src,bool shareMeshBuffers) {
     // copy metadata
     if ( nullptr != src->mMetaData ) {
         dest->mMetaData = new aiMetadata( *src->mMetaData );
     }
 
+    // Meshes, materials, textures and animations are the bulk of the scene and don't
+    // reference each other, so all elements of these arrays are copied concurrently.
+
     // copy animations
     dest->mNumAnimations = src->mNumAnimations;
-    CopyPtrArray(dest->mAnimations,src->mAnimations,
-        dest->mNumAnimations);
+    ParallelCopyPtrArray(dest->mAnimations,src->mAnimations,
+        dest->mNumAnimations, [](aiAnimation** d, const aiAnimation* s) { Copy(d, s); });
 
     // copy textures
     dest->mNumTextures = src->mNumTextures;
-    CopyPtrArray(dest->mTextures,src->mTextures,
-        dest->mNumTextures);
+    ParallelCopyPtrArray(dest->mTextures,src->mTextures,
+        dest->mNumTextures, [](aiTexture** d, const aiTexture* s) { Copy(d, s); });
 
     // copy materials
     dest->mNumMaterials = src->mNumMaterials;
-    CopyPtrArray(dest->mMaterials,src->mMaterials,
-        dest->mNumMaterials);
+    ParallelCopyPtrArray(dest->mMaterials,src->mMaterials,
+        dest->mNumMaterials, [](aiMaterial** d, const aiMaterial* s) { Copy(d, s); });
 
     // copy lights
     dest->mNumLights = src->mNumLights;
@@ -1042,8 +1135,8 @@ void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate)
 
     // copy meshes
     dest->mNumMeshes = src->mNumMeshes;
-    CopyPtrArray(dest->mMeshes,src->mMeshes,
-        dest->mNumMeshes);
+    ParallelCopyPtrArray(dest->mMeshes,src->mMeshes,
+        dest->mNumMeshes, [shareMeshBuffers](aiMesh** d, const aiMesh* s) { CopyMesh(d, s, shareMeshBuffers); });
 
     // now - copy the root node of the scene (deep copy, too)
     Copy( &dest->mRootNode, src->mRootNode);
@@ -1059,12 +1152,16 @@ void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate)
 
 // ------------------------------------------------------------------------------------------------
 void SceneCombiner::Copy( aiMesh** _dest, const aiMesh* src ) {
+    CopyMesh(_dest, src, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::CopyMesh( aiMesh** _dest, const aiMesh* src, bool shareBuffers ) {
     if ( nullptr == _dest || nullptr == src ) {
         return;
     }
 
     aiMesh* dest = *_dest = new aiMesh();
-
 	// release allocated memory
 	dest->Vertices.Clear();
 	dest->Normals.Clear();
@@ -1091,16 +1188,18 @@ void SceneCombiner::Copy( aiMesh** _dest, const aiMesh* src ) {
 	dest->Bones.Create(&dest->mBones, &dest->mNumBones);
 	dest->AnimMeshes.Create(&dest->mAnimMeshes, &dest->mNumAnimMeshes);
 
-    // and reallocate all arrays
-    GetArrayCopy( dest->mVertices,   dest->mNumVertices );
-    GetArrayCopy( dest->mNormals ,   dest->mNumVertices );
-    GetArrayCopy( dest->mTangents,   dest->mNumVertices );
-    GetArrayCopy( dest->mBitangents, dest->mNumVertices );
+    // and reallocate all arrays, unless they are shared with the source mesh
+    if (!shareBuffers) {
+        GetArrayCopy( dest->mVertices,   dest->mNumVertices );
+        GetArrayCopy( dest->mNormals ,   dest->mNumVertices );
+        GetArrayCopy( dest->mTangents,   dest->mNumVertices );
+        GetArrayCopy( dest->mBitangents, dest->mNumVertices );
+    }
 
 	for(unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
 		dest->TextureCoords.Set(n, new Array<aiVector3D>(&dest->mTextureCoords[n], &dest->mNumVertices));
 
-		if (dest->HasTextureCoords(n)) {
+		if (!shareBuffers && dest->HasTextureCoords(n)) {
 			GetArrayCopy( dest->mTextureCoords[n],   dest->mNumVertices );
 		}
 	}
@@ -1108,7 +1207,7 @@ void SceneCombiner::Copy( aiMesh** _dest, const aiMesh* src ) {
 	for(unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
 		dest->Colors.Set(n, new Array<aiColor4D>(&dest->mColors[n], &dest->mNumVertices));
 
-		if (dest->HasVertexColors(n)) {
+		if (!shareBuffers && dest->HasVertexColors(n)) {
 			GetArrayCopy( dest->mColors[n],   dest->mNumVertices );
 		}
 	}
@@ -1120,17 +1219,63 @@ void SceneCombiner::Copy( aiMesh** _dest, const aiMesh* src ) {
 	CopyPtrArray(dest->mAnimMeshes,dest->mAnimMeshes,dest->mNumAnimMeshes);
 
     // make a deep copy of all faces
-    GetArrayCopy(dest->mFaces,dest->mNumFaces);
-    for (unsigned int i = 0; i < dest->mNumFaces;++i) {
-        aiFace& f = dest->mFaces[i];
+    if (!shareBuffers) {
+        GetArrayCopy(dest->mFaces,dest->mNumFaces);
+        for (unsigned int i = 0; i < dest->mNumFaces;++i) {
+            aiFace& f = dest->mFaces[i];
 
-		f.Indices.Create(&f.mIndices, &f.mNumIndices);
+            f.Indices.Create(&f.mIndices, &f.mNumIndices);
 
-        GetArrayCopy(f.mIndices,f.mNumIndices);
+            GetArrayCopy(f.mIndices,f.mNumIndices);
+        }
     }
 
     // make a deep copy of all blend shapes
     CopyPtrArray(dest->mAnimMeshes, dest->mAnimMeshes, dest->mNumAnimMeshes);
+    // the meshlets are always copied, they are not tracked by DeleteSharedScene()
+    GetArrayCopy(dest->mMeshlets, dest->mNumMeshlets);
+    GetArrayCopy(dest->mMeshletVertices, dest->mNumMeshletVertices);
+    GetArrayCopy(dest->mMeshletTriangles, dest->mNumMeshletTriangleIndices);
+    GetArrayCopy(dest->mLODs, dest->mNumLODs);
+    GetArrayCopy(dest->mPackedBoneIndices, dest->mNumVertices * dest->mNumBoneInfluences);
+    GetArrayCopy(dest->mPackedBoneWeights, dest->mNumVertices * dest->mNumBoneInfluences);
+    Copy(&dest->mQuantizedVertices, src->mQuantizedVertices);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy(aiQuantizedVertices** _dest, const aiQuantizedVertices* src) {
+    if (nullptr == _dest || nullptr == src) {
+        return;
+    }
+
+    aiQuantizedVertices* dest = *_dest = new aiQuantizedVertices();
+
+    // the destructor owns the arrays, so the fields are copied one by one
+    // and all arrays are reallocated
+    dest->mNumVertices = src->mNumVertices;
+    dest->mPositions = src->mPositions;
+    dest->mPositionOffset = src->mPositionOffset;
+    dest->mPositionScale = src->mPositionScale;
+    dest->mNormals = src->mNormals;
+    dest->mTangents = src->mTangents;
+    dest->mMaxPositionError = src->mMaxPositionError;
+    dest->mMaxDirectionError = src->mMaxDirectionError;
+    dest->mMaxTextureCoordsError = src->mMaxTextureCoordsError;
+    dest->mMaxColorError = src->mMaxColorError;
+    GetArrayCopy(dest->mPositions, dest->mNumVertices * 3);
+    GetArrayCopy(dest->mNormals, dest->mNumVertices * 2);
+    GetArrayCopy(dest->mTangents, dest->mNumVertices * 2);
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+        dest->mTextureCoords[n] = src->mTextureCoords[n];
+        dest->mNumUVComponents[n] = src->mNumUVComponents[n];
+        dest->mTextureCoordsOffset[n] = src->mTextureCoordsOffset[n];
+        dest->mTextureCoordsScale[n] = src->mTextureCoordsScale[n];
+        GetArrayCopy(dest->mTextureCoords[n], dest->mNumVertices * dest->mNumUVComponents[n]);
+    }
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+        dest->mColors[n] = src->mColors[n];
+        GetArrayCopy(dest->mColors[n], dest->mNumVertices * 4);
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -0,0 +1,166 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file SceneNameIndex.cpp
+ *  @brief Implementation of the SceneNameIndex class.
+ */
+
+#include "Common/SceneNameIndex.h"
+#include "Common/ScenePrivate.h"
+
+#include <assimp/Hash.h>
+#include <assimp/scene.h>
+
+#include <cstring>
+#include <memory>
+
+namespace Assimp {
+
+namespace {
+
+// Index of the last scene without private data looked up by this thread
+struct UncachedSceneNameIndex {
+    const aiScene* mScene = nullptr;
+    std::unique_ptr<SceneNameIndex> mIndex;
+};
+
+thread_local UncachedSceneNameIndex uncached;
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+size_t SceneNameKeyHash::operator()(const SceneNameKey& key) const {
+    return SuperFastHash(key.data, static_cast<uint32_t>(key.length));
+}
+
+// ------------------------------------------------------------------------------------------------
+bool SceneNameKeyEqual::operator()(const SceneNameKey& a, const SceneNameKey& b) const {
+    return a.length == b.length && 0 == ::memcmp(a.data, b.data, a.length);
+}
+
+// ------------------------------------------------------------------------------------------------
+SceneNameIndex::SceneNameIndex(const aiScene* scene) {
+    if (nullptr == scene) {
+        return;
+    }
+    if (nullptr != scene->mRootNode) {
+        AddNode(scene->mRootNode);
+    }
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh* mesh = scene->mMeshes[i];
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            aiBone* bone = mesh->mBones[b];
+            const Key key = { bone->mName.data, bone->mName.length };
+            // keep the first one, like a linear search would
+            mBones.insert(std::make_pair(key, bone));
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneNameIndex::AddNode(aiNode* node) {
+    // pre-order, so the first node in depth-first order wins as in aiNode::FindNode()
+    const Key key = { node->mName.data, node->mName.length };
+    mNodes.insert(std::make_pair(key, node));
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        AddNode(node->mChildren[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+aiNode* SceneNameIndex::FindNode(const aiString& name) const {
+    const Key key = { name.data, name.length };
+    const auto it = mNodes.find(key);
+    return it == mNodes.end() ? nullptr : it->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiNode* SceneNameIndex::FindNode(const char* name) const {
+    const Key key = { name, ::strlen(name) };
+    const auto it = mNodes.find(key);
+    return it == mNodes.end() ? nullptr : it->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiBone* SceneNameIndex::FindBone(const aiString& name) const {
+    const Key key = { name.data, name.length };
+    const auto it = mBones.find(key);
+    return it == mBones.end() ? nullptr : it->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiBone* SceneNameIndex::FindBone(const char* name) const {
+    const Key key = { name, ::strlen(name) };
+    const auto it = mBones.find(key);
+    return it == mBones.end() ? nullptr : it->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+const SceneNameIndex& GetSceneNameIndex(const aiScene* scene) {
+    ScenePrivateData* priv = const_cast<ScenePrivateData*>(ScenePriv(scene));
+    if (nullptr == priv) {
+        // user-allocated scene without private data, nowhere to keep the index
+        if (!uncached.mIndex || uncached.mScene != scene) {
+            uncached.mIndex.reset(new SceneNameIndex(scene));
+            uncached.mScene = scene;
+        }
+        return *uncached.mIndex;
+    }
+    if (!priv->mNameIndex) {
+        priv->mNameIndex = std::make_shared<SceneNameIndex>(scene);
+    }
+    return *priv->mNameIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+void InvalidateSceneNameIndex(const aiScene* scene) {
+    ScenePrivateData* priv = const_cast<ScenePrivateData*>(ScenePriv(scene));
+    if (nullptr != priv) {
+        priv->mNameIndex.reset();
+    } else if (uncached.mScene == scene) {
+        uncached.mIndex.reset();
+        uncached.mScene = nullptr;
+    }
+}
+
+} // Namespace Assimp
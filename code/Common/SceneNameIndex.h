@@ -0,0 +1,134 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file SceneNameIndex.h
+ *  @brief Hash index for looking up nodes and bones by name.
+ */
+#pragma once
+#ifndef AI_SCENENAMEINDEX_H_INC
+#define AI_SCENENAMEINDEX_H_INC
+
+#include <assimp/defs.h>
+
+#include <cstddef>
+#include <unordered_map>
+
+struct aiScene;
+struct aiNode;
+struct aiBone;
+struct aiString;
+
+namespace Assimp {
+
+// --------------------------------------------------------------------------------------------
+/** Name as used by the index. Refers to the characters of a string, does not copy them. */
+struct SceneNameKey {
+    const char* data;
+    size_t length;
+};
+
+struct ASSIMP_API SceneNameKeyHash {
+    size_t operator()(const SceneNameKey& key) const;
+};
+
+struct ASSIMP_API SceneNameKeyEqual {
+    bool operator()(const SceneNameKey& a, const SceneNameKey& b) const;
+};
+
+// --------------------------------------------------------------------------------------------
+/** Maps the names of all nodes and bones of a scene to the objects themselves.
+ *
+ *  aiNode::FindNode() walks the whole graph, so resolving every bone of a skinned scene
+ *  that way costs O(bones x nodes). The index is built in a single pass and answers each
+ *  lookup with one hash probe. Names are not copied, the keys refer to the aiString
+ *  storage of the indexed nodes and bones.
+ *
+ *  The index does not notice changes to the scene. Use GetSceneNameIndex() to share one
+ *  index per scene: it is dropped before and after every post-processing step. Code that
+ *  adds, removes or renames nodes or bones outside of a step must call
+ *  InvalidateSceneNameIndex() itself. */
+class ASSIMP_API SceneNameIndex {
+public:
+    /** Indexes all nodes below the root node and all bones of all meshes. */
+    explicit SceneNameIndex(const aiScene* scene);
+
+    /** Same result as aiNode::FindNode() on the root node, i.e. the first match in
+     *  depth-first order, or NULL. */
+    aiNode* FindNode(const aiString& name) const;
+    aiNode* FindNode(const char* name) const;
+
+    /** Returns the first bone with the given name, searching the meshes and their
+     *  bones in order, or NULL. */
+    aiBone* FindBone(const aiString& name) const;
+    aiBone* FindBone(const char* name) const;
+
+    /** Number of distinct node names */
+    size_t GetNumNodeNames() const {
+        return mNodes.size();
+    }
+
+private:
+    typedef SceneNameKey Key;
+
+    void AddNode(aiNode* node);
+
+    std::unordered_map<Key, aiNode*, SceneNameKeyHash, SceneNameKeyEqual> mNodes;
+    std::unordered_map<Key, aiBone*, SceneNameKeyHash, SceneNameKeyEqual> mBones;
+};
+
+// --------------------------------------------------------------------------------------------
+/** Returns the index of the given scene, building it on first use.
+ *
+ *  The index is kept in the private data of the scene until it is invalidated. Building
+ *  it is not thread-safe, so call this before spreading work across threads. Scenes
+ *  without private data, i.e. not created by the aiScene constructor, keep the index of
+ *  the last such scene per thread instead. */
+ASSIMP_API const SceneNameIndex& GetSceneNameIndex(const aiScene* scene);
+
+// --------------------------------------------------------------------------------------------
+/** Drops the index cached for the given scene, if any. */
+ASSIMP_API void InvalidateSceneNameIndex(const aiScene* scene);
+
+} // Namespace Assimp
+
+#endif // AI_SCENENAMEINDEX_H_INC
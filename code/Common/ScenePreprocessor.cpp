@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ScenePreprocessor.h"
+#include "SceneNameIndex.h"
 #include <assimp/ai_assert.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
@@ -206,7 +207,7 @@ void ScenePreprocessor::ProcessAnimation (aiAnimation* anim)
          */
         if (!channel->mNumRotationKeys || !channel->mNumPositionKeys || !channel->mNumScalingKeys)  {
             // Find the node that belongs to this animation
-            aiNode* node = scene->mRootNode->FindNode(channel->mNodeName);
+            aiNode* node = GetSceneNameIndex(scene).FindNode(channel->mNodeName);
             if (node) // ValidateDS will complain later if 'node' is NULL
             {
                 // Decompose the transformation matrix of the node
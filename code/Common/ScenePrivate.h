@@ -49,10 +49,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <assimp/scene.h>
 
+#include <memory>
+
 namespace Assimp {
 
 // Forward declarations
 class Importer;
+class SceneNameIndex;
 
 struct ScenePrivateData {
     //  The struct constructor.
@@ -71,13 +74,18 @@ struct ScenePrivateData {
     // and mOrigImporter are no longer safe to rely on and only
     // serve informative purposes.
     bool mIsCopy;
+
+    // Name lookup index shared by steps and exporters, built on demand.
+    // See GetSceneNameIndex() and InvalidateSceneNameIndex().
+    std::shared_ptr<SceneNameIndex> mNameIndex;
 };
 
 inline
 ScenePrivateData::ScenePrivateData() AI_NO_EXCEPT
 : mOrigImporter( nullptr )
 , mPPStepsApplied( 0 )
-, mIsCopy( false ) {
+, mIsCopy( false )
+, mNameIndex() {
     // empty
 }
 
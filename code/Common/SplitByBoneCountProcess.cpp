@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers of the post-processing framework
 #include "SplitByBoneCountProcess.h"
+#include "PostProcessing/ProcessHelper.h"
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
 
@@ -107,7 +108,9 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
     mSubMeshIndices.resize( pScene->mNumMeshes);
 
     // build a new array of meshes for the scene
+    const MeshLODRemapper lodRemapper( pScene);
     std::vector<aiMesh*> meshes;
+    std::vector<unsigned int> sources;
 
     for( unsigned int a = 0; a < pScene->mNumMeshes; ++a)
     {
@@ -124,6 +127,7 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
             {
                 mSubMeshIndices[a].push_back( static_cast<unsigned int>(meshes.size()));
                 meshes.push_back( newMeshes[b]);
+                sources.push_back( a);
             }
 
             // and destroy the source mesh. It should be completely contained inside the new submeshes
@@ -134,6 +138,7 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
             // Mesh is kept unchanged - store it's new place in the mesh array
             mSubMeshIndices[a].push_back( static_cast<unsigned int>(meshes.size()));
             meshes.push_back( srcMesh);
+            sources.push_back( a);
         }
     }
 
@@ -142,6 +147,7 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
     delete [] pScene->mMeshes;
     pScene->mMeshes = new aiMesh*[pScene->mNumMeshes];
     std::copy( meshes.begin(), meshes.end(), pScene->mMeshes);
+    lodRemapper.Update( pScene, sources);
 
     // recurse through all nodes and translate the node's mesh indices to fit the new mesh array
     UpdateNode( pScene->mRootNode);
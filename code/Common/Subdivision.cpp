@@ -47,12 +47,48 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 
 #include "PostProcessing/ProcessHelper.h"
+#include "Common/ParallelFor.h"
 
 #include <stdio.h>
+#include <algorithm>
 
 using namespace Assimp;
 void mydummy() {}
 
+namespace {
+
+// Number of faces, edges or points handed to a thread at once
+const size_t SubdivisionGrain = 256;
+
+// ------------------------------------------------------------------------------------------------
+// Sorts the vector using all threads: blocks are sorted in parallel and then merged pairwise,
+// the merges of each round again in parallel.
+template <typename T>
+void ParallelSort(std::vector<T>& v) {
+    const size_t numBlocks = std::min<size_t>(GetParallelForThreadCount(), v.size() / 4096 + 1);
+    if (numBlocks <= 1) {
+        std::sort(v.begin(), v.end());
+        return;
+    }
+
+    const size_t blockSize = (v.size() + numBlocks - 1) / numBlocks;
+    ParallelFor(numBlocks, [&v, blockSize](size_t b) {
+        const size_t begin = std::min(v.size(), b * blockSize);
+        const size_t end = std::min(v.size(), begin + blockSize);
+        std::sort(v.begin() + begin, v.begin() + end);
+    });
+    for (size_t width = blockSize; width < v.size(); width *= 2) {
+        ParallelFor((v.size() + 2 * width - 1) / (2 * width), [&v, width](size_t m) {
+            const size_t begin = m * 2 * width;
+            const size_t mid = std::min(v.size(), begin + width);
+            const size_t end = std::min(v.size(), begin + 2 * width);
+            std::inplace_merge(v.begin() + begin, v.begin() + mid, v.begin() + end);
+        });
+    }
+}
+
+} // Namespace
+
 // ------------------------------------------------------------------------------------------------
 /** Subdivider stub class to implement the Catmull-Clarke subdivision algorithm. The
  *  implementation is basing on recursive refinement. Directly evaluating the result is also
@@ -77,10 +113,10 @@ public:
     };
 
     typedef std::vector<unsigned int> UIntVector;
-    typedef std::map<uint64_t,Edge> EdgeMap;
+    typedef std::vector<Edge> EdgeTable;
 
     // ---------------------------------------------------------------------------
-    // Hashing function to derive an index into an #EdgeMap from two given
+    // Hashing function to derive a sort key for an #EdgeTable from two given
     // 'unsigned int' vertex coordinates (!!distinct coordinates - same
     // vertex position == same index!!).
     // NOTE - this leads to rare hash collisions if a) sizeof(unsigned int)>4
@@ -221,7 +257,8 @@ void CatmullClarkSubdivider::Subdivide (
 // here: http://en.wikipedia.org/wiki/Catmull-Clark_subdivision_surface
 //
 // The code is mostly O(n), however parts are O(nlogn) which is therefore the algorithm's
-// expected total runtime complexity. The implementation is able to work in-place on the same
+// expected total runtime complexity. Edges are kept in a flat table which is built by sorting
+// the face corners, all passes over faces, edges and points run on all threads. The implementation is able to work in-place on the same
 // mesh arrays. Calling #InternSubdivide() directly is not encouraged. The code can operate
 // in-place unless 'smesh' and 'out' are equal (no strange overlaps or reorderings).
 // Previous data is replaced/deleted then.
@@ -234,7 +271,6 @@ void CatmullClarkSubdivider::InternSubdivide (
     )
 {
     ai_assert(NULL != smesh && NULL != out);
-    INIT_EDGE_HASH_TEMPORARIES();
 
     // no subdivision requested or end of recursive refinement
     if (!num) {
@@ -246,7 +282,8 @@ void CatmullClarkSubdivider::InternSubdivide (
 
     // ---------------------------------------------------------------------
     // 0. Offset table to index all meshes continuously, generate a spatially
-    // sorted representation of all vertices in all meshes.
+    // sorted representation of all vertices in all meshes. Every face corner
+    // starts one (half-)edge, cornerofs[f] is the first corner of face f.
     // ---------------------------------------------------------------------
     typedef std::pair<unsigned int,unsigned int> IntPair;
     std::vector<IntPair> moffsets(nmesh);
@@ -264,6 +301,23 @@ void CatmullClarkSubdivider::InternSubdivide (
     spatial.Finalize();
     const unsigned int num_unique = spatial.GenerateMappingTable(maptbl,ComputePositionEpsilon(smesh,nmesh));
 
+    UIntVector cornerofs(totfaces+1);
+    unsigned int nfacesout = 0;
+    for (size_t t = 0, n = 0; t < nmesh; ++t) {
+        const aiMesh* mesh = smesh[t];
+        for (unsigned int i = 0; i < mesh->mNumFaces;++i,++n) {
+            cornerofs[n] = nfacesout;
+            nfacesout += mesh->mFaces[i].mNumIndices;
+        }
+    }
+    cornerofs[totfaces] = nfacesout;
+
+    // index of the mesh which contains the face with the given global index
+    auto mesh_of_face = [&moffsets](unsigned int fidx) -> size_t {
+        return std::upper_bound(moffsets.begin(),moffsets.end(),fidx,[](unsigned int f, const IntPair& p) {
+            return f < p.first;
+        }) - moffsets.begin() - 1;
+    };
 
 #define FLATTEN_VERTEX_IDX(mesh_idx, vert_idx) (moffsets[mesh_idx].second+vert_idx)
 #define   FLATTEN_FACE_IDX(mesh_idx, face_idx) (moffsets[mesh_idx].first+face_idx)
@@ -272,71 +326,100 @@ void CatmullClarkSubdivider::InternSubdivide (
     // 1. Compute the centroid point for all faces
     // ---------------------------------------------------------------------
     std::vector<Vertex> centroids(totfaces);
-    unsigned int nfacesout = 0;
-    for (size_t t = 0, n = 0; t < nmesh; ++t) {
+    for (size_t t = 0; t < nmesh; ++t) {
         const aiMesh* mesh = smesh[t];
-        for (unsigned int i = 0; i < mesh->mNumFaces;++i,++n)
-        {
+        ParallelFor(mesh->mNumFaces, [&](size_t i) {
             const aiFace& face = mesh->mFaces[i];
-            Vertex& c = centroids[n];
+            Vertex& c = centroids[FLATTEN_FACE_IDX(t,i)];
 
             for (unsigned int a = 0; a < face.mNumIndices;++a) {
                 c += Vertex(mesh,face.mIndices[a]);
             }
 
             c /= static_cast<float>(face.mNumIndices);
-            nfacesout += face.mNumIndices;
-        }
+        }, SubdivisionGrain);
     }
 
     {
     // we want edges to go away before the recursive calls so begin a new scope
-    EdgeMap edges;
+    EdgeTable edges;
+    UIntVector corneredge(nfacesout);
 
     // ---------------------------------------------------------------------
-    // 2. Set each edge point to be the average of all neighbouring
-    // face points and original points. Every edge exists twice
-    // if there is a neighboring face.
+    // 2. Build the edge table. Sorting the corners by edge key groups both
+    // halves of an edge, each group in the order the faces were visited.
+    // Set each edge point to be the average of all neighbouring face points
+    // and original points.
     // ---------------------------------------------------------------------
+    {
+    typedef std::pair<uint64_t,unsigned int> EdgeKey;
+    std::vector<EdgeKey> keys(nfacesout);
+    UIntVector cornerface(nfacesout);
     for (size_t t = 0; t < nmesh; ++t) {
         const aiMesh* mesh = smesh[t];
-
-        for (unsigned int i = 0; i < mesh->mNumFaces;++i)   {
+        ParallelFor(mesh->mNumFaces, [&](size_t i) {
+            INIT_EDGE_HASH_TEMPORARIES();
             const aiFace& face = mesh->mFaces[i];
+            const unsigned int fidx = FLATTEN_FACE_IDX(t,i), c = cornerofs[fidx];
 
             for (unsigned int p =0; p< face.mNumIndices; ++p) {
-                const unsigned int id[] = {
-                    face.mIndices[p],
-                    face.mIndices[p==face.mNumIndices-1?0:p+1]
-                };
                 const unsigned int mp[] = {
-                    maptbl[FLATTEN_VERTEX_IDX(t,id[0])],
-                    maptbl[FLATTEN_VERTEX_IDX(t,id[1])]
+                    maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[p])],
+                    maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[p==face.mNumIndices-1?0:p+1])]
                 };
-
-                Edge& e = edges[MAKE_EDGE_HASH(mp[0],mp[1])];
-                e.ref++;
-                if (e.ref<=2) {
-                    if (e.ref==1) { // original points (end points) - add only once
-                        e.edge_point = e.midpoint = Vertex(mesh,id[0])+Vertex(mesh,id[1]);
-                        e.midpoint *= 0.5f;
-                    }
-                    e.edge_point += centroids[FLATTEN_FACE_IDX(t,i)];
-                }
+                keys[c+p] = EdgeKey(MAKE_EDGE_HASH(mp[0],mp[1]),c+p);
+                cornerface[c+p] = fidx;
             }
+        }, SubdivisionGrain);
+    }
+    ParallelSort(keys);
+
+    UIntVector edgestart;
+    for (unsigned int k = 0; k < nfacesout; ++k) {
+        if (!k || keys[k].first != keys[k-1].first) {
+            edgestart.push_back(k);
+        }
+    }
+    edgestart.push_back(nfacesout);
+
+    edges.resize(edgestart.size()-1);
+    ParallelFor(edges.size(), [&](size_t ei) {
+        Edge& e = edges[ei];
+        const unsigned int begin = edgestart[ei], end = edgestart[ei+1];
+        for (unsigned int k = begin; k < end; ++k) {
+            corneredge[keys[k].second] = static_cast<unsigned int>(ei);
+        }
+        e.ref = end-begin;
+
+        // original points (end points) - taken from the first corner
+        const unsigned int c = keys[begin].second, fidx = cornerface[c];
+        const size_t t = mesh_of_face(fidx);
+        const aiMesh* mesh = smesh[t];
+        const aiFace& face = mesh->mFaces[fidx-moffsets[t].first];
+        const unsigned int p = c-cornerofs[fidx];
+
+        e.edge_point = e.midpoint = Vertex(mesh,face.mIndices[p])+
+            Vertex(mesh,face.mIndices[p==face.mNumIndices-1?0:p+1]);
+        e.midpoint *= 0.5f;
+
+        // every edge exists twice if there is a neighboring face
+        for (unsigned int k = begin; k < end && k < begin+2; ++k) {
+            e.edge_point += centroids[cornerface[keys[k].second]];
         }
+
+        // -----------------------------------------------------------------
+        // 3. Normalize edge points
+        // -----------------------------------------------------------------
+        e.edge_point *= 1.f/(e.ref+2.f);
+    }, SubdivisionGrain);
     }
 
-    // ---------------------------------------------------------------------
-    // 3. Normalize edge points
-    // ---------------------------------------------------------------------
     {unsigned int bad_cnt = 0;
-    for (EdgeMap::iterator it = edges.begin(); it != edges.end(); ++it) {
-        if ((*it).second.ref < 2) {
-            ai_assert((*it).second.ref);
+    for (const Edge& e : edges) {
+        if (e.ref < 2) {
+            ai_assert(e.ref);
             ++bad_cnt;
         }
-        (*it).second.edge_point *= 1.f/((*it).second.ref+2.f);
     }
 
     if (bad_cnt) {
@@ -416,10 +499,82 @@ void CatmullClarkSubdivider::InternSubdivide (
 #define GET_ADJACENT_FACES_AND_CNT(vidx,fstartout,numout) \
     fstartout = &faceadjac[ofsadjvec[vidx]], numout = cntadjfac[vidx]
 
-    typedef std::pair<bool,Vertex> TouchedOVertex;
-    std::vector<TouchedOVertex > new_points(num_unique,TouchedOVertex(false,Vertex()));
     // ---------------------------------------------------------------------
-    // 5. Spawn a quad from each face point to the corresponding edge points
+    // 5. Compute the new position of every original point. Its attributes
+    // are taken from the first corner that refers to it.
+    //
+    // d= original point P with distinct index i
+    // F := 0
+    // R := 0
+    // n := 0
+    // for each face f containing i
+    //    F := F+ centroid of f
+    //    R := R+ midpoint of edge of f from i to i+1
+    //    n := n+1
+    //
+    // (F+2R+(n-3)P)/n
+    // ---------------------------------------------------------------------
+    std::vector<Vertex> new_points(num_unique);
+    ParallelFor(num_unique, [&](size_t i) {
+        const unsigned int org = static_cast<unsigned int>(i);
+        if (!cntadjfac[org]) {
+            // not referenced by any face
+            return;
+        }
+
+        const unsigned int* adj; unsigned int cnt;
+        GET_ADJACENT_FACES_AND_CNT(org,adj,cnt);
+
+        // find our original point in the face, returns the corner index within the face
+        auto find_corner = [&](unsigned int fidx, size_t& nidx) -> unsigned int {
+            nidx = mesh_of_face(fidx);
+            const aiFace& f = smesh[nidx]->mFaces[fidx-moffsets[nidx].first];
+            unsigned int m = 0;
+            while (m < f.mNumIndices && maptbl[FLATTEN_VERTEX_IDX(nidx,f.mIndices[m])] != org) {
+                ++m;
+            }
+            // this invariant *must* hold if the vertex-to-face adjacency table is valid
+            ai_assert(m < f.mNumIndices);
+            return m;
+        };
+
+        size_t nidx;
+        const unsigned int m0 = find_corner(adj[0],nidx);
+        const aiMesh* const minp = smesh[nidx];
+        const Vertex P(minp,minp->mFaces[adj[0]-moffsets[nidx].first].mIndices[m0]);
+
+        if (cnt < 3) {
+            new_points[org] = P;
+            return;
+        }
+
+        Vertex F,R;
+        for (unsigned int o = 0; o < cnt; ++o) {
+            ai_assert(adj[o] < totfaces);
+            F += centroids[adj[o]];
+
+            const unsigned int m = find_corner(adj[o],nidx);
+            const aiFace& f = smesh[nidx]->mFaces[adj[o]-moffsets[nidx].first];
+            if (m == f.mNumIndices) {
+                continue;
+            }
+
+            // add *both* edges. this way, we can be sure that we add
+            // *all* adjacent edges to R. In a closed shape, every
+            // edge is added twice - so we simply leave out the
+            // factor 2.f in the amove formula and get the right
+            // result.
+            const Edge& c0 = edges[corneredge[cornerofs[adj[o]]+(!m?f.mNumIndices-1:m-1)]];
+            const Edge& c1 = edges[corneredge[cornerofs[adj[o]]+m]];
+            R += c0.midpoint+c1.midpoint;
+        }
+
+        const float div = static_cast<float>(cnt), divsq = 1.f/(div*div);
+        new_points[org] = P*((div-3.f) / div) + R*divsq + F*divsq;
+    }, SubdivisionGrain);
+
+    // ---------------------------------------------------------------------
+    // 6. Spawn a quad from each face point to the corresponding edge points
     // the original points being the fourth quad points.
     // ---------------------------------------------------------------------
     for (size_t t = 0; t < nmesh; ++t) {
@@ -459,9 +614,14 @@ void CatmullClarkSubdivider::InternSubdivide (
         }
 
         mout->mNumVertices = mout->mNumFaces<<2u;
-        for (unsigned int i = 0, v = 0, n = 0; i < minp->mNumFaces;++i) {
 
+        // each face writes its quads at the position of its first corner
+        const unsigned int cofs = cornerofs[FLATTEN_FACE_IDX(t,0)];
+        ParallelFor(minp->mNumFaces, [&](size_t i) {
             const aiFace& face = minp->mFaces[i];
+            const unsigned int fidx = FLATTEN_FACE_IDX(t,i), c = cornerofs[fidx];
+            unsigned int n = c-cofs, v = n<<2u;
+
             for (unsigned int a = 0; a < face.mNumIndices;++a)  {
 
                 // Get a clean new face.
@@ -470,108 +630,21 @@ void CatmullClarkSubdivider::InternSubdivide (
 
                 // Spawn a new quadrilateral (ccw winding) for this original point between:
                 // a) face centroid
-                centroids[FLATTEN_FACE_IDX(t,i)].SortBack(mout,faceOut.mIndices[0]=v++);
+                centroids[fidx].SortBack(mout,faceOut.mIndices[0]=v++);
 
                 // b) adjacent edge on the left, seen from the centroid
-                const Edge& e0 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])],
-                    maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a==face.mNumIndices-1?0:a+1])
-                    ])];  // fixme: replace with mod face.mNumIndices?
+                const Edge& e0 = edges[corneredge[c+a]];
 
                 // c) adjacent edge on the right, seen from the centroid
-                const Edge& e1 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])],
-                    maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[!a?face.mNumIndices-1:a-1])
-                    ])];  // fixme: replace with mod face.mNumIndices?
+                const Edge& e1 = edges[corneredge[c+(!a?face.mNumIndices-1:a-1)]];
 
                 e0.edge_point.SortBack(mout,faceOut.mIndices[3]=v++);
                 e1.edge_point.SortBack(mout,faceOut.mIndices[1]=v++);
 
-                // d= original point P with distinct index i
-                // F := 0
-                // R := 0
-                // n := 0
-                // for each face f containing i
-                //    F := F+ centroid of f
-                //    R := R+ midpoint of edge of f from i to i+1
-                //    n := n+1
-                //
-                // (F+2R+(n-3)P)/n
-                const unsigned int org = maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])];
-                TouchedOVertex& ov = new_points[org];
-
-                if (!ov.first) {
-                    ov.first = true;
-
-                    const unsigned int* adj; unsigned int cnt;
-                    GET_ADJACENT_FACES_AND_CNT(org,adj,cnt);
-
-                    if (cnt < 3) {
-                        ov.second = Vertex(minp,face.mIndices[a]);
-                    }
-                    else {
-
-                        Vertex F,R;
-                        for (unsigned int o = 0; o < cnt; ++o) {
-                            ai_assert(adj[o] < totfaces);
-                            F += centroids[adj[o]];
-
-                            // adj[0] is a global face index - search the face in the mesh list
-                            const aiMesh* mp = NULL;
-                            size_t nidx;
-
-                            if (adj[o] < moffsets[0].first) {
-                                mp = smesh[nidx=0];
-                            }
-                            else {
-                                for (nidx = 1; nidx<= nmesh; ++nidx) {
-                                    if (nidx == nmesh ||moffsets[nidx].first > adj[o]) {
-                                        mp = smesh[--nidx];
-                                        break;
-                                    }
-                                }
-                            }
-
-                            ai_assert(adj[o]-moffsets[nidx].first < mp->mNumFaces);
-                            const aiFace& f = mp->mFaces[adj[o]-moffsets[nidx].first];
-                            bool haveit = false;
-
-                            // find our original point in the face
-                            for (unsigned int m = 0; m < f.mNumIndices; ++m) {
-                                if (maptbl[FLATTEN_VERTEX_IDX(nidx,f.mIndices[m])] == org) {
-
-                                    // add *both* edges. this way, we can be sure that we add
-                                    // *all* adjacent edges to R. In a closed shape, every
-                                    // edge is added twice - so we simply leave out the
-                                    // factor 2.f in the amove formula and get the right
-                                    // result.
-
-                                    const Edge& c0 = edges[MAKE_EDGE_HASH(org,maptbl[FLATTEN_VERTEX_IDX(
-                                        nidx,f.mIndices[!m?f.mNumIndices-1:m-1])])];
-                                    // fixme: replace with mod face.mNumIndices?
-
-                                    const Edge& c1 = edges[MAKE_EDGE_HASH(org,maptbl[FLATTEN_VERTEX_IDX(
-                                        nidx,f.mIndices[m==f.mNumIndices-1?0:m+1])])];
-                                    // fixme: replace with mod face.mNumIndices?
-                                    R += c0.midpoint+c1.midpoint;
-
-                                    haveit = true;
-                                    break;
-                                }
-                            }
-
-                            // this invariant *must* hold if the vertex-to-face adjacency table is valid
-                            ai_assert(haveit);
-                            if ( !haveit ) {
-                                ASSIMP_LOG_WARN( "OBJ: no name for material library specified." );
-                            }
-                        }
-
-                        const float div = static_cast<float>(cnt), divsq = 1.f/(div*div);
-                        ov.second = Vertex(minp,face.mIndices[a])*((div-3.f) / div) + R*divsq + F*divsq;
-                    }
-                }
-                ov.second.SortBack(mout,faceOut.mIndices[2]=v++);
+                // d) original point
+                new_points[maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])]].SortBack(mout,faceOut.mIndices[2]=v++);
             }
-        }
+        }, SubdivisionGrain);
     }
     }  // end of scope for edges, freeing its memory
 
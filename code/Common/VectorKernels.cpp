@@ -0,0 +1,708 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "VectorKernels.h"
+#include "simd.h"
+
+#if !defined(ASSIMP_DOUBLE_PRECISION)
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define AI_VECTOR_KERNELS_SSE2
+#       include <emmintrin.h>
+#       if defined(__GNUC__) || defined(__clang__)
+            // AVX2 code is compiled per function and only called if the CPU supports it
+#           define AI_VECTOR_KERNELS_AVX2
+#           include <immintrin.h>
+#       endif
+#   elif defined(__aarch64__) || defined(_M_ARM64)
+#       define AI_VECTOR_KERNELS_NEON
+#       include <arm_neon.h>
+#   endif
+#endif
+
+namespace Assimp {
+
+namespace {
+
+enum InstructionSet {
+    InstructionSet_Scalar,
+    InstructionSet_SSE2,
+    InstructionSet_AVX2,
+    InstructionSet_NEON
+};
+
+InstructionSet DetectInstructionSet() {
+#if defined(AI_VECTOR_KERNELS_NEON)
+    // part of the base instruction set on AArch64
+    return InstructionSet_NEON;
+#else
+#   if defined(AI_VECTOR_KERNELS_AVX2)
+    if (CPUSupportsAVX2()) {
+        return InstructionSet_AVX2;
+    }
+#   endif
+#   if defined(AI_VECTOR_KERNELS_SSE2)
+    if (CPUSupportsSSE2()) {
+        return InstructionSet_SSE2;
+    }
+#   endif
+    return InstructionSet_Scalar;
+#endif
+}
+
+InstructionSet GetInstructionSet() {
+    static const InstructionSet instructionSet = DetectInstructionSet();
+    return instructionSet;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Scalar versions, also used for the remainder of the SIMD loops
+void TransformPointsScalar(const aiMatrix4x4& m, const aiVector3D* in, aiVector3D* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = m * in[i];
+    }
+}
+
+void TransformDirectionsScalar(const aiMatrix3x3& m, const aiVector3D* in, aiVector3D* out,
+        size_t count, bool normalize) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = m * in[i];
+        if (normalize) {
+            out[i].Normalize();
+        }
+    }
+}
+
+void ScaleVectorsScalar(const aiVector3D& scale, const aiVector3D* in, aiVector3D* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = aiVector3D(in[i].x * scale.x, in[i].y * scale.y, in[i].z * scale.z);
+    }
+}
+
+void InterpolateVectorsScalar(const aiVector3D* start, const aiVector3D* end, const ai_real* factors,
+        aiVector3D* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = start[i] + (end[i] - start[i]) * factors[i];
+    }
+}
+
+void ExtendBoundingBoxScalar(const aiVector3D* points, size_t count, aiVector3D& min, aiVector3D& max) {
+    for (size_t i = 0; i < count; ++i) {
+        const aiVector3D& pos = points[i];
+        if (pos.x < min.x) {
+            min.x = pos.x;
+        }
+        if (pos.y < min.y) {
+            min.y = pos.y;
+        }
+        if (pos.z < min.z) {
+            min.z = pos.z;
+        }
+
+        if (pos.x > max.x) {
+            max.x = pos.x;
+        }
+        if (pos.y > max.y) {
+            max.y = pos.y;
+        }
+        if (pos.z > max.z) {
+            max.z = pos.z;
+        }
+    }
+}
+
+#if defined(AI_VECTOR_KERNELS_SSE2) || defined(AI_VECTOR_KERNELS_NEON)
+
+// ------------------------------------------------------------------------------------------------
+// Merges the lanes of the per-lane minimum and maximum into min and max. Lane i of a stream of
+// interleaved xyz floats holds component i % 3.
+void MergeBoundingBoxLanes(const float* lanesMin, const float* lanesMax, size_t numLanes,
+        aiVector3D& min, aiVector3D& max) {
+    for (size_t i = 0; i < numLanes; ++i) {
+        const unsigned int c = static_cast<unsigned int>(i % 3);
+        if (lanesMin[i] < min[c]) {
+            min[c] = lanesMin[i];
+        }
+        if (lanesMax[i] > max[c]) {
+            max[c] = lanesMax[i];
+        }
+    }
+}
+
+#endif
+
+#if defined(AI_VECTOR_KERNELS_SSE2)
+
+// ------------------------------------------------------------------------------------------------
+// Splits four interleaved xyz vectors into one register per component
+inline void LoadSoA(const float* p, __m128& x, __m128& y, __m128& z) {
+    const __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+    x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+            _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+            _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Inverse of LoadSoA
+inline void StoreAoS(float* p, __m128 x, __m128 y, __m128 z) {
+    _mm_storeu_ps(p, _mm_shuffle_ps(_mm_unpacklo_ps(x, y),
+            _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(p + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+            _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(p + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+            _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+// r = ((m0 * x + m1 * y) + m2 * z), the same order as the scalar operators
+inline __m128 Dot3(__m128 m0, __m128 m1, __m128 m2, __m128 x, __m128 y, __m128 z) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m1, y)), _mm_mul_ps(m2, z));
+}
+
+// ------------------------------------------------------------------------------------------------
+void TransformPointsSSE2(const aiMatrix4x4& m, const aiVector3D* in, aiVector3D* out, size_t count) {
+    const __m128 a1 = _mm_set1_ps(m.a1), a2 = _mm_set1_ps(m.a2), a3 = _mm_set1_ps(m.a3), a4 = _mm_set1_ps(m.a4);
+    const __m128 b1 = _mm_set1_ps(m.b1), b2 = _mm_set1_ps(m.b2), b3 = _mm_set1_ps(m.b3), b4 = _mm_set1_ps(m.b4);
+    const __m128 c1 = _mm_set1_ps(m.c1), c2 = _mm_set1_ps(m.c2), c3 = _mm_set1_ps(m.c3), c4 = _mm_set1_ps(m.c4);
+
+    const size_t blocks = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < blocks; i += 4) {
+        __m128 x, y, z;
+        LoadSoA(&in[i].x, x, y, z);
+        StoreAoS(&out[i].x,
+                _mm_add_ps(Dot3(a1, a2, a3, x, y, z), a4),
+                _mm_add_ps(Dot3(b1, b2, b3, x, y, z), b4),
+                _mm_add_ps(Dot3(c1, c2, c3, x, y, z), c4));
+    }
+    TransformPointsScalar(m, in + blocks, out + blocks, count - blocks);
+}
+
+// ------------------------------------------------------------------------------------------------
+void TransformDirectionsSSE2(const aiMatrix3x3& m, const aiVector3D* in, aiVector3D* out,
+        size_t count, bool normalize) {
+    const __m128 a1 = _mm_set1_ps(m.a1), a2 = _mm_set1_ps(m.a2), a3 = _mm_set1_ps(m.a3);
+    const __m128 b1 = _mm_set1_ps(m.b1), b2 = _mm_set1_ps(m.b2), b3 = _mm_set1_ps(m.b3);
+    const __m128 c1 = _mm_set1_ps(m.c1), c2 = _mm_set1_ps(m.c2), c3 = _mm_set1_ps(m.c3);
+    const __m128 one = _mm_set1_ps(1.f);
+
+    const size_t blocks = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < blocks; i += 4) {
+        __m128 x, y, z;
+        LoadSoA(&in[i].x, x, y, z);
+        __m128 rx = Dot3(a1, a2, a3, x, y, z), ry = Dot3(b1, b2, b3, x, y, z), rz = Dot3(c1, c2, c3, x, y, z);
+        if (normalize) {
+            // v *= 1 / sqrt(x*x + y*y + z*z), as aiVector3D::Normalize()
+            const __m128 inv = _mm_div_ps(one, _mm_sqrt_ps(Dot3(rx, ry, rz, rx, ry, rz)));
+            rx = _mm_mul_ps(rx, inv);
+            ry = _mm_mul_ps(ry, inv);
+            rz = _mm_mul_ps(rz, inv);
+        }
+        StoreAoS(&out[i].x, rx, ry, rz);
+    }
+    TransformDirectionsScalar(m, in + blocks, out + blocks, count - blocks, normalize);
+}
+
+// ------------------------------------------------------------------------------------------------
+// The kernels below work on the interleaved floats directly, 12 floats are 4 vectors
+void ScaleVectorsSSE2(const aiVector3D& scale, const aiVector3D* in, aiVector3D* out, size_t count) {
+    const __m128 s0 = _mm_setr_ps(scale.x, scale.y, scale.z, scale.x);
+    const __m128 s1 = _mm_setr_ps(scale.y, scale.z, scale.x, scale.y);
+    const __m128 s2 = _mm_setr_ps(scale.z, scale.x, scale.y, scale.z);
+
+    const size_t blocks = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < blocks; i += 4) {
+        const float* src = &in[i].x;
+        float* dst = &out[i].x;
+        _mm_storeu_ps(dst, _mm_mul_ps(_mm_loadu_ps(src), s0));
+        _mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_loadu_ps(src + 4), s1));
+        _mm_storeu_ps(dst + 8, _mm_mul_ps(_mm_loadu_ps(src + 8), s2));
+    }
+    ScaleVectorsScalar(scale, in + blocks, out + blocks, count - blocks);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InterpolateVectorsSSE2(const aiVector3D* start, const aiVector3D* end, const ai_real* factors,
+        aiVector3D* out, size_t count) {
+    const size_t blocks = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < blocks; i += 4) {
+        // spread the four factors over the three registers of interleaved floats
+        const __m128 f = _mm_loadu_ps(factors + i);
+        const __m128 f0 = _mm_shuffle_ps(f, f, _MM_SHUFFLE(1, 0, 0, 0));
+        const __m128 f1 = _mm_shuffle_ps(f, f, _MM_SHUFFLE(2, 2, 1, 1));
+        const __m128 f2 = _mm_shuffle_ps(f, f, _MM_SHUFFLE(3, 3, 3, 2));
+        const float *a = &start[i].x, *b = &end[i].x;
+        float* dst = &out[i].x;
+        const __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 4), a2 = _mm_loadu_ps(a + 8);
+        _mm_storeu_ps(dst, _mm_add_ps(a0, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b), a0), f0)));
+        _mm_storeu_ps(dst + 4, _mm_add_ps(a1, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b + 4), a1), f1)));
+        _mm_storeu_ps(dst + 8, _mm_add_ps(a2, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b + 8), a2), f2)));
+    }
+    InterpolateVectorsScalar(start + blocks, end + blocks, factors + blocks, out + blocks, count - blocks);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ExtendBoundingBoxSSE2(const aiVector3D* points, size_t count, aiVector3D& min, aiVector3D& max) {
+    const size_t blocks = count & ~static_cast<size_t>(3);
+    if (blocks) {
+        // seeded with the incoming box in the interleaved xyz layout of the points, a seed
+        // taken from the points would keep a NaN value in its lane forever
+        __m128 mn[3] = {
+            _mm_setr_ps(min.x, min.y, min.z, min.x),
+            _mm_setr_ps(min.y, min.z, min.x, min.y),
+            _mm_setr_ps(min.z, min.x, min.y, min.z)
+        };
+        __m128 mx[3] = {
+            _mm_setr_ps(max.x, max.y, max.z, max.x),
+            _mm_setr_ps(max.y, max.z, max.x, max.y),
+            _mm_setr_ps(max.z, max.x, max.y, max.z)
+        };
+        for (size_t i = 0; i < blocks; i += 4) {
+            const float* src = &points[i].x;
+            for (int k = 0; k < 3; ++k) {
+                // (v < acc ? v : acc), so NaN values are skipped like in the scalar version
+                const __m128 v = _mm_loadu_ps(src + 4 * k);
+                mn[k] = _mm_min_ps(v, mn[k]);
+                mx[k] = _mm_max_ps(v, mx[k]);
+            }
+        }
+
+        float lanesMin[12], lanesMax[12];
+        for (int k = 0; k < 3; ++k) {
+            _mm_storeu_ps(lanesMin + 4 * k, mn[k]);
+            _mm_storeu_ps(lanesMax + 4 * k, mx[k]);
+        }
+        MergeBoundingBoxLanes(lanesMin, lanesMax, 12, min, max);
+    }
+    ExtendBoundingBoxScalar(points + blocks, count - blocks, min, max);
+}
+
+#endif // AI_VECTOR_KERNELS_SSE2
+
+#if defined(AI_VECTOR_KERNELS_AVX2)
+
+#define AI_TARGET_AVX2 __attribute__((target("avx2")))
+
+// ------------------------------------------------------------------------------------------------
+// Eight vectors at a time, split into components with the SSE2 shuffles
+AI_TARGET_AVX2 inline void LoadSoA8(const float* p, __m256& x, __m256& y, __m256& z) {
+    __m128 xl, yl, zl, xh, yh, zh;
+    LoadSoA(p, xl, yl, zl);
+    LoadSoA(p + 12, xh, yh, zh);
+    x = _mm256_insertf128_ps(_mm256_castps128_ps256(xl), xh, 1);
+    y = _mm256_insertf128_ps(_mm256_castps128_ps256(yl), yh, 1);
+    z = _mm256_insertf128_ps(_mm256_castps128_ps256(zl), zh, 1);
+}
+
+AI_TARGET_AVX2 inline void StoreAoS8(float* p, __m256 x, __m256 y, __m256 z) {
+    StoreAoS(p, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+    StoreAoS(p + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+}
+
+AI_TARGET_AVX2 inline __m256 Dot3(__m256 m0, __m256 m1, __m256 m2, __m256 x, __m256 y, __m256 z) {
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, x), _mm256_mul_ps(m1, y)), _mm256_mul_ps(m2, z));
+}
+
+// ------------------------------------------------------------------------------------------------
+AI_TARGET_AVX2 void TransformPointsAVX2(const aiMatrix4x4& m, const aiVector3D* in, aiVector3D* out, size_t count) {
+    const __m256 a1 = _mm256_set1_ps(m.a1), a2 = _mm256_set1_ps(m.a2), a3 = _mm256_set1_ps(m.a3), a4 = _mm256_set1_ps(m.a4);
+    const __m256 b1 = _mm256_set1_ps(m.b1), b2 = _mm256_set1_ps(m.b2), b3 = _mm256_set1_ps(m.b3), b4 = _mm256_set1_ps(m.b4);
+    const __m256 c1 = _mm256_set1_ps(m.c1), c2 = _mm256_set1_ps(m.c2), c3 = _mm256_set1_ps(m.c3), c4 = _mm256_set1_ps(m.c4);
+
+    const size_t blocks = count & ~static_cast<size_t>(7);
+    for (size_t i = 0; i < blocks; i += 8) {
+        __m256 x, y, z;
+        LoadSoA8(&in[i].x, x, y, z);
+        StoreAoS8(&out[i].x,
+                _mm256_add_ps(Dot3(a1, a2, a3, x, y, z), a4),
+                _mm256_add_ps(Dot3(b1, b2, b3, x, y, z), b4),
+                _mm256_add_ps(Dot3(c1, c2, c3, x, y, z), c4));
+    }
+    TransformPointsSSE2(m, in + blocks, out + blocks, count - blocks);
+}
+
+// ------------------------------------------------------------------------------------------------
+AI_TARGET_AVX2 void TransformDirectionsAVX2(const aiMatrix3x3& m, const aiVector3D* in, aiVector3D* out,
+        size_t count, bool normalize) {
+    const __m256 a1 = _mm256_set1_ps(m.a1), a2 = _mm256_set1_ps(m.a2), a3 = _mm256_set1_ps(m.a3);
+    const __m256 b1 = _mm256_set1_ps(m.b1), b2 = _mm256_set1_ps(m.b2), b3 = _mm256_set1_ps(m.b3);
+    const __m256 c1 = _mm256_set1_ps(m.c1), c2 = _mm256_set1_ps(m.c2), c3 = _mm256_set1_ps(m.c3);
+    const __m256 one = _mm256_set1_ps(1.f);
+
+    const size_t blocks = count & ~static_cast<size_t>(7);
+    for (size_t i = 0; i < blocks; i += 8) {
+        __m256 x, y, z;
+        LoadSoA8(&in[i].x, x, y, z);
+        __m256 rx = Dot3(a1, a2, a3, x, y, z), ry = Dot3(b1, b2, b3, x, y, z), rz = Dot3(c1, c2, c3, x, y, z);
+        if (normalize) {
+            const __m256 inv = _mm256_div_ps(one, _mm256_sqrt_ps(Dot3(rx, ry, rz, rx, ry, rz)));
+            rx = _mm256_mul_ps(rx, inv);
+            ry = _mm256_mul_ps(ry, inv);
+            rz = _mm256_mul_ps(rz, inv);
+        }
+        StoreAoS8(&out[i].x, rx, ry, rz);
+    }
+    TransformDirectionsSSE2(m, in + blocks, out + blocks, count - blocks, normalize);
+}
+
+// ------------------------------------------------------------------------------------------------
+// 24 floats are 8 vectors, lane i of register k holds component (8 * k + i) % 3
+AI_TARGET_AVX2 void ScaleVectorsAVX2(const aiVector3D& scale, const aiVector3D* in, aiVector3D* out, size_t count) {
+    const __m256 s0 = _mm256_setr_ps(scale.x, scale.y, scale.z, scale.x, scale.y, scale.z, scale.x, scale.y);
+    const __m256 s1 = _mm256_setr_ps(scale.z, scale.x, scale.y, scale.z, scale.x, scale.y, scale.z, scale.x);
+    const __m256 s2 = _mm256_setr_ps(scale.y, scale.z, scale.x, scale.y, scale.z, scale.x, scale.y, scale.z);
+
+    const size_t blocks = count & ~static_cast<size_t>(7);
+    for (size_t i = 0; i < blocks; i += 8) {
+        const float* src = &in[i].x;
+        float* dst = &out[i].x;
+        _mm256_storeu_ps(dst, _mm256_mul_ps(_mm256_loadu_ps(src), s0));
+        _mm256_storeu_ps(dst + 8, _mm256_mul_ps(_mm256_loadu_ps(src + 8), s1));
+        _mm256_storeu_ps(dst + 16, _mm256_mul_ps(_mm256_loadu_ps(src + 16), s2));
+    }
+    ScaleVectorsSSE2(scale, in + blocks, out + blocks, count - blocks);
+}
+
+// ------------------------------------------------------------------------------------------------
+AI_TARGET_AVX2 void InterpolateVectorsAVX2(const aiVector3D* start, const aiVector3D* end, const ai_real* factors,
+        aiVector3D* out, size_t count) {
+    const __m256i i0 = _mm256_setr_epi32(0, 0, 0, 1, 1, 1, 2, 2);
+    const __m256i i1 = _mm256_setr_epi32(2, 3, 3, 3, 4, 4, 4, 5);
+    const __m256i i2 = _mm256_setr_epi32(5, 5, 6, 6, 6, 7, 7, 7);
+
+    const size_t blocks = count & ~static_cast<size_t>(7);
+    for (size_t i = 0; i < blocks; i += 8) {
+        const __m256 f = _mm256_loadu_ps(factors + i);
+        const __m256 f0 = _mm256_permutevar8x32_ps(f, i0);
+        const __m256 f1 = _mm256_permutevar8x32_ps(f, i1);
+        const __m256 f2 = _mm256_permutevar8x32_ps(f, i2);
+        const float *a = &start[i].x, *b = &end[i].x;
+        float* dst = &out[i].x;
+        const __m256 a0 = _mm256_loadu_ps(a), a1 = _mm256_loadu_ps(a + 8), a2 = _mm256_loadu_ps(a + 16);
+        _mm256_storeu_ps(dst, _mm256_add_ps(a0, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b), a0), f0)));
+        _mm256_storeu_ps(dst + 8, _mm256_add_ps(a1, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b + 8), a1), f1)));
+        _mm256_storeu_ps(dst + 16, _mm256_add_ps(a2, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b + 16), a2), f2)));
+    }
+    InterpolateVectorsSSE2(start + blocks, end + blocks, factors + blocks, out + blocks, count - blocks);
+}
+
+// ------------------------------------------------------------------------------------------------
+AI_TARGET_AVX2 void ExtendBoundingBoxAVX2(const aiVector3D* points, size_t count, aiVector3D& min, aiVector3D& max) {
+    const size_t blocks = count & ~static_cast<size_t>(7);
+    if (blocks) {
+        // seeded with the incoming box, see ExtendBoundingBoxSSE2
+        __m256 mn[3] = {
+            _mm256_setr_ps(min.x, min.y, min.z, min.x, min.y, min.z, min.x, min.y),
+            _mm256_setr_ps(min.z, min.x, min.y, min.z, min.x, min.y, min.z, min.x),
+            _mm256_setr_ps(min.y, min.z, min.x, min.y, min.z, min.x, min.y, min.z)
+        };
+        __m256 mx[3] = {
+            _mm256_setr_ps(max.x, max.y, max.z, max.x, max.y, max.z, max.x, max.y),
+            _mm256_setr_ps(max.z, max.x, max.y, max.z, max.x, max.y, max.z, max.x),
+            _mm256_setr_ps(max.y, max.z, max.x, max.y, max.z, max.x, max.y, max.z)
+        };
+        for (size_t i = 0; i < blocks; i += 8) {
+            const float* src = &points[i].x;
+            for (int k = 0; k < 3; ++k) {
+                const __m256 v = _mm256_loadu_ps(src + 8 * k);
+                mn[k] = _mm256_min_ps(v, mn[k]);
+                mx[k] = _mm256_max_ps(v, mx[k]);
+            }
+        }
+
+        float lanesMin[24], lanesMax[24];
+        for (int k = 0; k < 3; ++k) {
+            _mm256_storeu_ps(lanesMin + 8 * k, mn[k]);
+            _mm256_storeu_ps(lanesMax + 8 * k, mx[k]);
+        }
+        MergeBoundingBoxLanes(lanesMin, lanesMax, 24, min, max);
+    }
+    ExtendBoundingBoxSSE2(points + blocks, count - blocks, min, max);
+}
+
+#undef AI_TARGET_AVX2
+
+#endif // AI_VECTOR_KERNELS_AVX2
+
+#if defined(AI_VECTOR_KERNELS_NEON)
+
+// ------------------------------------------------------------------------------------------------
+// vld3q/vst3q split and merge four interleaved xyz vectors
+inline float32x4_t Dot3(float m0, float m1, float m2, const float32x4x3_t& v) {
+    return vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], m0), vmulq_n_f32(v.val[1], m1)), vmulq_n_f32(v.val[2], m2));
+}
+
+inline void Normalize(float32x4x3_t& v) {
+    const float32x4_t inv = vdivq_f32(vdupq_n_f32(1.f), vsqrtq_f32(vaddq_f32(vaddq_f32(
+            vmulq_f32(v.val[0], v.val[0]), vmulq_f32(v.val[1], v.val[1])), vmulq_f32(v.val[2], v.val[2]))));
+    for (int k = 0; k < 3; ++k) {
+        v.val[k] = vmulq_f32(v.val[k], inv);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TransformPointsNEON(const aiMatrix4x4& m, const aiVector3D* in, aiVector3D* out, size_t count) {
+    const size_t blocks = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < blocks; i += 4) {
+        const float32x4x3_t v = vld3q_f32(&in[i].x);
+        float32x4x3_t r;
+        r.val[0] = vaddq_f32(Dot3(m.a1, m.a2, m.a3, v), vdupq_n_f32(m.a4));
+        r.val[1] = vaddq_f32(Dot3(m.b1, m.b2, m.b3, v), vdupq_n_f32(m.b4));
+        r.val[2] = vaddq_f32(Dot3(m.c1, m.c2, m.c3, v), vdupq_n_f32(m.c4));
+        vst3q_f32(&out[i].x, r);
+    }
+    TransformPointsScalar(m, in + blocks, out + blocks, count - blocks);
+}
+
+// ------------------------------------------------------------------------------------------------
+void TransformDirectionsNEON(const aiMatrix3x3& m, const aiVector3D* in, aiVector3D* out,
+        size_t count, bool normalize) {
+    const size_t blocks = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < blocks; i += 4) {
+        const float32x4x3_t v = vld3q_f32(&in[i].x);
+        float32x4x3_t r;
+        r.val[0] = Dot3(m.a1, m.a2, m.a3, v);
+        r.val[1] = Dot3(m.b1, m.b2, m.b3, v);
+        r.val[2] = Dot3(m.c1, m.c2, m.c3, v);
+        if (normalize) {
+            Normalize(r);
+        }
+        vst3q_f32(&out[i].x, r);
+    }
+    TransformDirectionsScalar(m, in + blocks, out + blocks, count - blocks, normalize);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ScaleVectorsNEON(const aiVector3D& scale, const aiVector3D* in, aiVector3D* out, size_t count) {
+    const size_t blocks = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < blocks; i += 4) {
+        float32x4x3_t v = vld3q_f32(&in[i].x);
+        v.val[0] = vmulq_n_f32(v.val[0], scale.x);
+        v.val[1] = vmulq_n_f32(v.val[1], scale.y);
+        v.val[2] = vmulq_n_f32(v.val[2], scale.z);
+        vst3q_f32(&out[i].x, v);
+    }
+    ScaleVectorsScalar(scale, in + blocks, out + blocks, count - blocks);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InterpolateVectorsNEON(const aiVector3D* start, const aiVector3D* end, const ai_real* factors,
+        aiVector3D* out, size_t count) {
+    const size_t blocks = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < blocks; i += 4) {
+        const float32x4_t f = vld1q_f32(factors + i);
+        const float32x4x3_t a = vld3q_f32(&start[i].x), b = vld3q_f32(&end[i].x);
+        float32x4x3_t r;
+        for (int k = 0; k < 3; ++k) {
+            r.val[k] = vaddq_f32(a.val[k], vmulq_f32(vsubq_f32(b.val[k], a.val[k]), f));
+        }
+        vst3q_f32(&out[i].x, r);
+    }
+    InterpolateVectorsScalar(start + blocks, end + blocks, factors + blocks, out + blocks, count - blocks);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ExtendBoundingBoxNEON(const aiVector3D* points, size_t count, aiVector3D& min, aiVector3D& max) {
+    const size_t blocks = count & ~static_cast<size_t>(3);
+    if (blocks) {
+        // seeded with the incoming box, a seed taken from the points would keep a NaN value
+        // in its lane forever
+        float32x4x3_t mn, mx;
+        for (int k = 0; k < 3; ++k) {
+            mn.val[k] = vdupq_n_f32(min[k]);
+            mx.val[k] = vdupq_n_f32(max[k]);
+        }
+        for (size_t i = 0; i < blocks; i += 4) {
+            const float32x4x3_t v = vld3q_f32(&points[i].x);
+            for (int k = 0; k < 3; ++k) {
+                // select instead of vminq/vmaxq, which would propagate NaN values
+                mn.val[k] = vbslq_f32(vcltq_f32(v.val[k], mn.val[k]), v.val[k], mn.val[k]);
+                mx.val[k] = vbslq_f32(vcgtq_f32(v.val[k], mx.val[k]), v.val[k], mx.val[k]);
+            }
+        }
+
+        // back to interleaved xyz, so lane i holds component i % 3
+        float lanesMin[12], lanesMax[12];
+        vst3q_f32(lanesMin, mn);
+        vst3q_f32(lanesMax, mx);
+        MergeBoundingBoxLanes(lanesMin, lanesMax, 12, min, max);
+    }
+    ExtendBoundingBoxScalar(points + blocks, count - blocks, min, max);
+}
+
+#endif // AI_VECTOR_KERNELS_NEON
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+void TransformPoints(const aiMatrix4x4& m, const aiVector3D* in, aiVector3D* out, size_t count) {
+    if (!count) {
+        return;
+    }
+    switch (GetInstructionSet()) {
+#if defined(AI_VECTOR_KERNELS_AVX2)
+    case InstructionSet_AVX2:
+        TransformPointsAVX2(m, in, out, count);
+        return;
+#endif
+#if defined(AI_VECTOR_KERNELS_SSE2)
+    case InstructionSet_SSE2:
+        TransformPointsSSE2(m, in, out, count);
+        return;
+#endif
+#if defined(AI_VECTOR_KERNELS_NEON)
+    case InstructionSet_NEON:
+        TransformPointsNEON(m, in, out, count);
+        return;
+#endif
+    default:
+        TransformPointsScalar(m, in, out, count);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TransformDirections(const aiMatrix3x3& m, const aiVector3D* in, aiVector3D* out,
+        size_t count, bool normalize) {
+    if (!count) {
+        return;
+    }
+    switch (GetInstructionSet()) {
+#if defined(AI_VECTOR_KERNELS_AVX2)
+    case InstructionSet_AVX2:
+        TransformDirectionsAVX2(m, in, out, count, normalize);
+        return;
+#endif
+#if defined(AI_VECTOR_KERNELS_SSE2)
+    case InstructionSet_SSE2:
+        TransformDirectionsSSE2(m, in, out, count, normalize);
+        return;
+#endif
+#if defined(AI_VECTOR_KERNELS_NEON)
+    case InstructionSet_NEON:
+        TransformDirectionsNEON(m, in, out, count, normalize);
+        return;
+#endif
+    default:
+        TransformDirectionsScalar(m, in, out, count, normalize);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ScaleVectors(const aiVector3D& scale, const aiVector3D* in, aiVector3D* out, size_t count) {
+    if (!count) {
+        return;
+    }
+    switch (GetInstructionSet()) {
+#if defined(AI_VECTOR_KERNELS_AVX2)
+    case InstructionSet_AVX2:
+        ScaleVectorsAVX2(scale, in, out, count);
+        return;
+#endif
+#if defined(AI_VECTOR_KERNELS_SSE2)
+    case InstructionSet_SSE2:
+        ScaleVectorsSSE2(scale, in, out, count);
+        return;
+#endif
+#if defined(AI_VECTOR_KERNELS_NEON)
+    case InstructionSet_NEON:
+        ScaleVectorsNEON(scale, in, out, count);
+        return;
+#endif
+    default:
+        ScaleVectorsScalar(scale, in, out, count);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InterpolateVectors(const aiVector3D* start, const aiVector3D* end, const ai_real* factors,
+        aiVector3D* out, size_t count) {
+    if (!count) {
+        return;
+    }
+    switch (GetInstructionSet()) {
+#if defined(AI_VECTOR_KERNELS_AVX2)
+    case InstructionSet_AVX2:
+        InterpolateVectorsAVX2(start, end, factors, out, count);
+        return;
+#endif
+#if defined(AI_VECTOR_KERNELS_SSE2)
+    case InstructionSet_SSE2:
+        InterpolateVectorsSSE2(start, end, factors, out, count);
+        return;
+#endif
+#if defined(AI_VECTOR_KERNELS_NEON)
+    case InstructionSet_NEON:
+        InterpolateVectorsNEON(start, end, factors, out, count);
+        return;
+#endif
+    default:
+        InterpolateVectorsScalar(start, end, factors, out, count);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ExtendBoundingBox(const aiVector3D* points, size_t count, aiVector3D& min, aiVector3D& max) {
+    if (!count) {
+        return;
+    }
+    switch (GetInstructionSet()) {
+#if defined(AI_VECTOR_KERNELS_AVX2)
+    case InstructionSet_AVX2:
+        ExtendBoundingBoxAVX2(points, count, min, max);
+        return;
+#endif
+#if defined(AI_VECTOR_KERNELS_SSE2)
+    case InstructionSet_SSE2:
+        ExtendBoundingBoxSSE2(points, count, min, max);
+        return;
+#endif
+#if defined(AI_VECTOR_KERNELS_NEON)
+    case InstructionSet_NEON:
+        ExtendBoundingBoxNEON(points, count, min, max);
+        return;
+#endif
+    default:
+        ExtendBoundingBoxScalar(points, count, min, max);
+    }
+}
+
+} // Namespace Assimp
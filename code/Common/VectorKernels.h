@@ -0,0 +1,76 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#pragma once
+
+#include <assimp/types.h>
+
+#include <cstddef>
+
+namespace Assimp {
+
+// All kernels process arrays of vectors in one go, using SSE2, AVX2 or NEON where
+// the CPU supports it. Each lane computes the same sequence of operations as the
+// scalar aiMatrix and aiVector3D operators. @p in and @p out may be the same array,
+// but must not overlap otherwise.
+
+/// @brief  out[i] = m * in[i], for count points.
+ASSIMP_API void TransformPoints(const aiMatrix4x4& m, const aiVector3D* in,
+        aiVector3D* out, size_t count);
+
+/// @brief  out[i] = m * in[i], for count directions, normalized afterwards if requested.
+ASSIMP_API void TransformDirections(const aiMatrix3x3& m, const aiVector3D* in,
+        aiVector3D* out, size_t count, bool normalize);
+
+/// @brief  out[i] = in[i] multiplied component-wise by scale, for count vectors.
+ASSIMP_API void ScaleVectors(const aiVector3D& scale, const aiVector3D* in,
+        aiVector3D* out, size_t count);
+
+/// @brief  out[i] = start[i] + (end[i] - start[i]) * factors[i], for count vectors.
+ASSIMP_API void InterpolateVectors(const aiVector3D* start, const aiVector3D* end,
+        const ai_real* factors, aiVector3D* out, size_t count);
+
+/// @brief  Grows the box given by min and max until it encloses all count points.
+ASSIMP_API void ExtendBoundingBox(const aiVector3D* points, size_t count,
+        aiVector3D& min, aiVector3D& max);
+
+} // Namespace Assimp
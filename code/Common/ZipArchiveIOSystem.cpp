@@ -49,8 +49,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/ai_assert.h>
 
-#include <map>
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #ifdef ASSIMP_USE_HUNTER
 #  include <minizip/unzip.h>
@@ -170,6 +173,63 @@ namespace Assimp {
         return mapping;
     }
 
+    // ----------------------------------------------------------------
+    // Entries larger than this are inflated on demand by default
+    static const size_t DefaultStreamingThreshold = 16 * 1024 * 1024;
+
+    // ----------------------------------------------------------------
+    // Handles to the same ZIP, each handle is used by one stream at a time
+    class ZipHandlePool {
+    public:
+        ZipHandlePool(IOSystem* pIOHandler, const char* pFilename);
+        ~ZipHandlePool();
+
+        // Returns a free handle or opens a new one, nullptr if the ZIP can't be opened
+        unzFile Acquire();
+        void Release(unzFile handle);
+
+    private:
+        zlib_filefunc_def m_Mapping;
+        std::string m_Filename;
+        std::mutex m_Mutex;
+        std::vector<unzFile> m_FreeHandles;
+        size_t m_NumHandles = 0;
+    };
+
+    ZipHandlePool::ZipHandlePool(IOSystem* pIOHandler, const char* pFilename)
+        : m_Mapping(IOSystem2Unzip::get(pIOHandler))
+        , m_Filename(pFilename) {
+    }
+
+    ZipHandlePool::~ZipHandlePool() {
+        // The open streams share the pool, so all of them are closed by now
+        ai_assert(m_FreeHandles.size() == m_NumHandles);
+        for (unzFile handle : m_FreeHandles) {
+            unzClose(handle);
+        }
+    }
+
+    unzFile ZipHandlePool::Acquire() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_FreeHandles.empty()) {
+            unzFile handle = m_FreeHandles.back();
+            m_FreeHandles.pop_back();
+            return handle;
+        }
+
+        // The IOSystem is only used with the lock held
+        unzFile handle = unzOpen2(m_Filename.c_str(), &m_Mapping);
+        if (handle != nullptr) {
+            ++m_NumHandles;
+        }
+        return handle;
+    }
+
+    void ZipHandlePool::Release(unzFile handle) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_FreeHandles.push_back(handle);
+    }
+
     // ----------------------------------------------------------------
     // A read-only file inside a ZIP
 
@@ -201,6 +261,11 @@ namespace Assimp {
     public:
         explicit ZipFileInfo(unzFile zip_handle, size_t size);
 
+        size_t GetSize() const { return m_Size; }
+
+        // Makes the file the current one of the handle and opens it for reading
+        bool Open(unzFile zip_handle) const;
+
         // Allocate and Extract data from the ZIP
         ZipFile * Extract(unzFile zip_handle) const;
 
@@ -218,13 +283,17 @@ namespace Assimp {
         unzGetFilePos(zip_handle, &(m_ZipFilePos));
     }
 
-    ZipFile * ZipFileInfo::Extract(unzFile zip_handle) const {
-        // Find in the ZIP. This cannot fail
+    bool ZipFileInfo::Open(unzFile zip_handle) const {
+        // The position is an offset into the directory, so it's valid for all handles to the ZIP
         unz_file_pos_s *filepos = const_cast<unz_file_pos_s*>(&(m_ZipFilePos));
         if (unzGoToFilePos(zip_handle, filepos) != UNZ_OK)
-            return nullptr;
+            return false;
+
+        return unzOpenCurrentFile(zip_handle) == UNZ_OK;
+    }
 
-        if (unzOpenCurrentFile(zip_handle) != UNZ_OK)
+    ZipFile * ZipFileInfo::Extract(unzFile zip_handle) const {
+        if (!Open(zip_handle))
             return nullptr;
 
         ZipFile *zip_file = new ZipFile(m_Size);
@@ -236,7 +305,9 @@ namespace Assimp {
             zip_file = nullptr;
         }
 
-        ai_assert(unzCloseCurrentFile(zip_handle) == UNZ_OK);
+        const int result = unzCloseCurrentFile(zip_handle);
+        ai_assert(result == UNZ_OK);
+        (void)result;
         return zip_file;
     }
 
@@ -305,61 +376,183 @@ namespace Assimp {
         return m_SeekPtr;
     }
 
+    // ----------------------------------------------------------------
+    // A read-only file inside a ZIP which is inflated while it is read.
+    // It keeps a handle of the pool until it's closed, and shares the
+    // pool with the archive, so it may outlive the archive.
+
+    class ZipStreamFile : public IOStream {
+    public:
+        ZipStreamFile(std::shared_ptr<ZipHandlePool> pool, unzFile zip_handle, const ZipFileInfo& info);
+        virtual ~ZipStreamFile();
+
+        // IOStream interface
+        size_t Read(void* pvBuffer, size_t pSize, size_t pCount) override;
+        size_t Write(const void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) override { return 0; }
+        size_t FileSize() const override;
+        aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+        size_t Tell() const override;
+        void Flush() override {}
+
+    private:
+        bool Inflate(uint8_t* pBuffer, size_t size);
+
+    private:
+        std::shared_ptr<ZipHandlePool> m_Pool;
+        unzFile m_ZipHandle;
+        const ZipFileInfo m_Info;
+        size_t m_SeekPtr = 0;
+        std::vector<uint8_t> m_SkipBuffer;
+    };
+
+    ZipStreamFile::ZipStreamFile(std::shared_ptr<ZipHandlePool> pool, unzFile zip_handle, const ZipFileInfo& info)
+        : m_Pool(std::move(pool))
+        , m_ZipHandle(zip_handle)
+        , m_Info(info) {
+    }
+
+    ZipStreamFile::~ZipStreamFile() {
+        unzCloseCurrentFile(m_ZipHandle);
+        m_Pool->Release(m_ZipHandle);
+    }
+
+    bool ZipStreamFile::Inflate(uint8_t* pBuffer, size_t size) {
+        while (size > 0) {
+            const unsigned int chunk = static_cast<unsigned int>(std::min<size_t>(size, 1u << 30));
+            const int read = unzReadCurrentFile(m_ZipHandle, pBuffer, chunk);
+            if (read <= 0)
+                return false;
+
+            pBuffer += read;
+            size -= read;
+            m_SeekPtr += read;
+        }
+        return true;
+    }
+
+    size_t ZipStreamFile::Read(void* pvBuffer, size_t pSize, size_t pCount) {
+        ai_assert(NULL != pvBuffer && 0 != pSize && 0 != pCount);
+
+        // Clip down to file size
+        pCount = std::min(pCount, (m_Info.GetSize() - m_SeekPtr) / pSize);
+        const size_t byteSize = pSize * pCount;
+        if (byteSize == 0)
+            return 0;
+
+        if (!Inflate(static_cast<uint8_t*>(pvBuffer), byteSize))
+            return 0;
+
+        return pCount;
+    }
+
+    size_t ZipStreamFile::FileSize() const {
+        return m_Info.GetSize();
+    }
+
+    aiReturn ZipStreamFile::Seek(size_t pOffset, aiOrigin pOrigin) {
+        const size_t size = m_Info.GetSize();
+
+        size_t target;
+        switch (pOrigin)
+        {
+        case aiOrigin_SET:
+            target = pOffset;
+            break;
+        case aiOrigin_CUR:
+            target = m_SeekPtr + pOffset;
+            break;
+        case aiOrigin_END:
+            if (pOffset > size) return aiReturn_FAILURE;
+            target = size - pOffset;
+            break;
+        default:
+            return aiReturn_FAILURE;
+        }
+        if (target > size)
+            return aiReturn_FAILURE;
+
+        // Deflate streams can't go backwards, so inflate again from the start
+        if (target < m_SeekPtr) {
+            unzCloseCurrentFile(m_ZipHandle);
+            m_SeekPtr = 0;
+            if (!m_Info.Open(m_ZipHandle))
+                return aiReturn_FAILURE;
+        }
+
+        // Skip forward
+        if (target > m_SeekPtr && m_SkipBuffer.empty()) {
+            m_SkipBuffer.resize(64 * 1024);
+        }
+        while (target > m_SeekPtr) {
+            if (!Inflate(m_SkipBuffer.data(), std::min(target - m_SeekPtr, m_SkipBuffer.size())))
+                return aiReturn_FAILURE;
+        }
+        return aiReturn_SUCCESS;
+    }
+
+    size_t ZipStreamFile::Tell() const {
+        return m_SeekPtr;
+    }
+
     // ----------------------------------------------------------------
     // pImpl of the Zip Archive IO
     class ZipArchiveIOSystem::Implement {
     public:
         static const unsigned int FileNameSize = 256;
 
-        Implement(IOSystem* pIOHandler, const char* pFilename, const char* pMode);
+        Implement(IOSystem* pIOHandler, const char* pFilename, const char* pMode, bool mapArchive = true);
         ~Implement();
 
         bool isOpen() const;
-        void getFileList(std::vector<std::string>& rFileList);
-        void getFileListExtension(std::vector<std::string>& rFileList, const std::string& extension);
-        bool Exists(std::string& filename);
+        void getFileList(std::vector<std::string>& rFileList) const;
+        void getFileListExtension(std::vector<std::string>& rFileList, const std::string& extension) const;
+        bool Exists(std::string& filename) const;
         IOStream* OpenFile(std::string& filename);
+        void setStreamingThreshold(size_t threshold);
 
         static void SimplifyFilename(std::string& filename);
 
     private:
-        void MapArchive();
+        void MapArchive(unzFile zip_handle);
 
     private:
-        typedef std::map<std::string, ZipFileInfo> ZipFileInfoMap;
+        typedef std::unordered_map<std::string, ZipFileInfo> ZipFileInfoMap;
+
+        // Shared with the open streams
+        std::shared_ptr<ZipHandlePool> m_Handles;
+        bool m_IsOpen = false;
+        size_t m_StreamingThreshold = DefaultStreamingThreshold;
 
-        unzFile m_ZipFileHandle = nullptr;
+        // Written once in the constructor, so concurrent lookups need no lock
         ZipFileInfoMap m_ArchiveMap;
+        std::vector<std::string> m_FileNames;
     };
 
-    ZipArchiveIOSystem::Implement::Implement(IOSystem* pIOHandler, const char* pFilename, const char* pMode) {
+    ZipArchiveIOSystem::Implement::Implement(IOSystem* pIOHandler, const char* pFilename, const char* pMode, bool mapArchive)
+        : m_Handles(std::make_shared<ZipHandlePool>(pIOHandler, pFilename != nullptr ? pFilename : "")) {
         ai_assert(strcmp(pMode, "r") == 0);
         ai_assert(pFilename != nullptr);
-        if (pFilename[0] == 0)
+        if (pFilename == nullptr || pFilename[0] == 0)
+            return;
+
+        unzFile zip_handle = m_Handles->Acquire();
+        if (zip_handle == nullptr)
             return;
 
-        zlib_filefunc_def mapping = IOSystem2Unzip::get(pIOHandler);
-        m_ZipFileHandle = unzOpen2(pFilename, &mapping);
+        m_IsOpen = true;
+        if (mapArchive) {
+            MapArchive(zip_handle);
+        }
+        m_Handles->Release(zip_handle);
     }
 
     ZipArchiveIOSystem::Implement::~Implement() {
         m_ArchiveMap.clear();
-
-        if (m_ZipFileHandle != nullptr) {
-            unzClose(m_ZipFileHandle);
-            m_ZipFileHandle = nullptr;
-        }
     }
 
-    void ZipArchiveIOSystem::Implement::MapArchive() {
-        if (m_ZipFileHandle == nullptr)
-            return;
-
-        if (!m_ArchiveMap.empty())
-            return;
-
+    void ZipArchiveIOSystem::Implement::MapArchive(unzFile zip_handle) {
         //  At first ensure file is already open
-        if (unzGoToFirstFile(m_ZipFileHandle) != UNZ_OK)
+        if (unzGoToFirstFile(zip_handle) != UNZ_OK)
             return;
 
         // Loop over all files
@@ -367,49 +560,44 @@ namespace Assimp {
             char filename[FileNameSize];
             unz_file_info fileInfo;
 
-            if (unzGetCurrentFileInfo(m_ZipFileHandle, &fileInfo, filename, FileNameSize, nullptr, 0, nullptr, 0) == UNZ_OK) {
+            if (unzGetCurrentFileInfo(zip_handle, &fileInfo, filename, FileNameSize, nullptr, 0, nullptr, 0) == UNZ_OK) {
                 if (fileInfo.uncompressed_size != 0) {
                     std::string filename_string(filename, fileInfo.size_filename);
                     SimplifyFilename(filename_string);
-                    m_ArchiveMap.emplace(filename_string, ZipFileInfo(m_ZipFileHandle, fileInfo.uncompressed_size));
+                    if (m_ArchiveMap.emplace(filename_string, ZipFileInfo(zip_handle, fileInfo.uncompressed_size)).second) {
+                        m_FileNames.push_back(filename_string);
+                    }
                 }
             }
-        } while (unzGoToNextFile(m_ZipFileHandle) != UNZ_END_OF_LIST_OF_FILE);
+        } while (unzGoToNextFile(zip_handle) != UNZ_END_OF_LIST_OF_FILE);
+
+        // The file lists are sorted by name
+        std::sort(m_FileNames.begin(), m_FileNames.end());
     }
 
     bool ZipArchiveIOSystem::Implement::isOpen() const {
-        return (m_ZipFileHandle != nullptr);
+        return m_IsOpen;
     }
 
-    void ZipArchiveIOSystem::Implement::getFileList(std::vector<std::string>& rFileList) {
-        MapArchive();
-        rFileList.clear();
-
-        for (const auto &file : m_ArchiveMap) {
-            rFileList.push_back(file.first);
-        }
+    void ZipArchiveIOSystem::Implement::getFileList(std::vector<std::string>& rFileList) const {
+        rFileList = m_FileNames;
     }
 
-    void ZipArchiveIOSystem::Implement::getFileListExtension(std::vector<std::string>& rFileList, const std::string& extension) {
-        MapArchive();
+    void ZipArchiveIOSystem::Implement::getFileListExtension(std::vector<std::string>& rFileList, const std::string& extension) const {
         rFileList.clear();
 
-        for (const auto &file : m_ArchiveMap) {
-            if (extension == BaseImporter::GetExtension(file.first))
-                rFileList.push_back(file.first);
+        for (const auto &file : m_FileNames) {
+            if (extension == BaseImporter::GetExtension(file))
+                rFileList.push_back(file);
         }
     }
 
-    bool ZipArchiveIOSystem::Implement::Exists(std::string& filename) {
-        MapArchive();
-
+    bool ZipArchiveIOSystem::Implement::Exists(std::string& filename) const {
         ZipFileInfoMap::const_iterator it = m_ArchiveMap.find(filename);
         return (it != m_ArchiveMap.end());
     }
 
     IOStream * ZipArchiveIOSystem::Implement::OpenFile(std::string& filename) {
-        MapArchive();
-
         SimplifyFilename(filename);
 
         // Find in the map
@@ -417,8 +605,27 @@ namespace Assimp {
         if (zip_it == m_ArchiveMap.cend())
             return nullptr;
 
+        // Each stream works on its own handle, so files can be opened and read concurrently
+        unzFile zip_handle = m_Handles->Acquire();
+        if (zip_handle == nullptr)
+            return nullptr;
+
         const ZipFileInfo &zip_file = (*zip_it).second;
-        return zip_file.Extract(m_ZipFileHandle);
+        if (zip_file.GetSize() > m_StreamingThreshold) {
+            if (zip_file.Open(zip_handle))
+                return new ZipStreamFile(m_Handles, zip_handle, zip_file);
+
+            m_Handles->Release(zip_handle);
+            return nullptr;
+        }
+
+        ZipFile *result = zip_file.Extract(zip_handle);
+        m_Handles->Release(zip_handle);
+        return result;
+    }
+
+    void ZipArchiveIOSystem::Implement::setStreamingThreshold(size_t threshold) {
+        m_StreamingThreshold = threshold;
     }
 
     inline void ReplaceAll(std::string& data, const std::string& before, const std::string& after) {
@@ -527,8 +734,13 @@ namespace Assimp {
         return pImpl->getFileListExtension(rFileList, extension);
     }
 
+    void ZipArchiveIOSystem::setStreamingThreshold(size_t threshold) {
+        pImpl->setStreamingThreshold(threshold);
+    }
+
     bool ZipArchiveIOSystem::isZipArchive(IOSystem* pIOHandler, const char* pFilename) {
-        Implement tmp(pIOHandler, pFilename, "r");
+        // The directory isn't needed to tell
+        Implement tmp(pIOHandler, pFilename, "r", false);
         return tmp.isOpen();
     }
 
@@ -75,5 +75,13 @@ bool CPUSupportsSSE2() {
 #endif
 }
 
+bool CPUSupportsAVX2() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    // GCC and clang query cpuid and the OS support for the extended registers
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+}
 
 } // Namespace Assimp
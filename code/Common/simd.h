@@ -50,4 +50,8 @@ namespace Assimp {
 /// @return true, if SSE2 is supported. false if SSE2 is not supported.
 bool ASSIMP_API CPUSupportsSSE2();
 
+/// @brief  Checks if the platform supports AVX2 optimization
+/// @return true, if AVX2 is supported. false if AVX2 is not supported.
+bool ASSIMP_API CPUSupportsAVX2();
+
 } // Namespace Assimp
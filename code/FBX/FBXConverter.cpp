@@ -61,6 +61,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/CreateAnimMesh.h>
 
+#include "Common/ParallelFor.h"
+
 #include <tuple>
 #include <memory>
 #include <iterator>
@@ -2527,16 +2529,29 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                         kv.first,
                         kv.second,
                         layer_map,
-                        start_time, stop_time,
-                        max_time,
-                        min_time);
+                        start_time, stop_time);
                 }
+
+                ConvertScheduledKeys(max_time, min_time);
             }
             catch (std::exception&) {
+                key_conversion_jobs.clear();
                 std::for_each(node_anims.begin(), node_anims.end(), Util::delete_fun<aiNodeAnim>());
                 throw;
             }
 
+            // drop the channels that ended up without keys, keeping the order of the others
+            size_t num_node_anims = 0;
+            for (aiNodeAnim* na : node_anims) {
+                if (na->mNumPositionKeys == 0 && na->mNumRotationKeys == 0 && na->mNumScalingKeys == 0) {
+                    delete na;
+                }
+                else {
+                    node_anims[num_node_anims++] = na;
+                }
+            }
+            node_anims.resize(num_node_anims);
+
             if (node_anims.size() || morphAnimDatas.size()) {
                 if (node_anims.size()) {
                     anim->mChannels = new aiNodeAnim*[node_anims.size()]();
@@ -2697,9 +2712,7 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
             const std::string& fixed_name,
             const std::vector<const AnimationCurveNode*>& curves,
             const LayerMap& layer_map,
-            int64_t start, int64_t stop,
-            double& max_time,
-            double& min_time)
+            int64_t start, int64_t stop)
         {
 
             NodeMap node_property_map;
@@ -2782,18 +2795,11 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                     node_property_map.end(),
                     layer_map,
                     start, stop,
-                    max_time,
-                    min_time,
                     true // input is TRS order, assimp is SRT
                 );
 
                 ai_assert(nd);
-                if (nd->mNumPositionKeys == 0 && nd->mNumRotationKeys == 0 && nd->mNumScalingKeys == 0) {
-                    delete nd;
-                }
-                else {
-                    node_anims.push_back(nd);
-                }
+                node_anims.push_back(nd);
                 return;
             }
 
@@ -2825,9 +2831,7 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                             target,
                             (*chain[i]).second,
                             layer_map,
-                            start, stop,
-                            max_time,
-                            min_time);
+                            start, stop);
 
                         break;
 
@@ -2841,9 +2845,7 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                             target,
                             (*chain[i]).second,
                             layer_map,
-                            start, stop,
-                            max_time,
-                            min_time);
+                            start, stop);
 
                         // pivoting requires us to generate an implicit inverse channel to undo the pivot translation
                         if (comp == TransformationComp_RotationPivot) {
@@ -2855,17 +2857,10 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                                 (*chain[i]).second,
                                 layer_map,
                                 start, stop,
-                                max_time,
-                                min_time,
                                 true);
 
                             ai_assert(inv);
-                            if (inv->mNumPositionKeys == 0 && inv->mNumRotationKeys == 0 && inv->mNumScalingKeys == 0) {
-                                delete inv;
-                            }
-                            else {
-                                node_anims.push_back(inv);
-                            }
+                            node_anims.push_back(inv);
 
                             ai_assert(TransformationComp_RotationPivotInverse > i);
                             flags |= bit << (TransformationComp_RotationPivotInverse - i);
@@ -2879,17 +2874,10 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                                 (*chain[i]).second,
                                 layer_map,
                                 start, stop,
-                                max_time,
-                                min_time,
                                 true);
 
                             ai_assert(inv);
-                            if (inv->mNumPositionKeys == 0 && inv->mNumRotationKeys == 0 && inv->mNumScalingKeys == 0) {
-                                delete inv;
-                            }
-                            else {
-                                node_anims.push_back(inv);
-                            }
+                            node_anims.push_back(inv);
 
                             ai_assert(TransformationComp_RotationPivotInverse > i);
                             flags |= bit << (TransformationComp_RotationPivotInverse - i);
@@ -2903,9 +2891,7 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                             target,
                             (*chain[i]).second,
                             layer_map,
-                            start, stop,
-                            max_time,
-                            min_time);
+                            start, stop);
 
                         break;
 
@@ -2914,12 +2900,7 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                     }
 
                     ai_assert(na);
-                    if (na->mNumPositionKeys == 0 && na->mNumRotationKeys == 0 && na->mNumScalingKeys == 0) {
-                        delete na;
-                    }
-                    else {
-                        node_anims.push_back(na);
-                    }
+                    node_anims.push_back(na);
                     continue;
                 }
             }
@@ -2977,14 +2958,12 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
             const Model& target,
             const std::vector<const AnimationCurveNode*>& curves,
             const LayerMap& layer_map,
-            int64_t start, int64_t stop,
-            double& max_time,
-            double& min_time)
+            int64_t start, int64_t stop)
         {
             std::unique_ptr<aiNodeAnim> na(new aiNodeAnim());
             na->mNodeName.Set(name);
 
-            ConvertRotationKeys(na.get(), curves, layer_map, start, stop, max_time, min_time, target.RotationOrder());
+            ConvertRotationKeys(na.get(), curves, layer_map, start, stop, target.RotationOrder());
 
             // dummy scaling key
             na->mScalingKeys = new aiVectorKey[1];
@@ -3007,14 +2986,12 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
             const Model& /*target*/,
             const std::vector<const AnimationCurveNode*>& curves,
             const LayerMap& layer_map,
-            int64_t start, int64_t stop,
-            double& max_time,
-            double& min_time)
+            int64_t start, int64_t stop)
         {
             std::unique_ptr<aiNodeAnim> na(new aiNodeAnim());
             na->mNodeName.Set(name);
 
-            ConvertScaleKeys(na.get(), curves, layer_map, start, stop, max_time, min_time);
+            ConvertScaleKeys(na.get(), curves, layer_map, start, stop);
 
             // dummy rotation key
             na->mRotationKeys = new aiQuatKey[1];
@@ -3038,19 +3015,11 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
             const std::vector<const AnimationCurveNode*>& curves,
             const LayerMap& layer_map,
             int64_t start, int64_t stop,
-            double& max_time,
-            double& min_time,
             bool inverse) {
             std::unique_ptr<aiNodeAnim> na(new aiNodeAnim());
             na->mNodeName.Set(name);
 
-            ConvertTranslationKeys(na.get(), curves, layer_map, start, stop, max_time, min_time);
-
-            if (inverse) {
-                for (unsigned int i = 0; i < na->mNumPositionKeys; ++i) {
-                    na->mPositionKeys[i].mValue *= -1.0f;
-                }
-            }
+            ConvertTranslationKeys(na.get(), curves, layer_map, start, stop, inverse);
 
             // dummy scaling key
             na->mScalingKeys = new aiVectorKey[1];
@@ -3075,8 +3044,6 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
             NodeMap::const_iterator iter_end,
             const LayerMap& layer_map,
             int64_t start, int64_t stop,
-            double& max_time,
-            double& min_time,
             bool reverse_order)
 
         {
@@ -3108,42 +3075,47 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                     rotation = GetKeyframeList((*chain[TransformationComp_Rotation]).second, start, stop);
                 }
 
-                KeyFrameListList joined;
-                joined.insert(joined.end(), scaling.begin(), scaling.end());
-                joined.insert(joined.end(), translation.begin(), translation.end());
-                joined.insert(joined.end(), rotation.begin(), rotation.end());
+                const Model::RotOrder order = target.RotationOrder();
+                aiNodeAnim* const out_anim = na.get();
+                ScheduleKeyConversion([this, out_anim, scaling, translation, rotation, order, def_scale, def_translate, def_rot](
+                        double& max_time, double& min_time) {
+                    KeyFrameListList joined;
+                    joined.insert(joined.end(), scaling.begin(), scaling.end());
+                    joined.insert(joined.end(), translation.begin(), translation.end());
+                    joined.insert(joined.end(), rotation.begin(), rotation.end());
 
-                const KeyTimeList& times = GetKeyTimeList(joined);
+                    const KeyTimeList& times = GetKeyTimeList(joined);
 
-                aiQuatKey* out_quat = new aiQuatKey[times.size()];
-                aiVectorKey* out_scale = new aiVectorKey[times.size()];
-                aiVectorKey* out_translation = new aiVectorKey[times.size()];
+                    aiQuatKey* out_quat = new aiQuatKey[times.size()];
+                    aiVectorKey* out_scale = new aiVectorKey[times.size()];
+                    aiVectorKey* out_translation = new aiVectorKey[times.size()];
 
-                if (times.size())
-                {
-                    ConvertTransformOrder_TRStoSRT(out_quat, out_scale, out_translation,
-                        scaling,
-                        translation,
-                        rotation,
-                        times,
-                        max_time,
-                        min_time,
-                        target.RotationOrder(),
-                        def_scale,
-                        def_translate,
-                        def_rot);
-                }
-
-                // XXX remove duplicates / redundant keys which this operation did
-                // likely produce if not all three channels were equally dense.
-
-                na->mNumScalingKeys = static_cast<unsigned int>(times.size());
-                na->mNumRotationKeys = na->mNumScalingKeys;
-                na->mNumPositionKeys = na->mNumScalingKeys;
-
-                na->mScalingKeys = out_scale;
-                na->mRotationKeys = out_quat;
-                na->mPositionKeys = out_translation;
+                    // XXX remove duplicates / redundant keys which this operation did
+                    // likely produce if not all three channels were equally dense.
+
+                    out_anim->mNumScalingKeys = static_cast<unsigned int>(times.size());
+                    out_anim->mNumRotationKeys = out_anim->mNumScalingKeys;
+                    out_anim->mNumPositionKeys = out_anim->mNumScalingKeys;
+
+                    out_anim->mScalingKeys = out_scale;
+                    out_anim->mRotationKeys = out_quat;
+                    out_anim->mPositionKeys = out_translation;
+
+                    if (times.size())
+                    {
+                        ConvertTransformOrder_TRStoSRT(out_quat, out_scale, out_translation,
+                            scaling,
+                            translation,
+                            rotation,
+                            times,
+                            max_time,
+                            min_time,
+                            order,
+                            def_scale,
+                            def_translate,
+                            def_rot);
+                    }
+                }, order != Model::RotOrder_SphericXYZ);
             }
             else {
 
@@ -3154,9 +3126,7 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                 if (chain[TransformationComp_Scaling] != iter_end) {
                     ConvertScaleKeys(na.get(), (*chain[TransformationComp_Scaling]).second,
                         layer_map,
-                        start, stop,
-                        max_time,
-                        min_time);
+                        start, stop);
                 }
                 else {
                     na->mScalingKeys = new aiVectorKey[1];
@@ -3171,8 +3141,6 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                     ConvertRotationKeys(na.get(), (*chain[TransformationComp_Rotation]).second,
                         layer_map,
                         start, stop,
-                        max_time,
-                        min_time,
                         target.RotationOrder());
                 }
                 else {
@@ -3188,9 +3156,7 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                 if (chain[TransformationComp_Translation] != iter_end) {
                     ConvertTranslationKeys(na.get(), (*chain[TransformationComp_Translation]).second,
                         layer_map,
-                        start, stop,
-                        max_time,
-                        min_time);
+                        start, stop);
                 }
                 else {
                     na->mPositionKeys = new aiVectorKey[1];
@@ -3276,32 +3242,40 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
 
             keys.reserve(estimate);
 
-            std::vector<unsigned int> next_pos;
-            next_pos.resize(inputs.size(), 0);
+            // k-way merge of the key times, which are ascending in every input (see AnimationCurve).
+            // The heap holds the next key time of every input that has keys left.
+            typedef std::pair<int64_t, size_t> Head; // next key time, input index
+            const std::greater<Head> later;
 
             const size_t count = inputs.size();
-            while (true) {
-
-                int64_t min_tick = std::numeric_limits<int64_t>::max();
-                for (size_t i = 0; i < count; ++i) {
-                    const KeyFrameList& kfl = inputs[i];
-
-                    if (std::get<0>(kfl)->size() > next_pos[i] && std::get<0>(kfl)->at(next_pos[i]) < min_tick) {
-                        min_tick = std::get<0>(kfl)->at(next_pos[i]);
-                    }
+            std::vector<size_t> next_pos(count, 0);
+            std::vector<Head> heads;
+            heads.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                if (!std::get<0>(inputs[i])->empty()) {
+                    heads.push_back(Head(std::get<0>(inputs[i])->front(), i));
                 }
+            }
+            std::make_heap(heads.begin(), heads.end(), later);
 
-                if (min_tick == std::numeric_limits<int64_t>::max()) {
-                    break;
-                }
+            while (!heads.empty()) {
+                const int64_t min_tick = heads.front().first;
                 keys.push_back(min_tick);
 
-                for (size_t i = 0; i < count; ++i) {
-                    const KeyFrameList& kfl = inputs[i];
-
+                // move every input past this time
+                while (!heads.empty() && heads.front().first == min_tick) {
+                    const size_t i = heads.front().second;
+                    std::pop_heap(heads.begin(), heads.end(), later);
+                    heads.pop_back();
 
-                    while (std::get<0>(kfl)->size() > next_pos[i] && std::get<0>(kfl)->at(next_pos[i]) == min_tick) {
-                        ++next_pos[i];
+                    const KeyTimeList& times = *std::get<0>(inputs[i]);
+                    size_t& pos = next_pos[i];
+                    while (pos < times.size() && times[pos] == min_tick) {
+                        ++pos;
+                    }
+                    if (pos < times.size()) {
+                        heads.push_back(Head(times[pos], i));
+                        std::push_heap(heads.begin(), heads.end(), later);
                     }
                 }
             }
@@ -3326,12 +3300,14 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
 
                 for (size_t i = 0; i < count; ++i) {
                     const KeyFrameList& kfl = inputs[i];
+                    const KeyTimeList& times = *std::get<0>(kfl);
+                    const KeyValueList& values = *std::get<1>(kfl);
 
-                    const size_t ksize = std::get<0>(kfl)->size();
+                    const size_t ksize = times.size();
                     if (ksize == 0) {
                         continue;
                     }
-                    if (ksize > next_pos[i] && std::get<0>(kfl)->at(next_pos[i]) == time) {
+                    if (ksize > next_pos[i] && times[next_pos[i]] == time) {
                         ++next_pos[i];
                     }
 
@@ -3339,11 +3315,11 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
                     const size_t id1 = next_pos[i] == ksize ? ksize - 1 : next_pos[i];
 
                     // use lerp for interpolation
-                    const KeyValueList::value_type valueA = std::get<1>(kfl)->at(id0);
-                    const KeyValueList::value_type valueB = std::get<1>(kfl)->at(id1);
+                    const KeyValueList::value_type valueA = values[id0];
+                    const KeyValueList::value_type valueB = values[id1];
 
-                    const KeyTimeList::value_type timeA = std::get<0>(kfl)->at(id0);
-                    const KeyTimeList::value_type timeB = std::get<0>(kfl)->at(id1);
+                    const KeyTimeList::value_type timeA = times[id0];
+                    const KeyTimeList::value_type timeB = times[id1];
 
                     const ai_real factor = timeB == timeA ? ai_real(0.) : static_cast<ai_real>((time - timeA)) / (timeB - timeA);
                     const ai_real interpValue = static_cast<ai_real>(valueA + (valueB - valueA) * factor);
@@ -3470,9 +3446,7 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
         }
 
         void FBXConverter::ConvertScaleKeys(aiNodeAnim* na, const std::vector<const AnimationCurveNode*>& nodes, const LayerMap& /*layers*/,
-            int64_t start, int64_t stop,
-            double& maxTime,
-            double& minTime)
+            int64_t start, int64_t stop)
         {
             ai_assert(nodes.size());
 
@@ -3480,51 +3454,92 @@ void FBXConverter::SetShadingPropertiesRaw(aiMaterial* out_mat, const PropertyTa
             // layers should be multiplied with each other). There is a FBX
             // property in the layer to specify the behaviour, though.
 
-            const KeyFrameListList& inputs = GetKeyframeList(nodes, start, stop);
-            const KeyTimeList& keys = GetKeyTimeList(inputs);
+            const KeyFrameListList inputs = GetKeyframeList(nodes, start, stop);
+            ScheduleKeyConversion([this, na, inputs](double& maxTime, double& minTime) {
+                const KeyTimeList& keys = GetKeyTimeList(inputs);
 
-            na->mNumScalingKeys = static_cast<unsigned int>(keys.size());
-            na->mScalingKeys = new aiVectorKey[keys.size()];
-            if (keys.size() > 0) {
-                InterpolateKeys(na->mScalingKeys, keys, inputs, aiVector3D(1.0f, 1.0f, 1.0f), maxTime, minTime);
-            }
+                na->mNumScalingKeys = static_cast<unsigned int>(keys.size());
+                na->mScalingKeys = new aiVectorKey[keys.size()];
+                if (keys.size() > 0) {
+                    InterpolateKeys(na->mScalingKeys, keys, inputs, aiVector3D(1.0f, 1.0f, 1.0f), maxTime, minTime);
+                }
+            });
         }
 
         void FBXConverter::ConvertTranslationKeys(aiNodeAnim* na, const std::vector<const AnimationCurveNode*>& nodes,
             const LayerMap& /*layers*/,
             int64_t start, int64_t stop,
-            double& maxTime,
-            double& minTime)
+            bool inverse)
         {
             ai_assert(nodes.size());
 
             // XXX see notes in ConvertScaleKeys()
-            const KeyFrameListList& inputs = GetKeyframeList(nodes, start, stop);
-            const KeyTimeList& keys = GetKeyTimeList(inputs);
-
-            na->mNumPositionKeys = static_cast<unsigned int>(keys.size());
-            na->mPositionKeys = new aiVectorKey[keys.size()];
-            if (keys.size() > 0)
-                InterpolateKeys(na->mPositionKeys, keys, inputs, aiVector3D(0.0f, 0.0f, 0.0f), maxTime, minTime);
+            const KeyFrameListList inputs = GetKeyframeList(nodes, start, stop);
+            ScheduleKeyConversion([this, na, inputs, inverse](double& maxTime, double& minTime) {
+                const KeyTimeList& keys = GetKeyTimeList(inputs);
+
+                na->mNumPositionKeys = static_cast<unsigned int>(keys.size());
+                na->mPositionKeys = new aiVectorKey[keys.size()];
+                if (keys.size() > 0)
+                    InterpolateKeys(na->mPositionKeys, keys, inputs, aiVector3D(0.0f, 0.0f, 0.0f), maxTime, minTime);
+
+                if (inverse) {
+                    for (unsigned int i = 0; i < na->mNumPositionKeys; ++i) {
+                        na->mPositionKeys[i].mValue *= -1.0f;
+                    }
+                }
+            });
         }
 
         void FBXConverter::ConvertRotationKeys(aiNodeAnim* na, const std::vector<const AnimationCurveNode*>& nodes,
             const LayerMap& /*layers*/,
             int64_t start, int64_t stop,
-            double& maxTime,
-            double& minTime,
             Model::RotOrder order)
         {
             ai_assert(nodes.size());
 
             // XXX see notes in ConvertScaleKeys()
-            const std::vector< KeyFrameList >& inputs = GetKeyframeList(nodes, start, stop);
-            const KeyTimeList& keys = GetKeyTimeList(inputs);
+            const KeyFrameListList inputs = GetKeyframeList(nodes, start, stop);
+            ScheduleKeyConversion([this, na, inputs, order](double& maxTime, double& minTime) {
+                const KeyTimeList& keys = GetKeyTimeList(inputs);
+
+                na->mNumRotationKeys = static_cast<unsigned int>(keys.size());
+                na->mRotationKeys = new aiQuatKey[keys.size()];
+                if (!keys.empty()) {
+                    InterpolateKeys(na->mRotationKeys, keys, inputs, aiVector3D(0.0f, 0.0f, 0.0f), maxTime, minTime, order);
+                }
+            }, order != Model::RotOrder_SphericXYZ);
+        }
+
+        void FBXConverter::ScheduleKeyConversion(const KeyConversion& conversion, bool concurrent)
+        {
+            KeyConversionJob job;
+            job.conversion = conversion;
+            job.concurrent = concurrent;
+            key_conversion_jobs.push_back(job);
+        }
+
+        void FBXConverter::ConvertScheduledKeys(double& max_time, double& min_time)
+        {
+            std::vector<KeyConversionJob> jobs;
+            jobs.swap(key_conversion_jobs);
+
+            // every job tracks its own time range, min and max give the same result in any order
+            std::vector<double> max_times(jobs.size(), max_time);
+            std::vector<double> min_times(jobs.size(), min_time);
 
-            na->mNumRotationKeys = static_cast<unsigned int>(keys.size());
-            na->mRotationKeys = new aiQuatKey[keys.size()];
-            if (!keys.empty()) {
-                InterpolateKeys(na->mRotationKeys, keys, inputs, aiVector3D(0.0f, 0.0f, 0.0f), maxTime, minTime, order);
+            ParallelFor(jobs.size(), [&](size_t i) {
+                if (jobs[i].concurrent) {
+                    jobs[i].conversion(max_times[i], min_times[i]);
+                }
+            });
+
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                if (!jobs[i].concurrent) {
+                    jobs[i].conversion(max_times[i], min_times[i]);
+                }
+                max_time = std::max(max_time, max_times[i]);
+                min_time = std::min(min_time, min_times[i]);
             }
         }
 
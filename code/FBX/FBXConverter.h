@@ -59,6 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/texture.h>
 #include <assimp/camera.h>
 #include <assimp/StringComparison.h>
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -303,13 +304,12 @@ private:
     void ProcessMorphAnimDatas(std::map<std::string, morphAnimData*>* morphAnimDatas, const BlendShapeChannel* bsc, const AnimationCurveNode* node);
 
     // ------------------------------------------------------------------------------------------------
+    // the keys of the generated channels are filled in by ConvertScheduledKeys()
     void GenerateNodeAnimations(std::vector<aiNodeAnim*>& node_anims,
         const std::string& fixed_name,
         const std::vector<const AnimationCurveNode*>& curves,
         const LayerMap& layer_map,
-        int64_t start, int64_t stop,
-        double& max_time,
-        double& min_time);
+        int64_t start, int64_t stop);
 
     // ------------------------------------------------------------------------------------------------
     bool IsRedundantAnimationData(const Model& target,
@@ -321,18 +321,14 @@ private:
         const Model& target,
         const std::vector<const AnimationCurveNode*>& curves,
         const LayerMap& layer_map,
-        int64_t start, int64_t stop,
-        double& max_time,
-        double& min_time);
+        int64_t start, int64_t stop);
 
     // ------------------------------------------------------------------------------------------------
     aiNodeAnim* GenerateScalingNodeAnim(const std::string& name,
         const Model& /*target*/,
         const std::vector<const AnimationCurveNode*>& curves,
         const LayerMap& layer_map,
-        int64_t start, int64_t stop,
-        double& max_time,
-        double& min_time);
+        int64_t start, int64_t stop);
 
     // ------------------------------------------------------------------------------------------------
     aiNodeAnim* GenerateTranslationNodeAnim(const std::string& name,
@@ -340,8 +336,6 @@ private:
         const std::vector<const AnimationCurveNode*>& curves,
         const LayerMap& layer_map,
         int64_t start, int64_t stop,
-        double& max_time,
-        double& min_time,
         bool inverse = false);
 
     // ------------------------------------------------------------------------------------------------
@@ -352,8 +346,6 @@ private:
         NodeMap::const_iterator iter_end,
         const LayerMap& layer_map,
         int64_t start, int64_t stop,
-        double& max_time,
-        double& min_time,
         bool reverse_order = false);
 
     // key (time), value, mapto (component index)
@@ -364,6 +356,7 @@ private:
     KeyFrameListList GetKeyframeList(const std::vector<const AnimationCurveNode*>& nodes, int64_t start, int64_t stop);
 
     // ------------------------------------------------------------------------------------------------
+    // merges the key times of all inputs into one ascending list without duplicates
     KeyTimeList GetKeyTimeList(const KeyFrameListList& inputs);
 
     // ------------------------------------------------------------------------------------------------
@@ -398,26 +391,36 @@ private:
     aiQuaternion EulerToQuaternion(const aiVector3D& rot, Model::RotOrder order);
 
     // ------------------------------------------------------------------------------------------------
+    // the Convert*Keys() functions only gather the key frames, the keys themselves are
+    // interpolated by a job run in ConvertScheduledKeys()
     void ConvertScaleKeys(aiNodeAnim* na, const std::vector<const AnimationCurveNode*>& nodes, const LayerMap& /*layers*/,
-        int64_t start, int64_t stop,
-        double& maxTime,
-        double& minTime);
+        int64_t start, int64_t stop);
 
     // ------------------------------------------------------------------------------------------------
     void ConvertTranslationKeys(aiNodeAnim* na, const std::vector<const AnimationCurveNode*>& nodes,
         const LayerMap& /*layers*/,
         int64_t start, int64_t stop,
-        double& maxTime,
-        double& minTime);
+        bool inverse = false);
 
     // ------------------------------------------------------------------------------------------------
     void ConvertRotationKeys(aiNodeAnim* na, const std::vector<const AnimationCurveNode*>& nodes,
         const LayerMap& /*layers*/,
         int64_t start, int64_t stop,
-        double& maxTime,
-        double& minTime,
         Model::RotOrder order);
 
+    // ------------------------------------------------------------------------------------------------
+    // key interpolation of a node animation channel, updating the time range of the animation
+    using KeyConversion = std::function<void(double& max_time, double& min_time)>;
+
+    // ------------------------------------------------------------------------------------------------
+    // queues a key interpolation job. Jobs that may log (i.e. unsupported rotation orders) must
+    // not be concurrent, the logger is not thread-safe in all builds.
+    void ScheduleKeyConversion(const KeyConversion& conversion, bool concurrent = true);
+
+    // ------------------------------------------------------------------------------------------------
+    // runs all queued jobs, spread over all cores, and merges their time ranges
+    void ConvertScheduledKeys(double& max_time, double& min_time);
+
     void ConvertGlobalSettings();
 
     // ------------------------------------------------------------------------------------------------
@@ -448,6 +451,13 @@ private:
     using NodeAnimBitMap = std::map<std::string, unsigned int> ;
     NodeAnimBitMap node_anim_chain_bits;
 
+    // key interpolation jobs of the animation stack being converted
+    struct KeyConversionJob {
+        KeyConversion conversion;
+        bool concurrent;
+    };
+    std::vector<KeyConversionJob> key_conversion_jobs;
+
     // number of nodes with the same name
     using NodeNameCache = std::unordered_map<std::string, unsigned int>;
     NodeNameCache mNodeNames;
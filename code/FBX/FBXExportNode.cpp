@@ -48,6 +48,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exceptional.h> // DeadlyExportError
 #include <assimp/ai_assert.h>
 #include <assimp/StringUtils.h> // ai_snprintf
+#include <assimp/ByteSwapper.h>
+
+#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
+#   include <zlib.h>
+#else
+#   include "../contrib/zlib/zlib.h"
+#endif
 
 #include <string>
 #include <ostream>
@@ -55,6 +62,59 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <memory> // shared_ptr
 
 namespace Assimp {
+
+namespace {
+
+template <typename T>
+void CompressArrayData(
+    const std::vector<T>& v,
+    size_t threshold,
+    FBX::CompressedArray& out
+){
+    out.count = uint32_t(v.size());
+    out.data.clear();
+    const size_t raw_size = v.size() * sizeof(T);
+    if (threshold == 0 || raw_size < threshold) { return; }
+
+    // array elements are little-endian, inside the zip stream too
+#ifdef AI_BUILD_BIG_ENDIAN
+    std::vector<T> swapped(v);
+    for (T& x : swapped) { ByteSwap::Swap(&x); }
+    const T* src = swapped.data();
+#else
+    const T* src = v.data();
+#endif
+
+    uLongf size = compressBound(uLong(raw_size));
+    out.data.resize(size);
+    const int res = compress2(
+        out.data.data(), &size,
+        reinterpret_cast<const Bytef*>(src), uLong(raw_size),
+        Z_DEFAULT_COMPRESSION
+    );
+    if (res != Z_OK || size >= raw_size) {
+        // not worth it, store the array as it is
+        std::vector<uint8_t>().swap(out.data);
+        return;
+    }
+    out.data.resize(size);
+    out.data.shrink_to_fit();
+}
+
+} // namespace
+
+void FBX::CompressArray(
+    const std::vector<double>& v, size_t threshold, CompressedArray& out
+) {
+    CompressArrayData(v, threshold, out);
+}
+
+void FBX::CompressArray(
+    const std::vector<int32_t>& v, size_t threshold, CompressedArray& out
+) {
+    CompressArrayData(v, threshold, out);
+}
+
 // AddP70<type> helpers... there's no usable pattern here,
 // so all are defined as separate functions.
 // Even "animatable" properties are often completely different
@@ -498,7 +558,6 @@ void FBX::Node::WritePropertyNodeAscii(
 }
 
 // binary property node from vector of doubles
-// TODO: optional zip compression!
 void FBX::Node::WritePropertyNodeBinary(
     const std::string& name,
     const std::vector<double>& v,
@@ -516,7 +575,6 @@ void FBX::Node::WritePropertyNodeBinary(
 }
 
 // binary property node from vector of int32_t
-// TODO: optional zip compression!
 void FBX::Node::WritePropertyNodeBinary(
     const std::string& name,
     const std::vector<int32_t>& v,
@@ -533,6 +591,24 @@ void FBX::Node::WritePropertyNodeBinary(
     node.EndBinary(s, false);
 }
 
+// binary property node from a zip-compressed array
+void FBX::Node::WritePropertyNodeBinary(
+    const std::string& name,
+    char type,
+    const CompressedArray& compressed,
+    Assimp::StreamWriterLE& s
+){
+    FBX::Node node(name);
+    node.BeginBinary(s);
+    s.PutU1(type);
+    s.PutU4(compressed.count); // number of elements
+    s.PutU4(1); // zip encoding
+    s.PutU4(uint32_t(compressed.data.size())); // compressed data size
+    for (auto it = compressed.data.begin(); it != compressed.data.end(); ++it) { s.PutU1(*it); }
+    node.EndPropertiesBinary(s, 1);
+    node.EndBinary(s, false);
+}
+
 // public static member functions
 
 // convenience function to create and write a property node,
@@ -566,6 +642,38 @@ void FBX::Node::WritePropertyNode(
         FBX::Node::WritePropertyNodeAscii(name, v, s, indent);
     }
 }
+
+// convenience function to write an array property node,
+// using the compressed data if there is any.
+void FBX::Node::WritePropertyNode(
+    const std::string& name,
+    const std::vector<double>& v,
+    const CompressedArray& compressed,
+    Assimp::StreamWriterLE& s,
+    bool binary, int indent
+){
+    if (binary && !compressed.data.empty()) {
+        FBX::Node::WritePropertyNodeBinary(name, 'd', compressed, s);
+    } else {
+        FBX::Node::WritePropertyNode(name, v, s, binary, indent);
+    }
+}
+
+// convenience function to write an array property node,
+// using the compressed data if there is any.
+void FBX::Node::WritePropertyNode(
+    const std::string& name,
+    const std::vector<int32_t>& v,
+    const CompressedArray& compressed,
+    Assimp::StreamWriterLE& s,
+    bool binary, int indent
+){
+    if (binary && !compressed.data.empty()) {
+        FBX::Node::WritePropertyNodeBinary(name, 'i', compressed, s);
+    } else {
+        FBX::Node::WritePropertyNode(name, v, s, binary, indent);
+    }
+}
 }
 #endif // ASSIMP_BUILD_NO_FBX_EXPORTER
 #endif // ASSIMP_BUILD_NO_EXPORT
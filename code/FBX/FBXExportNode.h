@@ -57,6 +57,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace Assimp {
 namespace FBX {
     class Node;
+
+    /** zlib compressed payload of an array property.
+     *  Compression is by far the most expensive part of writing a large
+     *  array, so the exporter runs it ahead of the sequential write pass. */
+    struct CompressedArray {
+        uint32_t count = 0; // number of elements
+        std::vector<uint8_t> data; // zlib stream, empty if stored uncompressed
+    };
+
+    // compresses v into out if its raw size is at least threshold bytes
+    // and compression actually saves space. a threshold of 0 disables it.
+    void CompressArray(const std::vector<double>& v, size_t threshold, CompressedArray& out);
+    void CompressArray(const std::vector<int32_t>& v, size_t threshold, CompressedArray& out);
 }
 
 class FBX::Node {
@@ -239,6 +252,23 @@ public: // static member functions
         bool binary, int indent
     );
 
+    // same as above, but writes the compressed payload instead
+    // if there is one and the file is binary.
+    static void WritePropertyNode(
+        const std::string& name,
+        const std::vector<double>& v,
+        const CompressedArray& compressed,
+        Assimp::StreamWriterLE& s,
+        bool binary, int indent
+    );
+    static void WritePropertyNode(
+        const std::string& name,
+        const std::vector<int32_t>& v,
+        const CompressedArray& compressed,
+        Assimp::StreamWriterLE& s,
+        bool binary, int indent
+    );
+
 private: // static helper functions
     static void WritePropertyNodeAscii(
         const std::string& name,
@@ -262,6 +292,12 @@ private: // static helper functions
         const std::vector<int32_t>& v,
         Assimp::StreamWriterLE& s
     );
+    static void WritePropertyNodeBinary(
+        const std::string& name,
+        char type,
+        const CompressedArray& compressed,
+        Assimp::StreamWriterLE& s
+    );
 
 };
 }
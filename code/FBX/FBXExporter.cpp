@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXExportProperty.h"
 #include "FBXCommon.h"
 #include "FBXUtil.h"
+#include "Common/ParallelFor.h"
+#include "Common/SceneNameIndex.h"
 
 #include <assimp/version.h> // aiGetVersion
 #include <assimp/IOSystem.hpp>
@@ -56,6 +58,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/material.h> // aiTextureType
 #include <assimp/scene.h>
 #include <assimp/mesh.h>
+#include <assimp/config.h>
 
 // Header files, standard library.
 #include <memory> // shared_ptr
@@ -68,6 +71,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <array>
 #include <unordered_set>
 #include <numeric>
+#include <algorithm>
 
 // RESOURCES:
 // https://code.blender.org/2013/08/fbx-binary-file-format-specification/
@@ -133,6 +137,167 @@ namespace FBX {
 
 } // end of namespace Assimp
 
+namespace {
+
+// the large arrays of one "Geometry" object, built (and compressed)
+// for all meshes ahead of the sequential write pass.
+struct GeometryArrays {
+    std::vector<double> vertices;
+    std::vector<int32_t> vertex_indices; // index of original vertex in vertices
+    std::vector<int32_t> polygon_data;
+    std::vector<double> normals;
+    std::vector<double> colors;
+    std::vector<std::vector<double>> uvs;
+    std::vector<std::vector<int32_t>> uv_indices;
+
+    FBX::CompressedArray z_vertices;
+    FBX::CompressedArray z_polygon_data;
+    FBX::CompressedArray z_normals;
+    FBX::CompressedArray z_colors;
+    std::vector<FBX::CompressedArray> z_uvs;
+    std::vector<FBX::CompressedArray> z_uv_indices;
+};
+
+void BuildGeometryArrays(
+    const aiMesh* m,
+    bool bJoinIdenticalVertices,
+    GeometryArrays& g
+){
+    // output vertex data - each vertex should be unique (probably)
+    // map of vertex value to its index in the data vector
+    std::map<aiVector3D,size_t> index_by_vertex_value;
+    if(bJoinIdenticalVertices){
+        int32_t index = 0;
+        for (size_t vi = 0; vi < m->mNumVertices; ++vi) {
+            aiVector3D vtx = m->mVertices[vi];
+            auto elem = index_by_vertex_value.find(vtx);
+            if (elem == index_by_vertex_value.end()) {
+                g.vertex_indices.push_back(index);
+                index_by_vertex_value[vtx] = index;
+                g.vertices.push_back(vtx[0]);
+                g.vertices.push_back(vtx[1]);
+                g.vertices.push_back(vtx[2]);
+                ++index;
+            } else {
+                g.vertex_indices.push_back(int32_t(elem->second));
+            }
+        }
+    }
+    else { // do not join vertex, respect the export flag
+        g.vertex_indices.resize(m->mNumVertices);
+        std::iota(g.vertex_indices.begin(), g.vertex_indices.end(), 0);
+        for(unsigned int v = 0; v < m->mNumVertices; ++ v) {
+            aiVector3D vtx = m->mVertices[v];
+            g.vertices.push_back(vtx.x);
+            g.vertices.push_back(vtx.y);
+            g.vertices.push_back(vtx.z);
+        }
+    }
+
+    // output polygon data as a flattened array of vertex indices.
+    // the last vertex index of each polygon is negated and - 1
+    for (size_t fi = 0; fi < m->mNumFaces; ++fi) {
+        const aiFace &f = m->mFaces[fi];
+        for (size_t pvi = 0; pvi < f.mNumIndices - 1; ++pvi) {
+            g.polygon_data.push_back(g.vertex_indices[f.mIndices[pvi]]);
+        }
+        g.polygon_data.push_back(
+            -1 - g.vertex_indices[f.mIndices[f.mNumIndices-1]]
+        );
+    }
+
+    // normals, if any
+    if (m->HasNormals()) {
+        g.normals.reserve(3 * g.polygon_data.size());
+        for (size_t fi = 0; fi < m->mNumFaces; ++fi) {
+            const aiFace &f = m->mFaces[fi];
+            for (size_t pvi = 0; pvi < f.mNumIndices; ++pvi) {
+                const aiVector3D &n = m->mNormals[f.mIndices[pvi]];
+                g.normals.push_back(n.x);
+                g.normals.push_back(n.y);
+                g.normals.push_back(n.z);
+            }
+        }
+    }
+
+    // colors, if any
+    // TODO only one color channel currently
+    const int32_t colorChannelIndex = 0;
+    if (m->HasVertexColors(colorChannelIndex)) {
+        g.colors.reserve(4 * g.polygon_data.size());
+        for (size_t fi = 0; fi < m->mNumFaces; ++fi) {
+            const aiFace &f = m->mFaces[fi];
+            for (size_t pvi = 0; pvi < f.mNumIndices; ++pvi) {
+                const aiColor4D &c = m->mColors[colorChannelIndex][f.mIndices[pvi]];
+                g.colors.push_back(c.r);
+                g.colors.push_back(c.g);
+                g.colors.push_back(c.b);
+                g.colors.push_back(c.a);
+            }
+        }
+    }
+
+    // uvs, if any
+    g.uvs.resize(m->GetNumUVChannels());
+    g.uv_indices.resize(m->GetNumUVChannels());
+    for (size_t uvi = 0; uvi < m->GetNumUVChannels(); ++uvi) {
+        std::vector<double>& uv_data = g.uvs[uvi];
+        std::vector<int32_t>& uv_indices = g.uv_indices[uvi];
+        std::map<aiVector3D,int32_t> index_by_uv;
+        int32_t index = 0;
+        for (size_t fi = 0; fi < m->mNumFaces; ++fi) {
+            const aiFace &f = m->mFaces[fi];
+            for (size_t pvi = 0; pvi < f.mNumIndices; ++pvi) {
+                const aiVector3D &uv =
+                    m->mTextureCoords[uvi][f.mIndices[pvi]];
+                auto elem = index_by_uv.find(uv);
+                if (elem == index_by_uv.end()) {
+                    index_by_uv[uv] = index;
+                    uv_indices.push_back(index);
+                    for (unsigned int x = 0; x < m->mNumUVComponents[uvi]; ++x) {
+                        uv_data.push_back(uv[x]);
+                    }
+                    ++index;
+                } else {
+                    uv_indices.push_back(elem->second);
+                }
+            }
+        }
+    }
+    g.z_uvs.resize(g.uvs.size());
+    g.z_uv_indices.resize(g.uv_indices.size());
+}
+
+// compresses all large geometry arrays of the scene. each array is
+// independent of all others, so they are spread across all threads.
+void CompressGeometryArrays(
+    std::vector<GeometryArrays>& geometry,
+    size_t threshold
+){
+    std::vector<std::pair<const std::vector<double>*, FBX::CompressedArray*>> doubles;
+    std::vector<std::pair<const std::vector<int32_t>*, FBX::CompressedArray*>> ints;
+    for (GeometryArrays& g : geometry) {
+        doubles.emplace_back(&g.vertices, &g.z_vertices);
+        ints.emplace_back(&g.polygon_data, &g.z_polygon_data);
+        doubles.emplace_back(&g.normals, &g.z_normals);
+        doubles.emplace_back(&g.colors, &g.z_colors);
+        for (size_t i = 0; i < g.uvs.size(); ++i) {
+            doubles.emplace_back(&g.uvs[i], &g.z_uvs[i]);
+            ints.emplace_back(&g.uv_indices[i], &g.z_uv_indices[i]);
+        }
+    }
+    ParallelFor(doubles.size() + ints.size(), [&](size_t i) {
+        if (i < doubles.size()) {
+            FBX::CompressArray(*doubles[i].first, threshold, *doubles[i].second);
+        } else {
+            i -= doubles.size();
+            FBX::CompressArray(*ints[i].first, threshold, *ints[i].second);
+        }
+    });
+}
+
+} // namespace
+
 FBXExporter::FBXExporter ( const aiScene* pScene, const ExportProperties* pProperties )
 : binary(false)
 , mScene(pScene)
@@ -1007,7 +1172,20 @@ void FBXExporter::WriteObjects ()
     object_node.BeginChildren(outstream, binary, indent);
 
     bool bJoinIdenticalVertices = mProperties->GetPropertyBool("bJoinIdenticalVertices", true);
-    std::vector<std::vector<int32_t>> vVertexIndice;//save vertex_indices as it is needed later
+
+    // build the large arrays of all meshes first, they are needed later
+    // (vertex indices for the skin deformers) and take most of the time.
+    std::vector<GeometryArrays> geometry(mScene->mNumMeshes);
+    ParallelFor(mScene->mNumMeshes, [&](size_t mi) {
+        BuildGeometryArrays(mScene->mMeshes[mi], bJoinIdenticalVertices, geometry[mi]);
+    });
+    if (binary) {
+        const int threshold = mProperties->GetPropertyInteger(
+            AI_CONFIG_EXPORT_FBX_COMPRESSION_THRESHOLD,
+            AI_FBX_DEFAULT_COMPRESSION_THRESHOLD
+        );
+        CompressGeometryArrays(geometry, size_t(std::max(threshold, 0)));
+    }
 
     // geometry (aiMesh)
     mesh_uids.clear();
@@ -1015,6 +1193,7 @@ void FBXExporter::WriteObjects ()
     for (size_t mi = 0; mi < mScene->mNumMeshes; ++mi) {
         // it's all about this mesh
         aiMesh* m = mScene->mMeshes[mi];
+        const GeometryArrays& g = geometry[mi];
 
         // start the node record
         FBX::Node n("Geometry");
@@ -1029,59 +1208,13 @@ void FBXExporter::WriteObjects ()
         n.BeginChildren(outstream, binary, indent);
         indent = 2;
 
-        // output vertex data - each vertex should be unique (probably)
-        std::vector<double> flattened_vertices;
-        // index of original vertex in vertex data vector
-        std::vector<int32_t> vertex_indices;
-        // map of vertex value to its index in the data vector
-        std::map<aiVector3D,size_t> index_by_vertex_value;
-        if(bJoinIdenticalVertices){
-            int32_t index = 0;
-            for (size_t vi = 0; vi < m->mNumVertices; ++vi) {
-                aiVector3D vtx = m->mVertices[vi];
-                auto elem = index_by_vertex_value.find(vtx);
-                if (elem == index_by_vertex_value.end()) {
-                    vertex_indices.push_back(index);
-                    index_by_vertex_value[vtx] = index;
-                    flattened_vertices.push_back(vtx[0]);
-                    flattened_vertices.push_back(vtx[1]);
-                    flattened_vertices.push_back(vtx[2]);
-                    ++index;
-                } else {
-                    vertex_indices.push_back(int32_t(elem->second));
-                }
-            }
-        }
-        else { // do not join vertex, respect the export flag
-            vertex_indices.resize(m->mNumVertices);
-            std::iota(vertex_indices.begin(), vertex_indices.end(), 0);
-            for(unsigned int v = 0; v < m->mNumVertices; ++ v) {
-                aiVector3D vtx = m->mVertices[v];
-                flattened_vertices.push_back(vtx.x);
-                flattened_vertices.push_back(vtx.y);
-                flattened_vertices.push_back(vtx.z);
-            }
-        }
-        vVertexIndice.push_back(vertex_indices);
-
         FBX::Node::WritePropertyNode(
-            "Vertices", flattened_vertices, outstream, binary, indent
+            "Vertices", g.vertices, g.z_vertices, outstream, binary, indent
         );
 
-        // output polygon data as a flattened array of vertex indices.
-        // the last vertex index of each polygon is negated and - 1
-        std::vector<int32_t> polygon_data;
-        for (size_t fi = 0; fi < m->mNumFaces; ++fi) {
-            const aiFace &f = m->mFaces[fi];
-            for (size_t pvi = 0; pvi < f.mNumIndices - 1; ++pvi) {
-                polygon_data.push_back(vertex_indices[f.mIndices[pvi]]);
-            }
-            polygon_data.push_back(
-                -1 - vertex_indices[f.mIndices[f.mNumIndices-1]]
-            );
-        }
         FBX::Node::WritePropertyNode(
-            "PolygonVertexIndex", polygon_data, outstream, binary, indent
+            "PolygonVertexIndex", g.polygon_data, g.z_polygon_data,
+            outstream, binary, indent
         );
 
         // here could be edges but they're insane.
@@ -1114,19 +1247,8 @@ void FBXExporter::WriteObjects ()
                 "ReferenceInformationType", "Direct",
                 outstream, binary, indent
             );
-            std::vector<double> normal_data;
-            normal_data.reserve(3 * polygon_data.size());
-            for (size_t fi = 0; fi < m->mNumFaces; ++fi) {
-                const aiFace &f = m->mFaces[fi];
-                for (size_t pvi = 0; pvi < f.mNumIndices; ++pvi) {
-                    const aiVector3D &n = m->mNormals[f.mIndices[pvi]];
-                    normal_data.push_back(n.x);
-                    normal_data.push_back(n.y);
-                    normal_data.push_back(n.z);
-                }
-            }
             FBX::Node::WritePropertyNode(
-                "Normals", normal_data, outstream, binary, indent
+                "Normals", g.normals, g.z_normals, outstream, binary, indent
             );
             // note: version 102 has a NormalsW also... not sure what it is,
             // so we can stick with version 101 for now.
@@ -1160,20 +1282,8 @@ void FBXExporter::WriteObjects ()
                 "ReferenceInformationType", "Direct",
                 outstream, binary, indent
             );
-            std::vector<double> color_data;
-            color_data.reserve(4 * polygon_data.size());
-            for (size_t fi = 0; fi < m->mNumFaces; ++fi) {
-                const aiFace &f = m->mFaces[fi];
-                for (size_t pvi = 0; pvi < f.mNumIndices; ++pvi) {
-                    const aiColor4D &c = m->mColors[colorChannelIndex][f.mIndices[pvi]];
-                    color_data.push_back(c.r);
-                    color_data.push_back(c.g);
-                    color_data.push_back(c.b);
-                    color_data.push_back(c.a);
-                }
-            }
             FBX::Node::WritePropertyNode(
-                "Colors", color_data, outstream, binary, indent
+                "Colors", g.colors, g.z_colors, outstream, binary, indent
             );
             indent = 2;
             vertexcolors.End(outstream, binary, indent, true);
@@ -1219,33 +1329,12 @@ void FBXExporter::WriteObjects ()
                 outstream, binary, indent
             );
 
-            std::vector<double> uv_data;
-            std::vector<int32_t> uv_indices;
-            std::map<aiVector3D,int32_t> index_by_uv;
-            int32_t index = 0;
-            for (size_t fi = 0; fi < m->mNumFaces; ++fi) {
-                const aiFace &f = m->mFaces[fi];
-                for (size_t pvi = 0; pvi < f.mNumIndices; ++pvi) {
-                    const aiVector3D &uv =
-                        m->mTextureCoords[uvi][f.mIndices[pvi]];
-                    auto elem = index_by_uv.find(uv);
-                    if (elem == index_by_uv.end()) {
-                        index_by_uv[uv] = index;
-                        uv_indices.push_back(index);
-                        for (unsigned int x = 0; x < m->mNumUVComponents[uvi]; ++x) {
-                            uv_data.push_back(uv[x]);
-                        }
-                        ++index;
-                    } else {
-                        uv_indices.push_back(elem->second);
-                    }
-                }
-            }
             FBX::Node::WritePropertyNode(
-                "UV", uv_data, outstream, binary, indent
+                "UV", g.uvs[uvi], g.z_uvs[uvi], outstream, binary, indent
             );
             FBX::Node::WritePropertyNode(
-                "UVIndex", uv_indices, outstream, binary, indent
+                "UVIndex", g.uv_indices[uvi], g.z_uv_indices[uvi],
+                outstream, binary, indent
             );
             indent = 2;
             uv.End(outstream, binary, indent, true);
@@ -1719,7 +1808,7 @@ void FBXExporter::WriteObjects ()
             if (elem != node_by_bone.end()) {
                 n = elem->second;
             } else {
-                n = mScene->mRootNode->FindNode(b->mName);
+                n = GetSceneNameIndex(mScene).FindNode(b->mName);
                 if (!n) {
                     // this should never happen
                     std::stringstream err;
@@ -1817,7 +1906,7 @@ void FBXExporter::WriteObjects ()
         connections.emplace_back("C", "OO", deformer_uid, mesh_uids[mi]);
 
         //computed before
-        std::vector<int32_t>& vertex_indices = vVertexIndice[mi];
+        const std::vector<int32_t>& vertex_indices = geometry[mi].vertex_indices;
 
         // TODO, FIXME: this won't work if anything is not in the bind pose.
         // for now if such a situation is detected, we throw an exception.
@@ -2114,7 +2203,7 @@ void FBXExporter::WriteObjects ()
         for (size_t nai = 0; nai < anim->mNumChannels; ++nai) {
             const aiNodeAnim* na = anim->mChannels[nai];
             // get the corresponding aiNode
-            const aiNode* node = mScene->mRootNode->FindNode(na->mNodeName);
+            const aiNode* node = GetSceneNameIndex(mScene).FindNode(na->mNodeName);
             // and its transform
             const aiMatrix4x4 node_xfm = get_world_transform(node, mScene);
             aiVector3D T, R, S;
@@ -2158,7 +2247,7 @@ void FBXExporter::WriteObjects ()
         for (size_t nai = 0; nai < anim->mNumChannels; ++nai) {
             const aiNodeAnim* na = anim->mChannels[nai];
             // get the corresponding aiNode
-            const aiNode* node = mScene->mRootNode->FindNode(na->mNodeName);
+            const aiNode* node = GetSceneNameIndex(mScene).FindNode(na->mNodeName);
             // and its transform
             const aiMatrix4x4 node_xfm = get_world_transform(node, mScene);
             aiVector3D T, R, S;
@@ -53,8 +53,178 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Macros.h>
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/*  Lazily built key index for materials with many properties.
+ *
+ *  Loaders and SceneCombiner fill mProperties directly, sometimes in place. The index
+ *  therefore keeps a snapshot of the property pointers it was built for: a hit is only
+ *  taken if its slot still holds the indexed property with the requested key, a miss
+ *  only if the property array still matches the snapshot. Otherwise the index is
+ *  extended (if properties were just appended) or rebuilt.
+ *  The indices live in a side table keyed by the material, so the layout of the C struct
+ *  stays untouched. The table is split into shards to keep lookups of different materials
+ *  from contending for a single lock; the destructor of aiMaterial drops the entry.
+ *  Slots are kept in ascending order per key, so lookups return exactly the same
+ *  property as a linear scan would. The mutex only guards the lazy build against
+ *  concurrent lookups of the same material. */
+const unsigned int MaterialKeyIndexThreshold = 16;
+
+struct MaterialKeyIndex {
+    std::mutex mMutex;
+    std::vector<aiMaterialProperty*> mProperties;
+    std::unordered_map<uint32_t, std::vector<unsigned int> > mSlots;
+};
+
+const unsigned int MaterialKeyIndexShards = 32;
+
+struct MaterialKeyIndexShard {
+    std::mutex mMutex;
+    std::unordered_map<const aiMaterial*, std::unique_ptr<MaterialKeyIndex> > mIndices;
+};
+
+inline MaterialKeyIndexShard& GetMaterialKeyIndexShard(const aiMaterial* pMat) {
+    // never destroyed, materials may still be released during static destruction
+    static MaterialKeyIndexShard* shards = new MaterialKeyIndexShard[MaterialKeyIndexShards];
+    return shards[(reinterpret_cast<uintptr_t>(pMat) / sizeof(aiMaterial)) % MaterialKeyIndexShards];
+}
+
+// ------------------------------------------------------------------------------------------------
+/*  Returns the index of a material or NULL if there is none and bCreate is false.
+ *  The index stays valid until the material is destroyed. */
+MaterialKeyIndex* GetMaterialKeyIndex(const aiMaterial* pMat, bool bCreate) {
+    MaterialKeyIndexShard& shard = GetMaterialKeyIndexShard(pMat);
+    std::lock_guard<std::mutex> lock(shard.mMutex);
+    const auto it = shard.mIndices.find(pMat);
+    if (it != shard.mIndices.end()) {
+        return it->second.get();
+    }
+    if (!bCreate) {
+        return NULL;
+    }
+    MaterialKeyIndex* idx = new MaterialKeyIndex();
+    shard.mIndices[pMat].reset(idx);
+    return idx;
+}
+
+inline uint32_t HashMaterialKey(const char* pKey, size_t len) {
+    return SuperFastHash(pKey, static_cast<uint32_t>(len));
+}
+
+// ------------------------------------------------------------------------------------------------
+/*  Brings the index up to date with the property array of the material. */
+void UpdateMaterialKeyIndex(const aiMaterial* pMat, MaterialKeyIndex& idx) {
+    const size_t numIndexed = idx.mProperties.size();
+    if (numIndexed > pMat->mNumProperties ||
+            (numIndexed && 0 != memcmp(&idx.mProperties[0], pMat->mProperties, numIndexed * sizeof(aiMaterialProperty*)))) {
+        idx.mProperties.clear();
+        idx.mSlots.clear();
+    }
+    for (unsigned int i = static_cast<unsigned int>(idx.mProperties.size()); i < pMat->mNumProperties; ++i) {
+        aiMaterialProperty* prop = pMat->mProperties[i];
+        idx.mProperties.push_back(prop);
+        if (prop) {
+            idx.mSlots[HashMaterialKey(prop->mKey.data, prop->mKey.length)].push_back(i);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+/*  Searches the indexed slots of a key, returns false if a slot is out of date. */
+bool FindMaterialKeySlot(const aiMaterial* pMat, const MaterialKeyIndex& idx, uint32_t hash, const char* pKey,
+        unsigned int type, unsigned int index, unsigned int& slot) {
+    slot = UINT_MAX;
+    const std::unordered_map<uint32_t, std::vector<unsigned int> >::const_iterator bucket = idx.mSlots.find(hash);
+    if (bucket == idx.mSlots.end()) {
+        return true;
+    }
+    for (unsigned int i : bucket->second) {
+        const aiMaterialProperty* prop = i < pMat->mNumProperties ? pMat->mProperties[i] : NULL;
+        if (prop != idx.mProperties[i]) {
+            return false;
+        }
+        if (prop
+            && 0 == strcmp( prop->mKey.data, pKey )
+            && (UINT_MAX == type  || prop->mSemantic == type)
+            && (UINT_MAX == index || prop->mIndex == index)) {
+            slot = i;
+            return true;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+/*  Find the first slot holding a property with the given key, semantic and index.
+ *  Returns false if the material is too small to be indexed, the caller should
+ *  fall back to a linear scan then. */
+bool FindIndexedMaterialSlot(const aiMaterial* pMat, const char* pKey,
+        unsigned int type, unsigned int index, unsigned int& slot) {
+    if (pMat->mNumProperties < MaterialKeyIndexThreshold) {
+        return false;
+    }
+
+    MaterialKeyIndex& idx = *GetMaterialKeyIndex(pMat, true);
+    std::lock_guard<std::mutex> lock(idx.mMutex);
+    const uint32_t hash = HashMaterialKey(pKey, ::strlen(pKey));
+    if (FindMaterialKeySlot(pMat, idx, hash, pKey, type, index, slot) && UINT_MAX != slot) {
+        return true;
+    }
+
+    // a miss is only reliable if no property was added or replaced behind our back
+    UpdateMaterialKeyIndex(pMat, idx);
+    FindMaterialKeySlot(pMat, idx, hash, pKey, type, index, slot);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+/*  Called after the property in a slot has been replaced or appended. */
+void SetMaterialKeyIndexSlot(const aiMaterial* pMat, unsigned int slot) {
+    MaterialKeyIndex* pIdx = GetMaterialKeyIndex(pMat, false);
+    if (NULL == pIdx) {
+        return;
+    }
+    MaterialKeyIndex& idx = *pIdx;
+    std::lock_guard<std::mutex> lock(idx.mMutex);
+    if (slot < idx.mProperties.size()) {
+        // the key stays the same, so does its slot
+        idx.mProperties[slot] = pMat->mProperties[slot];
+    } else if (slot == idx.mProperties.size() && !idx.mProperties.empty()) {
+        aiMaterialProperty* prop = pMat->mProperties[slot];
+        idx.mProperties.push_back(prop);
+        idx.mSlots[HashMaterialKey(prop->mKey.data, prop->mKey.length)].push_back(slot);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InvalidateMaterialKeyIndex(const aiMaterial* pMat) {
+    MaterialKeyIndex* pIdx = GetMaterialKeyIndex(pMat, false);
+    if (NULL == pIdx) {
+        return;
+    }
+    MaterialKeyIndex& idx = *pIdx;
+    std::lock_guard<std::mutex> lock(idx.mMutex);
+    idx.mProperties.clear();
+    idx.mSlots.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReleaseMaterialKeyIndex(const aiMaterial* pMat) {
+    MaterialKeyIndexShard& shard = GetMaterialKeyIndexShard(pMat);
+    std::lock_guard<std::mutex> lock(shard.mMutex);
+    shard.mIndices.erase(pMat);
+}
+
+} // ! anonymous namespace
+
 // ------------------------------------------------------------------------------------------------
 // Get a specific property from a material
 aiReturn aiGetMaterialProperty(const aiMaterial* pMat,
@@ -67,10 +237,14 @@ aiReturn aiGetMaterialProperty(const aiMaterial* pMat,
     ai_assert( pKey != NULL );
     ai_assert( pPropOut != NULL );
 
-    /*  Just search for a property with exactly this name ..
-     *  could be improved by hashing, but it's possibly
-     *  no worth the effort (we're bound to C structures,
-     *  thus std::map or derivates are not applicable. */
+    // Large materials are looked up through the key index
+    unsigned int slot;
+    if (FindIndexedMaterialSlot(pMat, pKey, type, index, slot)) {
+        *pPropOut = (UINT_MAX != slot ? pMat->mProperties[slot] : NULL);
+        return (UINT_MAX != slot ? AI_SUCCESS : AI_FAILURE);
+    }
+
+    // Just search for a property with exactly this name ..
     for ( unsigned int i = 0; i < pMat->mNumProperties; ++i ) {
         aiMaterialProperty* prop = pMat->mProperties[i];
 
@@ -414,6 +588,7 @@ aiMaterial::~aiMaterial()
     Clear();
 
     delete[] mProperties;
+    ReleaseMaterialKeyIndex(this);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -433,6 +608,7 @@ void aiMaterial::Clear()
         AI_DEBUG_INVALIDATE_PTR(mProperties[i]);
     }
     mNumProperties = 0;
+    InvalidateMaterialKeyIndex(this);
 
     // The array remains allocated, we just invalidated its contents
 }
@@ -456,6 +632,7 @@ aiReturn aiMaterial::RemoveProperty ( const char* pKey,unsigned int type, unsign
             for (unsigned int a = i; a < mNumProperties;++a)    {
                 mProperties[a] = mProperties[a+1];
             }
+            InvalidateMaterialKeyIndex(this);
             return AI_SUCCESS;
         }
     }
@@ -482,14 +659,20 @@ aiReturn aiMaterial::AddBinaryProperty (const void* pInput,
 
     // first search the list whether there is already an entry with this key
     unsigned int iOutIndex( UINT_MAX );
-    for ( unsigned int i = 0; i < mNumProperties; ++i ) {
-        aiMaterialProperty *prop( mProperties[ i ] );
+    if (FindIndexedMaterialSlot(this, pKey, type, index, iOutIndex)) {
+        if (UINT_MAX != iOutIndex) {
+            delete mProperties[iOutIndex];
+        }
+    } else {
+        for ( unsigned int i = 0; i < mNumProperties; ++i ) {
+            aiMaterialProperty *prop( mProperties[ i ] );
 
-        if (prop /* just for safety */ && !strcmp( prop->mKey.data, pKey ) &&
-            prop->mSemantic == type && prop->mIndex == index){
+            if (prop /* just for safety */ && !strcmp( prop->mKey.data, pKey ) &&
+                prop->mSemantic == type && prop->mIndex == index){
 
-            delete mProperties[i];
-            iOutIndex = i;
+                delete mProperties[i];
+                iOutIndex = i;
+            }
         }
     }
 
@@ -510,7 +693,9 @@ aiReturn aiMaterial::AddBinaryProperty (const void* pInput,
     strcpy( pcNew->mKey.data, pKey );
 
     if (UINT_MAX != iOutIndex)  {
+        // same key in the same slot, an existing key index stays valid
         mProperties[iOutIndex] = pcNew;
+        SetMaterialKeyIndexSlot(this, iOutIndex);
         return AI_SUCCESS;
     }
 
@@ -535,6 +720,7 @@ aiReturn aiMaterial::AddBinaryProperty (const void* pInput,
     }
     // push back ...
     mProperties[mNumProperties++] = pcNew;
+    SetMaterialKeyIndexSlot(this, mNumProperties - 1);
 
     return AI_SUCCESS;
 }
@@ -584,6 +770,8 @@ void aiMaterial::CopyPropertyList(aiMaterial* pcDest,
     ai_assert(NULL != pcDest);
     ai_assert(NULL != pcSrc);
 
+    InvalidateMaterialKeyIndex(pcDest);
+
     unsigned int iOldNum = pcDest->mNumProperties;
     pcDest->mNumAllocated += pcSrc->mNumAllocated;
     pcDest->mNumProperties += pcSrc->mNumProperties;
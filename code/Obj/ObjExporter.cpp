@@ -63,24 +63,20 @@ void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
     // invoke the exporter
     ObjExporter exporter(pFile, pScene);
 
-    if (exporter.mOutput.fail() || exporter.mOutputMat.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-
-    // we're still here - export successfully completed. Write both the main OBJ file and the material script
+    // Write both the main OBJ file and the material script
     {
         std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
         if(outfile == NULL) {
             throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
         }
-        outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+        exporter.WriteGeometryFile(outfile.get());
     }
     {
         std::unique_ptr<IOStream> outfile (pIOSystem->Open(exporter.GetMaterialLibFileName(),"wt"));
         if(outfile == NULL) {
             throw DeadlyExportError("could not open output .mtl file: " + std::string(exporter.GetMaterialLibFileName()));
         }
-        outfile->Write( exporter.mOutputMat.str().c_str(), static_cast<size_t>(exporter.mOutputMat.tellp()),1);
+        exporter.WriteMaterialFile(outfile.get());
     }
 }
 
@@ -90,20 +86,12 @@ void ExportSceneObjNoMtl(const char* pFile,IOSystem* pIOSystem, const aiScene* p
     // invoke the exporter
     ObjExporter exporter(pFile, pScene, true);
 
-    if (exporter.mOutput.fail() || exporter.mOutputMat.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
+    // Write the main OBJ file only
+    std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
+    if(outfile == NULL) {
+        throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
     }
-
-    // we're still here - export successfully completed. Write both the main OBJ file and the material script
-    {
-        std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-        if(outfile == NULL) {
-            throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
-        }
-        outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
-    }
-
-
+    exporter.WriteGeometryFile(outfile.get());
 }
 
 } // end of namespace Assimp
@@ -114,6 +102,7 @@ static const std::string MaterialExt = ".mtl";
 ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene, bool noMtl)
 : filename(_filename)
 , pScene(pScene)
+, noMtl(noMtl)
 , vn()
 , vt()
 , vp()
@@ -123,17 +112,7 @@ ObjExporter::ObjExporter(const char* _filename, const aiScene* pScene, bool noMt
 , mVpMap()
 , mMeshes()
 , endl("\n") {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
-    mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
-    mOutputMat.imbue(l);
-    mOutputMat.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
-
-    WriteGeometryFile(noMtl);
-    if ( !noMtl ) {
-        WriteMaterialFile();
-    }
+    // empty
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -165,7 +144,7 @@ std::string ObjExporter::GetMaterialLibFileName() {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter::WriteHeader(std::ostringstream& out) {
+void ObjExporter::WriteHeader(BufferedTextWriter& out) {
     out << "# File produced by Open Asset Import Library (http://www.assimp.sf.net)" << endl;
     out << "# (assimp v" << aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.'
         << aiGetVersionRevision() << ")" << endl  << endl;
@@ -190,7 +169,10 @@ std::string ObjExporter::GetMaterialName(unsigned int index) {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter::WriteMaterialFile() {
+void ObjExporter::WriteMaterialFile(IOStream* output) {
+    BufferedTextWriter mOutputMat(output);
+    mOutputMat.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
+
     WriteHeader(mOutputMat);
 
     for(unsigned int i = 0; i < pScene->mNumMaterials; ++i) {
@@ -255,9 +237,18 @@ void ObjExporter::WriteMaterialFile() {
 
         mOutputMat << endl;
     }
+
+    mOutputMat.Flush();
+    if (mOutputMat.fail()) {
+        throw DeadlyExportError("could not write output .mtl file: " + GetMaterialLibFileName());
+    }
 }
 
-void ObjExporter::WriteGeometryFile(bool noMtl) {
+// ------------------------------------------------------------------------------------------------
+void ObjExporter::WriteGeometryFile(IOStream* output) {
+    BufferedTextWriter mOutput(output);
+    mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
+
     WriteHeader(mOutput);
     if (!noMtl)
         mOutput << "mtllib "  << GetMaterialLibName() << endl << endl;
@@ -329,6 +320,11 @@ void ObjExporter::WriteGeometryFile(bool noMtl) {
         }
         mOutput << endl;
     }
+
+    mOutput.Flush();
+    if (mOutput.fail()) {
+        throw DeadlyExportError("could not write output .obj file: " + filename);
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
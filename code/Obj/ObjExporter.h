@@ -47,7 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_OBJEXPORTER_H_INC
 
 #include <assimp/types.h>
-#include <sstream>
+#include "Common/BufferedTextWriter.h"
+
 #include <vector>
 #include <map>
 
@@ -67,9 +68,12 @@ public:
     ~ObjExporter();
     std::string GetMaterialLibName();
     std::string GetMaterialLibFileName();
-    
-    /// public string-streams to write all output into
-    std::ostringstream mOutput, mOutputMat;
+
+    /// Writes the OBJ file to the given stream
+    void WriteGeometryFile(IOStream* output);
+
+    /// Writes the material library to the given stream
+    void WriteMaterialFile(IOStream* output);
 
 private:
     // intermediate data structures
@@ -95,9 +99,7 @@ private:
         std::vector<Face> faces;
     };
 
-    void WriteHeader(std::ostringstream& out);
-    void WriteMaterialFile();
-    void WriteGeometryFile(bool noMtl=false);
+    void WriteHeader(BufferedTextWriter& out);
     std::string GetMaterialName(unsigned int index);
     void AddMesh(const aiString& name, const aiMesh* m, const aiMatrix4x4& mat);
     void AddNode(const aiNode* nd, const aiMatrix4x4& mParent);
@@ -105,6 +107,7 @@ private:
 private:
     std::string filename;
     const aiScene* const pScene;
+    const bool noMtl;
 
     struct vertexData {
         aiVector3D vp;
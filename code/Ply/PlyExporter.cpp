@@ -68,34 +68,34 @@ template<> const char* type_of(double&) { return "double"; }
 // Worker function for exporting a scene to PLY. Prototyped and registered in Exporter.cpp
 void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
 {
-    // invoke the exporter
-    PlyExporter exporter(pFile, pScene);
-
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-
-    // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
     }
 
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    // invoke the exporter, it writes directly to the file
+    PlyExporter exporter(pFile, pScene, outfile.get());
+
+    exporter.mOutput.Flush();
+    if (exporter.mOutput.fail()) {
+        throw DeadlyExportError("could not write output .ply file: " + std::string(pFile));
+    }
 }
 
 void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* /*pProperties*/)
 {
-    // invoke the exporter
-    PlyExporter exporter(pFile, pScene, true);
-
-    // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile(pIOSystem->Open(pFile, "wb"));
     if (outfile == NULL) {
         throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
     }
 
-    outfile->Write(exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()), 1);
+    // invoke the exporter, it writes directly to the file
+    PlyExporter exporter(pFile, pScene, outfile.get(), true);
+
+    exporter.mOutput.Flush();
+    if (exporter.mOutput.fail()) {
+        throw DeadlyExportError("could not write output .ply file: " + std::string(pFile));
+    }
 }
 
 #define PLY_EXPORT_HAS_NORMALS 0x1
@@ -104,13 +104,12 @@ void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene*
 #define PLY_EXPORT_HAS_COLORS (PLY_EXPORT_HAS_TEXCOORDS << AI_MAX_NUMBER_OF_TEXTURECOORDS)
 
 // ------------------------------------------------------------------------------------------------
-PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, bool binary)
-: filename(_filename)
+PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, IOStream* output, bool binary)
+: mOutput(output)
+, filename(_filename)
 , endl("\n")
 {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
+    // BufferedTextWriter always formats numbers like the standard, C locale
     mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
 
     unsigned int faces = 0u, vertices = 0u, components = 0u;
@@ -375,14 +374,14 @@ void PlyExporter::WriteMeshIndices(const aiMesh* m, unsigned int offset)
         const aiFace& f = m->mFaces[i];
         mOutput << f.mNumIndices << " ";
         for(unsigned int c = 0; c < f.mNumIndices; ++c) {
-            mOutput << (f.mIndices[c] + offset) << (c == f.mNumIndices-1 ? endl : " ");
+            mOutput << (f.mIndices[c] + offset) << (c == f.mNumIndices-1 ? endl.c_str() : " ");
         }
     }
 }
 
 // Generic method in case we want to use different data types for the indices or make this configurable.
 template<typename NumIndicesType, typename IndexType>
-void WriteMeshIndicesBinary_Generic(const aiMesh* m, unsigned int offset, std::ostringstream& output)
+void WriteMeshIndicesBinary_Generic(const aiMesh* m, unsigned int offset, BufferedTextWriter& output)
 {
     for (unsigned int i = 0; i < m->mNumFaces; ++i) {
         const aiFace& f = m->mFaces[i];
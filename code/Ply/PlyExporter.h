@@ -46,7 +46,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_PLYEXPORTER_H_INC
 #define AI_PLYEXPORTER_H_INC
 
-#include <sstream>
+#include "Common/BufferedTextWriter.h"
+
+#include <string>
 
 struct aiScene;
 struct aiNode;
@@ -59,14 +61,14 @@ namespace Assimp {
 // ------------------------------------------------------------------------------------------------
 class PlyExporter {
 public:
-    /// The class constructor for a specific scene to export
-    PlyExporter(const char* filename, const aiScene* pScene, bool binary = false);
+    /// The class constructor for a specific scene to export, the output is written to the given stream
+    PlyExporter(const char* filename, const aiScene* pScene, IOStream* output, bool binary = false);
     /// The class destructor, empty.
     ~PlyExporter();
 
 public:
-    /// public string-streams to write all output into:
-    std::ostringstream mOutput;
+    /// public writer to write all output into:
+    BufferedTextWriter mOutput;
 
 private:
     void WriteMeshVerts(const aiMesh* m, unsigned int components);
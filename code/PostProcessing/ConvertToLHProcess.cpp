@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "ConvertToLHProcess.h"
+#include "Common/VectorKernels.h"
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
@@ -163,33 +164,32 @@ void MakeLeftHandedProcess::ProcessMesh( aiMesh* pMesh) {
         return;
     }
     // mirror positions, normals and stuff along the Z axis
-    for( size_t a = 0; a < pMesh->mNumVertices; ++a)
+    const aiVector3D mirrorZ(1.0f, 1.0f, -1.0f);
+    ScaleVectors(mirrorZ, pMesh->mVertices, pMesh->mVertices, pMesh->mNumVertices);
+    if (pMesh->HasNormals()) {
+        ScaleVectors(mirrorZ, pMesh->mNormals, pMesh->mNormals, pMesh->mNumVertices);
+    }
+    if( pMesh->HasTangentsAndBitangents())
     {
-        pMesh->mVertices[a].z *= -1.0f;
-        if (pMesh->HasNormals()) {
-            pMesh->mNormals[a].z *= -1.0f;
-        }
-        if( pMesh->HasTangentsAndBitangents())
-        {
-            pMesh->mTangents[a].z *= -1.0f;
-            pMesh->mBitangents[a].z *= -1.0f;
-        }
+        ScaleVectors(mirrorZ, pMesh->mTangents, pMesh->mTangents, pMesh->mNumVertices);
+
+        // mirror bitangents as well as they're derived from the texture coords,
+        // which leaves their z component untouched
+        ScaleVectors(aiVector3D(-1.0f, -1.0f, 1.0f), pMesh->mBitangents, pMesh->mBitangents, pMesh->mNumVertices);
     }
 
     // mirror anim meshes positions, normals and stuff along the Z axis
     for (size_t m = 0; m < pMesh->mNumAnimMeshes; ++m)
     {
-        for (size_t a = 0; a < pMesh->mAnimMeshes[m]->mNumVertices; ++a)
+        aiAnimMesh* animMesh = pMesh->mAnimMeshes[m];
+        ScaleVectors(mirrorZ, animMesh->mVertices, animMesh->mVertices, animMesh->mNumVertices);
+        if (animMesh->HasNormals()) {
+            ScaleVectors(mirrorZ, animMesh->mNormals, animMesh->mNormals, animMesh->mNumVertices);
+        }
+        if (animMesh->HasTangentsAndBitangents())
         {
-            pMesh->mAnimMeshes[m]->mVertices[a].z *= -1.0f;
-            if (pMesh->mAnimMeshes[m]->HasNormals()) {
-                pMesh->mAnimMeshes[m]->mNormals[a].z *= -1.0f;
-            }
-            if (pMesh->mAnimMeshes[m]->HasTangentsAndBitangents())
-            {
-                pMesh->mAnimMeshes[m]->mTangents[a].z *= -1.0f;
-                pMesh->mAnimMeshes[m]->mBitangents[a].z *= -1.0f;
-            }
+            ScaleVectors(mirrorZ, animMesh->mTangents, animMesh->mTangents, animMesh->mNumVertices);
+            ScaleVectors(mirrorZ, animMesh->mBitangents, animMesh->mBitangents, animMesh->mNumVertices);
         }
     }
 
@@ -204,13 +204,6 @@ void MakeLeftHandedProcess::ProcessMesh( aiMesh* pMesh) {
         bone->mOffsetMatrix.c2 = -bone->mOffsetMatrix.c2;
         bone->mOffsetMatrix.c4 = -bone->mOffsetMatrix.c4;
     }
-
-    // mirror bitangents as well as they're derived from the texture coords
-    if( pMesh->HasTangentsAndBitangents())
-    {
-        for( unsigned int a = 0; a < pMesh->mNumVertices; a++)
-            pMesh->mBitangents[a] *= -1.0f;
-    }
 }
 
 // ------------------------------------------------------------------------------------------------
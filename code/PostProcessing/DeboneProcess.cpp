@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers of the post-processing framework
 #include "ProcessHelper.h"
 #include "DeboneProcess.h"
+#include "Common/SceneNameIndex.h"
 #include <stdio.h>
 
 
@@ -118,7 +119,9 @@ void DeboneProcess::Execute( aiScene* pScene)
         mSubMeshIndices.resize(pScene->mNumMeshes); // because we're doing it here anyway
 
         // build a new array of meshes for the scene
+        const MeshLODRemapper lodRemapper(pScene);
         std::vector<aiMesh*> meshes;
+        std::vector<unsigned int> sources;
 
         for(unsigned int a=0;a<pScene->mNumMeshes;a++)
         {
@@ -138,11 +141,12 @@ void DeboneProcess::Execute( aiScene* pScene)
                 for(unsigned int b=0;b<newMeshes.size();b++)    {
                     const aiString *find = newMeshes[b].second?&newMeshes[b].second->mName:0;
 
-                    aiNode *theNode = find?pScene->mRootNode->FindNode(*find):0;
+                    aiNode *theNode = find?GetSceneNameIndex(pScene).FindNode(*find):0;
                     std::pair<unsigned int,aiNode*> push_pair(static_cast<unsigned int>(meshes.size()),theNode);
 
                     mSubMeshIndices[a].push_back(push_pair);
                     meshes.push_back(newMeshes[b].first);
+                    sources.push_back(a);
 
                     out+=newMeshes[b].first->mNumBones;
                 }
@@ -158,6 +162,7 @@ void DeboneProcess::Execute( aiScene* pScene)
                 // Mesh is kept unchanged - store it's new place in the mesh array
                 mSubMeshIndices[a].push_back(std::pair<unsigned int,aiNode*>(static_cast<unsigned int>(meshes.size()),(aiNode*)0));
                 meshes.push_back(srcMesh);
+                sources.push_back(a);
             }
         }
 
@@ -166,6 +171,7 @@ void DeboneProcess::Execute( aiScene* pScene)
         delete [] pScene->mMeshes;
         pScene->mMeshes = new aiMesh*[pScene->mNumMeshes];
         std::copy( meshes.begin(), meshes.end(), pScene->mMeshes);
+        lodRemapper.Update(pScene, sources);
 
         // recurse through all nodes and translate the node's mesh indices to fit the new mesh array
         UpdateNode( pScene->mRootNode);
@@ -91,14 +91,24 @@ void FindDegeneratesProcess::SetupProperties(const Importer* pImp) {
 // Executes the post processing step on the given imported data.
 void FindDegeneratesProcess::Execute( aiScene* pScene) {
     ASSIMP_LOG_DEBUG("FindDegeneratesProcess begin");
+    const MeshLODRemapper lodRemapper(pScene);
+    const unsigned int numMeshes = pScene->mNumMeshes;
+    std::vector<unsigned int> sources(numMeshes);
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        sources[i] = i;
+    }
     for (unsigned int i = 0; i < pScene->mNumMeshes;++i)
     {
         //Do not process point cloud, ExecuteOnMesh works only with faces data
         if ((pScene->mMeshes[i]->mPrimitiveTypes != aiPrimitiveType::aiPrimitiveType_POINT) && ExecuteOnMesh(pScene->mMeshes[i])) {
             removeMesh(pScene, i);
+            sources.erase(sources.begin() + i);
             --i; //the current i is removed, do not skip the next one
         }
     }
+    if (sources.size() != numMeshes) {
+        lodRemapper.Update(pScene, sources);
+    }
     ASSIMP_LOG_DEBUG("FindDegeneratesProcess finished");
 }
 
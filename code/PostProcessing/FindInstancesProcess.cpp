@@ -131,6 +131,10 @@ void FindInstancesProcess::Execute( aiScene* pScene)
         std::unique_ptr<uint64_t[]> hashes (new uint64_t[pScene->mNumMeshes]);
         std::unique_ptr<unsigned int[]> remapping (new unsigned int[pScene->mNumMeshes]);
 
+        // LOD chains are kept as they are, mLODs refers to their meshes
+        const MeshLODRemapper lodRemapper(pScene);
+        std::vector<unsigned int> sources;
+
         unsigned int numMeshesOut = 0;
         for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 
@@ -142,11 +146,11 @@ void FindInstancesProcess::Execute( aiScene* pScene)
             float epsilon = ComputePositionEpsilon(inst);
             epsilon *= epsilon;
 
-            for (int a = i-1; a >= 0; --a) {
+            for (int a = i-1; a >= 0 && !lodRemapper.IsInLODChain(i); --a) {
                 if (hashes[i] == hashes[a])
                 {
                     aiMesh* orig = pScene->mMeshes[a];
-                    if (!orig)
+                    if (!orig || lodRemapper.IsInLODChain(a))
                         continue;
 
                     // check for hash collision .. we needn't check
@@ -251,6 +255,7 @@ void FindInstancesProcess::Execute( aiScene* pScene)
             // If we didn't find a match for the current mesh: keep it
             if (pScene->mMeshes[i]) {
                 remapping[i] = numMeshesOut++;
+                sources.push_back(i);
             }
         }
         ai_assert(0 != numMeshesOut);
@@ -270,6 +275,7 @@ void FindInstancesProcess::Execute( aiScene* pScene)
                 ASSIMP_LOG_INFO_F( "FindInstancesProcess finished. Found ", (pScene->mNumMeshes - numMeshesOut), " instances" );
             }
             pScene->mNumMeshes = numMeshesOut;
+            lodRemapper.Update(pScene, sources);
         } else {
             ASSIMP_LOG_DEBUG("FindInstancesProcess finished. No instanced meshes found");
         }
@@ -118,6 +118,7 @@ void FindInvalidDataProcess::Execute( aiScene* pScene) {
     ASSIMP_LOG_DEBUG("FindInvalidDataProcess begin");
 
     bool out = false;
+    const MeshLODRemapper lodRemapper(pScene);
     std::vector<unsigned int> meshMapping(pScene->mNumMeshes);
     unsigned int real = 0;
 
@@ -157,7 +158,16 @@ void FindInvalidDataProcess::Execute( aiScene* pScene) {
             // therefore we'll also need to remove all references
             // to them from the scenegraph
             UpdateMeshReferences(pScene->mRootNode,meshMapping);
+
+            // the LOD lists refer to the old indices as well
+            std::vector<unsigned int> sources(real);
+            for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+                if (UINT_MAX != meshMapping[a]) {
+                    sources[meshMapping[a]] = a;
+                }
+            }
             pScene->mNumMeshes = real;
+            lodRemapper.Update(pScene, sources);
         }
 
         ASSIMP_LOG_INFO("FindInvalidDataProcess finished. Found issues ...");
@@ -0,0 +1,299 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Implementation of the post-processing step to generate LODs with
+ *        a quadric error metric.
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+
+#include "PostProcessing/GenLODsProcess.h"
+#include "PostProcessing/MeshSimplifier.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <string>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+T* CopyVertexStream(const T* source, const std::vector<unsigned int>& vertices) {
+    if (nullptr == source) {
+        return nullptr;
+    }
+    T* dest = new T[vertices.size()];
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        dest[i] = source[vertices[i]];
+    }
+    return dest;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds a mesh from the triangles left by the simplifier, with the vertices it still uses
+aiMesh* MakeLODMesh(const aiMesh* mesh, const std::vector<unsigned int>& indices, unsigned int level) {
+    std::vector<unsigned int> newIndex(mesh->mNumVertices, UINT_MAX), vertices;
+    vertices.reserve(indices.size() / 2);
+    for (const unsigned int v : indices) {
+        if (UINT_MAX == newIndex[v]) {
+            newIndex[v] = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(v);
+        }
+    }
+
+    aiMesh* lod = new aiMesh();
+    lod->mName = aiString(std::string(mesh->mName.C_Str()) + "_LOD" + std::to_string(level));
+    lod->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    lod->mMaterialIndex = mesh->mMaterialIndex;
+    lod->mMethod = mesh->mMethod;
+    lod->mNumVertices = static_cast<unsigned int>(vertices.size());
+    lod->mVertices = CopyVertexStream(mesh->mVertices, vertices);
+    lod->mNormals = CopyVertexStream(mesh->mNormals, vertices);
+    lod->mTangents = CopyVertexStream(mesh->mTangents, vertices);
+    lod->mBitangents = CopyVertexStream(mesh->mBitangents, vertices);
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        lod->mColors[c] = CopyVertexStream(mesh->mColors[c], vertices);
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+        lod->mTextureCoords[c] = CopyVertexStream(mesh->mTextureCoords[c], vertices);
+        lod->mNumUVComponents[c] = mesh->mNumUVComponents[c];
+    }
+
+    lod->mNumFaces = static_cast<unsigned int>(indices.size() / 3);
+    lod->mFaces = new aiFace[lod->mNumFaces];
+    for (unsigned int f = 0; f < lod->mNumFaces; ++f) {
+        aiFace& face = lod->mFaces[f];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        for (unsigned int k = 0; k < 3; ++k) {
+            face.mIndices[k] = newIndex[indices[f * 3 + k]];
+        }
+    }
+
+    // keep the weights of the remaining vertices, bones without any are dropped
+    std::vector<aiBone*> bones;
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        const aiBone* bone = mesh->mBones[b];
+        std::vector<aiVertexWeight> weights;
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight& weight = bone->mWeights[w];
+            if (weight.mVertexId < mesh->mNumVertices && UINT_MAX != newIndex[weight.mVertexId]) {
+                weights.push_back(aiVertexWeight(newIndex[weight.mVertexId], weight.mWeight));
+            }
+        }
+        if (weights.empty()) {
+            continue;
+        }
+        aiBone* newBone = new aiBone();
+        newBone->mName = bone->mName;
+        newBone->mOffsetMatrix = bone->mOffsetMatrix;
+        newBone->mNumWeights = static_cast<unsigned int>(weights.size());
+        newBone->mWeights = new aiVertexWeight[weights.size()];
+        std::copy(weights.begin(), weights.end(), newBone->mWeights);
+        bones.push_back(newBone);
+    }
+    if (!bones.empty()) {
+        lod->mNumBones = static_cast<unsigned int>(bones.size());
+        lod->mBones = new aiBone*[bones.size()];
+        std::copy(bones.begin(), bones.end(), lod->mBones);
+    }
+
+    // blend shapes share the topology of the mesh
+    if (mesh->mNumAnimMeshes) {
+        lod->mNumAnimMeshes = mesh->mNumAnimMeshes;
+        lod->mAnimMeshes = new aiAnimMesh*[mesh->mNumAnimMeshes];
+        for (unsigned int a = 0; a < mesh->mNumAnimMeshes; ++a) {
+            const aiAnimMesh* source = mesh->mAnimMeshes[a];
+            aiAnimMesh* anim = new aiAnimMesh();
+            anim->mName = source->mName;
+            anim->mWeight = source->mWeight;
+            anim->mNumVertices = lod->mNumVertices;
+            anim->mVertices = CopyVertexStream(source->mVertices, vertices);
+            anim->mNormals = CopyVertexStream(source->mNormals, vertices);
+            anim->mTangents = CopyVertexStream(source->mTangents, vertices);
+            anim->mBitangents = CopyVertexStream(source->mBitangents, vertices);
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+                anim->mColors[c] = CopyVertexStream(source->mColors[c], vertices);
+            }
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+                anim->mTextureCoords[c] = CopyVertexStream(source->mTextureCoords[c], vertices);
+            }
+            lod->mAnimMeshes[a] = anim;
+        }
+    }
+    return lod;
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+GenLODsProcess::GenLODsProcess()
+: BaseProcess()
+, mNumLODs(AI_GL_DEFAULT_NUM_LODS)
+, mRatio(AI_GL_DEFAULT_RATIO) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+GenLODsProcess::~GenLODsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenLODsProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenLODsProcess::IsActiveExt(unsigned int pExtFlags) const {
+    return 0 != ( pExtFlags & aiProcessExt_GenLODs );
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenLODsProcess::SetupProperties(const Importer* pImp) {
+    const int numLODs = pImp->GetPropertyInteger(AI_CONFIG_PP_GL_NUM_LODS, AI_GL_DEFAULT_NUM_LODS);
+    SetLODs(static_cast<unsigned int>(std::max(numLODs, 0)), pImp->GetPropertyFloat(AI_CONFIG_PP_GL_RATIO, AI_GL_DEFAULT_RATIO));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenLODsProcess::SetLODs(unsigned int numLODs, float ratio) {
+    mNumLODs = numLODs;
+    mRatio = std::min(std::max(ratio, 0.01f), 0.99f);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenLODsProcess::Execute(aiScene* pScene) {
+    if (nullptr == pScene || 0 == pScene->mNumMeshes || 0 == mNumLODs) {
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("GenLODsProcess begin");
+
+    // meshes which are LODs or have LODs from a previous run are left alone
+    std::vector<char> skip(pScene->mNumMeshes, 0);
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        const aiMesh* mesh = pScene->mMeshes[a];
+        if (mesh->mNumLODs) {
+            skip[a] = 1;
+        }
+        for (unsigned int l = 0; l < mesh->mNumLODs; ++l) {
+            if (mesh->mLODs[l] < pScene->mNumMeshes) {
+                skip[mesh->mLODs[l]] = 1;
+            }
+        }
+    }
+
+    std::vector<std::vector<aiMesh*> > lods(pScene->mNumMeshes);
+    unsigned int numLODs = 0;
+    ParallelForThenReport(pScene->mNumMeshes, [&](size_t a) {
+        return skip[a] ? std::vector<aiMesh*>() : GenerateLODs(pScene->mMeshes[a]);
+    }, [&](size_t a, std::vector<aiMesh*>& chain) {
+        numLODs += static_cast<unsigned int>(chain.size());
+        lods[a].swap(chain);
+    });
+    if (0 == numLODs) {
+        ASSIMP_LOG_DEBUG("GenLODsProcess finished. No mesh could be simplified");
+        return;
+    }
+
+    // append the LODs to the meshes of the scene
+    aiMesh** meshes = new aiMesh*[pScene->mNumMeshes + numLODs];
+    std::copy(pScene->mMeshes, pScene->mMeshes + pScene->mNumMeshes, meshes);
+    unsigned int next = pScene->mNumMeshes;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        const std::vector<aiMesh*>& chain = lods[a];
+        if (chain.empty()) {
+            continue;
+        }
+        aiMesh* mesh = meshes[a];
+        mesh->mNumLODs = static_cast<unsigned int>(chain.size());
+        mesh->mLODs = new unsigned int[chain.size()];
+        for (unsigned int l = 0; l < mesh->mNumLODs; ++l) {
+            mesh->mLODs[l] = next;
+            meshes[next++] = chain[l];
+        }
+    }
+    delete[] pScene->mMeshes;
+    pScene->mMeshes = meshes;
+    pScene->mNumMeshes = next;
+
+    ASSIMP_LOG_INFO_F("GenLODsProcess finished. Generated ", numLODs, " LOD meshes");
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<aiMesh*> GenLODsProcess::GenerateLODs(const aiMesh* pMesh) const {
+    ai_assert(nullptr != pMesh);
+
+    std::vector<aiMesh*> lods;
+    if (aiPrimitiveType_TRIANGLE != pMesh->mPrimitiveTypes || !pMesh->HasFaces() || !pMesh->HasPositions()) {
+        return lods;
+    }
+
+    // each LOD continues from the previous one
+    MeshSimplifier simplifier(pMesh);
+    size_t previous = pMesh->mNumFaces;
+    double target = pMesh->mNumFaces;
+    for (unsigned int level = 1; level <= mNumLODs; ++level) {
+        target *= mRatio;
+        simplifier.Simplify(static_cast<size_t>(target));
+
+        // stop if the mesh can't be simplified any further
+        const size_t numTriangles = simplifier.GetNumTriangles();
+        if (0 == numTriangles || numTriangles >= previous) {
+            break;
+        }
+        lods.push_back(MakeLODMesh(pMesh, simplifier.GetIndices(), level));
+        previous = numTriangles;
+    }
+    return lods;
+}
+
+} // Namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_GENLODS_PROCESS
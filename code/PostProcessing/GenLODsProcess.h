@@ -0,0 +1,101 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Defines a post-processing step to generate simplified versions of
+ *        triangle meshes.
+ */
+
+#pragma once
+
+#ifndef AI_GENLODSPROCESS_H_INC
+#define AI_GENLODSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+#include <vector>
+
+struct aiMesh;
+
+namespace Assimp {
+
+/** Post-processing process to generate a chain of LODs for all triangle
+ *  meshes of a scene. Edges are collapsed in the order of their quadric
+ *  error onto one of their vertices, so all attributes of the remaining
+ *  vertices are kept. Vertices on UV or normal seams and on open borders
+ *  only move along the seam or border.
+ */
+class ASSIMP_API GenLODsProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    GenLODsProcess();
+    /// The class destructor.
+    ~GenLODsProcess();
+    /// There is no aiPostProcessSteps flag for this step, returns false.
+    bool IsActive(unsigned int pFlags) const override;
+    /// Will return true, if aiProcessExt_GenLODs is defined.
+    bool IsActiveExt(unsigned int pExtFlags) const override;
+    /// Reads the number of LODs and their ratio from the importer properties.
+    void SetupProperties(const Importer* pImp) override;
+    /// The execution callback.
+    void Execute(aiScene* pScene) override;
+
+    /// Sets the number of LODs and the triangle ratio between two of them,
+    /// the ratio is clamped to [0.01, 0.99].
+    void SetLODs(unsigned int numLODs, float ratio);
+
+    /// Generates the LODs of a single mesh.
+    /// @return The new meshes, finest first. Empty if the mesh is no triangle
+    ///   mesh or can't be simplified.
+    std::vector<aiMesh*> GenerateLODs(const aiMesh* pMesh) const;
+
+private:
+    unsigned int mNumLODs;
+    float mRatio;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+
+#endif // AI_GENLODSPROCESS_H_INC
@@ -0,0 +1,535 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#include "PostProcessing/GenMeshletsProcess.h"
+#include "PostProcessing/MeshSimplifier.h"
+#include "Common/VertexTriangleAdjacency.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace Assimp {
+
+namespace {
+
+// number of neighbouring meshlets simplified together in the cluster-LOD hierarchy
+const unsigned int MeshletsPerGroup = 4;
+
+// ------------------------------------------------------------------------------------------------
+// Computes the bounding sphere and the normal cone of a meshlet
+void ComputeMeshletBounds(const aiMesh* mesh, const unsigned int* vertices,
+        const unsigned char* triangles, std::vector<aiVector3D>& normals, aiMeshlet& meshlet) {
+    // sphere around the center of the bounding box
+    aiVector3D min = mesh->mVertices[vertices[0]], max = min;
+    for (unsigned int i = 1; i < meshlet.mVertexCount; ++i) {
+        const aiVector3D& pos = mesh->mVertices[vertices[i]];
+        min = aiVector3D(std::min(min.x, pos.x), std::min(min.y, pos.y), std::min(min.z, pos.z));
+        max = aiVector3D(std::max(max.x, pos.x), std::max(max.y, pos.y), std::max(max.z, pos.z));
+    }
+    meshlet.mCenter = (min + max) / static_cast<ai_real>(2.0);
+
+    ai_real radiusSquared = 0;
+    for (unsigned int i = 0; i < meshlet.mVertexCount; ++i) {
+        radiusSquared = std::max(radiusSquared, (mesh->mVertices[vertices[i]] - meshlet.mCenter).SquareLength());
+    }
+    meshlet.mRadius = std::sqrt(radiusSquared);
+
+    // the cone axis is the average of the triangle normals, degenerates are skipped
+    normals.clear();
+    aiVector3D axis;
+    for (unsigned int t = 0; t < meshlet.mTriangleCount; ++t) {
+        const aiVector3D& p0 = mesh->mVertices[vertices[triangles[t * 3]]];
+        const aiVector3D& p1 = mesh->mVertices[vertices[triangles[t * 3 + 1]]];
+        const aiVector3D& p2 = mesh->mVertices[vertices[triangles[t * 3 + 2]]];
+        aiVector3D normal = (p1 - p0) ^ (p2 - p0);
+        const ai_real length = normal.Length();
+        if (length > 0) {
+            normal /= length;
+            normals.push_back(normal);
+            axis += normal;
+        }
+    }
+
+    meshlet.mConeAxis = aiVector3D();
+    meshlet.mConeCutoff = -1;
+    const ai_real axisLength = axis.Length();
+    if (normals.empty() || axisLength <= 0) {
+        return;
+    }
+    meshlet.mConeAxis = axis / axisLength;
+    meshlet.mConeCutoff = 1;
+    for (const aiVector3D& normal : normals) {
+        meshlet.mConeCutoff = std::min(meshlet.mConeCutoff, normal * meshlet.mConeAxis);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Partitions triangles into meshlets, which are appended to the meshlet arrays. The faces index
+// numVertices vertices, which vertexMap maps to the vertices of the mesh unless it is NULL.
+void AppendMeshlets(const aiMesh* mesh, aiFace* faces, unsigned int numFaces, unsigned int numVertices,
+        const unsigned int* vertexMap, unsigned int maxVertices, unsigned int maxTriangles,
+        std::vector<aiMeshlet>& meshlets, std::vector<unsigned int>& vertices, std::vector<unsigned char>& triangles) {
+    VertexTriangleAdjacency adj(faces, numFaces, numVertices, true);
+
+    // number of triangles per vertex which are not yet in a meshlet
+    std::vector<unsigned int> live(adj.mLiveTriangles, adj.mLiveTriangles + numVertices);
+    std::vector<char> emitted(numFaces, 0);
+
+    // index of a vertex in the current meshlet, valid if its generation is the meshlet's one
+    std::vector<unsigned int> local(numVertices), generation(numVertices, 0);
+    unsigned int currentGeneration = 1;
+
+    // number of vertices a triangle would add to the current meshlet
+    auto newVertices = [&](unsigned int f) {
+        const unsigned int* idx = faces[f].mIndices;
+        unsigned int count = 0;
+        for (unsigned int k = 0; k < 3; ++k) {
+            if (generation[idx[k]] != currentGeneration && (k < 1 || idx[k] != idx[0]) && (k < 2 || idx[k] != idx[1])) {
+                ++count;
+            }
+        }
+        return count;
+    };
+
+    const size_t firstMeshlet = meshlets.size(), firstVertex = vertices.size();
+    aiMeshlet meshlet;
+    meshlet.mVertexOffset = static_cast<unsigned int>(vertices.size());
+    meshlet.mTriangleOffset = static_cast<unsigned int>(triangles.size());
+    unsigned int seed = 0;
+    for (unsigned int remaining = numFaces; remaining > 0; --remaining) {
+        // continue with the adjacent triangle which adds the fewest vertices
+        unsigned int best = UINT_MAX, bestScore = UINT_MAX;
+        for (size_t i = meshlet.mVertexOffset; i < vertices.size() && bestScore > 0; ++i) {
+            const unsigned int v = vertices[i];
+            if (0 == live[v]) {
+                continue;
+            }
+            const unsigned int* adjacent = adj.GetAdjacentTriangles(v);
+            for (unsigned int n = 0; n < adj.mLiveTriangles[v]; ++n) {
+                const unsigned int f = adjacent[n];
+                if (emitted[f]) {
+                    continue;
+                }
+                const unsigned int score = newVertices(f);
+                if (score < bestScore || (score == bestScore && f < best)) {
+                    best = f;
+                    bestScore = score;
+                }
+            }
+        }
+
+        // nothing adjacent left, so continue with the next triangle in face order
+        if (UINT_MAX == best) {
+            while (emitted[seed]) {
+                ++seed;
+            }
+            best = seed;
+            bestScore = newVertices(seed);
+        }
+
+        // complete the meshlet if the triangle doesn't fit anymore
+        if (meshlet.mTriangleCount == maxTriangles || meshlet.mVertexCount + bestScore > maxVertices) {
+            meshlets.push_back(meshlet);
+
+            meshlet = aiMeshlet();
+            meshlet.mVertexOffset = static_cast<unsigned int>(vertices.size());
+            meshlet.mTriangleOffset = static_cast<unsigned int>(triangles.size());
+            ++currentGeneration;
+        }
+
+        // and add the triangle
+        emitted[best] = 1;
+        const unsigned int* idx = faces[best].mIndices;
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int v = idx[k];
+            if (generation[v] != currentGeneration) {
+                generation[v] = currentGeneration;
+                local[v] = meshlet.mVertexCount++;
+                vertices.push_back(v);
+            }
+            triangles.push_back(static_cast<unsigned char>(local[v]));
+            --live[v];
+        }
+        ++meshlet.mTriangleCount;
+    }
+    meshlets.push_back(meshlet);
+
+    if (nullptr != vertexMap) {
+        for (size_t i = firstVertex; i < vertices.size(); ++i) {
+            vertices[i] = vertexMap[vertices[i]];
+        }
+    }
+
+    std::vector<aiVector3D> normals;
+    for (size_t m = firstMeshlet; m < meshlets.size(); ++m) {
+        aiMeshlet& added = meshlets[m];
+        ComputeMeshletBounds(mesh, &vertices[added.mVertexOffset], &triangles[added.mTriangleOffset], normals, added);
+        added.mErrorCenter = added.mCenter;
+        added.mErrorRadius = added.mRadius;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Computes a sphere enclosing the error spheres of a group of meshlets
+void MergeErrorSpheres(const std::vector<aiMeshlet>& meshlets, const std::vector<unsigned int>& group,
+        aiVector3D& center, ai_real& radius) {
+    aiVector3D min, max;
+    for (size_t i = 0; i < group.size(); ++i) {
+        const aiMeshlet& meshlet = meshlets[group[i]];
+        const aiVector3D extent(meshlet.mErrorRadius, meshlet.mErrorRadius, meshlet.mErrorRadius);
+        const aiVector3D low = meshlet.mErrorCenter - extent, high = meshlet.mErrorCenter + extent;
+        min = 0 == i ? low : aiVector3D(std::min(min.x, low.x), std::min(min.y, low.y), std::min(min.z, low.z));
+        max = 0 == i ? high : aiVector3D(std::max(max.x, high.x), std::max(max.y, high.y), std::max(max.z, high.z));
+    }
+    center = (min + max) / static_cast<ai_real>(2.0);
+
+    radius = 0;
+    for (const unsigned int m : group) {
+        radius = std::max(radius, (meshlets[m].mErrorCenter - center).Length() + meshlets[m].mErrorRadius);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds the coarser levels of the cluster-LOD hierarchy on top of the meshlets of a mesh. Groups
+// of neighbouring meshlets are simplified with their outer border locked and split into meshlets
+// again, until a single meshlet is left or no group simplifies anymore.
+void AppendClusterLODs(const aiMesh* mesh, unsigned int maxVertices, unsigned int maxTriangles,
+        std::vector<aiMeshlet>& meshlets, std::vector<unsigned int>& vertices, std::vector<unsigned char>& triangles) {
+    const unsigned int numVertices = mesh->mNumVertices;
+    const unsigned int SharedPosition = UINT_MAX - 1;
+
+    // neighbours and borders are found by position, the vertices of UV seams are split
+    std::vector<unsigned int> position(numVertices);
+    std::map<aiVector3D, unsigned int> positions;
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        position[i] = positions.insert(std::make_pair(mesh->mVertices[i], i)).first->second;
+    }
+
+    // positions on the border of the roots of the hierarchy never move again
+    std::vector<char> fixed(numVertices, 0);
+    // the group of the meshlets at a position, or SharedPosition on the border of groups
+    std::vector<unsigned int> positionGroup(numVertices, UINT_MAX);
+    std::vector<unsigned int> localIndex(numVertices, UINT_MAX);
+
+    std::vector<unsigned int> current(meshlets.size()), next;
+    std::iota(current.begin(), current.end(), 0u);
+    for (unsigned int level = 1; current.size() > 1; ++level) {
+        // the positions of each meshlet, and the meshlets at each position
+        std::vector<std::vector<unsigned int>> meshletPositions(current.size());
+        std::vector<unsigned int> offsets(numVertices + 1, 0), users;
+        for (size_t i = 0; i < current.size(); ++i) {
+            const aiMeshlet& meshlet = meshlets[current[i]];
+            std::vector<unsigned int>& list = meshletPositions[i];
+            for (unsigned int v = 0; v < meshlet.mVertexCount; ++v) {
+                list.push_back(position[vertices[meshlet.mVertexOffset + v]]);
+            }
+            std::sort(list.begin(), list.end());
+            list.erase(std::unique(list.begin(), list.end()), list.end());
+            for (const unsigned int p : list) {
+                ++offsets[p + 1];
+            }
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        users.resize(offsets.back());
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < current.size(); ++i) {
+            for (const unsigned int p : meshletPositions[i]) {
+                users[fill[p]++] = static_cast<unsigned int>(i);
+            }
+        }
+
+        // grow each group with the neighbour sharing the most positions with it
+        std::vector<unsigned int> groupOf(current.size(), UINT_MAX);
+        std::vector<std::vector<unsigned int>> groups;
+        std::unordered_map<unsigned int, unsigned int> shared;
+        for (unsigned int seed = 0; seed < current.size(); ++seed) {
+            if (UINT_MAX != groupOf[seed]) {
+                continue;
+            }
+            const unsigned int g = static_cast<unsigned int>(groups.size());
+            groups.push_back(std::vector<unsigned int>(1, seed));
+            groupOf[seed] = g;
+
+            shared.clear();
+            for (unsigned int member = seed; groups[g].size() < MeshletsPerGroup;) {
+                for (const unsigned int p : meshletPositions[member]) {
+                    for (unsigned int k = offsets[p]; k < offsets[p + 1]; ++k) {
+                        if (UINT_MAX == groupOf[users[k]]) {
+                            ++shared[users[k]];
+                        }
+                    }
+                }
+
+                unsigned int bestCount = 0;
+                member = UINT_MAX;
+                for (const auto& candidate : shared) {
+                    if (UINT_MAX == groupOf[candidate.first] &&
+                            (candidate.second > bestCount || (candidate.second == bestCount && candidate.first < member))) {
+                        member = candidate.first;
+                        bestCount = candidate.second;
+                    }
+                }
+                if (UINT_MAX == member) {
+                    break;
+                }
+                groupOf[member] = g;
+                groups[g].push_back(member);
+            }
+        }
+
+        for (size_t i = 0; i < current.size(); ++i) {
+            for (const unsigned int p : meshletPositions[i]) {
+                positionGroup[p] = UINT_MAX == positionGroup[p] || groupOf[i] == positionGroup[p] ? groupOf[i] : SharedPosition;
+            }
+        }
+
+        next.clear();
+        std::vector<aiVector3D> groupVertices;
+        std::vector<unsigned int> groupMap, groupIndices, children;
+        for (const std::vector<unsigned int>& group : groups) {
+            // the triangles of the group, with its vertices numbered from 0
+            groupVertices.clear();
+            groupMap.clear();
+            groupIndices.clear();
+            children.clear();
+            for (const unsigned int i : group) {
+                const aiMeshlet& meshlet = meshlets[current[i]];
+                children.push_back(current[i]);
+                for (unsigned int t = 0; t < meshlet.mTriangleCount * 3; ++t) {
+                    const unsigned int v = vertices[meshlet.mVertexOffset + triangles[meshlet.mTriangleOffset + t]];
+                    if (UINT_MAX == localIndex[v]) {
+                        localIndex[v] = static_cast<unsigned int>(groupMap.size());
+                        groupMap.push_back(v);
+                        groupVertices.push_back(mesh->mVertices[v]);
+                    }
+                    groupIndices.push_back(localIndex[v]);
+                }
+            }
+
+            // the border of the group is locked, so it keeps matching its neighbours
+            const unsigned int numGroupVertices = static_cast<unsigned int>(groupMap.size());
+            MeshSimplifier simplifier(groupVertices.data(), numGroupVertices, groupIndices);
+            for (unsigned int v = 0; v < numGroupVertices; ++v) {
+                const unsigned int p = position[groupMap[v]];
+                if (fixed[p] || SharedPosition == positionGroup[p]) {
+                    simplifier.Lock(v);
+                }
+                localIndex[groupMap[v]] = UINT_MAX;
+            }
+            const size_t numTriangles = groupIndices.size() / 3;
+            simplifier.Simplify(numTriangles / 2);
+
+            // groups which hardly simplify become roots of the hierarchy
+            const size_t numSimplified = simplifier.GetNumTriangles();
+            if (0 == numSimplified || numSimplified * 20 > numTriangles * 17) {
+                for (const unsigned int i : group) {
+                    for (const unsigned int p : meshletPositions[i]) {
+                        fixed[p] = 1;
+                    }
+                }
+                continue;
+            }
+
+            // the error of the group includes the error of the meshlets it replaces
+            ai_real error = 0;
+            for (const unsigned int m : children) {
+                error = std::max(error, meshlets[m].mError);
+            }
+            error += static_cast<ai_real>(simplifier.GetError());
+            aiVector3D center;
+            ai_real radius;
+            MergeErrorSpheres(meshlets, children, center, radius);
+            for (const unsigned int m : children) {
+                meshlets[m].mParentError = error;
+                meshlets[m].mParentErrorCenter = center;
+                meshlets[m].mParentErrorRadius = radius;
+            }
+
+            // split the simplified triangles into the meshlets of the next level
+            const std::vector<unsigned int>& simplified = simplifier.GetIndices();
+            std::vector<aiFace> faces(numSimplified);
+            for (size_t f = 0; f < numSimplified; ++f) {
+                faces[f].mNumIndices = 3;
+                faces[f].mIndices = new unsigned int[3];
+                std::copy(simplified.begin() + f * 3, simplified.begin() + f * 3 + 3, faces[f].mIndices);
+            }
+            const size_t first = meshlets.size();
+            AppendMeshlets(mesh, faces.data(), static_cast<unsigned int>(numSimplified), numGroupVertices, groupMap.data(),
+                maxVertices, maxTriangles, meshlets, vertices, triangles);
+            for (size_t m = first; m < meshlets.size(); ++m) {
+                meshlets[m].mLevel = level;
+                meshlets[m].mError = error;
+                meshlets[m].mErrorCenter = center;
+                meshlets[m].mErrorRadius = radius;
+                next.push_back(static_cast<unsigned int>(m));
+            }
+        }
+
+        for (const std::vector<unsigned int>& list : meshletPositions) {
+            for (const unsigned int p : list) {
+                positionGroup[p] = UINT_MAX;
+            }
+        }
+        current.swap(next);
+    }
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+GenMeshletsProcess::GenMeshletsProcess()
+: BaseProcess()
+, mMaxVertices(AI_GM_DEFAULT_MAX_VERTICES)
+, mMaxTriangles(AI_GM_DEFAULT_MAX_TRIANGLES)
+, mClusterLOD(false) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+GenMeshletsProcess::~GenMeshletsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenMeshletsProcess::IsActive(unsigned int pFlags) const {
+    return 0 != ( pFlags & aiProcess_GenMeshlets );
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::SetupProperties(const Importer* pImp) {
+    const int maxVertices = pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES, AI_GM_DEFAULT_MAX_VERTICES);
+    const int maxTriangles = pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_TRIANGLES, AI_GM_DEFAULT_MAX_TRIANGLES);
+    SetLimits(static_cast<unsigned int>(std::max(maxVertices, 0)), static_cast<unsigned int>(std::max(maxTriangles, 0)));
+    SetClusterLOD(pImp->GetPropertyBool(AI_CONFIG_PP_GM_CLUSTER_LOD, false));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::SetLimits(unsigned int maxVertices, unsigned int maxTriangles) {
+    // meshlet triangles use 8 bit indices
+    mMaxVertices = std::min(std::max(maxVertices, 3u), 256u);
+    mMaxTriangles = std::max(maxTriangles, 1u);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::SetClusterLOD(bool clusterLOD) {
+    mClusterLOD = clusterLOD;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::Execute(aiScene* pScene) {
+    if (nullptr == pScene || 0 == pScene->mNumMeshes) {
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("GenMeshletsProcess begin");
+
+    unsigned int numMeshlets = 0;
+    ParallelForThenReport(pScene->mNumMeshes, [&](size_t a) {
+        return GenerateMeshlets(pScene->mMeshes[a]);
+    }, [&](size_t a, bool processed) {
+        if (!processed && pScene->mMeshes[a]->HasFaces()) {
+            ASSIMP_LOG_WARN_F("Mesh ", a, ": Meshlets are generated for triangle meshes only");
+        }
+        numMeshlets += pScene->mMeshes[a]->mNumMeshlets;
+    });
+    ASSIMP_LOG_INFO_F("GenMeshletsProcess finished. Generated ", numMeshlets, " meshlets");
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenMeshletsProcess::GenerateMeshlets(aiMesh* pMesh) const {
+    ai_assert(nullptr != pMesh);
+
+    if (aiPrimitiveType_TRIANGLE != pMesh->mPrimitiveTypes || !pMesh->HasFaces() || !pMesh->HasPositions()) {
+        return false;
+    }
+
+    // drop the meshlets of a previous run
+    delete[] pMesh->mMeshlets;
+    delete[] pMesh->mMeshletVertices;
+    delete[] pMesh->mMeshletTriangles;
+    pMesh->mMeshlets = nullptr;
+    pMesh->mMeshletVertices = nullptr;
+    pMesh->mMeshletTriangles = nullptr;
+    pMesh->mNumMeshlets = pMesh->mNumMeshletVertices = pMesh->mNumMeshletTriangleIndices = 0;
+
+    std::vector<aiMeshlet> meshlets;
+    std::vector<unsigned int> vertices;
+    std::vector<unsigned char> triangles;
+    meshlets.reserve(pMesh->mNumFaces / mMaxTriangles + 1);
+    vertices.reserve(pMesh->mNumFaces);
+    triangles.reserve(pMesh->mNumFaces * 3);
+
+    AppendMeshlets(pMesh, pMesh->mFaces, pMesh->mNumFaces, pMesh->mNumVertices, nullptr, mMaxVertices, mMaxTriangles,
+        meshlets, vertices, triangles);
+    if (mClusterLOD) {
+        AppendClusterLODs(pMesh, mMaxVertices, mMaxTriangles, meshlets, vertices, triangles);
+    }
+
+    // copy the result to the mesh
+    pMesh->mNumMeshlets = static_cast<unsigned int>(meshlets.size());
+    pMesh->mMeshlets = new aiMeshlet[meshlets.size()];
+    std::copy(meshlets.begin(), meshlets.end(), pMesh->mMeshlets);
+
+    pMesh->mNumMeshletVertices = static_cast<unsigned int>(vertices.size());
+    pMesh->mMeshletVertices = new unsigned int[vertices.size()];
+    std::copy(vertices.begin(), vertices.end(), pMesh->mMeshletVertices);
+
+    pMesh->mNumMeshletTriangleIndices = static_cast<unsigned int>(triangles.size());
+    pMesh->mMeshletTriangles = new unsigned char[triangles.size()];
+    std::copy(triangles.begin(), triangles.end(), pMesh->mMeshletTriangles);
+    return true;
+}
+
+} // Namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
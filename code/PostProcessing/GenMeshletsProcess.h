@@ -0,0 +1,98 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Defines a post-processing step to partition triangle meshes into
+ *        meshlets.
+ */
+
+#pragma once
+
+#ifndef AI_GENMESHLETSPROCESS_H_INC
+#define AI_GENMESHLETSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+struct aiMesh;
+
+namespace Assimp {
+
+/** Post-processing process to partition all triangle meshes of a scene into
+ *  meshlets, with a bounding sphere and a normal cone each. The meshlets are
+ *  grown greedily over the vertex-triangle adjacency, preferring triangles
+ *  which add the fewest vertices. Optionally, groups of neighbouring meshlets
+ *  are simplified level by level to a cluster-LOD hierarchy.
+ */
+class ASSIMP_API GenMeshletsProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    GenMeshletsProcess();
+    /// The class destructor.
+    ~GenMeshletsProcess();
+    /// Will return true, if aiProcess_GenMeshlets is defined.
+    bool IsActive(unsigned int pFlags) const override;
+    /// Reads the meshlet limits from the importer properties.
+    void SetupProperties(const Importer* pImp) override;
+    /// The execution callback.
+    void Execute(aiScene* pScene) override;
+
+    /// Sets the meshlet limits, vertices are clamped to [3, 256].
+    void SetLimits(unsigned int maxVertices, unsigned int maxTriangles);
+
+    /// Enables the cluster-LOD hierarchy on top of the meshlets.
+    void SetClusterLOD(bool clusterLOD);
+
+    /// Replaces the meshlets of a single mesh.
+    /// @return false if the mesh is no triangle mesh and was left alone.
+    bool GenerateMeshlets(aiMesh* pMesh) const;
+
+private:
+    unsigned int mMaxVertices;
+    unsigned int mMaxTriangles;
+    bool mClusterLOD;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#endif // AI_GENMESHLETSPROCESS_H_INC
@@ -43,163 +43,97 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /** @file Implementation of the post processing step to improve the cache locality of a mesh.
  * <br>
- * The algorithm is roughly basing on this paper:
- * http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf
- *   .. although overdraw reduction isn't implemented yet ...
+ * Two face reordering algorithms are available:
+ * - Tipsify, roughly basing on this paper:
+ *   http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf
+ * - Tom Forsyth's linear-speed vertex cache optimisation, which models a LRU cache:
+ *   https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+ * <br>
+ * Optionally, the reordered triangle clusters are sorted to reduce overdraw (as described in
+ * the Tipsify paper) and the vertex buffer is reordered to match the order in which the
+ * vertices are first referenced.
  */
 
 // internal headers
 #include "PostProcessing/ImproveCacheLocality.h"
 #include "Common/VertexTriangleAdjacency.h"
+#include "Common/ParallelFor.h"
 
 #include <assimp/StringUtils.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 #include <stdio.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include <stack>
 
 using namespace Assimp;
 
-// ------------------------------------------------------------------------------------------------
-// Constructor to be privately used by Importer
-ImproveCacheLocalityProcess::ImproveCacheLocalityProcess()
-: mConfigCacheDepth(PP_ICL_PTCACHE_SIZE) {
-    // empty
-}
-
-// ------------------------------------------------------------------------------------------------
-// Destructor, private as well
-ImproveCacheLocalityProcess::~ImproveCacheLocalityProcess() {
-    // nothing to do here
-}
+namespace {
 
 // ------------------------------------------------------------------------------------------------
-// Returns whether the processing step is present in the given flag field.
-bool ImproveCacheLocalityProcess::IsActive( unsigned int pFlags) const {
-    return (pFlags & aiProcess_ImproveCacheLocality) != 0;
-}
-
-// ------------------------------------------------------------------------------------------------
-// Setup configuration
-void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp) {
-    // AI_CONFIG_PP_ICL_PTCACHE_SIZE controls the target cache size for the optimizer
-    mConfigCacheDepth = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE,PP_ICL_PTCACHE_SIZE);
-}
-
-// ------------------------------------------------------------------------------------------------
-// Executes the post processing step on the given imported data.
-void ImproveCacheLocalityProcess::Execute( aiScene* pScene) {
-    if (!pScene->mNumMeshes) {
-        ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess skipped; there are no meshes");
-        return;
-    }
-
-    ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess begin");
-
-    float out = 0.f;
-    unsigned int numf = 0, numm = 0;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; ++a ){
-        const float res = ProcessMesh( pScene->mMeshes[a],a);
-        if (res) {
-            numf += pScene->mMeshes[a]->mNumFaces;
-            out  += res;
-            ++numm;
-        }
-    }
-    if (!DefaultLogger::isNullLogger()) {
-        if (numf > 0) {
-            ASSIMP_LOG_INFO_F("Cache relevant are ", numm, " meshes (", numf, " faces). Average output ACMR is ", out / numf);
+// Counts the cache misses of the faces of a mesh for a FIFO cache of the given size
+unsigned int CountCacheMisses(const aiMesh* pMesh, unsigned int iCacheDepth) {
+    // Cache time stamps - a vertex is in the cache as long as less than iCacheDepth
+    // other vertices have been loaded since it was loaded itself.
+    std::vector<unsigned int> stamps(pMesh->mNumVertices, 0);
+    unsigned int iStampCnt = iCacheDepth + 1;
+    unsigned int iCacheMisses = 0;
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        const aiFace& face = pMesh->mFaces[i];
+        for (unsigned int a = 0; a < face.mNumIndices; ++a) {
+            const unsigned int dp = face.mIndices[a];
+            if (iStampCnt - stamps[dp] > iCacheDepth) {
+                stamps[dp] = iStampCnt++;
+                ++iCacheMisses;
+            }
         }
-        ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess finished. ");
     }
+    return iCacheMisses;
 }
 
 // ------------------------------------------------------------------------------------------------
-// Improves the cache coherency of a specific mesh
-ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshNum) {
-    // TODO: rewrite this to use std::vector or boost::shared_array
-    ai_assert(nullptr != pMesh);
-
-    // Check whether the input data is valid
-    // - there must be vertices and faces
-    // - all faces must be triangulated or we can't operate on them
-    if (!pMesh->HasFaces() || !pMesh->HasPositions())
-        return static_cast<ai_real>(0.f);
-
-    if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
-        ASSIMP_LOG_ERROR("This algorithm works on triangle meshes only");
-        return static_cast<ai_real>(0.f);
-    }
-
-    if(pMesh->mNumVertices <= mConfigCacheDepth) {
-        return static_cast<ai_real>(0.f);
-    }
-
-    ai_real fACMR = 3.f;
-    const aiFace* const pcEnd = pMesh->mFaces+pMesh->mNumFaces;
-
-    // Input ACMR is for logging purposes only
-    if (!DefaultLogger::isNullLogger())     {
-
-        unsigned int* piFIFOStack = new unsigned int[mConfigCacheDepth];
-        memset(piFIFOStack,0xff,mConfigCacheDepth*sizeof(unsigned int));
-        unsigned int* piCur = piFIFOStack;
-        const unsigned int* const piCurEnd = piFIFOStack + mConfigCacheDepth;
-
-        // count the number of cache misses
-        unsigned int iCacheMisses = 0;
-        for (const aiFace* pcFace = pMesh->mFaces;pcFace != pcEnd;++pcFace) {
-            for (unsigned int qq = 0; qq < 3;++qq) {
-                bool bInCache = false;
-                for (unsigned int* pp = piFIFOStack;pp < piCurEnd;++pp) {
-                    if (*pp == pcFace->mIndices[qq])    {
-                        // the vertex is in cache
-                        bInCache = true;
-                        break;
-                    }
-                }
-                if (!bInCache)  {
-                    ++iCacheMisses;
-                    if (piCurEnd == piCur) {
-                        piCur = piFIFOStack;
-                    }
-                    *piCur++ = pcFace->mIndices[qq];
-                }
+// Counts the number of vertices referenced by at least one face
+unsigned int CountReferencedVertices(const aiMesh* pMesh) {
+    std::vector<bool> referenced(pMesh->mNumVertices, false);
+    unsigned int iCnt = 0;
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        const aiFace& face = pMesh->mFaces[i];
+        for (unsigned int a = 0; a < face.mNumIndices; ++a) {
+            if (!referenced[face.mIndices[a]]) {
+                referenced[face.mIndices[a]] = true;
+                ++iCnt;
             }
         }
-        delete[] piFIFOStack;
-        fACMR = (ai_real) iCacheMisses / pMesh->mNumFaces;
-        if (3.0 == fACMR)   {
-            char szBuff[128]; // should be sufficiently large in every case
-
-            // the JoinIdenticalVertices process has not been executed on this
-            // mesh, otherwise this value would normally be at least minimally
-            // smaller than 3.0 ...
-            ai_snprintf(szBuff,128,"Mesh %u: Not suitable for vcache optimization",meshNum);
-            ASSIMP_LOG_WARN(szBuff);
-            return static_cast<ai_real>(0.f);
-        }
     }
+    return iCnt;
+}
 
+// ------------------------------------------------------------------------------------------------
+// Tipsify: emits triangle fans around vertices which are likely to be still in the cache.
+// Appends the reordered triangles to the index buffer 'indices' and the first triangle of every
+// cluster to 'clusters'.
+void ComputeTipsifyOrder(const aiMesh* pMesh, unsigned int iCacheDepth,
+        std::vector<unsigned int>& indices, std::vector<unsigned int>& clusters) {
     // first we need to build a vertex-triangle adjacency list
     VertexTriangleAdjacency adj(pMesh->mFaces,pMesh->mNumFaces, pMesh->mNumVertices,true);
 
     // build a list to store per-vertex caching time stamps
-    unsigned int* const piCachingStamps = new unsigned int[pMesh->mNumVertices];
-    memset(piCachingStamps,0x0,pMesh->mNumVertices*sizeof(unsigned int));
-
-    // allocate an empty output index buffer. We store the output indices in one large array.
-    // Since the number of triangles won't change the input faces can be reused. This is how
-    // we save thousands of redundant mini allocations for aiFace::mIndices
-    const unsigned int iIdxCnt = pMesh->mNumFaces*3;
-    unsigned int* const piIBOutput = new unsigned int[iIdxCnt];
-    unsigned int* piCSIter = piIBOutput;
+    std::vector<unsigned int> piCachingStamps(pMesh->mNumVertices, 0);
 
     // allocate the flag array to hold the information
     // whether a face has already been emitted or not
     std::vector<bool> abEmitted(pMesh->mNumFaces,false);
 
+    // the triangles are visited in random order, a flat copy of their indices saves
+    // one cache miss per visit compared to aiFace::mIndices
+    std::vector<unsigned int> tris(pMesh->mNumFaces * 3);
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        std::copy(pMesh->mFaces[i].mIndices, pMesh->mFaces[i].mIndices + 3, &tris[i * 3]);
+    }
+
     // dead-end vertex index stack
     std::stack<unsigned int, std::vector<unsigned int> > sDeadEndVStack;
 
@@ -216,8 +150,7 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
         }
     }
     ai_assert(iMaxRefTris > 0);
-    unsigned int* piCandidates = new unsigned int[iMaxRefTris*3];
-    unsigned int iCacheMisses = 0;
+    std::vector<unsigned int> piCandidates(iMaxRefTris*3);
 
     // ...................................................................................
     /** PSEUDOCODE for the algorithm
@@ -251,12 +184,13 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
 
     int ivdx = 0;
     int ics = 1;
-    int iStampCnt = mConfigCacheDepth+1;
+    unsigned int iStampCnt = iCacheDepth+1;
+    clusters.push_back(static_cast<unsigned int>(indices.size() / 3));
     while (ivdx >= 0)   {
 
         unsigned int icnt = piNumTriPtrNoModify[ivdx];
         unsigned int* piList = adj.GetAdjacentTriangles(ivdx);
-        unsigned int* piCurCandidate = piCandidates;
+        unsigned int* piCurCandidate = &piCandidates[0];
 
         // get all triangles in the neighborhood
         for (unsigned int tri = 0; tri < icnt;++tri)    {
@@ -266,10 +200,9 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
             if (!abEmitted[fidx])   {
 
                 // so iterate through all vertices of the current triangle
-                const aiFace* pcFace = &pMesh->mFaces[ fidx ];
-                unsigned nind = pcFace->mNumIndices;
-                for (unsigned ind = 0; ind < nind; ind++) {
-                    unsigned dp = pcFace->mIndices[ind];
+                const unsigned int* piTri = &tris[fidx * 3];
+                for (unsigned ind = 0; ind < 3; ind++) {
+                    unsigned dp = piTri[ind];
 
                     // the current vertex won't have any free triangles after this step
                     if (ivdx != (int)dp) {
@@ -284,15 +217,14 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
                     }
 
                     // append the vertex to the output index buffer
-                    *piCSIter++ = dp;
+                    indices.push_back(dp);
 
                     // if the vertex is not yet in cache, set its cache count
-                    if (iStampCnt-piCachingStamps[dp] > mConfigCacheDepth) {
+                    if (iStampCnt-piCachingStamps[dp] > iCacheDepth) {
                         piCachingStamps[dp] = iStampCnt++;
-                        ++iCacheMisses;
                     }
                 }
-                // flag triangle as emitted
+                // flag the triangle as emitted
                 abEmitted[fidx] = true;
             }
         }
@@ -303,7 +235,7 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
         // get next fanning vertex
         ivdx = -1;
         int max_priority = -1;
-        for (unsigned int* piCur = piCandidates;piCur != piCurCandidate;++piCur)    {
+        for (unsigned int* piCur = &piCandidates[0];piCur != piCurCandidate;++piCur)    {
             const unsigned int dp = *piCur;
 
             // must have live triangles
@@ -312,7 +244,7 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
 
                 // will the vertex be in cache, even after fanning occurs?
                 unsigned int tmp;
-                if ((tmp = iStampCnt-piCachingStamps[dp]) + 2*piNumTriPtr[dp] <= mConfigCacheDepth) {
+                if ((tmp = iStampCnt-piCachingStamps[dp]) + 2*piNumTriPtr[dp] <= iCacheDepth) {
                     priority = tmp;
                 }
 
@@ -341,39 +273,453 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int me
                 // hope it is not too bad ...
                 while (ics < (int)pMesh->mNumVertices)  {
                     ++ics;
-                    if (piNumTriPtr[ics] > 0)   {
+                    if (ics < (int)pMesh->mNumVertices && piNumTriPtr[ics] > 0)   {
                         ivdx = ics;
                         break;
                     }
                 }
             }
+
+            // the fan doesn't continue the previous one - a hard boundary for overdraw sorting
+            if (-1 != ivdx) {
+                clusters.push_back(static_cast<unsigned int>(indices.size() / 3));
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Forsyth: greedily emits the triangle with the highest score, where the score of a triangle is
+// the sum of its vertices' scores. Vertices score high if they are at the front of a simulated
+// LRU cache and if only a few triangles still reference them.
+const unsigned int ForsythMaxCacheSize = 64;
+const unsigned int ForsythMaxValence = 64;
+
+void ComputeForsythOrder(const aiMesh* pMesh, unsigned int iCacheDepth,
+        std::vector<unsigned int>& indices, std::vector<unsigned int>& clusters) {
+    const unsigned int iCacheSize = std::max(4u, std::min(iCacheDepth, ForsythMaxCacheSize));
+    const unsigned int iNumFaces = pMesh->mNumFaces;
+
+    // precompute the score tables
+    float cacheScores[ForsythMaxCacheSize];
+    for (unsigned int i = 0; i < iCacheSize; ++i) {
+        if (i < 3) {
+            // the last triangle's vertices get a fixed score, so that it doesn't matter
+            // in which order they were added to the cache
+            cacheScores[i] = 0.75f;
+        } else {
+            cacheScores[i] = std::pow(1.f - static_cast<float>(i - 3) / static_cast<float>(iCacheSize - 3), 1.5f);
+        }
+    }
+    float valenceScores[ForsythMaxValence];
+    for (unsigned int i = 1; i < ForsythMaxValence; ++i) {
+        valenceScores[i] = 2.f / std::sqrt(static_cast<float>(i));
+    }
+    valenceScores[0] = 0.f;
+
+    // the state of the vertices, packed to be loaded with a single cache miss. The adjacency
+    // lists are kept partitioned, their first mNumLive entries are the triangles which
+    // haven't been emitted yet.
+    struct Vertex {
+        unsigned int mOffset;
+        unsigned int mNumLive;
+        int mCachePos;
+        float mScore;
+    };
+    const int iFrontOfCache = -2;
+    VertexTriangleAdjacency adj(pMesh->mFaces, iNumFaces, pMesh->mNumVertices, false);
+    unsigned int* const piAdjacency = adj.mAdjacencyTable;
+    auto computeScore = [&](const Vertex& v) {
+        if (0 == v.mNumLive) {
+            return -1.f;
+        }
+        float score = v.mNumLive < ForsythMaxValence ? valenceScores[v.mNumLive] : 2.f / std::sqrt(static_cast<float>(v.mNumLive));
+        if (v.mCachePos >= 0) {
+            score += cacheScores[v.mCachePos];
+        }
+        return score;
+    };
+    std::vector<Vertex> vertices(pMesh->mNumVertices);
+    for (unsigned int v = 0; v < pMesh->mNumVertices; ++v) {
+        Vertex& vert = vertices[v];
+        vert.mOffset = adj.mOffsetTable[v];
+        vert.mNumLive = adj.mOffsetTable[v + 1] - adj.mOffsetTable[v];
+        vert.mCachePos = -1;
+        vert.mScore = computeScore(vert);
+    }
+
+    // as for Tipsify, a flat copy of the indices saves a cache miss per visited triangle
+    std::vector<unsigned int> tris(iNumFaces * 3);
+    for (unsigned int f = 0; f < iNumFaces; ++f) {
+        std::copy(pMesh->mFaces[f].mIndices, pMesh->mFaces[f].mIndices + 3, &tris[f * 3]);
+    }
+
+    // the scores of the triangles aren't stored, they are summed up for the few triangles
+    // around the cached vertices instead of being updated for all of them
+    auto computeTriScore = [&](unsigned int f) {
+        return vertices[tris[f * 3]].mScore + vertices[tris[f * 3 + 1]].mScore + vertices[tris[f * 3 + 2]].mScore;
+    };
+    std::vector<bool> abEmitted(iNumFaces, false);
+    int iBest = -1;
+    float fBestScore = -1.f;
+
+    std::vector<unsigned int> cache, newCache;
+    cache.reserve(iCacheSize + 3);
+    newCache.reserve(iCacheSize + 3);
+
+    unsigned int iCursor = 0;
+    for (unsigned int iEmitted = 0; iEmitted < iNumFaces; ++iEmitted) {
+        if (iBest < 0) {
+            // no triangle left around the cached vertices (or none cached yet), continue
+            // in input order
+            while (abEmitted[iCursor]) {
+                ++iCursor;
+            }
+            iBest = iCursor;
+            clusters.push_back(static_cast<unsigned int>(indices.size() / 3));
+        }
+
+        const unsigned int* const face = &tris[iBest * 3];
+        indices.insert(indices.end(), face, face + 3);
+        abEmitted[iBest] = true;
+
+        // move the vertices of the triangle to the front of the cache, the marked cache
+        // positions tell which of the cached vertices are moved
+        newCache.clear();
+        for (unsigned int a = 0; a < 3; ++a) {
+            Vertex& vert = vertices[face[a]];
+            unsigned int* const piList = piAdjacency + vert.mOffset;
+            std::swap(*std::find(piList, piList + vert.mNumLive, static_cast<unsigned int>(iBest)), piList[vert.mNumLive - 1]);
+            --vert.mNumLive;
+            if (vert.mCachePos != iFrontOfCache) {
+                vert.mCachePos = iFrontOfCache;
+                newCache.push_back(face[a]);
+            }
+        }
+        for (unsigned int dp : cache) {
+            if (vertices[dp].mCachePos != iFrontOfCache) {
+                newCache.push_back(dp);
+            }
+        }
+
+        // update the scores of all vertices which are or were in the cache
+        for (unsigned int i = 0; i < newCache.size(); ++i) {
+            Vertex& vert = vertices[newCache[i]];
+            vert.mCachePos = i < iCacheSize ? static_cast<int>(i) : -1;
+            vert.mScore = computeScore(vert);
+        }
+        if (newCache.size() > iCacheSize) {
+            newCache.resize(iCacheSize);
+        }
+        cache.swap(newCache);
+
+        // the next triangle is the best one adjacent to a cached vertex
+        iBest = -1;
+        fBestScore = -1.f;
+        for (unsigned int dp : cache) {
+            const Vertex& vert = vertices[dp];
+            const unsigned int* const piList = piAdjacency + vert.mOffset;
+            for (unsigned int t = 0; t < vert.mNumLive; ++t) {
+                const float fTriScore = computeTriScore(piList[t]);
+                if (fTriScore > fBestScore) {
+                    fBestScore = fTriScore;
+                    iBest = piList[t];
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sorts the clusters of a triangle index buffer so that clusters facing away from the mesh center
+// come first. They are the likely occluders of the remaining clusters, which reduces overdraw.
+void SortClustersForOverdraw(const aiMesh* pMesh, std::vector<unsigned int>& indices,
+        const std::vector<unsigned int>& clusters) {
+    const size_t iNumClusters = clusters.size();
+    if (iNumClusters < 2) {
+        return;
+    }
+
+    struct Cluster {
+        unsigned int mBegin, mEnd;
+        aiVector3D mCenter, mNormal;
+        ai_real mArea, mSortKey;
+    };
+    std::vector<Cluster> data(iNumClusters);
+
+    aiVector3D meshCenter;
+    ai_real meshArea = 0.0;
+    for (size_t c = 0; c < iNumClusters; ++c) {
+        Cluster& cl = data[c];
+        cl.mBegin = clusters[c];
+        cl.mEnd = c + 1 < iNumClusters ? clusters[c + 1] : static_cast<unsigned int>(indices.size() / 3);
+        cl.mArea = 0.0;
+        for (unsigned int i = cl.mBegin; i < cl.mEnd; ++i) {
+            const aiVector3D& v0 = pMesh->mVertices[indices[i * 3]];
+            const aiVector3D& v1 = pMesh->mVertices[indices[i * 3 + 1]];
+            const aiVector3D& v2 = pMesh->mVertices[indices[i * 3 + 2]];
+            const aiVector3D n = (v1 - v0) ^ (v2 - v0);
+            const ai_real area = n.Length();
+            cl.mNormal += n;
+            cl.mCenter += (v0 + v1 + v2) * (area / static_cast<ai_real>(3.0));
+            cl.mArea += area;
+        }
+        meshCenter += cl.mCenter;
+        meshArea += cl.mArea;
+        if (cl.mArea > 0.0) {
+            cl.mCenter /= cl.mArea;
+        }
+    }
+    if (meshArea > 0.0) {
+        meshCenter /= meshArea;
+    }
+
+    for (Cluster& cl : data) {
+        const ai_real len = cl.mNormal.Length();
+        cl.mSortKey = len > 0.0 ? ((cl.mCenter - meshCenter) * cl.mNormal) / len : static_cast<ai_real>(0.0);
+    }
+    std::stable_sort(data.begin(), data.end(), [](const Cluster& a, const Cluster& b) {
+        return a.mSortKey > b.mSortKey;
+    });
+
+    std::vector<unsigned int> sorted;
+    sorted.reserve(indices.size());
+    for (const Cluster& cl : data) {
+        sorted.insert(sorted.end(), indices.begin() + cl.mBegin * 3, indices.begin() + cl.mEnd * 3);
+    }
+    indices.swap(sorted);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Moves the elements of a vertex stream to their new positions
+template <typename T>
+void RemapVertexStream(T*& pData, const std::vector<unsigned int>& remap) {
+    if (nullptr == pData) {
+        return;
+    }
+    T* pOut = new T[remap.size()];
+    for (unsigned int i = 0; i < remap.size(); ++i) {
+        pOut[remap[i]] = pData[i];
+    }
+    delete[] pData;
+    pData = pOut;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reorders the vertex buffer of a mesh so that vertices are stored in the order in which
+// the faces reference them for the first time. Unreferenced vertices are moved to the end.
+void OptimizeVertexFetch(aiMesh* pMesh) {
+    const unsigned int iUnused = UINT_MAX;
+    std::vector<unsigned int> remap(pMesh->mNumVertices, iUnused);
+    unsigned int iNext = 0;
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        aiFace& face = pMesh->mFaces[i];
+        for (unsigned int a = 0; a < face.mNumIndices; ++a) {
+            unsigned int& idx = remap[face.mIndices[a]];
+            if (iUnused == idx) {
+                idx = iNext++;
+            }
+            face.mIndices[a] = idx;
+        }
+    }
+    for (unsigned int& idx : remap) {
+        if (iUnused == idx) {
+            idx = iNext++;
         }
     }
-    ai_real fACMR2 = 0.0f;
-    if (!DefaultLogger::isNullLogger()) {
-        fACMR2 = (float)iCacheMisses / pMesh->mNumFaces;
+
+    RemapVertexStream(pMesh->mVertices, remap);
+    RemapVertexStream(pMesh->mNormals, remap);
+    RemapVertexStream(pMesh->mTangents, remap);
+    RemapVertexStream(pMesh->mBitangents, remap);
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+        RemapVertexStream(pMesh->mColors[a], remap);
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+        RemapVertexStream(pMesh->mTextureCoords[a], remap);
+    }
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+        aiBone* bone = pMesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            bone->mWeights[w].mVertexId = remap[bone->mWeights[w].mVertexId];
+        }
+    }
+    for (unsigned int m = 0; m < pMesh->mNumAnimMeshes; ++m) {
+        aiAnimMesh* anim = pMesh->mAnimMeshes[m];
+        if (anim->mNumVertices != pMesh->mNumVertices) {
+            continue;
+        }
+        RemapVertexStream(anim->mVertices, remap);
+        RemapVertexStream(anim->mNormals, remap);
+        RemapVertexStream(anim->mTangents, remap);
+        RemapVertexStream(anim->mBitangents, remap);
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+            RemapVertexStream(anim->mColors[a], remap);
+        }
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+            RemapVertexStream(anim->mTextureCoords[a], remap);
+        }
+    }
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+ImproveCacheLocalityProcess::ImproveCacheLocalityProcess()
+: mConfigCacheDepth(PP_ICL_PTCACHE_SIZE)
+, mConfigMethod(PP_ICL_METHOD_TIPSIFY)
+, mConfigOptimizeVertexFetch(false)
+, mConfigOptimizeOverdraw(false) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+ImproveCacheLocalityProcess::~ImproveCacheLocalityProcess() {
+    // nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool ImproveCacheLocalityProcess::IsActive( unsigned int pFlags) const {
+    return (pFlags & aiProcess_ImproveCacheLocality) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp) {
+    // AI_CONFIG_PP_ICL_PTCACHE_SIZE controls the target cache size for the optimizer
+    mConfigCacheDepth = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE,PP_ICL_PTCACHE_SIZE);
+    mConfigMethod = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_METHOD,PP_ICL_METHOD_TIPSIFY);
+    mConfigOptimizeVertexFetch = pImp->GetPropertyBool(AI_CONFIG_PP_ICL_OPTIMIZE_VERTEX_FETCH,false);
+    mConfigOptimizeOverdraw = pImp->GetPropertyBool(AI_CONFIG_PP_ICL_OPTIMIZE_OVERDRAW,false);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void ImproveCacheLocalityProcess::Execute( aiScene* pScene) {
+    if (!pScene->mNumMeshes) {
+        ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess skipped; there are no meshes");
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess begin");
+
+    const bool bStatistics = !DefaultLogger::isNullLogger();
+    unsigned int numf = 0, numm = 0, numv = 0, missesIn = 0, missesOut = 0;
+    ParallelForThenReport(pScene->mNumMeshes, [&](size_t a) {
+        return ProcessMesh( pScene->mMeshes[a], bStatistics);
+    }, [&](size_t a, const MeshStatistics& st) {
+        if (!bStatistics) {
+            return;
+        }
+        if (pScene->mMeshes[a]->mPrimitiveTypes != aiPrimitiveType_TRIANGLE && pScene->mMeshes[a]->HasFaces()) {
+            ASSIMP_LOG_ERROR("This algorithm works on triangle meshes only");
+        }
+        if (!st.mNumFaces) {
+            return;
+        }
+        if (st.mNumVertices == 3 * st.mNumFaces) {
+            // the JoinIdenticalVertices process has not been executed on this
+            // mesh, otherwise this value would normally be at least minimally
+            // smaller than 3.0 ...
+            ASSIMP_LOG_WARN_F("Mesh ", a, ": Not suitable for vcache optimization");
+            return;
+        }
 
         // very intense verbose logging ... prepare for much text if there are many meshes
         if ( DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
-            ASSIMP_LOG_DEBUG_F("Mesh %u | ACMR in: ", meshNum, " out: ", fACMR, " | ~", fACMR2, ((fACMR - fACMR2) / fACMR) * 100.f);
+            ASSIMP_LOG_DEBUG_F("Mesh ", a, " | ACMR in: ", st.mNumCacheMissesIn / (float)st.mNumFaces,
+                " out: ", st.mNumCacheMissesOut / (float)st.mNumFaces,
+                " | ATVR in: ", st.mNumCacheMissesIn / (float)st.mNumVertices,
+                " out: ", st.mNumCacheMissesOut / (float)st.mNumVertices);
+        }
+
+        numf += st.mNumFaces;
+        numv += st.mNumVertices;
+        missesIn += st.mNumCacheMissesIn;
+        missesOut += st.mNumCacheMissesOut;
+        ++numm;
+    });
+
+    if (bStatistics) {
+        if (numf > 0) {
+            ASSIMP_LOG_INFO_F("Cache relevant are ", numm, " meshes (", numf, " faces). Average ACMR is ",
+                missesIn / (float)numf, " in, ", missesOut / (float)numf, " out. Average ATVR is ",
+                missesIn / (float)numv, " in, ", missesOut / (float)numv, " out");
         }
+        ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess finished. ");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Improves the cache coherency of a specific mesh
+ImproveCacheLocalityProcess::MeshStatistics ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, bool bStatistics) {
+    ai_assert(nullptr != pMesh);
+    MeshStatistics stats;
+
+    // Check whether the input data is valid
+    // - there must be vertices and faces
+    // - all faces must be triangulated or we can't operate on them
+    if (!pMesh->HasFaces() || !pMesh->HasPositions()) {
+        return stats;
+    }
+
+    if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+        return stats;
+    }
 
-        fACMR2 *= pMesh->mNumFaces;
+    // if no vertex is shared, there is nothing to optimize and every index is a cache miss
+    stats.mNumFaces = pMesh->mNumFaces;
+    stats.mNumVertices = CountReferencedVertices(pMesh);
+    if (stats.mNumVertices == 3 * pMesh->mNumFaces) {
+        stats.mNumCacheMissesIn = stats.mNumCacheMissesOut = stats.mNumVertices;
+        return stats;
     }
-    // sort the output index buffer back to the input array
-    piCSIter = piIBOutput;
-    for (aiFace* pcFace = pMesh->mFaces; pcFace != pcEnd;++pcFace)  {
-        unsigned nind = pcFace->mNumIndices;
-        unsigned * ind = pcFace->mIndices;
-        if (nind > 0) ind[0] = *piCSIter++;
-        if (nind > 1) ind[1] = *piCSIter++;
-        if (nind > 2) ind[2] = *piCSIter++;
+
+    // the cache misses are for logging purposes only
+    if (bStatistics) {
+        stats.mNumCacheMissesIn = stats.mNumCacheMissesOut = CountCacheMisses(pMesh, mConfigCacheDepth);
     }
 
-    // delete temporary storage
-    delete[] piCachingStamps;
-    delete[] piIBOutput;
-    delete[] piCandidates;
+    // If all vertices fit into the cache, the face order can't get any better - but the
+    // faces may still be sorted against overdraw and the vertex buffer for fetch locality.
+    // The reordered triangles are collected in one index buffer and copied back to the
+    // input faces, since the number of triangles won't change. This is how we save
+    // thousands of redundant mini allocations for aiFace::mIndices
+    std::vector<unsigned int> indices;
+    std::vector<unsigned int> clusters;
+    indices.reserve(pMesh->mNumFaces * 3);
+    if (pMesh->mNumVertices > mConfigCacheDepth) {
+        if (PP_ICL_METHOD_FORSYTH == mConfigMethod) {
+            ComputeForsythOrder(pMesh, mConfigCacheDepth, indices, clusters);
+        } else {
+            ComputeTipsifyOrder(pMesh, mConfigCacheDepth, indices, clusters);
+        }
+    } else if (mConfigOptimizeOverdraw) {
+        for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+            indices.insert(indices.end(), pMesh->mFaces[i].mIndices, pMesh->mFaces[i].mIndices + 3);
+        }
+        clusters.push_back(0);
+    }
 
-    return fACMR2;
+    if (!indices.empty()) {
+        ai_assert(indices.size() == pMesh->mNumFaces * 3);
+        if (mConfigOptimizeOverdraw) {
+            SortClustersForOverdraw(pMesh, indices, clusters);
+        }
+
+        for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+            std::copy(&indices[i * 3], &indices[i * 3] + 3, pMesh->mFaces[i].mIndices);
+        }
+        if (bStatistics) {
+            stats.mNumCacheMissesOut = CountCacheMisses(pMesh, mConfigCacheDepth);
+        }
+    }
+
+    if (mConfigOptimizeVertexFetch) {
+        OptimizeVertexFetch(pMesh);
+    }
+    return stats;
 }
@@ -59,9 +59,13 @@ namespace Assimp
  *  cache locality. It tries to arrange all faces to fans and to render
  *  faces which share vertices directly one after the other.
  *
+ *  The reordering algorithm is chosen through #AI_CONFIG_PP_ICL_METHOD.
+ *  Optionally, triangle clusters are sorted to reduce overdraw and the
+ *  vertex buffer is reordered for better vertex fetch locality.
+ *
  *  @note This step expects triagulated input data.
  */
-class ImproveCacheLocalityProcess : public BaseProcess
+class ASSIMP_API ImproveCacheLocalityProcess : public BaseProcess
 {
 public:
 
@@ -83,17 +87,50 @@ public:
     void SetupProperties(const Importer* pImp);
 
 protected:
+    // -------------------------------------------------------------------
+    /** Cache statistics of a single mesh, before and after processing */
+    struct MeshStatistics {
+        MeshStatistics()
+        : mNumFaces(0)
+        , mNumVertices(0)
+        , mNumCacheMissesIn(0)
+        , mNumCacheMissesOut(0) {
+            // empty
+        }
+
+        //! Number of faces, 0 if the mesh was not processed
+        unsigned int mNumFaces;
+        //! Number of referenced vertices
+        unsigned int mNumVertices;
+        //! Cache misses of the input and output face order
+        unsigned int mNumCacheMissesIn, mNumCacheMissesOut;
+    };
+
     // -------------------------------------------------------------------
     /** Executes the postprocessing step on the given mesh
      * @param pMesh The mesh to process.
-     * @param meshNum Index of the mesh to process
+     * @param bStatistics Whether the cache misses are counted.
+     * @return Cache statistics of the mesh. Doesn't log, so
+     *   meshes may be processed concurrently.
      */
-    ai_real ProcessMesh( aiMesh* pMesh, unsigned int meshNum);
+    MeshStatistics ProcessMesh( aiMesh* pMesh, bool bStatistics);
 
 private:
     //! Configuration parameter: specifies the size of the cache to
     //! optimize the vertex data for.
     unsigned int mConfigCacheDepth;
+
+    //! Configuration parameter: reordering algorithm,
+    //! one of the PP_ICL_METHOD_XXX values.
+    int mConfigMethod;
+
+    //! Configuration parameter: reorder the vertex buffer in
+    //! order of first use.
+    bool mConfigOptimizeVertexFetch;
+
+    //! Configuration parameter: sort triangle clusters to
+    //! reduce overdraw.
+    bool mConfigOptimizeOverdraw;
 };
 
 } // end of namespace Assimp
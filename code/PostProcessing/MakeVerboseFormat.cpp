@@ -48,8 +48,58 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <algorithm>
+#include <climits>
+#include <vector>
+
 using namespace Assimp;
 
+// ------------------------------------------------------------------------------------------------
+// Gathers the elements of a quantized or packed stream for the new vertices
+template <typename T>
+static void RemapVertexStream(T*& stream, unsigned int numComponents, const std::vector<unsigned int>& sources)
+{
+    if (nullptr == stream) {
+        return;
+    }
+    T* remapped = new T[sources.size() * numComponents];
+    for (size_t i = 0; i < sources.size(); ++i) {
+        std::copy(stream + sources[i] * numComponents, stream + (sources[i] + 1) * numComponents, remapped + i * numComponents);
+    }
+    delete[] stream;
+    stream = remapped;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void RemapQuantizedVertices(aiQuantizedVertices& quantized, const std::vector<unsigned int>& sources)
+{
+    RemapVertexStream(quantized.mPositions, 3, sources);
+    RemapVertexStream(quantized.mNormals, 2, sources);
+    RemapVertexStream(quantized.mTangents, 2, sources);
+    for (unsigned int p = 0; p < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++p) {
+        RemapVertexStream(quantized.mTextureCoords[p], quantized.mNumUVComponents[p], sources);
+    }
+    for (unsigned int p = 0; p < AI_MAX_NUMBER_OF_COLOR_SETS; ++p) {
+        RemapVertexStream(quantized.mColors[p], 4, sources);
+    }
+    quantized.mNumVertices = static_cast<unsigned int>(sources.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+// The meshlets refer to the old vertices, each of them moves to its first copy
+static void RemapMeshletVertices(aiMesh& mesh, unsigned int numOldVertices, const std::vector<unsigned int>& sources)
+{
+    std::vector<unsigned int> firstCopy(numOldVertices, UINT_MAX);
+    for (size_t i = sources.size(); i-- > 0;) {
+        firstCopy[sources[i]] = static_cast<unsigned int>(i);
+    }
+    for (unsigned int i = 0; i < mesh.mNumMeshletVertices; ++i) {
+        // the meshlets are built from the faces, so all of their vertices have copies
+        ai_assert(UINT_MAX != firstCopy[mesh.mMeshletVertices[i]]);
+        mesh.mMeshletVertices[i] = firstCopy[mesh.mMeshletVertices[i]];
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 MakeVerboseFormatProcess::MakeVerboseFormatProcess()
 {
@@ -122,6 +172,12 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
         newWeights[i].reserve(pcMesh->mBones[i]->mNumWeights*3);
     }
 
+    // the quantized and packed bone streams and the meshlets follow the vertices
+    std::vector<unsigned int> sourceVertices;
+    if (pcMesh->mQuantizedVertices || pcMesh->mNumBoneInfluences || pcMesh->mNumMeshletVertices) {
+        sourceVertices.resize(iNumVerts, 0);
+    }
+
     // iterate through all faces and build a clean list
     unsigned int iIndex = 0;
     for (unsigned int a = 0; a< pcMesh->mNumFaces;++a)
@@ -146,6 +202,10 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
             }
 
             pvPositions[iIndex] = pcMesh->mVertices[pcFace->mIndices[q]];
+            if (!sourceVertices.empty())
+            {
+                sourceVertices[iIndex] = pcFace->mIndices[q];
+            }
 
             if (pcMesh->HasNormals())
             {
@@ -209,6 +269,19 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh* pcMesh)
         ++p;
     }
     pcMesh->mNumVertices = iNumVerts;
+    if (pcMesh->mQuantizedVertices)
+    {
+        RemapQuantizedVertices(*pcMesh->mQuantizedVertices, sourceVertices);
+    }
+    if (pcMesh->mNumBoneInfluences)
+    {
+        RemapVertexStream(pcMesh->mPackedBoneIndices, pcMesh->mNumBoneInfluences, sourceVertices);
+        RemapVertexStream(pcMesh->mPackedBoneWeights, pcMesh->mNumBoneInfluences, sourceVertices);
+    }
+    if (pcMesh->mNumMeshletVertices)
+    {
+        RemapMeshletVertices(*pcMesh, iOldNumVertices, sourceVertices);
+    }
 
     if (pcMesh->HasNormals())
     {
@@ -0,0 +1,419 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Implementation of the quadric error mesh simplifier.
+ */
+
+#include "PostProcessing/MeshSimplifier.h"
+
+#include <assimp/mesh.h>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// How a position may be collapsed onto one of its neighbours
+enum VertexKind {
+    // inside a single attribute region, may collapse along any edge
+    VertexKind_Manifold,
+    // on an open border, may collapse along the border only
+    VertexKind_Border,
+    // on a seam between two attribute regions, may collapse along the seam only
+    VertexKind_Seam,
+    // corners, non-manifold vertices and junctions of seams and borders
+    VertexKind_Locked
+};
+
+// ------------------------------------------------------------------------------------------------
+inline uint64_t EdgeKey(unsigned int a, unsigned int b) {
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+// ------------------------------------------------------------------------------------------------
+struct PositionHash {
+    size_t operator()(const aiVector3D& v) const {
+        // adding zero maps -0 to +0, so equal positions get equal hashes
+        const ai_real c[3] = { v.x + static_cast<ai_real>(0), v.y + static_cast<ai_real>(0), v.z + static_cast<ai_real>(0) };
+        size_t hash = 0;
+        for (const ai_real value : c) {
+            hash = hash * 31 + std::hash<ai_real>()(value);
+        }
+        return hash;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// The faces of a mesh as a triangle list
+std::vector<unsigned int> GetTriangleIndices(const aiMesh* mesh) {
+    std::vector<unsigned int> indices;
+    indices.reserve(mesh->mNumFaces * 3);
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        const aiFace& face = mesh->mFaces[f];
+        if (3 == face.mNumIndices) {
+            indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
+        }
+    }
+    return indices;
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+MeshSimplifier::MeshSimplifier(const aiMesh* mesh)
+: MeshSimplifier(mesh->mVertices, mesh->mNumVertices, GetTriangleIndices(mesh)) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshSimplifier::MeshSimplifier(const aiVector3D* vertices, unsigned int numVertices, const std::vector<unsigned int>& indices)
+: mVertices(vertices)
+, mNumVertices(numVertices)
+, mPosition(numVertices)
+, mQuadrics(numVertices)
+, mKind(numVertices, VertexKind_Locked)
+, mLocked(numVertices, 0)
+, mError(0) {
+    std::unordered_map<aiVector3D, unsigned int, PositionHash> positions;
+    positions.reserve(numVertices);
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        mPosition[i] = positions.insert(std::make_pair(vertices[i], i)).first->second;
+    }
+
+    // triangles which are degenerate already are dropped
+    mIndices.reserve(indices.size());
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const unsigned int p0 = mPosition[indices[t]], p1 = mPosition[indices[t + 1]], p2 = mPosition[indices[t + 2]];
+        if (p0 == p1 || p1 == p2 || p2 == p0) {
+            continue;
+        }
+        mIndices.insert(mIndices.end(), indices.begin() + t, indices.begin() + t + 3);
+
+        // area weighted plane of the triangle
+        aiVector3D normal = (vertices[p1] - vertices[p0]) ^ (vertices[p2] - vertices[p0]);
+        const ai_real area = normal.Length();
+        if (area > 0) {
+            normal /= area;
+            const Quadric plane(normal, -(normal * vertices[p0]), area);
+            mQuadrics[p0] += plane;
+            mQuadrics[p1] += plane;
+            mQuadrics[p2] += plane;
+        }
+    }
+
+    // open borders keep their shape with planes perpendicular to their triangles
+    Classify();
+    for (size_t t = 0; t < mIndices.size(); t += 3) {
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int a = mIndices[t + k], b = mIndices[t + (k + 1) % 3];
+            if (EdgeKind_Border != GetEdgeKind(a, b)) {
+                continue;
+            }
+            const unsigned int p0 = mPosition[a], p1 = mPosition[b], p2 = mPosition[mIndices[t + (k + 2) % 3]];
+            const aiVector3D edge = vertices[p1] - vertices[p0];
+            const aiVector3D normal = edge ^ (vertices[p2] - vertices[p0]);
+            aiVector3D side = edge ^ normal;
+            const ai_real length = side.Length();
+            if (length > 0) {
+                side /= length;
+                const Quadric plane(side, -(side * vertices[p0]), 2 * edge.SquareLength());
+                mQuadrics[p0] += plane;
+                mQuadrics[p1] += plane;
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::Lock(unsigned int vertex) {
+    mLocked[mPosition[vertex]] = 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Updates the edge lookups, the vertex kinds and the triangles around each position
+void MeshSimplifier::Classify() {
+    const unsigned int numVertices = mNumVertices;
+
+    mPositionEdges.clear();
+    mVertexEdges.clear();
+    mPositionEdges.reserve(mIndices.size());
+    mVertexEdges.reserve(mIndices.size());
+    for (size_t t = 0; t < mIndices.size(); t += 3) {
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int a = mIndices[t + k], b = mIndices[t + (k + 1) % 3];
+            ++mPositionEdges[EdgeKey(mPosition[a], mPosition[b])];
+            mVertexEdges.insert(EdgeKey(a, b));
+        }
+    }
+
+    // count the vertices, borders and seams at each position
+    std::vector<unsigned int> wedges(numVertices, 0), borders(numVertices, 0), seams(numVertices, 0);
+    std::vector<char> used(numVertices, 0), nonManifold(numVertices, 0);
+    for (size_t t = 0; t < mIndices.size(); t += 3) {
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int a = mIndices[t + k], b = mIndices[t + (k + 1) % 3];
+            const unsigned int p = mPosition[a], q = mPosition[b];
+            if (!used[a]) {
+                used[a] = 1;
+                ++wedges[p];
+            }
+            if (mPositionEdges.find(EdgeKey(p, q))->second > 1) {
+                nonManifold[p] = nonManifold[q] = 1;
+            }
+            switch (GetEdgeKind(a, b)) {
+            case EdgeKind_Border:
+                ++borders[p];
+                ++borders[q];
+                break;
+            case EdgeKind_Seam:
+                // both half-edges are open, count one of them
+                if (p < q) {
+                    ++seams[p];
+                    ++seams[q];
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    for (unsigned int p = 0; p < numVertices; ++p) {
+        unsigned char kind = VertexKind_Locked;
+        if (nonManifold[p] || mPosition[p] != p || mLocked[p]) {
+            kind = VertexKind_Locked;
+        } else if (1 == wedges[p] && 0 == borders[p] && 0 == seams[p]) {
+            kind = VertexKind_Manifold;
+        } else if (1 == wedges[p] && 2 == borders[p] && 0 == seams[p]) {
+            kind = VertexKind_Border;
+        } else if (2 == wedges[p] && 0 == borders[p] && 2 == seams[p]) {
+            kind = VertexKind_Seam;
+        }
+        mKind[p] = kind;
+    }
+
+    // triangles around each position
+    mTriangleOffsets.assign(numVertices + 1, 0);
+    for (const unsigned int v : mIndices) {
+        ++mTriangleOffsets[mPosition[v] + 1];
+    }
+    std::partial_sum(mTriangleOffsets.begin(), mTriangleOffsets.end(), mTriangleOffsets.begin());
+    mTriangles.resize(mIndices.size());
+    std::vector<unsigned int> fill(mTriangleOffsets.begin(), mTriangleOffsets.end() - 1);
+    for (size_t i = 0; i < mIndices.size(); ++i) {
+        mTriangles[fill[mPosition[mIndices[i]]]++] = static_cast<unsigned int>(i / 3);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshSimplifier::EdgeKind MeshSimplifier::GetEdgeKind(unsigned int a, unsigned int b) const {
+    if (mPositionEdges.end() == mPositionEdges.find(EdgeKey(mPosition[b], mPosition[a]))) {
+        return EdgeKind_Border;
+    }
+    if (mVertexEdges.end() == mVertexEdges.find(EdgeKey(b, a))) {
+        return EdgeKind_Seam;
+    }
+    return EdgeKind_Inner;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool MeshSimplifier::CanCollapse(unsigned int from, EdgeKind edge) const {
+    switch (mKind[from]) {
+    case VertexKind_Manifold:
+        return true;
+    case VertexKind_Border:
+        return EdgeKind_Border == edge;
+    case VertexKind_Seam:
+        return EdgeKind_Seam == edge;
+    default:
+        return false;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool MeshSimplifier::TryCollapse(unsigned int from, unsigned int to, std::vector<unsigned int>& remap,
+        std::vector<char>& locked, size_t& removed) {
+    const aiVector3D* vertices = mVertices;
+    const aiVector3D& target = vertices[to];
+
+    unsigned int mapped[2][2], numMapped = 0;
+    size_t collapsed = 0;
+    for (unsigned int i = mTriangleOffsets[from]; i < mTriangleOffsets[from + 1]; ++i) {
+        const unsigned int* tri = &mIndices[mTriangles[i] * 3];
+        unsigned int k = 0;
+        while (mPosition[tri[k]] != from) {
+            ++k;
+        }
+        const unsigned int v = tri[k], b = tri[(k + 1) % 3], c = tri[(k + 2) % 3];
+
+        if (mPosition[b] == to || mPosition[c] == to) {
+            // the triangle degenerates, its vertex at the target takes over
+            const unsigned int w = mPosition[b] == to ? b : c;
+            ++collapsed;
+            bool known = false;
+            for (unsigned int m = 0; m < numMapped; ++m) {
+                known = known || mapped[m][0] == v;
+            }
+            if (!known) {
+                if (2 == numMapped) {
+                    return false;
+                }
+                mapped[numMapped][0] = v;
+                mapped[numMapped++][1] = w;
+            }
+            continue;
+        }
+
+        // reject the collapse if it turns the triangle too far
+        const aiVector3D& pb = vertices[mPosition[b]];
+        const aiVector3D& pc = vertices[mPosition[c]];
+        const aiVector3D before = (pb - vertices[from]) ^ (pc - vertices[from]);
+        const aiVector3D after = (pb - target) ^ (pc - target);
+        if (before * after <= static_cast<ai_real>(0.25) * std::sqrt(before.SquareLength() * after.SquareLength())) {
+            return false;
+        }
+    }
+
+    // all vertices at the position need a counterpart at the target
+    const unsigned int expected = VertexKind_Seam == mKind[from] ? 2 : 1;
+    if (numMapped != expected) {
+        return false;
+    }
+
+    for (unsigned int m = 0; m < numMapped; ++m) {
+        remap[mapped[m][0]] = mapped[m][1];
+    }
+    mQuadrics[to] += mQuadrics[from];
+    if (mQuadrics[to].w > 0) {
+        mError = std::max(mError, std::sqrt(mQuadrics[to].Error(target) / mQuadrics[to].w));
+    }
+
+    // the neighbourhood is stale until the next pass
+    for (unsigned int i = mTriangleOffsets[from]; i < mTriangleOffsets[from + 1]; ++i) {
+        const unsigned int* tri = &mIndices[mTriangles[i] * 3];
+        for (unsigned int k = 0; k < 3; ++k) {
+            locked[mPosition[tri[k]]] = 1;
+        }
+    }
+    locked[to] = 1;
+    removed += collapsed;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::Simplify(size_t target) {
+    const aiVector3D* vertices = mVertices;
+    const unsigned int numVertices = mNumVertices;
+
+    std::vector<Collapse> collapses;
+    std::vector<unsigned int> remap(numVertices);
+    std::vector<char> locked(numVertices);
+
+    while (GetNumTriangles() > target) {
+        Classify();
+
+        // the cheaper direction of each edge which may be collapsed
+        collapses.clear();
+        for (size_t t = 0; t < mIndices.size(); t += 3) {
+            for (unsigned int k = 0; k < 3; ++k) {
+                const unsigned int a = mIndices[t + k], b = mIndices[t + (k + 1) % 3];
+                const unsigned int p = mPosition[a], q = mPosition[b];
+                const EdgeKind edge = GetEdgeKind(a, b);
+
+                // inner edges are visited twice, once is enough
+                if (EdgeKind_Border != edge && p > q) {
+                    continue;
+                }
+
+                Quadric merged = mQuadrics[p];
+                merged += mQuadrics[q];
+                const double costPQ = CanCollapse(p, edge) ? merged.Error(vertices[q]) : std::numeric_limits<double>::max();
+                const double costQP = CanCollapse(q, edge) ? merged.Error(vertices[p]) : std::numeric_limits<double>::max();
+                if (costPQ == std::numeric_limits<double>::max() && costQP == std::numeric_limits<double>::max()) {
+                    continue;
+                }
+                Collapse collapse;
+                collapse.from = costPQ <= costQP ? p : q;
+                collapse.to = costPQ <= costQP ? q : p;
+                collapse.cost = std::min(costPQ, costQP);
+                collapses.push_back(collapse);
+            }
+        }
+        std::sort(collapses.begin(), collapses.end());
+
+        // collapse the cheapest edges which don't touch each other
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::fill(locked.begin(), locked.end(), 0);
+        const size_t excess = GetNumTriangles() - target;
+        size_t removed = 0;
+        for (const Collapse& collapse : collapses) {
+            if (removed >= excess) {
+                break;
+            }
+            if (!locked[collapse.from] && !locked[collapse.to]) {
+                TryCollapse(collapse.from, collapse.to, remap, locked, removed);
+            }
+        }
+        if (0 == removed) {
+            break;
+        }
+
+        // move the triangles onto the remaining vertices and drop the degenerate ones
+        size_t write = 0;
+        for (size_t t = 0; t < mIndices.size(); t += 3) {
+            const unsigned int a = remap[mIndices[t]], b = remap[mIndices[t + 1]], c = remap[mIndices[t + 2]];
+            if (mPosition[a] == mPosition[b] || mPosition[b] == mPosition[c] || mPosition[c] == mPosition[a]) {
+                continue;
+            }
+            mIndices[write++] = a;
+            mIndices[write++] = b;
+            mIndices[write++] = c;
+        }
+        mIndices.resize(write);
+    }
+}
+
+} // Namespace Assimp
@@ -0,0 +1,177 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Defines a quadric error simplifier for triangle meshes, shared by
+ *        the post-processing steps which generate LODs.
+ */
+
+#pragma once
+
+#ifndef AI_MESHSIMPLIFIER_H_INC
+#define AI_MESHSIMPLIFIER_H_INC
+
+#include <assimp/vector3.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct aiMesh;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Collapses the edges of a triangle mesh in the order of their quadric error
+ *  onto one of their vertices, so all attributes of the remaining vertices
+ *  are kept. Topology is tracked per position, so vertices which only differ
+ *  in their attributes move together. Vertices on UV or normal seams and on
+ *  open borders only move along the seam or border, locked vertices don't
+ *  move at all.
+ */
+class MeshSimplifier {
+public:
+    /// Simplifies the triangles of a mesh.
+    explicit MeshSimplifier(const aiMesh* mesh);
+
+    /// Simplifies a triangle list, three indices into vertices per triangle.
+    MeshSimplifier(const aiVector3D* vertices, unsigned int numVertices, const std::vector<unsigned int>& indices);
+
+    /// Keeps the position of a vertex, along with all vertices sharing it.
+    void Lock(unsigned int vertex);
+
+    /// Collapses edges until at most target triangles are left or no collapse is possible.
+    void Simplify(size_t target);
+
+    size_t GetNumTriangles() const {
+        return mIndices.size() / 3;
+    }
+
+    const std::vector<unsigned int>& GetIndices() const {
+        return mIndices;
+    }
+
+    /// Largest area weighted RMS distance of a collapsed region to its original triangles.
+    double GetError() const {
+        return mError;
+    }
+
+private:
+    // Symmetric 4x4 matrix measuring the squared distance of a point to a set of planes
+    struct Quadric {
+        double a00, a01, a02, a11, a12, a22, b0, b1, b2, c;
+        // sum of the plane weights
+        double w;
+
+        Quadric()
+        : a00(0), a01(0), a02(0), a11(0), a12(0), a22(0), b0(0), b1(0), b2(0), c(0), w(0) {
+            // empty
+        }
+
+        // weighted plane with the unit normal n and n*p + d = 0
+        Quadric(const aiVector3D& n, double d, double weight)
+        : a00(weight * n.x * n.x), a01(weight * n.x * n.y), a02(weight * n.x * n.z)
+        , a11(weight * n.y * n.y), a12(weight * n.y * n.z), a22(weight * n.z * n.z)
+        , b0(weight * n.x * d), b1(weight * n.y * d), b2(weight * n.z * d), c(weight * d * d), w(weight) {
+            // empty
+        }
+
+        Quadric& operator+=(const Quadric& o) {
+            a00 += o.a00; a01 += o.a01; a02 += o.a02;
+            a11 += o.a11; a12 += o.a12; a22 += o.a22;
+            b0 += o.b0; b1 += o.b1; b2 += o.b2;
+            c += o.c;
+            w += o.w;
+            return *this;
+        }
+
+        double Error(const aiVector3D& p) const {
+            const double x = p.x, y = p.y, z = p.z;
+            const double error = x * (a00 * x + a01 * y + a02 * z) + y * (a01 * x + a11 * y + a12 * z) +
+                    z * (a02 * x + a12 * y + a22 * z) + 2 * (b0 * x + b1 * y + b2 * z) + c;
+            return std::max(error, 0.0);
+        }
+    };
+
+    enum EdgeKind {
+        EdgeKind_Inner,
+        EdgeKind_Border,
+        EdgeKind_Seam
+    };
+
+    struct Collapse {
+        unsigned int from, to;
+        double cost;
+
+        bool operator<(const Collapse& o) const {
+            return cost < o.cost || (cost == o.cost && (from < o.from || (from == o.from && to < o.to)));
+        }
+    };
+
+    void Classify();
+    EdgeKind GetEdgeKind(unsigned int a, unsigned int b) const;
+    bool CanCollapse(unsigned int from, EdgeKind edge) const;
+    bool TryCollapse(unsigned int from, unsigned int to, std::vector<unsigned int>& remap, std::vector<char>& locked, size_t& removed);
+
+    const aiVector3D* mVertices;
+    unsigned int mNumVertices;
+    // three vertex indices per triangle
+    std::vector<unsigned int> mIndices;
+    // first vertex with the same position as a vertex
+    std::vector<unsigned int> mPosition;
+    // per position, accumulated from the collapsed positions
+    std::vector<Quadric> mQuadrics;
+    std::vector<unsigned char> mKind;
+    // positions locked by the caller
+    std::vector<char> mLocked;
+    // number of half-edges between two positions, and the half-edges between vertices
+    std::unordered_map<uint64_t, unsigned int> mPositionEdges;
+    std::unordered_set<uint64_t> mVertexEdges;
+    // triangles around each position, rebuilt per pass
+    std::vector<unsigned int> mTriangleOffsets, mTriangles;
+    double mError;
+};
+
+} // Namespace Assimp
+
+#endif // AI_MESHSIMPLIFIER_H_INC
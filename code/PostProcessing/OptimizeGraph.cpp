@@ -56,16 +56,15 @@ using namespace Assimp;
 
 #define AI_RESERVED_NODE_NAME "$Reserved_And_Evil"
 
-/* AI_OG_USE_HASHING enables the use of hashing to speed-up std::set lookups.
- * The unhashed variant should be faster, except for *very* large data sets
+/* AI_OG_USE_HASHING stores only the hashes of the locked names in a std::set.
+ * The default looks the names up as the SceneNameIndex does, without copying them.
  */
 #ifdef AI_OG_USE_HASHING
     // Use our standard hashing function to compute the hash
 #   define AI_OG_GETKEY(str) SuperFastHash(str.data,str.length)
 #else
-    // Otherwise hope that std::string will utilize a static buffer
-    // for shorter node names. This would avoid endless heap copying.
-#   define AI_OG_GETKEY(str) std::string(str.data)
+    // Otherwise refer to the name itself, it outlives the step
+#   define AI_OG_GETKEY(str) SceneNameKey{ (str).data, (str).length }
 #endif
 
 // ------------------------------------------------------------------------------------------------
@@ -253,7 +252,7 @@ void OptimizeGraphProcess::Execute( aiScene* pScene) {
 #ifdef AI_OG_USE_HASHING
         locked.insert(SuperFastHash((*it).c_str()));
 #else
-        locked.insert(*it);
+        locked.insert(SceneNameKey{ (*it).c_str(), (*it).length() });
 #endif
     }
 
@@ -274,6 +273,11 @@ void OptimizeGraphProcess::Execute( aiScene* pScene) {
             // The easiest way to do this is to increase their reference counters ...
             meshes[i] += 2;
         }
+
+        // The same for meshes with LODs, the LOD meshes wouldn't be transformed with them
+        if (pScene->mMeshes[i]->mNumLODs) {
+            meshes[i] += 2;
+        }
     }
 
     for (unsigned int i = 0; i < pScene->mNumCameras; ++i) {
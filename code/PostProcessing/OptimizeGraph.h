@@ -48,10 +48,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Common/BaseProcess.h"
 #include "PostProcessing/ProcessHelper.h"
+#include "Common/SceneNameIndex.h"
 
 #include <assimp/types.h>
 
 #include <set>
+#include <unordered_set>
 
 // Forward declarations
 struct aiMesh;
@@ -116,13 +118,13 @@ private:
 #ifdef AI_OG_USE_HASHING
     typedef std::set<unsigned int> LockedSetType;
 #else
-    typedef std::set<std::string> LockedSetType;
+    typedef std::unordered_set<SceneNameKey, SceneNameKeyHash, SceneNameKeyEqual> LockedSetType;
 #endif
 
     //! Scene we're working with
     aiScene* mScene;
 
-    //! List of locked names. Stored is the hash of the name
+    //! List of locked names. Stored is the hash of the name or a key referring to it
     LockedSetType locked;
 
     //! List of nodes to be locked in addition to those with animations, lights or cameras assigned.
@@ -123,16 +123,19 @@ void OptimizeMeshesProcess::Execute( aiScene* pScene)
     output.reserve(pScene->mNumMeshes);
 
     // Prepare lookup tables
+    const MeshLODRemapper lodRemapper(pScene);
     meshes.resize(pScene->mNumMeshes);
     FindInstancedMeshes(pScene->mRootNode);
     if( max_verts == DeadBeef ) /* undo the magic hack */
         max_verts = NotSet;
 
-    // ... instanced meshes are immediately processed and added to the output list
+    // ... instanced meshes are immediately processed and added to the output list,
+    // as well as LOD chains. LOD meshes aren't referenced by any node.
     for (unsigned int i = 0, n = 0; i < pScene->mNumMeshes;++i) {
         meshes[i].vertex_format = GetMeshVFormatUnique(pScene->mMeshes[i]);
+        meshes[i].in_lod_chain = lodRemapper.IsInLODChain(i);
 
-        if (meshes[i].instance_cnt > 1 && meshes[i].output_id == NotSet ) {
+        if ((meshes[i].instance_cnt > 1 || meshes[i].in_lod_chain) && meshes[i].output_id == NotSet ) {
             meshes[i].output_id = n++;
             output.push_back(mScene->mMeshes[i]);
         }
@@ -144,11 +147,20 @@ void OptimizeMeshesProcess::Execute( aiScene* pScene)
         throw DeadlyImportError("OptimizeMeshes: No meshes remaining; there's definitely something wrong");
     }
 
+    // only the meshes output as they are can have LODs
+    std::vector<unsigned int> sources(output.size(), UINT_MAX);
+    for (unsigned int i = 0; i < num_old; ++i) {
+        if (NotSet != meshes[i].output_id) {
+            sources[meshes[i].output_id] = i;
+        }
+    }
+
     meshes.resize( 0 );
     ai_assert(output.size() <= num_old);
 
     mScene->mNumMeshes = static_cast<unsigned int>(output.size());
     std::copy(output.begin(),output.end(),mScene->mMeshes);
+    lodRemapper.Update(mScene, sources);
 
     if (output.size() != num_old) {
         ASSIMP_LOG_DEBUG_F("OptimizeMeshesProcess finished. Input meshes: ", num_old, ", Output meshes: ", pScene->mNumMeshes);
@@ -164,7 +176,7 @@ void OptimizeMeshesProcess::ProcessNode( aiNode* pNode)
     for (unsigned int i = 0; i < pNode->mNumMeshes;++i) {
         unsigned int& im = pNode->mMeshes[i];
 
-        if (meshes[im].instance_cnt > 1) {
+        if (meshes[im].instance_cnt > 1 || meshes[im].in_lod_chain) {
             im = meshes[im].output_id;
         }
         else  {
@@ -213,6 +225,10 @@ bool OptimizeMeshesProcess::CanJoin ( unsigned int a, unsigned int b, unsigned i
     if (meshes[a].vertex_format != meshes[b].vertex_format)
         return false;
 
+    // LOD chains refer to their meshes by index
+    if (meshes[a].in_lod_chain || meshes[b].in_lod_chain)
+        return false;
+
     aiMesh* ma = mScene->mMeshes[a], *mb = mScene->mMeshes[b];
 
     if ((NotSet != max_verts && verts+mb->mNumVertices > max_verts) ||
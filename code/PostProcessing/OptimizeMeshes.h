@@ -66,7 +66,7 @@ namespace Assimp    {
  *
  *  @note Instanced meshes are currently not processed.
  */
-class OptimizeMeshesProcess : public BaseProcess {
+class ASSIMP_API OptimizeMeshesProcess : public BaseProcess {
 public:
     /// @brief  The class constructor.
     OptimizeMeshesProcess();
@@ -80,7 +80,8 @@ public:
         MeshInfo() AI_NO_EXCEPT
         : instance_cnt(0)
         , vertex_format(0)
-        , output_id(0xffffffff) {
+        , output_id(0xffffffff)
+        , in_lod_chain(false) {
             // empty
         }
 
@@ -92,6 +93,9 @@ public:
 
         //! Output ID
         unsigned int output_id;
+
+        //! Mesh has LODs or is one, it is kept as it is
+        bool in_lod_chain;
     };
 
 public:
@@ -0,0 +1,238 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Implementation of the post-processing step to pack the bone
+ *        weights of a mesh into vertex-major streams.
+ */
+
+#ifndef ASSIMP_BUILD_NO_PACKBONEWEIGHTS_PROCESS
+
+#include "PostProcessing/PackBoneWeightsProcess.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace Assimp {
+
+namespace {
+
+// A single influence of a bone on a vertex
+struct Influence {
+    float mWeight;
+    unsigned int mBone;
+
+    // heavier influences first, ties keep the bone order
+    bool operator<(const Influence& other) const {
+        return mWeight > other.mWeight || (mWeight == other.mWeight && mBone < other.mBone);
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Quantizes weights summing up to 1 to bytes summing up to exactly 255. The rounding error is
+// distributed by the largest remainder, ties go to the earlier weight, so descending weights
+// stay in descending order.
+void QuantizeWeights(const float* weights, unsigned int count, unsigned char* out) {
+    float remainders[PackBoneWeightsProcess::MaxInfluences];
+    int missing = 255;
+    for (unsigned int i = 0; i < count; ++i) {
+        const float scaled = std::min(weights[i] * 255.f, 255.f);
+        const int floored = static_cast<int>(scaled);
+        out[i] = static_cast<unsigned char>(floored);
+        remainders[i] = scaled - static_cast<float>(floored);
+        missing -= floored;
+    }
+    for (; missing > 0; --missing) {
+        unsigned int best = 0;
+        for (unsigned int i = 1; i < count; ++i) {
+            if (remainders[i] > remainders[best]) {
+                best = i;
+            }
+        }
+        ++out[best];
+        remainders[best] = -1.f;
+    }
+}
+
+} // Namespace
+
+const unsigned int PackBoneWeightsProcess::MaxInfluences;
+
+// ------------------------------------------------------------------------------------------------
+PackBoneWeightsProcess::PackBoneWeightsProcess()
+: BaseProcess()
+, mNumInfluences(AI_PBW_DEFAULT_NUM_INFLUENCES) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+PackBoneWeightsProcess::~PackBoneWeightsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PackBoneWeightsProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PackBoneWeightsProcess::IsActiveExt(unsigned int pExtFlags) const {
+    return 0 != ( pExtFlags & aiProcessExt_PackBoneWeights );
+}
+
+// ------------------------------------------------------------------------------------------------
+void PackBoneWeightsProcess::SetupProperties(const Importer* pImp) {
+    const int numInfluences = pImp->GetPropertyInteger(AI_CONFIG_PP_PBW_NUM_INFLUENCES, AI_PBW_DEFAULT_NUM_INFLUENCES);
+    if (numInfluences < 1 || numInfluences > static_cast<int>(MaxInfluences)) {
+        ASSIMP_LOG_WARN_F("PackBoneWeightsProcess: AI_CONFIG_PP_PBW_NUM_INFLUENCES is ", numInfluences,
+                ", clamping it to 1 to ", MaxInfluences);
+    }
+    SetNumInfluences(static_cast<unsigned int>(std::max(numInfluences, 1)));
+}
+
+// ------------------------------------------------------------------------------------------------
+void PackBoneWeightsProcess::SetNumInfluences(unsigned int numInfluences) {
+    mNumInfluences = numInfluences < 1 ? 1 : (numInfluences > MaxInfluences ? MaxInfluences : numInfluences);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PackBoneWeightsProcess::PackMesh(aiMesh* pMesh) const {
+    ai_assert(nullptr != pMesh);
+
+    // drop the streams of a previous run
+    delete[] pMesh->mPackedBoneIndices;
+    delete[] pMesh->mPackedBoneWeights;
+    pMesh->mPackedBoneIndices = nullptr;
+    pMesh->mPackedBoneWeights = nullptr;
+    pMesh->mNumBoneInfluences = 0;
+
+    if (!pMesh->HasBones() || pMesh->mNumBones > std::numeric_limits<unsigned short>::max()) {
+        return false;
+    }
+
+    // gather the influences of each vertex, the bones store them bone-major
+    const unsigned int numVertices = pMesh->mNumVertices;
+    std::vector<unsigned int> offsets(numVertices + 1, 0);
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+        const aiBone* bone = pMesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight& weight = bone->mWeights[w];
+            if (weight.mVertexId < numVertices && weight.mWeight > 0.f) {
+                ++offsets[weight.mVertexId + 1];
+            }
+        }
+    }
+    for (unsigned int v = 0; v < numVertices; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<Influence> influences(offsets[numVertices]);
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+        const aiBone* bone = pMesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight& weight = bone->mWeights[w];
+            if (weight.mVertexId < numVertices && weight.mWeight > 0.f) {
+                influences[fill[weight.mVertexId]++] = { static_cast<float>(weight.mWeight), b };
+            }
+        }
+    }
+
+    const unsigned int n = mNumInfluences;
+    unsigned short* indices = new unsigned short[numVertices * n]();
+    unsigned char* weights = new unsigned char[numVertices * n]();
+    for (unsigned int v = 0; v < numVertices; ++v) {
+        Influence* begin = influences.data() + offsets[v];
+        const unsigned int count = std::min(offsets[v + 1] - offsets[v], n);
+        if (0 == count) {
+            continue;
+        }
+        std::partial_sort(begin, begin + count, influences.data() + offsets[v + 1]);
+
+        float sum = 0.f;
+        for (unsigned int i = 0; i < count; ++i) {
+            sum += begin[i].mWeight;
+        }
+        float normalized[MaxInfluences];
+        for (unsigned int i = 0; i < count; ++i) {
+            indices[v * n + i] = static_cast<unsigned short>(begin[i].mBone);
+            normalized[i] = begin[i].mWeight / sum;
+        }
+        QuantizeWeights(normalized, count, weights + v * n);
+    }
+
+    pMesh->mNumBoneInfluences = n;
+    pMesh->mPackedBoneIndices = indices;
+    pMesh->mPackedBoneWeights = weights;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void PackBoneWeightsProcess::Execute(aiScene* pScene) {
+    if (nullptr == pScene || 0 == pScene->mNumMeshes) {
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("PackBoneWeightsProcess begin");
+
+    unsigned int numPacked = 0;
+    ParallelForThenReport(pScene->mNumMeshes, [&](size_t a) {
+        return PackMesh(pScene->mMeshes[a]);
+    }, [&](size_t a, bool packed) {
+        if (packed) {
+            ++numPacked;
+        } else if (pScene->mMeshes[a]->HasBones()) {
+            ASSIMP_LOG_WARN_F("Mesh ", a, ": Too many bones to pack their weights, the limit is ",
+                    std::numeric_limits<unsigned short>::max());
+        }
+    });
+    ASSIMP_LOG_INFO_F("PackBoneWeightsProcess finished. Packed the bone weights of ", numPacked, " meshes with ",
+            mNumInfluences, " influences per vertex");
+}
+
+} // Namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_PACKBONEWEIGHTS_PROCESS
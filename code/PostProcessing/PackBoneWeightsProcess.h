@@ -0,0 +1,102 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Defines a post-processing step to pack the bone weights of a mesh
+ *        into vertex-major streams for skinning on the GPU.
+ */
+
+#pragma once
+
+#ifndef AI_PACKBONEWEIGHTSPROCESS_H_INC
+#define AI_PACKBONEWEIGHTSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_PACKBONEWEIGHTS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+struct aiMesh;
+
+namespace Assimp {
+
+/** Post-processing process to store a fixed number of bone influences per
+ *  vertex. The influences of each vertex are sorted by descending weight,
+ *  the heaviest ones are kept and their weights are renormalized and
+ *  quantized to bytes summing up to exactly 255. The result is written to
+ *  aiMesh::mPackedBoneIndices and aiMesh::mPackedBoneWeights, the bones of
+ *  the mesh are not modified.
+ */
+class ASSIMP_API PackBoneWeightsProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    PackBoneWeightsProcess();
+    /// The class destructor.
+    ~PackBoneWeightsProcess();
+    /// There is no aiPostProcessSteps flag for this step, returns false.
+    bool IsActive(unsigned int pFlags) const override;
+    /// Will return true, if aiProcessExt_PackBoneWeights is defined.
+    bool IsActiveExt(unsigned int pExtFlags) const override;
+    /// Reads the number of influences from the importer properties.
+    void SetupProperties(const Importer* pImp) override;
+    /// The execution callback.
+    void Execute(aiScene* pScene) override;
+
+    /// The largest supported number of influences per vertex.
+    static const unsigned int MaxInfluences = 8;
+
+    /// Sets the number of influences per vertex, clamped to 1 to MaxInfluences.
+    void SetNumInfluences(unsigned int numInfluences);
+
+    /// Packs the bone weights of a single mesh, replacing the packed
+    /// streams of a previous run.
+    /// @return false if the mesh has no bones or too many bones to be
+    ///   addressed by 16 bit indices.
+    bool PackMesh(aiMesh* pMesh) const;
+
+private:
+    unsigned int mNumInfluences;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_PACKBONEWEIGHTS_PROCESS
+
+#endif // AI_PACKBONEWEIGHTSPROCESS_H_INC
@@ -48,6 +48,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "PretransformVertices.h"
 #include "ProcessHelper.h"
+#include "Common/SceneNameIndex.h"
+#include "Common/VectorKernels.h"
 #include <assimp/SceneCombiner.h>
 #include <assimp/Exceptional.h>
 
@@ -199,9 +201,8 @@ void PretransformVertices::CollectData( aiScene* pcScene, aiNode* pcNode, unsign
             else
             {
                 // copy positions, transform them to worldspace
-                for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)  {
-                    pcMeshOut->mVertices[aiCurrent[AI_PTVS_VERTEX]+n] = pcNode->mTransformation * pcMesh->mVertices[n];
-                }
+                TransformPoints(pcNode->mTransformation, pcMesh->mVertices,
+                    pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices);
                 aiMatrix4x4 mWorldIT = pcNode->mTransformation;
                 mWorldIT.Inverse().Transpose();
 
@@ -211,18 +212,16 @@ void PretransformVertices::CollectData( aiScene* pcScene, aiNode* pcNode, unsign
                 if (iVFormat & 0x2)
                 {
                     // copy normals, transform them to worldspace
-                    for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)  {
-                        pcMeshOut->mNormals[aiCurrent[AI_PTVS_VERTEX]+n] =
-                            (m * pcMesh->mNormals[n]).Normalize();
-                    }
+                    TransformDirections(m, pcMesh->mNormals,
+                        pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices, true);
                 }
                 if (iVFormat & 0x4)
                 {
                     // copy tangents and bitangents, transform them to worldspace
-                    for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)  {
-                        pcMeshOut->mTangents  [aiCurrent[AI_PTVS_VERTEX]+n] = (m * pcMesh->mTangents[n]).Normalize();
-                        pcMeshOut->mBitangents[aiCurrent[AI_PTVS_VERTEX]+n] = (m * pcMesh->mBitangents[n]).Normalize();
-                    }
+                    TransformDirections(m, pcMesh->mTangents,
+                        pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices, true);
+                    TransformDirections(m, pcMesh->mBitangents,
+                        pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices, true);
                 }
             }
             unsigned int p = 0;
@@ -338,9 +337,7 @@ void PretransformVertices::ApplyTransform(aiMesh* mesh, const aiMatrix4x4& mat)
     if (!mat.IsIdentity()) {
 
         if (mesh->HasPositions()) {
-            for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-                mesh->mVertices[i] = mat * mesh->mVertices[i];
-            }
+            TransformPoints(mat, mesh->mVertices, mesh->mVertices, mesh->mNumVertices);
         }
         if (mesh->HasNormals() || mesh->HasTangentsAndBitangents()) {
             aiMatrix4x4 mWorldIT = mat;
@@ -350,15 +347,11 @@ void PretransformVertices::ApplyTransform(aiMesh* mesh, const aiMatrix4x4& mat)
             aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
 
             if (mesh->HasNormals()) {
-                for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-                    mesh->mNormals[i] = (m * mesh->mNormals[i]).Normalize();
-                }
+                TransformDirections(m, mesh->mNormals, mesh->mNormals, mesh->mNumVertices, true);
             }
             if (mesh->HasTangentsAndBitangents()) {
-                for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-                    mesh->mTangents[i]   = (m * mesh->mTangents[i]).Normalize();
-                    mesh->mBitangents[i] = (m * mesh->mBitangents[i]).Normalize();
-                }
+                TransformDirections(m, mesh->mTangents, mesh->mTangents, mesh->mNumVertices, true);
+                TransformDirections(m, mesh->mBitangents, mesh->mBitangents, mesh->mNumVertices, true);
             }
         }
     }
@@ -488,6 +481,23 @@ void PretransformVertices::Execute( aiScene* pScene)
         // Hack: store the matrix we're transforming a mesh with in aiMesh::mBones
         BuildWCSMeshes(apcOutMeshes,pScene->mMeshes,pScene->mNumMeshes, pScene->mRootNode);
 
+        // LOD meshes aren't referenced by any node, they get the transform of their base mesh.
+        // The copies of a base mesh don't get LODs.
+        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+            const aiMesh* mesh = pScene->mMeshes[i];
+            for (unsigned int l = 0; l < mesh->mNumLODs; ++l) {
+                aiMesh* lod = pScene->mMeshes[mesh->mLODs[l]];
+                if (!lod->mBones) {
+                    lod->mBones = mesh->mBones;
+                }
+            }
+        }
+        for (aiMesh* copy : apcOutMeshes) {
+            delete[] copy->mLODs;
+            copy->mLODs = NULL;
+            copy->mNumLODs = 0;
+        }
+
         // ... if new meshes have been generated, append them to the end of the scene
         if (apcOutMeshes.size() > 0) {
             aiMesh** npp = new aiMesh*[pScene->mNumMeshes + apcOutMeshes.size()];
@@ -499,9 +509,12 @@ void PretransformVertices::Execute( aiScene* pScene)
             delete[] pScene->mMeshes; pScene->mMeshes = npp;
         }
 
-        // now iterate through all meshes and transform them to worldspace
+        // now iterate through all meshes and transform them to worldspace,
+        // meshes which aren't referenced at all are left alone
         for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-            ApplyTransform(pScene->mMeshes[i],*reinterpret_cast<aiMatrix4x4*>( pScene->mMeshes[i]->mBones ));
+            if (pScene->mMeshes[i]->mBones) {
+                ApplyTransform(pScene->mMeshes[i],*reinterpret_cast<aiMatrix4x4*>( pScene->mMeshes[i]->mBones ));
+            }
 
             // prevent improper destruction
             pScene->mMeshes[i]->mBones    = NULL;
@@ -558,6 +571,15 @@ void PretransformVertices::Execute( aiScene* pScene)
             }
         }
 
+        // the meshes are joined per material, LOD chains can't be kept
+        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+            if (pScene->mMeshes[i]->mNumLODs) {
+                ASSIMP_LOG_WARN("PretransformVertices: The LODs of the meshes are dropped, set "
+                    "AI_CONFIG_PP_PTV_KEEP_HIERARCHY to keep them");
+                break;
+            }
+        }
+
         // If no meshes are referenced in the node graph it is possible that we get no output meshes.
         if (apcOutMeshes.empty()) {
             
@@ -606,10 +628,11 @@ void PretransformVertices::Execute( aiScene* pScene)
     pScene->mNumAnimations = 0;
 
     // --- we need to keep all cameras and lights
+    const SceneNameIndex& nameIndex = GetSceneNameIndex(pScene);
     for (unsigned int i = 0; i < pScene->mNumCameras;++i)
     {
         aiCamera* cam = pScene->mCameras[i];
-        const aiNode* nd = pScene->mRootNode->FindNode(cam->mName);
+        const aiNode* nd = nameIndex.FindNode(cam->mName);
         ai_assert(NULL != nd);
 
         // multiply all properties of the camera with the absolute
@@ -622,7 +645,7 @@ void PretransformVertices::Execute( aiScene* pScene)
     for (unsigned int i = 0; i < pScene->mNumLights;++i)
     {
         aiLight* l = pScene->mLights[i];
-        const aiNode* nd = pScene->mRootNode->FindNode(l->mName);
+        const aiNode* nd = nameIndex.FindNode(l->mName);
         ai_assert(NULL != nd);
 
         // multiply all properties of the camera with the absolute
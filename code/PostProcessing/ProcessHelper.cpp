@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 
 
+#include <algorithm>
 #include <limits>
 
 namespace Assimp {
@@ -440,4 +441,107 @@ aiMesh* MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMes
     return oMesh;
 }
 
+// -------------------------------------------------------------------------------
+MeshLODRemapper::MeshLODRemapper(const aiScene* pScene)
+: mHasLODs(false)
+{
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        if (pScene->mMeshes[i]->mNumLODs) {
+            mHasLODs = true;
+            break;
+        }
+    }
+    if (!mHasLODs) {
+        return;
+    }
+
+    mLODs.resize(pScene->mNumMeshes);
+    mInChain.resize(pScene->mNumMeshes, false);
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        const aiMesh* mesh = pScene->mMeshes[i];
+        if (!mesh->mNumLODs) {
+            continue;
+        }
+        mLODs[i].assign(mesh->mLODs, mesh->mLODs + mesh->mNumLODs);
+        mInChain[i] = true;
+        for (unsigned int l = 0; l < mesh->mNumLODs; ++l) {
+            if (mesh->mLODs[l] < pScene->mNumMeshes) {
+                mInChain[mesh->mLODs[l]] = true;
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+void MeshLODRemapper::Update(aiScene* pScene, const std::vector<unsigned int>& pSources) const
+{
+    if (!mHasLODs) {
+        return;
+    }
+    ai_assert(pSources.size() == pScene->mNumMeshes);
+
+    // the new meshes built from each old mesh
+    std::vector<std::vector<unsigned int> > pieces(mLODs.size());
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        if (pSources[i] < mLODs.size()) {
+            pieces[pSources[i]].push_back(i);
+        }
+    }
+
+    // the only piece of an old mesh with the given primitive types, UINT_MAX if there is none or several
+    auto findPiece = [&](unsigned int old, unsigned int primitiveTypes) {
+        unsigned int found = UINT_MAX;
+        if (old < pieces.size()) {
+            for (unsigned int piece : pieces[old]) {
+                if (pScene->mMeshes[piece]->mPrimitiveTypes == primitiveTypes) {
+                    if (UINT_MAX != found) {
+                        return UINT_MAX;
+                    }
+                    found = piece;
+                }
+            }
+        }
+        return found;
+    };
+
+    unsigned int dropped = 0;
+    std::vector<unsigned int> levels;
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        aiMesh* mesh = pScene->mMeshes[i];
+        delete[] mesh->mLODs;
+        mesh->mLODs = nullptr;
+        mesh->mNumLODs = 0;
+
+        const unsigned int source = pSources[i];
+        if (source >= mLODs.size() || mLODs[source].empty()) {
+            continue;
+        }
+        if (findPiece(source, mesh->mPrimitiveTypes) != i) {
+            if (pieces[source].front() == i) {
+                dropped += static_cast<unsigned int>(mLODs[source].size());
+            }
+            continue;
+        }
+
+        levels.clear();
+        for (unsigned int lod : mLODs[source]) {
+            const unsigned int piece = findPiece(lod, mesh->mPrimitiveTypes);
+            if (UINT_MAX == piece) {
+                ++dropped;
+                continue;
+            }
+            levels.push_back(piece);
+        }
+        if (!levels.empty()) {
+            mesh->mNumLODs = static_cast<unsigned int>(levels.size());
+            mesh->mLODs = new unsigned int[mesh->mNumLODs];
+            std::copy(levels.begin(), levels.end(), mesh->mLODs);
+        }
+    }
+
+    if (dropped) {
+        ASSIMP_LOG_WARN_F("Dropped ", dropped, " LOD levels, their meshes have been split or joined");
+    }
+}
+
 } // namespace Assimp
@@ -334,6 +334,42 @@ const char* MappingTypeToString(aiTextureMapping in);
 // Split a mesh given a list of faces to be contained in the sub mesh
 aiMesh* MakeSubmesh(const aiMesh *superMesh, const std::vector<unsigned int> &subMeshFaces, unsigned int subFlags);
 
+// -------------------------------------------------------------------------------
+/** @brief Keeps aiMesh::mLODs valid while a step rebuilds aiScene::mMeshes
+ *
+ *  Construct it before the step changes the mesh list and call Update() once the
+ *  new list is in place. A LOD level is kept if the base mesh and the LOD mesh each
+ *  ended up in exactly one new mesh with the primitive types of the new base mesh,
+ *  other levels are dropped. */
+class MeshLODRemapper
+{
+public:
+    explicit MeshLODRemapper(const aiScene* pScene);
+
+    //! Whether any mesh of the scene has LODs
+    bool HasLODs() const {
+        return mHasLODs;
+    }
+
+    //! Whether the mesh has LODs or is a LOD of another mesh. Steps joining
+    //! meshes must leave such meshes alone.
+    bool IsInLODChain(unsigned int pMesh) const {
+        return pMesh < mInChain.size() && mInChain[pMesh];
+    }
+
+    /** @brief Replaces the LOD lists of all meshes in the rebuilt mesh list
+     *  @param pScene Scene with the rebuilt mesh list
+     *  @param pSources For every new mesh the index of the mesh it was built from,
+     *    UINT_MAX if it was joined from several meshes */
+    void Update(aiScene* pScene, const std::vector<unsigned int>& pSources) const;
+
+private:
+    // LOD lists of the meshes before the step
+    std::vector<std::vector<unsigned int> > mLODs;
+    std::vector<bool> mInChain;
+    bool mHasLODs;
+};
+
 // -------------------------------------------------------------------------------
 // Utility postprocess step to share the spatial sort tree between
 // all steps which use it to speedup its computations.
@@ -0,0 +1,321 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Implementation of the post-processing step to quantize the
+ *        vertex streams of a mesh.
+ */
+
+#ifndef ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
+
+#include "PostProcessing/QuantizeVerticesProcess.h"
+#include "Common/ParallelFor.h"
+#include "Common/VectorKernels.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Maps value from [0, range] to an unsigned normalized integer with the given maximum
+unsigned int QuantizeUnorm(double value, double range, unsigned int maxValue) {
+    if (range <= 0.0) {
+        return 0;
+    }
+    const double scaled = std::round(value / range * maxValue);
+    return static_cast<unsigned int>(std::min(std::max(scaled, 0.0), static_cast<double>(maxValue)));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Angle between two directions, acos() would be too imprecise for the tiny angles
+double DirectionError(const aiVector3D& a, const aiVector3D& b) {
+    const double ax = a.x, ay = a.y, az = a.z, bx = b.x, by = b.y, bz = b.z;
+    const double cx = ay * bz - az * by, cy = az * bx - ax * bz, cz = ax * by - ay * bx;
+    return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), ax * bx + ay * by + az * bz);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Quantizes a stream of directions, returns the largest angle error
+double QuantizeDirections(const aiVector3D* directions, unsigned int count, short*& out) {
+    out = new short[count * 2];
+    double error = 0.0;
+    for (unsigned int i = 0; i < count; ++i) {
+        QuantizeVerticesProcess::EncodeDirection(directions[i], out + 2 * i);
+        if (directions[i].SquareLength() > 0) {
+            error = std::max(error, DirectionError(directions[i], aiQuantizedVertices::DecodeDirection(out + 2 * i)));
+        }
+    }
+    return error;
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+QuantizeVerticesProcess::QuantizeVerticesProcess()
+: BaseProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+QuantizeVerticesProcess::~QuantizeVerticesProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool QuantizeVerticesProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool QuantizeVerticesProcess::IsActiveExt(unsigned int pExtFlags) const {
+    return 0 != ( pExtFlags & aiProcessExt_QuantizeVertices );
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesProcess::EncodeDirection(const aiVector3D& pDirection, short* pEncoded) {
+    const ai_real length = std::abs(pDirection.x) + std::abs(pDirection.y) + std::abs(pDirection.z);
+    if (!(length > 0)) {
+        pEncoded[0] = pEncoded[1] = 0;
+        return;
+    }
+
+    // project onto the octahedron and fold the lower half over the upper one
+    double x = pDirection.x / length, y = pDirection.y / length;
+    if (pDirection.z < 0) {
+        const double fx = (1.0 - std::abs(y)) * (x >= 0.0 ? 1.0 : -1.0);
+        const double fy = (1.0 - std::abs(x)) * (y >= 0.0 ? 1.0 : -1.0);
+        x = fx;
+        y = fy;
+    }
+
+    // rounding each component separately isn't always closest, so all neighbours are tried
+    const double bx = std::floor(x * 32767.0), by = std::floor(y * 32767.0);
+    double bestError = 10.0;
+    for (int dx = 0; dx < 2; ++dx) {
+        for (int dy = 0; dy < 2; ++dy) {
+            const short candidate[2] = {
+                static_cast<short>(std::min(std::max(bx + dx, -32767.0), 32767.0)),
+                static_cast<short>(std::min(std::max(by + dy, -32767.0), 32767.0))
+            };
+            const double error = DirectionError(pDirection, aiQuantizedVertices::DecodeDirection(candidate));
+            if (error < bestError) {
+                bestError = error;
+                pEncoded[0] = candidate[0];
+                pEncoded[1] = candidate[1];
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool QuantizeVerticesProcess::QuantizeMesh(aiMesh* pMesh) const {
+    ai_assert(nullptr != pMesh);
+
+    // drop the streams of a previous run
+    delete pMesh->mQuantizedVertices;
+    pMesh->mQuantizedVertices = nullptr;
+
+    if (!pMesh->HasPositions()) {
+        return false;
+    }
+
+    const unsigned int numVertices = pMesh->mNumVertices;
+    aiQuantizedVertices* out = new aiQuantizedVertices();
+    out->mNumVertices = numVertices;
+
+    // positions are relative to the bounding box, with the same scale for all axes
+    aiVector3D min = pMesh->mVertices[0], max = pMesh->mVertices[0];
+    ExtendBoundingBox(pMesh->mVertices, numVertices, min, max);
+    const ai_real extent = std::max(std::max(max.x - min.x, max.y - min.y), max.z - min.z);
+    out->mPositionOffset = min;
+    out->mPositionScale = extent;
+    out->mPositions = new unsigned short[numVertices * 3];
+    double positionError = 0.0;
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        const aiVector3D& p = pMesh->mVertices[i];
+        for (unsigned int c = 0; c < 3; ++c) {
+            out->mPositions[3 * i + c] = static_cast<unsigned short>(QuantizeUnorm(p[c] - min[c], extent, 65535));
+        }
+        positionError = std::max(positionError, static_cast<double>((out->GetPosition(i) - p).Length()));
+    }
+    out->mMaxPositionError = static_cast<ai_real>(positionError);
+
+    double directionError = 0.0;
+    if (pMesh->HasNormals()) {
+        directionError = std::max(directionError, QuantizeDirections(pMesh->mNormals, numVertices, out->mNormals));
+    }
+    if (pMesh->HasTangentsAndBitangents()) {
+        directionError = std::max(directionError, QuantizeDirections(pMesh->mTangents, numVertices, out->mTangents));
+    }
+    out->mMaxDirectionError = static_cast<ai_real>(directionError);
+
+    // texture coordinates keep the [0,1] range if they fit into it, as it is used most
+    double textureCoordsError = 0.0;
+    for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+        if (!pMesh->HasTextureCoords(t)) {
+            continue;
+        }
+        const unsigned int numComponents = std::min(pMesh->mNumUVComponents[t], 3u);
+        const aiVector3D* coords = pMesh->mTextureCoords[t];
+        aiVector3D tmin = coords[0], tmax = coords[0];
+        for (unsigned int i = 1; i < numVertices; ++i) {
+            for (unsigned int c = 0; c < numComponents; ++c) {
+                tmin[c] = std::min(tmin[c], coords[i][c]);
+                tmax[c] = std::max(tmax[c], coords[i][c]);
+            }
+        }
+        bool unitRange = true;
+        for (unsigned int c = 0; c < numComponents; ++c) {
+            unitRange = unitRange && tmin[c] >= 0 && tmax[c] <= 1;
+        }
+        for (unsigned int c = 0; c < numComponents; ++c) {
+            out->mTextureCoordsOffset[t][c] = unitRange ? 0 : tmin[c];
+            out->mTextureCoordsScale[t][c] = unitRange ? 1 : tmax[c] - tmin[c];
+        }
+
+        out->mNumUVComponents[t] = numComponents;
+        out->mTextureCoords[t] = new unsigned short[numVertices * numComponents];
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            for (unsigned int c = 0; c < numComponents; ++c) {
+                out->mTextureCoords[t][numComponents * i + c] = static_cast<unsigned short>(
+                        QuantizeUnorm(coords[i][c] - out->mTextureCoordsOffset[t][c], out->mTextureCoordsScale[t][c], 65535));
+            }
+            const aiVector3D decoded = out->GetTextureCoords(t, i);
+            for (unsigned int c = 0; c < numComponents; ++c) {
+                textureCoordsError = std::max(textureCoordsError, static_cast<double>(std::abs(decoded[c] - coords[i][c])));
+            }
+        }
+    }
+    out->mMaxTextureCoordsError = static_cast<ai_real>(textureCoordsError);
+
+    double colorError = 0.0;
+    for (unsigned int k = 0; k < AI_MAX_NUMBER_OF_COLOR_SETS; ++k) {
+        if (!pMesh->HasVertexColors(k)) {
+            continue;
+        }
+        out->mColors[k] = new unsigned char[numVertices * 4];
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            const aiColor4D& color = pMesh->mColors[k][i];
+            for (unsigned int c = 0; c < 4; ++c) {
+                const double clamped = std::min(std::max(static_cast<double>(color[c]), 0.0), 1.0);
+                const unsigned int q = QuantizeUnorm(clamped, 1.0, 255);
+                out->mColors[k][4 * i + c] = static_cast<unsigned char>(q);
+                colorError = std::max(colorError, std::abs(q / 255.0 - clamped));
+            }
+        }
+    }
+    out->mMaxColorError = static_cast<ai_real>(colorError);
+
+    pMesh->mQuantizedVertices = out;
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeVerticesProcess::Execute(aiScene* pScene) {
+    if (nullptr == pScene || 0 == pScene->mNumMeshes) {
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("QuantizeVerticesProcess begin");
+
+    // the largest errors and the sizes of the float and the quantized streams
+    ai_real positionError = 0, directionError = 0, textureCoordsError = 0, colorError = 0;
+    size_t floatSize = 0, quantizedSize = 0;
+    ParallelForThenReport(pScene->mNumMeshes, [&](size_t a) {
+        return QuantizeMesh(pScene->mMeshes[a]);
+    }, [&](size_t a, bool) {
+        const aiMesh* mesh = pScene->mMeshes[a];
+        const aiQuantizedVertices* quantized = mesh->mQuantizedVertices;
+        if (nullptr == quantized) {
+            return;
+        }
+        positionError = std::max(positionError, quantized->mMaxPositionError);
+        directionError = std::max(directionError, quantized->mMaxDirectionError);
+        textureCoordsError = std::max(textureCoordsError, quantized->mMaxTextureCoordsError);
+        colorError = std::max(colorError, quantized->mMaxColorError);
+
+        const size_t n = mesh->mNumVertices;
+        floatSize += n * sizeof(aiVector3D);
+        quantizedSize += n * 3 * sizeof(unsigned short);
+        if (mesh->HasNormals()) {
+            floatSize += n * sizeof(aiVector3D);
+            quantizedSize += n * 2 * sizeof(short);
+        }
+        if (mesh->HasTangentsAndBitangents()) {
+            floatSize += n * sizeof(aiVector3D);
+            quantizedSize += n * 2 * sizeof(short);
+        }
+        for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+            if (mesh->HasTextureCoords(t)) {
+                floatSize += n * sizeof(aiVector3D);
+                quantizedSize += n * quantized->mNumUVComponents[t] * sizeof(unsigned short);
+            }
+        }
+        for (unsigned int k = 0; k < AI_MAX_NUMBER_OF_COLOR_SETS; ++k) {
+            if (mesh->HasVertexColors(k)) {
+                floatSize += n * sizeof(aiColor4D);
+                quantizedSize += n * 4;
+            }
+        }
+    });
+
+    if (0 == quantizedSize) {
+        ASSIMP_LOG_DEBUG("QuantizeVerticesProcess finished. There were no vertices to quantize");
+        return;
+    }
+
+    ASSIMP_LOG_INFO_F("QuantizeVerticesProcess finished. Quantized ", floatSize, " bytes of vertex data to ",
+            quantizedSize, " bytes. Largest errors: position ", positionError, ", direction ",
+            AI_RAD_TO_DEG(directionError), " degrees, texture coordinates ", textureCoordsError,
+            ", color ", colorError);
+}
+
+} // Namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
@@ -0,0 +1,96 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Defines a post-processing step to quantize the vertex streams of
+ *        a mesh into compact integer representations.
+ */
+
+#pragma once
+
+#ifndef AI_QUANTIZEVERTICESPROCESS_H_INC
+#define AI_QUANTIZEVERTICESPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
+
+#include "Common/BaseProcess.h"
+#include <assimp/vector3.h>
+
+struct aiMesh;
+
+namespace Assimp {
+
+/** Post-processing process to store quantized copies of the vertex streams
+ *  of each mesh in aiMesh::mQuantizedVertices. Positions and texture
+ *  coordinates are mapped to 16 bit integers over their range, normals and
+ *  tangents use a 16 bit octahedral encoding and colors are stored as bytes.
+ *  The largest error introduced is stored with the streams and logged.
+ */
+class ASSIMP_API QuantizeVerticesProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    QuantizeVerticesProcess();
+    /// The class destructor.
+    ~QuantizeVerticesProcess();
+    /// There is no aiPostProcessSteps flag for this step, returns false.
+    bool IsActive(unsigned int pFlags) const override;
+    /// Will return true, if aiProcessExt_QuantizeVertices is defined.
+    bool IsActiveExt(unsigned int pExtFlags) const override;
+    /// The execution callback.
+    void Execute(aiScene* pScene) override;
+
+    /// Quantizes the vertex streams of a single mesh, replacing the
+    /// quantized streams of a previous run.
+    /// @return false if the mesh has no positions.
+    bool QuantizeMesh(aiMesh* pMesh) const;
+
+    /// Encodes a direction in octahedral encoding. Of the neighbouring
+    /// encodings the one decoding closest to the direction is chosen.
+    /// @param pDirection The direction, doesn't need to be normalized.
+    /// @param pEncoded Receives the 2 encoded components.
+    static void EncodeDirection(const aiVector3D& pDirection, short* pEncoded);
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_QUANTIZEVERTICES_PROCESS
+
+#endif // AI_QUANTIZEVERTICESPROCESS_H_INC
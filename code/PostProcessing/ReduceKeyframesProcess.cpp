@@ -0,0 +1,251 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Implementation of the post-processing step to remove animation
+ *        keys which can be interpolated from their neighbours.
+ */
+
+#ifndef ASSIMP_BUILD_NO_REDUCEKEYFRAMES_PROCESS
+
+#include "PostProcessing/ReduceKeyframesProcess.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+aiVector3D LerpVector(const aiVector3D& start, const aiVector3D& end, ai_real factor) {
+    return start + (end - start) * factor;
+}
+
+// ------------------------------------------------------------------------------------------------
+double VectorDistance(const aiVector3D& a, const aiVector3D& b) {
+    return (a - b).Length();
+}
+
+// ------------------------------------------------------------------------------------------------
+aiQuaternion SlerpQuaternion(const aiQuaternion& start, const aiQuaternion& end, ai_real factor) {
+    aiQuaternion out;
+    aiQuaternion::Interpolate(out, aiQuaternion(start).Normalize(), aiQuaternion(end).Normalize(), factor);
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Angle of the rotation between two orientations
+double QuaternionDistance(const aiQuaternion& a, const aiQuaternion& b) {
+    const aiQuaternion na = aiQuaternion(a).Normalize(), nb = aiQuaternion(b).Normalize();
+    const double dot = std::fabs(static_cast<double>(na.w * nb.w + na.x * nb.x + na.y * nb.y + na.z * nb.z));
+    return 2.0 * std::acos(std::min(dot, 1.0));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Tests if interpolating between the keys first and last reproduces all the keys in between
+template <typename KeyType, typename Interpolate, typename Distance>
+bool SegmentFits(const KeyType* keys, unsigned int first, unsigned int last, Interpolate interpolate,
+        Distance distance, double maxError) {
+    const double span = keys[last].mTime - keys[first].mTime;
+    for (unsigned int i = first + 1; i < last; ++i) {
+        const double factor = span > 0.0 ? (keys[i].mTime - keys[first].mTime) / span : 0.0;
+        if (distance(interpolate(keys[first].mValue, keys[last].mValue, static_cast<ai_real>(factor)), keys[i].mValue) > maxError) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Starting from the first key, finds the longest segment reproducing the keys it skips and keeps
+// the key ending it. The segment grows exponentially and is then bisected, so long constant or
+// linear runs only cost O(n log n) interpolations.
+template <typename KeyType, typename Interpolate, typename Distance>
+std::vector<unsigned int> SelectKeys(const KeyType* keys, unsigned int numKeys, Interpolate interpolate,
+        Distance distance, double maxError) {
+    std::vector<unsigned int> kept;
+    if (0 == numKeys) {
+        return kept;
+    }
+
+    kept.push_back(0);
+    for (unsigned int anchor = 0; anchor + 1 < numKeys; anchor = kept.back()) {
+        // the next key always fits, as nothing is skipped
+        unsigned int good = anchor + 1, bad = numKeys;
+        for (unsigned int step = 2; good + 1 < numKeys; step *= 2) {
+            const unsigned int end = std::min(anchor + step, numKeys - 1);
+            if (!SegmentFits(keys, anchor, end, interpolate, distance, maxError)) {
+                bad = end;
+                break;
+            }
+            good = end;
+        }
+        while (bad < numKeys && bad - good > 1) {
+            const unsigned int middle = good + (bad - good) / 2;
+            if (SegmentFits(keys, anchor, middle, interpolate, distance, maxError)) {
+                good = middle;
+            } else {
+                bad = middle;
+            }
+        }
+        kept.push_back(good);
+    }
+    return kept;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename KeyType, typename Interpolate, typename Distance>
+unsigned int ReduceKeys(KeyType*& keys, unsigned int& numKeys, Interpolate interpolate,
+        Distance distance, double maxError) {
+    if (numKeys < 3) {
+        return 0;
+    }
+
+    const std::vector<unsigned int> kept = SelectKeys(keys, numKeys, interpolate, distance, maxError);
+    const unsigned int removed = numKeys - static_cast<unsigned int>(kept.size());
+    if (0 == removed) {
+        return 0;
+    }
+
+    KeyType* reduced = new KeyType[kept.size()];
+    for (size_t k = 0; k < kept.size(); ++k) {
+        reduced[k] = keys[kept[k]];
+    }
+    delete[] keys;
+    keys = reduced;
+    numKeys = static_cast<unsigned int>(kept.size());
+    return removed;
+}
+
+} // Namespace
+
+// ------------------------------------------------------------------------------------------------
+ReduceKeyframesProcess::ReduceKeyframesProcess()
+: BaseProcess()
+, mPositionError(AI_RK_DEFAULT_POSITION_ERROR)
+, mRotationError(AI_RK_DEFAULT_ROTATION_ERROR)
+, mScalingError(AI_RK_DEFAULT_SCALING_ERROR) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+ReduceKeyframesProcess::~ReduceKeyframesProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ReduceKeyframesProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ReduceKeyframesProcess::IsActiveExt(unsigned int pExtFlags) const {
+    return 0 != ( pExtFlags & aiProcessExt_ReduceKeyframes );
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReduceKeyframesProcess::SetupProperties(const Importer* pImp) {
+    SetErrors(pImp->GetPropertyFloat(AI_CONFIG_PP_RK_POSITION_ERROR, AI_RK_DEFAULT_POSITION_ERROR),
+            pImp->GetPropertyFloat(AI_CONFIG_PP_RK_ROTATION_ERROR, AI_RK_DEFAULT_ROTATION_ERROR),
+            pImp->GetPropertyFloat(AI_CONFIG_PP_RK_SCALING_ERROR, AI_RK_DEFAULT_SCALING_ERROR));
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReduceKeyframesProcess::SetErrors(float position, float rotation, float scaling) {
+    mPositionError = std::max(position, 0.f);
+    mRotationError = std::max(rotation, 0.f);
+    mScalingError = std::max(scaling, 0.f);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ReduceKeyframesProcess::ReduceChannel(aiNodeAnim* pChannel) const {
+    unsigned int removed = 0;
+    removed += ReduceKeys(pChannel->mPositionKeys, pChannel->mNumPositionKeys, LerpVector, VectorDistance, mPositionError);
+    removed += ReduceKeys(pChannel->mRotationKeys, pChannel->mNumRotationKeys, SlerpQuaternion, QuaternionDistance, mRotationError);
+    removed += ReduceKeys(pChannel->mScalingKeys, pChannel->mNumScalingKeys, LerpVector, VectorDistance, mScalingError);
+    return removed;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReduceKeyframesProcess::Execute(aiScene* pScene) {
+    if (nullptr == pScene || 0 == pScene->mNumAnimations) {
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("ReduceKeyframesProcess begin");
+
+    std::vector<aiNodeAnim*> channels;
+    size_t numKeys = 0;
+    for (unsigned int a = 0; a < pScene->mNumAnimations; ++a) {
+        const aiAnimation* anim = pScene->mAnimations[a];
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+            aiNodeAnim* channel = anim->mChannels[c];
+            channels.push_back(channel);
+            numKeys += channel->mNumPositionKeys + channel->mNumRotationKeys + channel->mNumScalingKeys;
+        }
+    }
+
+    size_t numRemoved = 0;
+    ParallelForThenReport(channels.size(), [&](size_t c) {
+        return ReduceChannel(channels[c]);
+    }, [&](size_t, unsigned int removed) {
+        numRemoved += removed;
+    });
+    if (0 == numRemoved) {
+        ASSIMP_LOG_DEBUG("ReduceKeyframesProcess finished. No key could be removed");
+        return;
+    }
+
+    const size_t numKept = numKeys - numRemoved;
+    ASSIMP_LOG_INFO_F("ReduceKeyframesProcess finished. Reduced ", numKeys, " keys to ", numKept,
+            " (compression ratio ", static_cast<double>(numKeys) / static_cast<double>(numKept), ":1)");
+}
+
+} // Namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_REDUCEKEYFRAMES_PROCESS
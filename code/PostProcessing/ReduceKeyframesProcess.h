@@ -0,0 +1,103 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Defines a post-processing step to remove animation keys which
+ *        can be interpolated from their neighbours.
+ */
+
+#pragma once
+
+#ifndef AI_REDUCEKEYFRAMESPROCESS_H_INC
+#define AI_REDUCEKEYFRAMESPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_REDUCEKEYFRAMES_PROCESS
+
+#include "Common/BaseProcess.h"
+
+struct aiNodeAnim;
+
+namespace Assimp {
+
+/** Post-processing process to compress the node animation channels of a
+ *  scene. A key is removed if linearly interpolating its position and
+ *  scaling, and spherically interpolating its rotation, between the keys
+ *  kept around it reproduces it within the configured error bounds.
+ */
+class ASSIMP_API ReduceKeyframesProcess : public BaseProcess {
+public:
+    /// The class constructor.
+    ReduceKeyframesProcess();
+    /// The class destructor.
+    ~ReduceKeyframesProcess();
+    /// There is no aiPostProcessSteps flag for this step, returns false.
+    bool IsActive(unsigned int pFlags) const override;
+    /// Will return true, if aiProcessExt_ReduceKeyframes is defined.
+    bool IsActiveExt(unsigned int pExtFlags) const override;
+    /// Reads the error bounds from the importer properties.
+    void SetupProperties(const Importer* pImp) override;
+    /// The execution callback.
+    void Execute(aiScene* pScene) override;
+
+    /// Sets the error bounds, negative values are clamped to 0.
+    /// @param position Maximum distance between a removed position key
+    ///   and the interpolated position.
+    /// @param rotation Maximum angle in radians between a removed rotation
+    ///   key and the interpolated rotation.
+    /// @param scaling Maximum distance between a removed scaling key and
+    ///   the interpolated scaling.
+    void SetErrors(float position, float rotation, float scaling);
+
+    /// Removes the keys of a single channel.
+    /// @return The number of removed keys.
+    unsigned int ReduceChannel(aiNodeAnim* pChannel) const;
+
+private:
+    float mPositionError;
+    float mRotationError;
+    float mScalingError;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_REDUCEKEYFRAMES_PROCESS
+
+#endif // AI_REDUCEKEYFRAMESPROCESS_H_INC
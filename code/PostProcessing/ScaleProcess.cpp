@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ----------------------------------------------------------------------
 */
 #include "ScaleProcess.h"
+#include "Common/VectorKernels.h"
 
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -119,11 +120,8 @@ void ScaleProcess::Execute( aiScene* pScene ) {
         aiMesh *mesh = pScene->mMeshes[meshID]; 
         
         // Reconstruct mesh vertexes to the new unit system
-        for( unsigned int vertexID = 0; vertexID < mesh->mNumVertices; vertexID++)
-        {
-            aiVector3D& vertex = mesh->mVertices[vertexID];
-            vertex *= mScale;
-        }
+        const aiVector3D vertexScale( mScale, mScale, mScale );
+        ScaleVectors( vertexScale, mesh->mVertices, mesh->mVertices, mesh->mNumVertices );
 
 
         // bone placement / scaling
@@ -158,11 +156,7 @@ void ScaleProcess::Execute( aiScene* pScene ) {
         {
             aiAnimMesh * animMesh = mesh->mAnimMeshes[animMeshID];
             
-            for( unsigned int vertexID = 0; vertexID < animMesh->mNumVertices; vertexID++)
-            {
-                aiVector3D& vertex = animMesh->mVertices[vertexID];
-                vertex *= mScale;
-            }
+            ScaleVectors( vertexScale, animMesh->mVertices, animMesh->mVertices, animMesh->mNumVertices );
         }
     }
 
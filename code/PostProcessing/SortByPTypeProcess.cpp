@@ -146,6 +146,8 @@ void SortByPTypeProcess::Execute( aiScene* pScene) {
 
     bool bAnyChanges = false;
 
+    const MeshLODRemapper lodRemapper(pScene);
+    const unsigned int iNumOldMeshes = pScene->mNumMeshes;
     std::vector<unsigned int> replaceMeshIndex(pScene->mNumMeshes*4,UINT_MAX);
     std::vector<unsigned int>::iterator meshIdx = replaceMeshIndex.begin();
     for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
@@ -388,6 +390,18 @@ void SortByPTypeProcess::Execute( aiScene* pScene) {
     }
     ::memcpy(pScene->mMeshes,&outMeshes[0],pScene->mNumMeshes*sizeof(void*));
 
+    // the old mesh of every new one, for the LOD lists
+    if (bAnyChanges && lodRemapper.HasLODs())
+    {
+        std::vector<unsigned int> sources(outMeshes.size(),UINT_MAX);
+        for (unsigned int i = 0; i < iNumOldMeshes*4; ++i)
+        {
+            if (UINT_MAX != replaceMeshIndex[i])
+                sources[replaceMeshIndex[i]] = i >> 2;
+        }
+        lodRemapper.Update(pScene,sources);
+    }
+
     if (!DefaultLogger::isNullLogger())
     {
         char buffer[1024];
@@ -48,8 +48,258 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SplitLargeMeshes.h"
 #include "ProcessHelper.h"
 
+#include <algorithm>
+
 using namespace Assimp;
 
+namespace {
+
+typedef std::vector<std::pair<aiMesh*, unsigned int> > MeshList;
+
+// ------------------------------------------------------------------------------------------------
+// Gathers the given vertices of a vertex stream into a new array
+template <typename T>
+T* CopyVertexStream(const T* in, const std::vector<unsigned int>& vertices) {
+    if (nullptr == in) {
+        return nullptr;
+    }
+    T* out = new T[vertices.size()];
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        out[i] = in[vertices[i]];
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Splits a mesh into chunks of consecutive faces in a single pass. A chunk is completed as soon
+// as the next face would exceed one of the limits. The vertex remap table is shared by all
+// chunks: a vertex belongs to the current chunk only if its generation is the chunk's one, so
+// the table never needs to be reset.
+class MeshChunker {
+public:
+    MeshChunker(const aiMesh* mesh, unsigned int maxVertices, unsigned int maxFaces)
+    : mMesh(mesh)
+    , mMaxVertices(maxVertices)
+    , mMaxFaces(maxFaces)
+    , mRemap(mesh->mNumVertices)
+    , mGeneration(mesh->mNumVertices, 0)
+    , mWeights(ComputeVertexBoneWeightTable(mesh))
+    , mBoneWeights(mesh->mNumBones) {
+        // empty
+    }
+
+    ~MeshChunker() {
+        delete[] mWeights;
+    }
+
+    // Appends all chunks to out
+    void Split(unsigned int meshIndex, MeshList& out) {
+        static const unsigned int Pending = 0xffffffff;
+
+        unsigned int generation = 1, firstFace = 0, f = 0;
+        while (f < mMesh->mNumFaces) {
+            const aiFace& face = mMesh->mFaces[f];
+
+            // mark the vertices the face would add to the chunk
+            unsigned int need = 0;
+            for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+                const unsigned int index = face.mIndices[i];
+                if (mGeneration[index] != generation) {
+                    mGeneration[index] = generation;
+                    mRemap[index] = Pending;
+                    ++need;
+                }
+            }
+
+            // a single face exceeding the vertex limit gets a chunk of its own
+            if (f > firstFace && (f - firstFace >= mMaxFaces || mVertices.size() + need > mMaxVertices)) {
+                // complete the chunk and retry the face with an empty one. The
+                // new generation drops the marks set above as well.
+                Emit(firstFace, f, meshIndex, out);
+                ++generation;
+                firstFace = f;
+                mVertices.clear();
+                continue;
+            }
+
+            for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+                const unsigned int index = face.mIndices[i];
+                if (Pending == mRemap[index]) {
+                    mRemap[index] = static_cast<unsigned int>(mVertices.size());
+                    mVertices.push_back(index);
+                }
+            }
+            ++f;
+        }
+        if (f > firstFace) {
+            Emit(firstFace, f, meshIndex, out);
+        }
+    }
+
+private:
+    void Emit(unsigned int firstFace, unsigned int endFace, unsigned int meshIndex, MeshList& out) {
+        out.push_back(std::pair<aiMesh*, unsigned int>(BuildChunk(firstFace, endFace), meshIndex));
+    }
+
+    // Builds a mesh from the faces [firstFace, endFace) and the vertices of the current chunk
+    aiMesh* BuildChunk(unsigned int firstFace, unsigned int endFace) {
+        const aiMesh* in = mMesh;
+        aiMesh* out = new aiMesh();
+
+        // the name carries the adjacency information between the meshes
+        out->mName = in->mName;
+        out->mMaterialIndex = in->mMaterialIndex;
+        out->mMethod = in->mMethod;
+
+        // copy the vertex streams
+        out->mNumVertices = static_cast<unsigned int>(mVertices.size());
+        out->mVertices = CopyVertexStream(in->mVertices, mVertices);
+        out->mNormals = CopyVertexStream(in->mNormals, mVertices);
+        out->mTangents = CopyVertexStream(in->mTangents, mVertices);
+        out->mBitangents = CopyVertexStream(in->mBitangents, mVertices);
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+            out->mNumUVComponents[c] = in->mNumUVComponents[c];
+            out->mTextureCoords[c] = CopyVertexStream(in->mTextureCoords[c], mVertices);
+        }
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            out->mColors[c] = CopyVertexStream(in->mColors[c], mVertices);
+        }
+
+        // copy the faces, with their indices remapped to the chunk
+        out->mNumFaces = endFace - firstFace;
+        out->mFaces = new aiFace[out->mNumFaces];
+        for (unsigned int f = 0; f < out->mNumFaces; ++f) {
+            const aiFace& src = in->mFaces[firstFace + f];
+            aiFace& dst = out->mFaces[f];
+            dst.mNumIndices = src.mNumIndices;
+            dst.mIndices = new unsigned int[src.mNumIndices];
+            for (unsigned int i = 0; i < src.mNumIndices; ++i) {
+                dst.mIndices[i] = mRemap[src.mIndices[i]];
+            }
+
+            // need to update the output primitive types
+            switch (src.mNumIndices) {
+            case 1:
+                out->mPrimitiveTypes |= aiPrimitiveType_POINT;
+                break;
+            case 2:
+                out->mPrimitiveTypes |= aiPrimitiveType_LINE;
+                break;
+            case 3:
+                out->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+                break;
+            default:
+                out->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
+            }
+        }
+
+        // copy the bones which influence at least one vertex of the chunk
+        if (nullptr != mWeights) {
+            for (unsigned int i = 0; i < out->mNumVertices; ++i) {
+                const VertexWeightTable& table = mWeights[mVertices[i]];
+                for (VertexWeightTable::const_iterator it = table.begin(); it != table.end(); ++it) {
+                    mBoneWeights[(*it).first].push_back(aiVertexWeight(i, (*it).second));
+                }
+            }
+
+            out->mBones = new aiBone*[in->mNumBones];
+            for (unsigned int b = 0; b < in->mNumBones; ++b) {
+                std::vector<aiVertexWeight>& weights = mBoneWeights[b];
+                if (weights.empty()) {
+                    continue;
+                }
+                const aiBone* srcBone = in->mBones[b];
+                aiBone* bone = new aiBone();
+                out->mBones[out->mNumBones++] = bone;
+                bone->mName = srcBone->mName;
+                bone->mOffsetMatrix = srcBone->mOffsetMatrix;
+                bone->mNumWeights = static_cast<unsigned int>(weights.size());
+                bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+                ::memcpy(bone->mWeights, &weights[0], sizeof(aiVertexWeight) * bone->mNumWeights);
+                weights.clear();
+            }
+            if (0 == out->mNumBones) {
+                delete[] out->mBones;
+                out->mBones = nullptr;
+            }
+        }
+
+        // and the anim meshes
+        if (in->mNumAnimMeshes) {
+            out->mNumAnimMeshes = in->mNumAnimMeshes;
+            out->mAnimMeshes = new aiAnimMesh*[in->mNumAnimMeshes];
+            for (unsigned int a = 0; a < in->mNumAnimMeshes; ++a) {
+                const aiAnimMesh* src = in->mAnimMeshes[a];
+                aiAnimMesh* dst = out->mAnimMeshes[a] = new aiAnimMesh();
+                dst->mName = src->mName;
+                dst->mWeight = src->mWeight;
+                dst->mNumVertices = out->mNumVertices;
+                dst->mVertices = CopyVertexStream(src->mVertices, mVertices);
+                dst->mNormals = CopyVertexStream(src->mNormals, mVertices);
+                dst->mTangents = CopyVertexStream(src->mTangents, mVertices);
+                dst->mBitangents = CopyVertexStream(src->mBitangents, mVertices);
+                for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+                    dst->mTextureCoords[c] = CopyVertexStream(src->mTextureCoords[c], mVertices);
+                }
+                for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+                    dst->mColors[c] = CopyVertexStream(src->mColors[c], mVertices);
+                }
+            }
+        }
+        return out;
+    }
+
+    const aiMesh* mMesh;
+    const unsigned int mMaxVertices;
+    const unsigned int mMaxFaces;
+
+    // per source vertex: index in the chunk and the generation of the chunk
+    std::vector<unsigned int> mRemap;
+    std::vector<unsigned int> mGeneration;
+
+    // source vertices of the current chunk
+    std::vector<unsigned int> mVertices;
+
+    // per-vertex bone weights of the source mesh, nullptr if there are no bones
+    VertexWeightTable* mWeights;
+
+    // temporary per-bone weight lists of the current chunk
+    std::vector<std::vector<aiVertexWeight> > mBoneWeights;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Replaces the mesh indices of a node and its children by the indices of the pieces in avList.
+// The pieces of source mesh i are avList[first[i]] to avList[first[i + 1] - 1].
+void UpdateNodeMeshes(aiNode* pcNode, const std::vector<unsigned int>& first) {
+    std::vector<unsigned int> aiEntries;
+    aiEntries.reserve(pcNode->mNumMeshes + 1);
+    for (unsigned int i = 0; i < pcNode->mNumMeshes; ++i) {
+        const unsigned int source = pcNode->mMeshes[i];
+        if (source + 1 >= first.size()) {
+            continue;
+        }
+        for (unsigned int a = first[source]; a < first[source + 1]; ++a) {
+            aiEntries.push_back(a);
+        }
+    }
+
+    // now build the new list
+    delete[] pcNode->mMeshes;
+    pcNode->mNumMeshes = (unsigned int)aiEntries.size();
+    pcNode->mMeshes = new unsigned int[pcNode->mNumMeshes];
+
+    for (unsigned int b = 0; b < pcNode->mNumMeshes; ++b) {
+        pcNode->mMeshes[b] = aiEntries[b];
+    }
+
+    // recusively update all other nodes
+    for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
+        UpdateNodeMeshes(pcNode->mChildren[i], first);
+    }
+}
+
+} // Namespace
+
 // ------------------------------------------------------------------------------------------------
 SplitLargeMeshesProcess_Triangle::SplitLargeMeshesProcess_Triangle() {
     LIMIT = AI_SLM_DEFAULT_MAX_TRIANGLES;
@@ -76,19 +326,25 @@ void SplitLargeMeshesProcess_Triangle::Execute( aiScene* pScene) {
     ASSIMP_LOG_DEBUG("SplitLargeMeshesProcess_Triangle begin");
     std::vector<std::pair<aiMesh*, unsigned int> > avList;
 
+    const MeshLODRemapper lodRemapper(pScene);
+    bool bReplaced = false;
     for( unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
-        this->SplitMesh(a, pScene->mMeshes[a],avList);
+        bReplaced |= this->SplitMesh(a, pScene->mMeshes[a],avList);
     }
 
-    if (avList.size() != pScene->mNumMeshes) {
+    // a mesh may be replaced by a single piece, e.g. if it has unreferenced vertices
+    if (bReplaced) {
         // it seems something has been split. rebuild the mesh list
         delete[] pScene->mMeshes;
         pScene->mNumMeshes = (unsigned int)avList.size();
         pScene->mMeshes = new aiMesh*[avList.size()];
 
+        std::vector<unsigned int> sources(avList.size());
         for (unsigned int i = 0; i < avList.size();++i) {
             pScene->mMeshes[i] = avList[i].first;
+            sources[i] = avList[i].second;
         }
+        lodRemapper.Update(pScene, sources);
 
         // now we need to update all nodes
         this->UpdateNode(pScene->mRootNode,avList);
@@ -109,35 +365,27 @@ void SplitLargeMeshesProcess_Triangle::SetupProperties( const Importer* pImp) {
 // Update a node after some meshes have been split
 void SplitLargeMeshesProcess_Triangle::UpdateNode(aiNode* pcNode,
         const std::vector<std::pair<aiMesh*, unsigned int> >& avList) {
-    // for every index in out list build a new entry
-    std::vector<unsigned int> aiEntries;
-    aiEntries.reserve(pcNode->mNumMeshes + 1);
-    for (unsigned int i = 0; i < pcNode->mNumMeshes;++i) {
-        for (unsigned int a = 0; a < avList.size();++a) {
-            if (avList[a].second == pcNode->mMeshes[i]) {
-                aiEntries.push_back(a);
-            }
-        }
+    // the pieces are appended in source mesh order, so the pieces of a source mesh are
+    // consecutive. Index them by source mesh once instead of searching per node.
+    unsigned int iNumSources = 0;
+    for (unsigned int a = 0; a < avList.size(); ++a) {
+        ai_assert(0 == a || avList[a - 1].second <= avList[a].second);
+        iNumSources = std::max(iNumSources, avList[a].second + 1);
     }
-
-    // now build the new list
-    delete[] pcNode->mMeshes;
-    pcNode->mNumMeshes = (unsigned int)aiEntries.size();
-    pcNode->mMeshes = new unsigned int[pcNode->mNumMeshes];
-
-    for (unsigned int b = 0; b < pcNode->mNumMeshes;++b) {
-        pcNode->mMeshes[b] = aiEntries[b];
+    std::vector<unsigned int> first(iNumSources + 1, 0);
+    for (unsigned int a = 0; a < avList.size(); ++a) {
+        ++first[avList[a].second + 1];
     }
-
-    // recusively update all other nodes
-    for (unsigned int i = 0; i < pcNode->mNumChildren;++i) {
-        UpdateNode ( pcNode->mChildren[i], avList );
+    for (unsigned int i = 0; i < iNumSources; ++i) {
+        first[i + 1] += first[i];
     }
+
+    UpdateNodeMeshes(pcNode, first);
 }
 
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
-void SplitLargeMeshesProcess_Triangle::SplitMesh(
+bool SplitLargeMeshesProcess_Triangle::SplitMesh(
         unsigned int a,
         aiMesh* pMesh,
         std::vector<std::pair<aiMesh*, unsigned int> >& avList) {
@@ -145,185 +393,20 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
         ASSIMP_LOG_INFO("Mesh exceeds the triangle limit. It will be split ...");
 
         // we need to split this mesh into sub meshes
-        // determine the size of a submesh
+        // determine the size of a submesh, so the faces are distributed evenly
         const unsigned int iSubMeshes = (pMesh->mNumFaces / LIMIT) + 1;
+        const unsigned int iOutFaceNum = pMesh->mNumFaces / iSubMeshes +
+            (pMesh->mNumFaces % iSubMeshes ? 1 : 0);
 
-        const unsigned int iOutFaceNum = pMesh->mNumFaces / iSubMeshes;
-        const unsigned int iOutVertexNum = iOutFaceNum * 3;
-
-        // now generate all submeshes
-        for (unsigned int i = 0; i < iSubMeshes;++i) {
-            aiMesh* pcMesh          = new aiMesh;
-            pcMesh->mNumFaces       = iOutFaceNum;
-            pcMesh->mMaterialIndex  = pMesh->mMaterialIndex;
-
-            // the name carries the adjacency information between the meshes
-            pcMesh->mName = pMesh->mName;
-
-            if (i == iSubMeshes-1) {
-                pcMesh->mNumFaces = iOutFaceNum + (
-                    pMesh->mNumFaces - iOutFaceNum * iSubMeshes);
-            }
-            // copy the list of faces
-            pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
-
-            const unsigned int iBase = iOutFaceNum * i;
-
-            // get the total number of indices
-            unsigned int iCnt = 0;
-            for (unsigned int p = iBase; p < pcMesh->mNumFaces + iBase;++p) {
-                iCnt += pMesh->mFaces[p].mNumIndices;
-            }
-            pcMesh->mNumVertices = iCnt;
-
-            // allocate storage
-            if (pMesh->mVertices != nullptr) {
-                pcMesh->mVertices = new aiVector3D[iCnt];
-            }
-
-            if (pMesh->HasNormals()) {
-                pcMesh->mNormals = new aiVector3D[iCnt];
-            }
-
-            if (pMesh->HasTangentsAndBitangents()) {
-                pcMesh->mTangents = new aiVector3D[iCnt];
-                pcMesh->mBitangents = new aiVector3D[iCnt];
-            }
-
-            // texture coordinates
-            for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c) {
-                pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
-                if (pMesh->HasTextureCoords( c)) {
-                    pcMesh->mTextureCoords[c] = new aiVector3D[iCnt];
-                }
-            }
-
-            // vertex colors
-            for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_COLOR_SETS;++c) {
-                if (pMesh->HasVertexColors( c)) {
-                    pcMesh->mColors[c] = new aiColor4D[iCnt];
-                }
-            }
-
-            if (pMesh->HasBones()) {
-                // assume the number of bones won't change in most cases
-                pcMesh->mBones = new aiBone*[pMesh->mNumBones];
-
-                // iterate through all bones of the mesh and find those which
-                // need to be copied to the split mesh
-                std::vector<aiVertexWeight> avTempWeights;
-                for (unsigned int p = 0; p < pcMesh->mNumBones;++p) {
-                    aiBone* const bone = pcMesh->mBones[p];
-                    avTempWeights.clear();
-                    avTempWeights.reserve(bone->mNumWeights / iSubMeshes);
-
-                    for (unsigned int q = 0; q < bone->mNumWeights;++q) {
-                        aiVertexWeight& weight = bone->mWeights[q];
-                        if(weight.mVertexId >= iBase && weight.mVertexId < iBase + iOutVertexNum) {
-                            avTempWeights.push_back(weight);
-                            weight = avTempWeights.back();
-                            weight.mVertexId -= iBase;
-                        }
-                    }
-
-                    if (!avTempWeights.empty()) {
-                        // we'll need this bone. Copy it ...
-                        aiBone* pc = new aiBone();
-                        pcMesh->mBones[pcMesh->mNumBones++] = pc;
-                        pc->mName = aiString(bone->mName);
-                        pc->mNumWeights = (unsigned int)avTempWeights.size();
-                        pc->mOffsetMatrix = bone->mOffsetMatrix;
-
-                        // no need to reallocate the array for the last submesh.
-                        // Here we can reuse the (large) source array, although
-                        // we'll waste some memory
-                        if (iSubMeshes-1 == i) {
-                            pc->mWeights = bone->mWeights;
-                            bone->mWeights = nullptr;
-                        } else {
-                            pc->mWeights = new aiVertexWeight[pc->mNumWeights];
-                        }
-
-                        // copy the weights
-                        ::memcpy(pc->mWeights,&avTempWeights[0],sizeof(aiVertexWeight)*pc->mNumWeights);
-                    }
-                }
-            }
-
-            // (we will also need to copy the array of indices)
-            unsigned int iCurrent = 0;
-            for (unsigned int p = 0; p < pcMesh->mNumFaces;++p) {
-                pcMesh->mFaces[p].mNumIndices = 3;
-                // allocate a new array
-                const unsigned int iTemp = p + iBase;
-                const unsigned int iNumIndices = pMesh->mFaces[iTemp].mNumIndices;
-
-                // setup face type and number of indices
-                pcMesh->mFaces[p].mNumIndices = iNumIndices;
-                unsigned int* pi = pMesh->mFaces[iTemp].mIndices;
-                unsigned int* piOut = pcMesh->mFaces[p].mIndices = new unsigned int[iNumIndices];
-
-                // need to update the output primitive types
-                switch (iNumIndices) {
-                case 1:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
-                    break;
-                case 2:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
-                    break;
-                case 3:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-                    break;
-                default:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
-                }
-
-                // and copy the contents of the old array, offset by current base
-                for (unsigned int v = 0; v < iNumIndices;++v) {
-                    unsigned int iIndex = pi[v];
-                    unsigned int iIndexOut = iCurrent++;
-                    piOut[v] = iIndexOut;
-
-                    // copy positions
-                    if (pMesh->mVertices != nullptr) {
-                        pcMesh->mVertices[iIndexOut] = pMesh->mVertices[iIndex];
-                    }
-
-                    // copy normals
-                    if (pMesh->HasNormals()) {
-                        pcMesh->mNormals[iIndexOut] = pMesh->mNormals[iIndex];
-                    }
-
-                    // copy tangents/bitangents
-                    if (pMesh->HasTangentsAndBitangents()) {
-                        pcMesh->mTangents[iIndexOut] = pMesh->mTangents[iIndex];
-                        pcMesh->mBitangents[iIndexOut] = pMesh->mBitangents[iIndex];
-                    }
-
-                    // texture coordinates
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c) {
-                        if (pMesh->HasTextureCoords( c ) ) {
-                            pcMesh->mTextureCoords[c][iIndexOut] = pMesh->mTextureCoords[c][iIndex];
-                        }
-                    }
-                    // vertex colors
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_COLOR_SETS;++c) {
-                        if (pMesh->HasVertexColors( c)) {
-                            pcMesh->mColors[c][iIndexOut] = pMesh->mColors[c][iIndex];
-                        }
-                    }
-                }
-            }
-
-            // add the newly created mesh to the list
-            avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
-        }
+        MeshChunker chunker(pMesh, 0xffffffff, iOutFaceNum);
+        chunker.Split(a, avList);
 
         // now delete the old mesh data
         delete pMesh;
-    } else {
-        avList.push_back(std::pair<aiMesh*, unsigned int>(pMesh,a));
+        return true;
     }
+    avList.push_back(std::pair<aiMesh*, unsigned int>(pMesh,a));
+    return false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -361,19 +444,25 @@ void SplitLargeMeshesProcess_Vertex::Execute( aiScene* pScene) {
         }
     }
 
+    const MeshLODRemapper lodRemapper(pScene);
+    bool bReplaced = false;
     for( unsigned int a = 0; a < pScene->mNumMeshes; ++a ) {
-        this->SplitMesh(a, pScene->mMeshes[a], avList);
+        bReplaced |= this->SplitMesh(a, pScene->mMeshes[a], avList);
     }
 
-    if (avList.size() != pScene->mNumMeshes) {
+    // a mesh may be replaced by a single piece, e.g. if it has unreferenced vertices
+    if (bReplaced) {
         // it seems something has been split. rebuild the mesh list
         delete[] pScene->mMeshes;
         pScene->mNumMeshes = (unsigned int)avList.size();
         pScene->mMeshes = new aiMesh*[avList.size()];
 
+        std::vector<unsigned int> sources(avList.size());
         for (unsigned int i = 0; i < avList.size();++i) {
             pScene->mMeshes[i] = avList[i].first;
+            sources[i] = avList[i].second;
         }
+        lodRemapper.Update(pScene, sources);
 
         // now we need to update all nodes
         SplitLargeMeshesProcess_Triangle::UpdateNode(pScene->mRootNode,avList);
@@ -391,233 +480,19 @@ void SplitLargeMeshesProcess_Vertex::SetupProperties( const Importer* pImp) {
 
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
-void SplitLargeMeshesProcess_Vertex::SplitMesh(
+bool SplitLargeMeshesProcess_Vertex::SplitMesh(
         unsigned int a,
         aiMesh* pMesh,
         std::vector<std::pair<aiMesh*, unsigned int> >& avList) {
-    if (pMesh->mNumVertices > SplitLargeMeshesProcess_Vertex::LIMIT) {
-        typedef std::vector< std::pair<unsigned int,float> > VertexWeightTable;
-
-        // build a per-vertex weight list if necessary
-        VertexWeightTable* avPerVertexWeights = ComputeVertexBoneWeightTable(pMesh);
-
-        // we need to split this mesh into sub meshes
-        // determine the estimated size of a submesh
-        // (this could be too large. Max waste is a single digit percentage)
-        const unsigned int iSubMeshes = (pMesh->mNumVertices / SplitLargeMeshesProcess_Vertex::LIMIT) + 1;
-
-        // create a std::vector<unsigned int> to indicate which vertices
-        // have already been copied
-        std::vector<unsigned int> avWasCopied;
-        avWasCopied.resize(pMesh->mNumVertices,0xFFFFFFFF);
-
-        // try to find a good estimate for the number of output faces
-        // per mesh. Add 12.5% as buffer
-        unsigned int iEstimatedSize = pMesh->mNumFaces / iSubMeshes;
-        iEstimatedSize += iEstimatedSize >> 3;
-
-        // now generate all submeshes
-        unsigned int iBase( 0 );
-        while (true) {
-            const unsigned int iOutVertexNum = SplitLargeMeshesProcess_Vertex::LIMIT;
-            aiMesh* pcMesh          = new aiMesh;
-            pcMesh->mNumVertices    = 0;
-            pcMesh->mMaterialIndex  = pMesh->mMaterialIndex;
-
-            // the name carries the adjacency information between the meshes
-            pcMesh->mName = pMesh->mName;
-
-            typedef std::vector<aiVertexWeight> BoneWeightList;
-            if (pMesh->HasBones()) {
-                pcMesh->mBones = new aiBone*[pMesh->mNumBones];
-                ::memset(pcMesh->mBones,0,sizeof(void*)*pMesh->mNumBones);
-            }
-
-            // clear the temporary helper array
-            if (iBase) {
-                // we can't use memset here we unsigned int needn' be 32 bits
-                for (auto &elem : avWasCopied) {
-                    elem = 0xffffffff;
-                }
-            }
-
-            // output vectors
-            std::vector<aiFace> vFaces;
-
-            // reserve enough storage for most cases
-            if (pMesh->HasPositions()) {
-                pcMesh->mVertices = new aiVector3D[iOutVertexNum];
-            }
-            if (pMesh->HasNormals()) {
-                pcMesh->mNormals = new aiVector3D[iOutVertexNum];
-            }
-            if (pMesh->HasTangentsAndBitangents()) {
-                pcMesh->mTangents = new aiVector3D[iOutVertexNum];
-                pcMesh->mBitangents = new aiVector3D[iOutVertexNum];
-            }
-            for (unsigned int c = 0; pMesh->HasVertexColors(c);++c) {
-                pcMesh->mColors[c] = new aiColor4D[iOutVertexNum];
-            }
-            for (unsigned int c = 0; pMesh->HasTextureCoords(c);++c) {
-                pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
-                pcMesh->mTextureCoords[c] = new aiVector3D[iOutVertexNum];
-            }
-            vFaces.reserve(iEstimatedSize);
-
-            // (we will also need to copy the array of indices)
-            while (iBase < pMesh->mNumFaces) {
-                // allocate a new array
-                const unsigned int iNumIndices = pMesh->mFaces[iBase].mNumIndices;
-
-                // doesn't catch degenerates but is quite fast
-                unsigned int iNeed = 0;
-                for (unsigned int v = 0; v < iNumIndices;++v) {
-                    unsigned int iIndex = pMesh->mFaces[iBase].mIndices[v];
-
-                    // check whether we do already have this vertex
-                    if (0xFFFFFFFF == avWasCopied[iIndex]) {
-                        iNeed++;
-                    }
-                }
-                if (pcMesh->mNumVertices + iNeed > iOutVertexNum) {
-                    // don't use this face
-                    break;
-                }
-
-                vFaces.push_back(aiFace());
-                aiFace& rFace = vFaces.back();
-
-                // setup face type and number of indices
-                rFace.mNumIndices = iNumIndices;
-                rFace.mIndices = new unsigned int[iNumIndices];
-
-                // need to update the output primitive types
-                switch (rFace.mNumIndices) {
-                case 1:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
-                    break;
-                case 2:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
-                    break;
-                case 3:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-                    break;
-                default:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
-                }
-
-                // and copy the contents of the old array, offset by current base
-                for (unsigned int v = 0; v < iNumIndices;++v) {
-                    unsigned int iIndex = pMesh->mFaces[iBase].mIndices[v];
-
-                    // check whether we do already have this vertex
-                    if (0xFFFFFFFF != avWasCopied[iIndex]) {
-                        rFace.mIndices[v] = avWasCopied[iIndex];
-                        continue;
-                    }
-
-                    // copy positions
-                    pcMesh->mVertices[pcMesh->mNumVertices] = (pMesh->mVertices[iIndex]);
-
-                    // copy normals
-                    if (pMesh->HasNormals()) {
-                        pcMesh->mNormals[pcMesh->mNumVertices] = (pMesh->mNormals[iIndex]);
-                    }
-
-                    // copy tangents/bitangents
-                    if (pMesh->HasTangentsAndBitangents()) {
-                        pcMesh->mTangents[pcMesh->mNumVertices] = (pMesh->mTangents[iIndex]);
-                        pcMesh->mBitangents[pcMesh->mNumVertices] = (pMesh->mBitangents[iIndex]);
-                    }
-
-                    // texture coordinates
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c) {
-                        if (pMesh->HasTextureCoords( c)) {
-                            pcMesh->mTextureCoords[c][pcMesh->mNumVertices] = pMesh->mTextureCoords[c][iIndex];
-                        }
-                    }
-                    // vertex colors
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_COLOR_SETS;++c) {
-                        if (pMesh->HasVertexColors( c)) {
-                            pcMesh->mColors[c][pcMesh->mNumVertices] = pMesh->mColors[c][iIndex];
-                        }
-                    }
-                    // check whether we have bone weights assigned to this vertex
-                    rFace.mIndices[v] = pcMesh->mNumVertices;
-                    if (avPerVertexWeights) {
-                        VertexWeightTable& table = avPerVertexWeights[ pcMesh->mNumVertices ];
-                        if( !table.empty() ) {
-                            for (VertexWeightTable::const_iterator iter =  table.begin();
-                                    iter != table.end();++iter) {
-                                // allocate the bone weight array if necessary
-                                BoneWeightList* pcWeightList = (BoneWeightList*)pcMesh->mBones[(*iter).first];
-                                if (nullptr == pcWeightList) {
-                                    pcMesh->mBones[(*iter).first] = (aiBone*)(pcWeightList = new BoneWeightList());
-                                }
-                                pcWeightList->push_back(aiVertexWeight(pcMesh->mNumVertices,(*iter).second));
-                            }
-                        }
-                    }
-
-                    avWasCopied[iIndex] = pcMesh->mNumVertices;
-                    pcMesh->mNumVertices++;
-                }
-                ++iBase;
-                if(pcMesh->mNumVertices == iOutVertexNum) {
-                    // break here. The face is only added if it was complete
-                    break;
-                }
-            }
-
-            // check which bones we'll need to create for this submesh
-            if (pMesh->HasBones()) {
-                aiBone** ppCurrent = pcMesh->mBones;
-                for (unsigned int k = 0; k < pMesh->mNumBones;++k) {
-                    // check whether the bone is existing
-                    BoneWeightList* pcWeightList;
-                    if ((pcWeightList = (BoneWeightList*)pcMesh->mBones[k])) {
-                        aiBone* pcOldBone = pMesh->mBones[k];
-                        aiBone* pcOut( nullptr );
-                        *ppCurrent++ = pcOut = new aiBone();
-                        pcOut->mName = aiString(pcOldBone->mName);
-                        pcOut->mOffsetMatrix = pcOldBone->mOffsetMatrix;
-                        pcOut->mNumWeights = (unsigned int)pcWeightList->size();
-                        pcOut->mWeights = new aiVertexWeight[pcOut->mNumWeights];
-
-                        // copy the vertex weights
-                        ::memcpy(pcOut->mWeights,&pcWeightList->operator[](0),
-                            pcOut->mNumWeights * sizeof(aiVertexWeight));
-
-                        // delete the temporary bone weight list
-                        delete pcWeightList;
-                        pcMesh->mNumBones++;
-                    }
-                }
-            }
-
-            // copy the face list to the mesh
-            pcMesh->mFaces = new aiFace[vFaces.size()];
-            pcMesh->mNumFaces = (unsigned int)vFaces.size();
-
-            for (unsigned int p = 0; p < pcMesh->mNumFaces;++p) {
-                pcMesh->mFaces[p] = vFaces[p];
-            }
-
-            // add the newly created mesh to the list
-            avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
-
-            if (iBase == pMesh->mNumFaces) {
-                // have all faces ... finish the outer loop, too
-                break;
-            }
-        }
-
-        // delete the per-vertex weight list again
-        delete[] avPerVertexWeights;
+    // without faces there is nothing to distribute over the sub-meshes, keep the mesh as it is
+    if (pMesh->mNumVertices > SplitLargeMeshesProcess_Vertex::LIMIT && pMesh->mNumFaces) {
+        MeshChunker chunker(pMesh, SplitLargeMeshesProcess_Vertex::LIMIT, 0xffffffff);
+        chunker.Split(a, avList);
 
         // now delete the old mesh data
         delete pMesh;
-        return;
+        return true;
     }
     avList.push_back(std::pair<aiMesh*, unsigned int>(pMesh,a));
+    return false;
 }
@@ -81,7 +81,8 @@ class SplitLargeMeshesProcess_Vertex;
 /** Post-processing filter to split large meshes into sub-meshes
  *
  * Applied BEFORE the JoinVertices-Step occurs.
- * Returns NON-UNIQUE vertices, splits by triangle number.
+ * Splits by triangle number, the vertices referenced by a sub-mesh are
+ * copied once per sub-mesh.
 */
 class ASSIMP_API SplitLargeMeshesProcess_Triangle : public BaseProcess
 {
@@ -129,8 +130,9 @@ public:
     void Execute( aiScene* pScene);
 
     // -------------------------------------------------------------------
-    //! Apply the algorithm to a given mesh
-    void SplitMesh (unsigned int a, aiMesh* pcMesh,
+    //! Apply the algorithm to a given mesh. Returns true if the mesh
+    //! was deleted and replaced by its pieces.
+    bool SplitMesh (unsigned int a, aiMesh* pcMesh,
         std::vector<std::pair<aiMesh*, unsigned int> >& avList);
 
     // -------------------------------------------------------------------
@@ -193,14 +195,15 @@ public:
     void Execute( aiScene* pScene);
 
     // -------------------------------------------------------------------
-    //! Apply the algorithm to a given mesh
-    void SplitMesh (unsigned int a, aiMesh* pcMesh,
+    //! Apply the algorithm to a given mesh. Returns true if the mesh
+    //! was deleted and replaced by its pieces.
+    bool SplitMesh (unsigned int a, aiMesh* pcMesh,
         std::vector<std::pair<aiMesh*, unsigned int> >& avList);
 
     // NOTE: Reuse SplitLargeMeshesProcess_Triangle::UpdateNode()
 
 public:
-    //! Triangle limit
+    //! Vertex limit
     unsigned int LIMIT;
 };
 
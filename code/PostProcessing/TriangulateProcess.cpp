@@ -48,6 +48,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *  Self-intersecting or non-planar polygons are not rejected, but
  *  they're probably not triangulated correctly.
  *
+ *  Small polygons are triangulated by ear cutting. Large polygons are
+ *  split into y-monotone pieces by a sweep line, which are then
+ *  triangulated in linear time (see de Berg et al., Computational
+ *  Geometry, chapter 3). If the sweep fails, which only happens for
+ *  polygons which aren't simple, ear cutting is used as well.
+ *
  * DEBUG SWITCHES - do not enable any of them in release builds:
  *
  * AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
@@ -63,7 +69,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/PolyTools.h"
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include <memory>
+#include <set>
 
 //#define AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
 //#define AI_BUILD_TRIANGULATE_DEBUG_POLYS
@@ -75,9 +85,414 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Total order of the sweep line: descending y, then ascending x. Coincident points are
+// ordered by their position in the polygon.
+inline bool SweepAbove(const aiVector2D* pts, unsigned int a, unsigned int b) {
+    if (pts[a].y != pts[b].y) {
+        return pts[a].y > pts[b].y;
+    }
+    if (pts[a].x != pts[b].x) {
+        return pts[a].x < pts[b].x;
+    }
+    return a < b;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Twice the signed area of a triangle, positive for ccw winding
+inline double Cross2D(const aiVector2D& o, const aiVector2D& a, const aiVector2D& b) {
+    return ((double)a.x - o.x) * ((double)b.y - o.y) - ((double)a.y - o.y) * ((double)b.x - o.x);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Appends a triangle in ccw winding
+inline void EmitTriangle(const aiVector2D* pts, unsigned int a, unsigned int b, unsigned int c,
+        std::vector<unsigned int>& tris) {
+    if (Cross2D(pts[a], pts[b], pts[c]) < 0.0) {
+        std::swap(b, c);
+    }
+    tris.push_back(a);
+    tris.push_back(b);
+    tris.push_back(c);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sweep line status: the polygon edges left of the interior which are crossed by the sweep line,
+// ordered by their x coordinate at the current sweep position. Edge i runs from point i to i+1.
+class SweepStatus {
+public:
+    // Sentinel edge index which stands for the current sweep point in lookups
+    static const unsigned int Query = UINT_MAX;
+
+    SweepStatus(const aiVector2D* pts, unsigned int num)
+    : mPts(pts)
+    , mNum(num)
+    , mX()
+    , mY() {
+        // empty
+    }
+
+    void SetSweepPoint(const aiVector2D& p) {
+        mX = p.x;
+        mY = p.y;
+    }
+
+    double XAt(unsigned int e) const {
+        if (Query == e) {
+            return mX;
+        }
+        const aiVector2D& a = mPts[e], &b = mPts[(e + 1) % mNum];
+        if (a.y == b.y) {
+            // horizontal edges are only crossed at their end points
+            return std::min(std::max(mX, (double)std::min(a.x, b.x)), (double)std::max(a.x, b.x));
+        }
+        return a.x + (mY - a.y) * ((double)b.x - a.x) / ((double)b.y - a.y);
+    }
+
+    bool Less(unsigned int e0, unsigned int e1) const {
+        if (e0 == e1) {
+            return false;
+        }
+        const double x0 = XAt(e0), x1 = XAt(e1);
+        if (x0 != x1) {
+            return x0 < x1;
+        }
+        // a point touching an edge is right of it
+        if (Query == e0 || Query == e1) {
+            return Query == e1;
+        }
+        // edges meeting in the sweep point - the one heading further left is left
+        const double s0 = InvSlope(e0), s1 = InvSlope(e1);
+        if (s0 != s1) {
+            return s0 > s1;
+        }
+        return e0 < e1;
+    }
+
+private:
+    double InvSlope(unsigned int e) const {
+        const aiVector2D& a = mPts[e], &b = mPts[(e + 1) % mNum];
+        return a.y == b.y ? 0.0 : ((double)b.x - a.x) / ((double)b.y - a.y);
+    }
+
+    const aiVector2D* mPts;
+    unsigned int mNum;
+    double mX, mY;
+};
+
+struct SweepEdgeLess {
+    const SweepStatus* mStatus;
+    bool operator()(unsigned int e0, unsigned int e1) const {
+        return mStatus->Less(e0, e1);
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Triangulates an y-monotone polygon given in ccw winding in linear time
+bool TriangulateMonotone(const aiVector2D* pts, const std::vector<unsigned int>& poly,
+        std::vector<unsigned int>& tris) {
+    const size_t n = poly.size();
+    if (n < 3) {
+        return false;
+    }
+
+    size_t top = 0, bottom = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (SweepAbove(pts, poly[i], poly[top])) {
+            top = i;
+        }
+        if (SweepAbove(pts, poly[bottom], poly[i])) {
+            bottom = i;
+        }
+    }
+
+    // Walking ccw from the top vertex leads down the left chain, walking cw down the right
+    // chain. Merge both chains into sweep order.
+    struct ChainVertex {
+        unsigned int mIdx;
+        bool mLeft;
+    };
+    std::vector<ChainVertex> sorted;
+    sorted.reserve(n);
+    sorted.push_back({ poly[top], true });
+    size_t numLeft = (bottom + n - top) % n, numRight = n - 1 - numLeft;
+    size_t l = (top + 1) % n, r = (top + n - 1) % n;
+    while (numLeft || numRight) {
+        const bool takeLeft = !numRight || (numLeft && SweepAbove(pts, poly[l], poly[r]));
+        const unsigned int idx = takeLeft ? poly[l] : poly[r];
+        const unsigned int above = takeLeft ? poly[(l + n - 1) % n] : poly[(r + 1) % n];
+        if (!SweepAbove(pts, above, idx)) {
+            // not monotone
+            return false;
+        }
+        sorted.push_back({ idx, takeLeft });
+        if (takeLeft) {
+            l = (l + 1) % n;
+            --numLeft;
+        } else {
+            r = (r + n - 1) % n;
+            --numRight;
+        }
+    }
+
+    std::vector<ChainVertex> stack;
+    stack.reserve(n);
+    stack.push_back(sorted[0]);
+    stack.push_back(sorted[1]);
+    for (size_t j = 2; j < n - 1; ++j) {
+        const ChainVertex& u = sorted[j];
+        if (u.mLeft != stack.back().mLeft) {
+            // connect to all vertices on the other chain
+            for (size_t k = 0; k + 1 < stack.size(); ++k) {
+                EmitTriangle(pts, u.mIdx, stack[k].mIdx, stack[k + 1].mIdx, tris);
+            }
+            stack.clear();
+            stack.push_back(sorted[j - 1]);
+            stack.push_back(u);
+        } else {
+            // cut off ears as long as the diagonals stay inside the polygon
+            ChainVertex last = stack.back();
+            stack.pop_back();
+            while (!stack.empty()) {
+                const ChainVertex& cand = stack.back();
+                const double turn = u.mLeft ?
+                    Cross2D(pts[cand.mIdx], pts[last.mIdx], pts[u.mIdx]) :
+                    Cross2D(pts[u.mIdx], pts[last.mIdx], pts[cand.mIdx]);
+                if (turn <= 0.0) {
+                    break;
+                }
+                EmitTriangle(pts, cand.mIdx, last.mIdx, u.mIdx, tris);
+                last = cand;
+                stack.pop_back();
+            }
+            stack.push_back(last);
+            stack.push_back(u);
+        }
+    }
+    for (size_t k = 0; k + 1 < stack.size(); ++k) {
+        EmitTriangle(pts, sorted[n - 1].mIdx, stack[k].mIdx, stack[k + 1].mIdx, tris);
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Triangulates a simple polygon in ccw winding in O(n log n): a sweep line splits it into
+// y-monotone pieces, which are triangulated separately. Returns false if the polygon turns
+// out not to be simple, the caller should then fall back to ear cutting.
+bool TriangulateSweep(const aiVector2D* pts, unsigned int num, std::vector<unsigned int>& tris) {
+    tris.clear();
+
+    double area = 0.0;
+    for (unsigned int i = 0; i < num; ++i) {
+        const aiVector2D& a = pts[i], &b = pts[(i + 1) % num];
+        area += (double)a.x * b.y - (double)b.x * a.y;
+    }
+    if (!(area > 0.0)) {
+        return false;
+    }
+
+    enum VertexType { Start, End, Split, Merge, RegularLeft, RegularRight };
+    std::vector<VertexType> types(num);
+    for (unsigned int v = 0; v < num; ++v) {
+        const unsigned int prev = (v + num - 1) % num, next = (v + 1) % num;
+        const bool prevAbove = SweepAbove(pts, prev, v), nextAbove = SweepAbove(pts, next, v);
+        const bool convex = Cross2D(pts[prev], pts[v], pts[next]) > 0.0;
+        if (!prevAbove && !nextAbove) {
+            types[v] = convex ? Start : Split;
+        } else if (prevAbove && nextAbove) {
+            types[v] = convex ? End : Merge;
+        } else {
+            // the interior is right of the left chain, which is traversed downwards
+            types[v] = prevAbove ? RegularLeft : RegularRight;
+        }
+    }
+
+    std::vector<unsigned int> order(num);
+    for (unsigned int i = 0; i < num; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [pts](unsigned int a, unsigned int b) {
+        return SweepAbove(pts, a, b);
+    });
+
+    // split the polygon into monotone pieces by adding diagonals at split and merge vertices
+    typedef std::set<unsigned int, SweepEdgeLess> StatusTree;
+    SweepStatus status(pts, num);
+    StatusTree tree(SweepEdgeLess{ &status });
+    std::vector<StatusTree::iterator> edges(num, tree.end());
+    std::vector<unsigned int> helper(num);
+    std::vector<std::vector<unsigned int> > neighbors(num);
+    unsigned int numDiagonals = 0;
+
+    auto addDiagonal = [&](unsigned int a, unsigned int b) {
+        neighbors[a].push_back(b);
+        neighbors[b].push_back(a);
+        ++numDiagonals;
+    };
+    auto fixUp = [&](unsigned int v, unsigned int e) {
+        if (Merge == types[helper[e]]) {
+            addDiagonal(v, helper[e]);
+        }
+    };
+    auto insertEdge = [&](unsigned int e, unsigned int v) {
+        edges[e] = tree.insert(e).first;
+        helper[e] = v;
+    };
+    auto removeEdge = [&](unsigned int e) {
+        if (edges[e] == tree.end()) {
+            return false;
+        }
+        tree.erase(edges[e]);
+        edges[e] = tree.end();
+        return true;
+    };
+    auto leftEdge = [&]() -> int {
+        const unsigned int query = SweepStatus::Query;
+        StatusTree::iterator it = tree.lower_bound(query);
+        return it == tree.begin() ? -1 : static_cast<int>(*--it);
+    };
+
+    for (unsigned int v : order) {
+        const unsigned int prev = (v + num - 1) % num;
+        status.SetSweepPoint(pts[v]);
+        switch (types[v]) {
+            case Start:
+                insertEdge(v, v);
+                break;
+            case End:
+                if (edges[prev] == tree.end()) {
+                    return false;
+                }
+                fixUp(v, prev);
+                removeEdge(prev);
+                break;
+            case Split: {
+                const int e = leftEdge();
+                if (e < 0) {
+                    return false;
+                }
+                addDiagonal(v, helper[e]);
+                helper[e] = v;
+                insertEdge(v, v);
+                break;
+            }
+            case Merge: {
+                if (edges[prev] == tree.end()) {
+                    return false;
+                }
+                fixUp(v, prev);
+                removeEdge(prev);
+                const int e = leftEdge();
+                if (e < 0) {
+                    return false;
+                }
+                fixUp(v, e);
+                helper[e] = v;
+                break;
+            }
+            case RegularLeft:
+                if (edges[prev] == tree.end()) {
+                    return false;
+                }
+                fixUp(v, prev);
+                removeEdge(prev);
+                insertEdge(v, v);
+                break;
+            case RegularRight: {
+                const int e = leftEdge();
+                if (e < 0) {
+                    return false;
+                }
+                fixUp(v, e);
+                helper[e] = v;
+                break;
+            }
+        }
+    }
+
+    tris.reserve((num - 2) * 3);
+    if (!numDiagonals) {
+        std::vector<unsigned int> poly(num);
+        for (unsigned int i = 0; i < num; ++i) {
+            poly[i] = i;
+        }
+        if (!TriangulateMonotone(pts, poly, tris)) {
+            return false;
+        }
+    } else {
+        // Walk the faces of the subdivision. Arriving at a vertex, the next edge of the
+        // face is the first one clockwise from the incoming edge.
+        for (unsigned int v = 0; v < num; ++v) {
+            std::vector<unsigned int>& nb = neighbors[v];
+            nb.push_back((v + num - 1) % num);
+            nb.push_back((v + 1) % num);
+            if (nb.size() > 2) {
+                const aiVector2D& o = pts[v];
+                std::sort(nb.begin(), nb.end(), [pts, &o](unsigned int a, unsigned int b) {
+                    return std::atan2((double)pts[a].y - o.y, (double)pts[a].x - o.x) <
+                        std::atan2((double)pts[b].y - o.y, (double)pts[b].x - o.x);
+                });
+            }
+        }
+        std::vector<std::vector<bool> > used(num);
+        for (unsigned int v = 0; v < num; ++v) {
+            used[v].resize(neighbors[v].size(), false);
+        }
+
+        std::vector<unsigned int> poly;
+        for (unsigned int v = 0; v < num; ++v) {
+            for (size_t k = 0; k < neighbors[v].size(); ++k) {
+                // the interior is left of every edge we walk along, so the polygon
+                // edges are only walked in ccw direction
+                if (used[v][k] || neighbors[v][k] == (v + num - 1) % num) {
+                    continue;
+                }
+                poly.clear();
+                unsigned int cur = v;
+                size_t slot = k;
+                while (!used[cur][slot]) {
+                    if (poly.size() > num) {
+                        return false;
+                    }
+                    used[cur][slot] = true;
+                    poly.push_back(cur);
+
+                    const unsigned int nextVertex = neighbors[cur][slot];
+                    const std::vector<unsigned int>& nb = neighbors[nextVertex];
+                    const size_t back = std::find(nb.begin(), nb.end(), cur) - nb.begin();
+                    slot = (back + nb.size() - 1) % nb.size();
+                    cur = nextVertex;
+                    if (nb[slot] == (cur + num - 1) % num) {
+                        return false;
+                    }
+                }
+                if (cur != v || slot != k || !TriangulateMonotone(pts, poly, tris)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Final sanity check against non-simple input: the triangles must cover
+    // exactly the area of the polygon.
+    if (tris.size() != (num - 2) * 3) {
+        return false;
+    }
+    double sum = 0.0;
+    for (size_t i = 0; i < tris.size(); i += 3) {
+        sum += Cross2D(pts[tris[i]], pts[tris[i + 1]], pts[tris[i + 2]]);
+    }
+    return std::fabs(sum - area) <= area * 1e-5;
+}
+
+} // Namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 TriangulateProcess::TriangulateProcess()
+: mSweepThreshold(AI_TRI_DEFAULT_SWEEP_THRESHOLD)
 {
     // nothing to do here
 }
@@ -96,6 +511,13 @@ bool TriangulateProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_Triangulate) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void TriangulateProcess::SetupProperties(const Importer* pImp)
+{
+    mSweepThreshold = pImp->GetPropertyInteger(AI_CONFIG_PP_TRI_SWEEP_THRESHOLD,AI_TRI_DEFAULT_SWEEP_THRESHOLD);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void TriangulateProcess::Execute( aiScene* pScene)
@@ -196,6 +618,7 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 
     // use std::unique_ptr to avoid slow std::vector<bool> specialiations
     std::unique_ptr<bool[]> done(new bool[max_out]);
+    std::vector<unsigned int> sweep_tris;
     for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
         aiFace& face = pMesh->mFaces[a];
 
@@ -356,9 +779,25 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
             fprintf(fout,"\ntriangulation sequence: ");
 #endif
 
+            // Large polygons are triangulated by a sweep line in O(n log n)
+            if (mSweepThreshold && num >= (int)mSweepThreshold) {
+                if (TriangulateSweep(&temp_verts.front(), max, sweep_tris)) {
+                    for (size_t i = 0; i < sweep_tris.size(); i += 3) {
+                        aiFace& nface = *curOut++;
+                        nface.mNumIndices = 3;
+                        nface.mIndices = new unsigned int[3];
+                        std::copy(&sweep_tris[i], &sweep_tris[i] + 3, nface.mIndices);
+                    }
+                    num = 0;
+                }
+                else {
+                    ASSIMP_LOG_DEBUG("Sweep line triangulation failed, polygon is probably not simple. Falling back to ear cutting.");
+                }
+            }
+
             //
-            // FIXME: currently this is the slow O(kn) variant with a worst case
-            // complexity of O(n^2) (I think). Can be done in O(n).
+            // Ear cutting is the slow O(kn) variant with a worst case complexity
+            // of O(n^2), but it copes better with polygons which aren't simple.
             while (num > 3) {
 
                 // Find the next ear of the polygon
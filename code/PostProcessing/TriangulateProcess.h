@@ -79,11 +79,23 @@ public:
     */
     void Execute( aiScene* pScene);
 
+    // -------------------------------------------------------------------
+    /** Called prior to ExecuteOnScene().
+    * The function is a request to the process to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer* pImp);
+
     // -------------------------------------------------------------------
     /** Triangulates the given mesh.
      * @param pMesh The mesh to triangulate.
      */
     bool TriangulateMesh( aiMesh* pMesh);
+
+private:
+    //! Configuration parameter: polygons with at least this many
+    //! vertices are triangulated by a sweep line, 0 disables it.
+    unsigned int mSweepThreshold;
 };
 
 } // end of namespace Assimp
@@ -51,13 +51,103 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/BaseImporter.h>
 #include <assimp/fast_atof.h>
 #include "ProcessHelper.h"
+#include "Common/ParallelFor.h"
 #include <memory>
+#include <atomic>
+#include <exception>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 // CRT headers
 #include <stdarg.h>
+#include <limits.h>
 
 using namespace Assimp;
 
+namespace {
+
+// Warnings of the entry the current thread validates in ValidateInParallel(),
+// they are logged afterwards in the order a sequential run would produce.
+thread_local std::vector<std::string>* tWarnings = nullptr;
+
+// ------------------------------------------------------------------------------------------------
+// Calls validate(i) for all entries in [0,size) on all threads. Warnings and the
+// error (if any) are reported exactly as if the entries were validated in order.
+template <typename Func>
+void ValidateInParallel(unsigned int size, const Func& validate) {
+    struct Result {
+        std::vector<std::string> mWarnings;
+        std::exception_ptr mError;
+    };
+    std::atomic<unsigned int> firstError(size);
+
+    ParallelForThenReport(size, [&](size_t idx) {
+        const unsigned int i = static_cast<unsigned int>(idx);
+        Result result;
+        if (i > firstError) {
+            // a preceding entry failed already, a sequential run would never get here
+            return result;
+        }
+        tWarnings = &result.mWarnings;
+        try {
+            validate(i);
+        } catch (...) {
+            result.mError = std::current_exception();
+            unsigned int current = firstError;
+            while (i < current && !firstError.compare_exchange_weak(current, i)) {}
+        }
+        tWarnings = nullptr;
+        return result;
+    }, [](size_t, const Result& result) {
+        for (const std::string& warning : result.mWarnings) {
+            ASSIMP_LOG_WARN(warning);
+        }
+        if (result.mError) {
+            std::rethrow_exception(result.mError);
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the key used to hash a name, matching aiString::operator==
+inline std::string NameKey(const aiString& name) {
+    return std::string(name.data, std::min<size_t>(name.length, MAXLEN - 1));
+}
+
+// ------------------------------------------------------------------------------------------------
+// For each entry, finds the index of the next entry with the same name
+// (or UINT_MAX if there is none). NULL entries are skipped.
+template <typename T>
+std::vector<unsigned int> FindNextDuplicateNames(const T* const* array, unsigned int size) {
+    std::vector<unsigned int> next(size, UINT_MAX);
+    std::unordered_map<std::string, unsigned int> latest;
+    latest.reserve(size);
+    for (unsigned int i = size; i-- > 0;) {
+        if (!array[i] || array[i]->mName.length >= MAXLEN) {
+            continue;
+        }
+        auto res = latest.emplace(NameKey(array[i]->mName), i);
+        if (!res.second) {
+            next[i] = res.first->second;
+            res.first->second = i;
+        }
+    }
+    return next;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Counts how often each node name occurs in the scene graph
+void CountNodeNames(const aiNode* node, std::unordered_map<std::string, int>& counts) {
+    ++counts[NameKey(node->mName)];
+    for (unsigned int i = 0; i < node->mNumChildren;++i) {
+        CountNodeNames(node->mChildren[i], counts);
+    }
+}
+
+} // Namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ValidateDSProcess::ValidateDSProcess() :
@@ -104,17 +194,12 @@ void ValidateDSProcess::ReportWarning(const char* msg,...)
     ai_assert(iLen > 0);
 
     va_end(args);
-    ASSIMP_LOG_WARN("Validation warning: " + std::string(szBuffer,iLen));
-}
-
-// ------------------------------------------------------------------------------------------------
-inline
-int HasNameMatch(const aiString& in, aiNode* node) {
-    int result = (node->mName == in ? 1 : 0 );
-    for (unsigned int i = 0; i < node->mNumChildren;++i)    {
-        result += HasNameMatch(in,node->mChildren[i]);
+    const std::string warning = "Validation warning: " + std::string(szBuffer,iLen);
+    if (tWarnings) {
+        tWarnings->push_back(warning);
+    } else {
+        ASSIMP_LOG_WARN(warning);
     }
-    return result;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -129,15 +214,15 @@ void ValidateDSProcess::DoValidation(T** parray, unsigned int size, const char*
             ReportError("aiScene::%s is NULL (aiScene::%s is %i)",
                 firstName, secondName, size);
         }
-        for (unsigned int i = 0; i < size;++i)
-        {
+        // the entries don't depend on each other, so spread them across all threads
+        ValidateInParallel(size, [&](unsigned int i) {
             if (!parray[i])
             {
                 ReportError("aiScene::%s[%i] is NULL (aiScene::%s is %i)",
                     firstName,i,secondName,size);
             }
             Validate(parray[i]);
-        }
+        });
     }
 }
 
@@ -153,6 +238,7 @@ inline void ValidateDSProcess::DoValidationEx(T** parray, unsigned int size,
             ReportError("aiScene::%s is NULL (aiScene::%s is %i)",
                 firstName, secondName, size);
         }
+        const std::vector<unsigned int> nextDuplicate = FindNextDuplicateNames(parray, size);
         for (unsigned int i = 0; i < size;++i)
         {
             if (!parray[i])
@@ -163,13 +249,10 @@ inline void ValidateDSProcess::DoValidationEx(T** parray, unsigned int size,
             Validate(parray[i]);
 
             // check whether there are duplicate names
-            for (unsigned int a = i+1; a < size;++a)
+            if (nextDuplicate[i] != UINT_MAX)
             {
-                if (parray[i]->mName == parray[a]->mName)
-                {
-                	ReportError("aiScene::%s[%u] has the same name as "
-                        "aiScene::%s[%u]",firstName, i,secondName, a);
-                }
+                ReportError("aiScene::%s[%u] has the same name as "
+                    "aiScene::%s[%u]",firstName, i,secondName, nextDuplicate[i]);
             }
         }
     }
@@ -183,8 +266,11 @@ void ValidateDSProcess::DoValidationWithNameCheck(T** array, unsigned int size,
     // validate all entries
     DoValidationEx(array,size,firstName,secondName);
 
+    std::unordered_map<std::string, int> nodeNames;
+    CountNodeNames(mScene->mRootNode, nodeNames);
     for (unsigned int i = 0; i < size;++i) {
-        int res = HasNameMatch(array[i]->mName,mScene->mRootNode);
+        const auto it = nodeNames.find(NameKey(array[i]->mName));
+        const int res = it == nodeNames.end() ? 0 : it->second;
         if (0 == res)   {
             const std::string name = static_cast<char*>(array[i]->mName.data);
             ReportError("aiScene::%s[%i] has no corresponding node in the scene graph (%s)",
@@ -618,6 +704,7 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
         }
 
         // check whether there are duplicate bone names
+        const std::vector<unsigned int> nextDuplicate = FindNextDuplicateNames(pMesh->mBones, pMesh->mNumBones);
         for (unsigned int i = 0; i < pMesh->mNumBones;++i)
         {
             const aiBone* bone = pMesh->mBones[i];
@@ -632,17 +719,14 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
             }
             Validate(pMesh,pMesh->mBones[i],afSum.get());
 
-            for (unsigned int a = i+1; a < pMesh->mNumBones;++a)
+            if (nextDuplicate[i] != UINT_MAX)
             {
-                if (pMesh->mBones[i]->mName == pMesh->mBones[a]->mName)
-                {
-                    const char *name = "unknown";
-                    if (nullptr != pMesh->mBones[ i ]->mName.C_Str()) {
-                        name = pMesh->mBones[ i ]->mName.C_Str();
-                    }
-                    ReportError("aiMesh::mBones[%i], name = \"%s\" has the same name as "
-                        "aiMesh::mBones[%i]", i, name, a );
+                const char *name = "unknown";
+                if (nullptr != pMesh->mBones[ i ]->mName.C_Str()) {
+                    name = pMesh->mBones[ i ]->mName.C_Str();
                 }
+                ReportError("aiMesh::mBones[%i], name = \"%s\" has the same name as "
+                    "aiMesh::mBones[%i]", i, name, nextDuplicate[i] );
             }
 
 			// check that the dynamic arrays are correctly synchronized
@@ -665,6 +749,119 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
     {
         ReportError("aiMesh::mBones is non-null although there are no bones");
     }
+
+    // validate all meshlets
+    if (pMesh->mNumMeshlets)
+    {
+        if (!pMesh->mMeshlets || !pMesh->mMeshletVertices || !pMesh->mMeshletTriangles)
+        {
+            ReportError("aiMesh::mMeshlets, mMeshletVertices or mMeshletTriangles is NULL "
+                "(aiMesh::mNumMeshlets is %i)", pMesh->mNumMeshlets);
+        }
+        for (unsigned int i = 0; i < pMesh->mNumMeshletVertices; ++i)
+        {
+            if (pMesh->mMeshletVertices[i] >= pMesh->mNumVertices)
+            {
+                ReportError("aiMesh::mMeshletVertices[%i] is out of range", i);
+            }
+        }
+        for (unsigned int i = 0; i < pMesh->mNumMeshlets; ++i)
+        {
+            const aiMeshlet& meshlet = pMesh->mMeshlets[i];
+            if (meshlet.mVertexOffset + meshlet.mVertexCount > pMesh->mNumMeshletVertices ||
+                meshlet.mTriangleOffset + meshlet.mTriangleCount * 3 > pMesh->mNumMeshletTriangleIndices)
+            {
+                ReportError("aiMesh::mMeshlets[%i] exceeds the meshlet vertex or triangle arrays", i);
+            }
+            if (meshlet.mParentError >= 0 && meshlet.mParentError < meshlet.mError)
+            {
+                ReportError("aiMesh::mMeshlets[%i]: the parent error is smaller than the error", i);
+            }
+            for (unsigned int t = 0; t < meshlet.mTriangleCount * 3; ++t)
+            {
+                if (pMesh->mMeshletTriangles[meshlet.mTriangleOffset + t] >= meshlet.mVertexCount)
+                {
+                    ReportError("aiMesh::mMeshlets[%i]: triangle index %i is out of range", i, t);
+                }
+            }
+        }
+    }
+    else if (pMesh->mMeshlets)
+    {
+        ReportError("aiMesh::mMeshlets is non-null although there are no meshlets");
+    }
+
+    // the LODs are other meshes of the scene
+    if (pMesh->mNumLODs)
+    {
+        if (!pMesh->mLODs)
+        {
+            ReportError("aiMesh::mLODs is NULL (aiMesh::mNumLODs is %i)", pMesh->mNumLODs);
+        }
+        for (unsigned int i = 0; i < pMesh->mNumLODs; ++i)
+        {
+            if (pMesh->mLODs[i] >= mScene->mNumMeshes || pMesh == mScene->mMeshes[pMesh->mLODs[i]])
+            {
+                ReportError("aiMesh::mLODs[%i] is out of range or refers to the mesh itself", i);
+            }
+        }
+    }
+    else if (pMesh->mLODs)
+    {
+        ReportError("aiMesh::mLODs is non-null although there are no LODs");
+    }
+
+    // the packed bone weights refer to the bones of the mesh
+    if (pMesh->mNumBoneInfluences)
+    {
+        if (!pMesh->mPackedBoneIndices || !pMesh->mPackedBoneWeights)
+        {
+            ReportError("aiMesh::mPackedBoneIndices or aiMesh::mPackedBoneWeights is NULL "
+                "(aiMesh::mNumBoneInfluences is %i)", pMesh->mNumBoneInfluences);
+        }
+        for (unsigned int i = 0; i < pMesh->mNumVertices * pMesh->mNumBoneInfluences; ++i)
+        {
+            if (pMesh->mPackedBoneWeights[i] && pMesh->mPackedBoneIndices[i] >= pMesh->mNumBones)
+            {
+                ReportError("aiMesh::mPackedBoneIndices[%i] is out of range", i);
+            }
+        }
+    }
+    else if (pMesh->mPackedBoneIndices || pMesh->mPackedBoneWeights)
+    {
+        ReportError("aiMesh::mPackedBoneIndices is non-null although there are no bone influences");
+    }
+
+    // the quantized streams mirror the float streams of the mesh
+    if (const aiQuantizedVertices* quantized = pMesh->mQuantizedVertices)
+    {
+        if (quantized->mNumVertices != pMesh->mNumVertices)
+        {
+            ReportError("aiMesh::mQuantizedVertices->mNumVertices is %i, but the mesh has %i vertices",
+                quantized->mNumVertices, pMesh->mNumVertices);
+        }
+        if ((nullptr != quantized->mPositions) != pMesh->HasPositions() ||
+            (nullptr != quantized->mNormals) != pMesh->HasNormals() ||
+            (nullptr != quantized->mTangents) != pMesh->HasTangentsAndBitangents())
+        {
+            ReportError("aiMesh::mQuantizedVertices doesn't match the position, normal or tangent stream");
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i)
+        {
+            if ((nullptr != quantized->mTextureCoords[i]) != pMesh->HasTextureCoords(i) ||
+                (quantized->mTextureCoords[i] && quantized->mNumUVComponents[i] != pMesh->mNumUVComponents[i]))
+            {
+                ReportError("aiMesh::mQuantizedVertices doesn't match the texture coordinate channel %i", i);
+            }
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i)
+        {
+            if ((nullptr != quantized->mColors[i]) != pMesh->HasVertexColors(i))
+            {
+                ReportError("aiMesh::mQuantizedVertices doesn't match the vertex color channel %i", i);
+            }
+        }
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1116,8 +1313,8 @@ void ValidateDSProcess::Validate( const aiNode* pNode)
             ReportError("aiNode::mMeshes is NULL for node %s (aiNode::mNumMeshes is %i)",
             		  nodeName, pNode->mNumMeshes);
         }
-        std::vector<bool> abHadMesh;
-        abHadMesh.resize(mScene->mNumMeshes,false);
+        std::unordered_set<unsigned int> abHadMesh;
+        abHadMesh.reserve(pNode->mNumMeshes);
         for (unsigned int i = 0; i < pNode->mNumMeshes;++i)
         {
             if (pNode->mMeshes[i] >= mScene->mNumMeshes)
@@ -1125,12 +1322,11 @@ void ValidateDSProcess::Validate( const aiNode* pNode)
                 ReportError("aiNode::mMeshes[%i] is out of range for node %s (maximum is %i)",
                     pNode->mMeshes[i], nodeName, mScene->mNumMeshes-1);
             }
-            if (abHadMesh[pNode->mMeshes[i]])
+            if (!abHadMesh.insert(pNode->mMeshes[i]).second)
             {
                 ReportError("aiNode::mMeshes[%i] is already referenced by this node %s (value: %i)",
                     i, nodeName, pNode->mMeshes[i]);
             }
-            abHadMesh[pNode->mMeshes[i]] = true;
         }
     }
     if (pNode->mNumChildren)
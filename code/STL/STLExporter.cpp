@@ -63,39 +63,35 @@ void ExportSceneSTL(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
 {
     bool exportPointClouds = pProperties->GetPropertyBool(AI_CONFIG_EXPORT_POINT_CLOUDS);
 
-    // invoke the exporter
-    STLExporter exporter(pFile, pScene, exportPointClouds );
-
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-    
-    // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
     }
 
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    // invoke the exporter, it writes directly to the file
+    STLExporter exporter(pFile, pScene, outfile.get(), exportPointClouds);
+
+    exporter.mOutput.Flush();
+    if (exporter.mOutput.fail()) {
+        throw DeadlyExportError("could not write output .stl file: " + std::string(pFile));
+    }
 }
 void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties )
 {
     bool exportPointClouds = pProperties->GetPropertyBool(AI_CONFIG_EXPORT_POINT_CLOUDS);
 
-    // invoke the exporter
-    STLExporter exporter(pFile, pScene, exportPointClouds, true);
-
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
-    }
-    
-    // we're still here - export successfully completed. Write the file.
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wb"));
     if(outfile == NULL) {
         throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
     }
 
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    // invoke the exporter, it writes directly to the file
+    STLExporter exporter(pFile, pScene, outfile.get(), exportPointClouds, true);
+
+    exporter.mOutput.Flush();
+    if (exporter.mOutput.fail()) {
+        throw DeadlyExportError("could not write output .stl file: " + std::string(pFile));
+    }
 }
 
 } // end of namespace Assimp
@@ -104,13 +100,12 @@ static const char *SolidToken = "solid";
 static const char *EndSolidToken = "endsolid";
 
 // ------------------------------------------------------------------------------------------------
-STLExporter::STLExporter(const char* _filename, const aiScene* pScene, bool exportPointClouds, bool binary)
-: filename(_filename)
+STLExporter::STLExporter(const char* _filename, const aiScene* pScene, IOStream* output, bool exportPointClouds, bool binary)
+: mOutput(output)
+, filename(_filename)
 , endl("\n")
 {
-    // make sure that all formatting happens using the standard, C locale and not the user's current locale
-    const std::locale& l = std::locale("C");
-    mOutput.imbue(l);
+    // BufferedTextWriter always formats numbers like the standard, C locale
     mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
     if (binary) {
         char buf[80] = {0} ;
@@ -46,7 +46,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_STLEXPORTER_H_INC
 #define AI_STLEXPORTER_H_INC
 
-#include <sstream>
+#include "Common/BufferedTextWriter.h"
+
+#include <string>
 
 struct aiScene;
 struct aiNode;
@@ -60,11 +62,11 @@ namespace Assimp {
 class STLExporter
 {
 public:
-    /// Constructor for a specific scene to export
-    STLExporter(const char* filename, const aiScene* pScene, bool exportPOintClouds, bool binary = false);
+    /// Constructor for a specific scene to export, the output is written to the given stream
+    STLExporter(const char* filename, const aiScene* pScene, IOStream* output, bool exportPOintClouds, bool binary = false);
 
-    /// public stringstreams to write all output into
-    std::ostringstream mOutput;
+    /// public writer to write all output into
+    BufferedTextWriter mOutput;
 
 private:
     void WritePointCloud(const std::string &name, const aiScene* pScene);
@@ -594,19 +594,21 @@ void glTFExporter::ExportMeshes()
 
 		/************** Texture coordinates **************/
         for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
-            // Flip UV y coords
-            if (aim -> mNumUVComponents[i] > 1) {
-                for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
-                    aim->mTextureCoords[i][j].y = 1 - aim->mTextureCoords[i][j].y;
-                }
-            }
-
             if (aim->mNumUVComponents[i] > 0) {
                 AttribType::Value type = (aim->mNumUVComponents[i] == 2) ? AttribType::VEC2 : AttribType::VEC3;
 
+                // Flip UV y coords. The scene may share its mesh buffers with the caller's
+                // scene (see AI_CONFIG_EXPORT_SHARE_MESH_BUFFERS), so they are flipped in a copy.
+                std::vector<aiVector3D> coords(aim->mTextureCoords[i], aim->mTextureCoords[i] + aim->mNumVertices);
+                if (aim->mNumUVComponents[i] > 1) {
+                    for (aiVector3D& uv : coords) {
+                        uv.y = 1 - uv.y;
+                    }
+                }
+
 				if(comp_allow) idx_srcdata_tc.push_back(b->byteLength);// Store index of texture coordinates array.
 
-				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, false);
+				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, coords.data(), AttribType::VEC3, type, ComponentType_FLOAT, false);
 				if (tc) p.attributes.texcoord.push_back(tc);
 			}
 		}
@@ -47,6 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *   KHR_materials_pbrSpecularGlossiness full
  *   KHR_materials_unlit full
  *   KHR_lights_punctual full
+ *   KHR_mesh_quantization full
+ *   KHR_draco_mesh_compression full with ASSIMP_GLTF2_USE_DRACO, uncompressed fallback only otherwise
  */
 #ifndef GLTF2ASSET_H_INC
 #define GLTF2ASSET_H_INC
@@ -56,6 +58,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exceptional.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <list>
 #include <vector>
@@ -387,9 +390,13 @@ namespace glTF2
         ComponentType componentType; //!< The datatype of components in the attribute. (required)
         size_t count;                //!< The number of attributes referenced by this accessor. (required)
         AttribType::Value type;      //!< Specifies if the attribute is a scalar, vector, or matrix. (required)
+        bool normalized;             //!< Specifies whether integer components are mapped to [0,1] or [-1,1].
         std::vector<float> max;      //!< Maximum value of each component in this attribute.
         std::vector<float> min;      //!< Minimum value of each component in this attribute.
 
+        //! The tightly packed elements decoded from a compressed primitive, used instead of the bufferView
+        std::unique_ptr<uint8_t[]> decodedData;
+
         unsigned int GetNumComponents();
         unsigned int GetBytesPerComponent();
         unsigned int GetElementSize();
@@ -399,6 +406,11 @@ namespace glTF2
         template<class T>
         bool ExtractData(T*& outData);
 
+        //! Extracts the data into a type made of ai_real components, converting
+        //! integer components as allowed by KHR_mesh_quantization
+        template<class T>
+        bool ExtractFloatData(T*& outData);
+
         void WriteData(size_t count, const void* src_buffer, size_t src_stride);
 
         //! Helper class to iterate the data
@@ -435,7 +447,7 @@ namespace glTF2
             return Indexer(*this);
         }
 
-        Accessor() {}
+        Accessor() : normalized(false) {}
         void Read(Value& obj, Asset& r);
     };
 
@@ -761,6 +773,11 @@ namespace glTF2
 
             Ref<Material> material;
 
+            //! KHR_draco_mesh_compression: the compressed geometry, and the ids of the
+            //! attributes in it by their semantic. The accessors have no bufferView then.
+            Ref<BufferView> dracoBufferView;
+            std::map<std::string, unsigned int> dracoAttributes;
+
             struct Target {
                 AccessorList position, normal, tangent;
             };
@@ -1024,6 +1041,8 @@ namespace glTF2
             bool KHR_materials_pbrSpecularGlossiness;
             bool KHR_materials_unlit;
             bool KHR_lights_punctual;
+            bool KHR_mesh_quantization;
+            bool KHR_draco_mesh_compression;
 
         } extensionsUsed;
 
@@ -45,6 +45,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Header files, Assimp
 #include <assimp/DefaultLogger.hpp>
 
+#ifdef ASSIMP_GLTF2_USE_DRACO
+	// Header files, Draco.
+#	include <draco/compression/decode.h>
+#endif
+
 using namespace Assimp;
 
 namespace glTF2 {
@@ -572,6 +577,7 @@ inline void Accessor::Read(Value& obj, Asset& r)
     byteOffset = MemberOrDefault(obj, "byteOffset", size_t(0));
     componentType = MemberOrDefault(obj, "componentType", ComponentType_BYTE);
     count = MemberOrDefault(obj, "count", size_t(0));
+    normalized = MemberOrDefault(obj, "normalized", false);
 
     const char* typestr;
     type = ReadMember(obj, "type", typestr) ? AttribType::FromString(typestr) : AttribType::SCALAR;
@@ -594,6 +600,7 @@ inline unsigned int Accessor::GetElementSize()
 
 inline uint8_t* Accessor::GetPointer()
 {
+    if (decodedData) return decodedData.get();
     if (!bufferView || !bufferView->buffer) return 0;
     uint8_t* basePtr = bufferView->buffer->GetPointer();
     if (!basePtr) return 0;
@@ -649,7 +656,7 @@ bool Accessor::ExtractData(T*& outData)
     const size_t targetElemSize = sizeof(T);
     ai_assert(elemSize <= targetElemSize);
 
-    ai_assert(count*stride <= bufferView->byteLength);
+    ai_assert(!bufferView || count*stride <= bufferView->byteLength);
 
     outData = new T[count];
     if (stride == elemSize && targetElemSize == elemSize) {
@@ -664,6 +671,64 @@ bool Accessor::ExtractData(T*& outData)
     return true;
 }
 
+template<class T>
+bool Accessor::ExtractFloatData(T*& outData)
+{
+    if (componentType == ComponentType_FLOAT) {
+        return ExtractData(outData);
+    }
+
+    uint8_t* data = GetPointer();
+    if (!data) return false;
+
+    const unsigned int numComponents = GetNumComponents();
+    const unsigned int bytesPerComponent = GetBytesPerComponent();
+    const size_t elemSize = GetElementSize();
+    const size_t stride = bufferView && bufferView->byteStride ? bufferView->byteStride : elemSize;
+
+    ai_assert(numComponents * sizeof(ai_real) <= sizeof(T));
+    ai_assert(!bufferView || count*stride <= bufferView->byteLength);
+
+    outData = new T[count];
+    for (size_t i = 0; i < count; ++i) {
+        ai_real* out = reinterpret_cast<ai_real*>(outData + i);
+        const uint8_t* in = data + i*stride;
+        for (unsigned int c = 0; c < numComponents; ++c, in += bytesPerComponent) {
+            // the normalized mappings of the glTF 2.0 specification
+            switch (componentType) {
+                case ComponentType_BYTE: {
+                    const int8_t v = static_cast<int8_t>(in[0]);
+                    out[c] = normalized ? std::max(v / ai_real(127), ai_real(-1)) : ai_real(v);
+                    break;
+                }
+                case ComponentType_UNSIGNED_BYTE:
+                    out[c] = normalized ? in[0] / ai_real(255) : ai_real(in[0]);
+                    break;
+                case ComponentType_SHORT: {
+                    int16_t v;
+                    memcpy(&v, in, sizeof(v));
+                    out[c] = normalized ? std::max(v / ai_real(32767), ai_real(-1)) : ai_real(v);
+                    break;
+                }
+                case ComponentType_UNSIGNED_SHORT: {
+                    uint16_t v;
+                    memcpy(&v, in, sizeof(v));
+                    out[c] = normalized ? v / ai_real(65535) : ai_real(v);
+                    break;
+                }
+                default: {
+                    uint32_t v;
+                    memcpy(&v, in, sizeof(v));
+                    out[c] = ai_real(v);
+                    break;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 inline void Accessor::WriteData(size_t count, const void* src_buffer, size_t src_stride)
 {
     uint8_t* buffer_ptr = bufferView->buffer->GetPointer();
@@ -694,7 +759,7 @@ template<class T>
 T Accessor::Indexer::GetValue(int i)
 {
     ai_assert(data);
-    ai_assert(i*stride < accessor.bufferView->byteLength);
+    ai_assert(!accessor.bufferView || i*stride < accessor.bufferView->byteLength);
     T value = T();
     memcpy(&value, data + i*stride, elemSize);
     //value >>= 8 * (sizeof(T) - elemSize);
@@ -964,6 +1029,140 @@ namespace {
     }
 }
 
+namespace {
+#ifdef ASSIMP_GLTF2_USE_DRACO
+    //! Converts the decoded values of a Draco attribute to the components of an accessor
+    template<class T>
+    inline bool CopyDracoAttribute(const draco::Mesh& mesh, const draco::PointAttribute& attr, Accessor& acc)
+    {
+        const int8_t numComponents = static_cast<int8_t>(acc.GetNumComponents());
+        T* out = reinterpret_cast<T*>(acc.decodedData.get());
+        for (uint32_t i = 0; i < mesh.num_points(); ++i, out += numComponents) {
+            if (!attr.ConvertValue<T>(attr.mapped_index(draco::PointIndex(i)), numComponents, out)) return false;
+        }
+        return true;
+    }
+
+    //! Makes the accessor hold decoded data instead of referring to its bufferView
+    inline void AllocateDecodedData(Accessor& acc, size_t count, const std::string& meshName)
+    {
+        if (acc.count != count) {
+            throw DeadlyImportError("GLTF: Mesh \"" + meshName + "\": the count of accessor \"" + acc.id + "\" does not match its Draco compressed data");
+        }
+        acc.bufferView = Ref<BufferView>();
+        acc.byteOffset = 0;
+        acc.decodedData.reset(new uint8_t[count * acc.GetElementSize()]);
+    }
+
+    //! Decodes the geometry of a primitive compressed with KHR_draco_mesh_compression into its accessors
+    inline void DecodeDracoPrimitive(Value& draco, Value& primitive, Mesh::Primitive& prim, const std::string& meshName, Asset& r)
+    {
+        Value* bufferViewVal = FindUInt(draco, "bufferView");
+        Value* dracoAttrs = FindObject(draco, "attributes");
+        Value* attrs = FindObject(primitive, "attributes");
+        if (!bufferViewVal || !dracoAttrs || !attrs) {
+            throw DeadlyImportError("GLTF: Mesh \"" + meshName + "\": invalid KHR_draco_mesh_compression extension");
+        }
+
+        Ref<BufferView> view = r.bufferViews.Retrieve(bufferViewVal->GetUint());
+        if (!view->buffer || !view->buffer->GetPointer() || view->byteOffset + view->byteLength > view->buffer->byteLength) {
+            throw DeadlyImportError("GLTF: Mesh \"" + meshName + "\": invalid bufferView of the Draco compressed data");
+        }
+
+        draco::DecoderBuffer buffer;
+        buffer.Init(reinterpret_cast<const char*>(view->buffer->GetPointer() + view->byteOffset), view->byteLength);
+
+        draco::Decoder decoder;
+        draco::StatusOr<std::unique_ptr<draco::Mesh>> decoded = decoder.DecodeMeshFromBuffer(&buffer);
+        if (!decoded.ok()) {
+            throw DeadlyImportError("GLTF: Mesh \"" + meshName + "\": failed to decode the Draco compressed data, " + decoded.status().error_msg_string());
+        }
+        const std::unique_ptr<draco::Mesh> mesh = std::move(decoded).value();
+
+        if (prim.indices) {
+            Accessor& acc = *prim.indices;
+            if (acc.componentType != ComponentType_UNSIGNED_BYTE && acc.componentType != ComponentType_UNSIGNED_SHORT &&
+                    acc.componentType != ComponentType_UNSIGNED_INT) {
+                throw DeadlyImportError("GLTF: Mesh \"" + meshName + "\": invalid component type of the indices");
+            }
+            AllocateDecodedData(acc, mesh->num_faces() * 3, meshName);
+
+            uint8_t* out = acc.decodedData.get();
+            for (uint32_t f = 0; f < mesh->num_faces(); ++f) {
+                const draco::Mesh::Face& face = mesh->face(draco::FaceIndex(f));
+                for (unsigned int j = 0; j < 3; ++j, out += acc.GetElementSize()) {
+                    const uint32_t index = face[j].value();
+                    if (acc.componentType == ComponentType_UNSIGNED_BYTE) {
+                        *out = static_cast<uint8_t>(index);
+                    } else if (acc.componentType == ComponentType_UNSIGNED_SHORT) {
+                        const uint16_t value = static_cast<uint16_t>(index);
+                        memcpy(out, &value, sizeof(value));
+                    } else {
+                        memcpy(out, &index, sizeof(index));
+                    }
+                }
+            }
+        }
+
+        for (Value::MemberIterator it = dracoAttrs->MemberBegin(); it != dracoAttrs->MemberEnd(); ++it) {
+            Value* accessorVal = FindUInt(*attrs, it->name.GetString());
+            if (!it->value.IsUint() || !accessorVal) continue;
+
+            const draco::PointAttribute* attr = mesh->GetAttributeByUniqueId(it->value.GetUint());
+            if (!attr) {
+                throw DeadlyImportError("GLTF: Mesh \"" + meshName + "\": attribute \"" + it->name.GetString() + "\" is missing in the Draco compressed data");
+            }
+
+            Accessor& acc = *r.accessors.Retrieve(accessorVal->GetUint());
+            AllocateDecodedData(acc, mesh->num_points(), meshName);
+
+            bool converted;
+            switch (acc.componentType) {
+                case ComponentType_BYTE:
+                    converted = CopyDracoAttribute<int8_t>(*mesh, *attr, acc);
+                    break;
+                case ComponentType_UNSIGNED_BYTE:
+                    converted = CopyDracoAttribute<uint8_t>(*mesh, *attr, acc);
+                    break;
+                case ComponentType_SHORT:
+                    converted = CopyDracoAttribute<int16_t>(*mesh, *attr, acc);
+                    break;
+                case ComponentType_UNSIGNED_SHORT:
+                    converted = CopyDracoAttribute<uint16_t>(*mesh, *attr, acc);
+                    break;
+                case ComponentType_UNSIGNED_INT:
+                    converted = CopyDracoAttribute<uint32_t>(*mesh, *attr, acc);
+                    break;
+                default:
+                    converted = CopyDracoAttribute<float>(*mesh, *attr, acc);
+            }
+            if (!converted) {
+                throw DeadlyImportError("GLTF: Mesh \"" + meshName + "\": can not convert the Draco compressed attribute \"" + it->name.GetString() + "\"");
+            }
+        }
+    }
+#else
+    inline bool HasBufferViews(Mesh::AccessorList& accessors)
+    {
+        for (size_t i = 0; i < accessors.size(); ++i) {
+            if (accessors[i] && !accessors[i]->bufferView) return false;
+        }
+        return true;
+    }
+
+    //! Compressed primitives may still provide plain buffer views for all of their accessors
+    inline bool HasUncompressedData(Mesh::Primitive& prim)
+    {
+        Mesh::Primitive::Attributes& attr = prim.attributes;
+        if (attr.position.empty()) return false;
+        if (prim.indices && !prim.indices->bufferView) return false;
+        return HasBufferViews(attr.position) && HasBufferViews(attr.normal) && HasBufferViews(attr.tangent) &&
+            HasBufferViews(attr.texcoord) && HasBufferViews(attr.color) && HasBufferViews(attr.joint) &&
+            HasBufferViews(attr.jointmatrix) && HasBufferViews(attr.weight);
+    }
+#endif
+}
+
 inline void Mesh::Read(Value& pJSON_Object, Asset& pAsset_Root)
 {
     if (Value* name = FindMember(pJSON_Object, "name")) {
@@ -1023,6 +1222,23 @@ inline void Mesh::Read(Value& pJSON_Object, Asset& pAsset_Root)
             if (Value* material = FindUInt(primitive, "material")) {
 				prim.material = pAsset_Root.materials.Retrieve(material->GetUint());
             }
+
+            if (Value* extensions = FindObject(primitive, "extensions")) {
+#ifdef ASSIMP_GLTF2_USE_DRACO
+                if (Value* draco = FindObject(*extensions, "KHR_draco_mesh_compression")) {
+                    DecodeDracoPrimitive(*draco, primitive, prim, this->name, pAsset_Root);
+                }
+#else
+                if (FindObject(*extensions, "KHR_draco_mesh_compression")) {
+                    // built without the Draco decoder, only the optional uncompressed fallback can be loaded
+                    if (!HasUncompressedData(prim)) {
+                        throw DeadlyImportError("GLTF: Mesh \"" + this->name + "\" is compressed with KHR_draco_mesh_compression, "
+                            "but assimp was built without ASSIMP_GLTF2_USE_DRACO");
+                    }
+                    ASSIMP_LOG_WARN_F("GLTF: Loading the uncompressed fallback of Draco compressed mesh \"", this->name, "\"");
+                }
+#endif
+            }
         }
     }
 
@@ -1469,6 +1685,8 @@ inline void Asset::ReadExtensionsUsed(Document& doc)
     CHECK_EXT(KHR_materials_pbrSpecularGlossiness);
     CHECK_EXT(KHR_materials_unlit);
     CHECK_EXT(KHR_lights_punctual);
+    CHECK_EXT(KHR_mesh_quantization);
+    CHECK_EXT(KHR_draco_mesh_compression);
 
     #undef CHECK_EXT
 }
@@ -96,16 +96,24 @@ namespace glTF2 {
 
     inline void Write(Value& obj, Accessor& a, AssetWriter& w)
     {
-        obj.AddMember("bufferView", a.bufferView->index, w.mAl);
-        obj.AddMember("byteOffset", (unsigned int)a.byteOffset, w.mAl);
+        // the elements of compressed primitives are stored in the primitive extension
+        if (a.bufferView) {
+            obj.AddMember("bufferView", a.bufferView->index, w.mAl);
+            obj.AddMember("byteOffset", (unsigned int)a.byteOffset, w.mAl);
+        }
 
         obj.AddMember("componentType", int(a.componentType), w.mAl);
         obj.AddMember("count", (unsigned int)a.count, w.mAl);
         obj.AddMember("type", StringRef(AttribType::ToString(a.type)), w.mAl);
+        if (a.normalized) {
+            obj.AddMember("normalized", true, w.mAl);
+        }
 
-        Value vTmpMax, vTmpMin;
-        obj.AddMember("max", MakeValue(vTmpMax, a.max, w.mAl), w.mAl);
-        obj.AddMember("min", MakeValue(vTmpMin, a.min, w.mAl), w.mAl);
+        if (!a.max.empty() && !a.min.empty()) {
+            Value vTmpMax, vTmpMin;
+            obj.AddMember("max", MakeValue(vTmpMax, a.max, w.mAl), w.mAl);
+            obj.AddMember("min", MakeValue(vTmpMin, a.min, w.mAl), w.mAl);
+        }
     }
 
     inline void Write(Value& obj, Animation& a, AssetWriter& w)
@@ -429,6 +437,24 @@ namespace glTF2 {
                     WriteAttrs(w, attrs, p.attributes.weight, "WEIGHTS", true);
                 }
                 prim.AddMember("attributes", attrs, w.mAl);
+
+                if (p.dracoBufferView) {
+                    Value dracoAttrs;
+                    dracoAttrs.SetObject();
+                    for (const auto& attr : p.dracoAttributes) {
+                        dracoAttrs.AddMember(Value(attr.first.c_str(), w.mAl).Move(), attr.second, w.mAl);
+                    }
+
+                    Value draco;
+                    draco.SetObject();
+                    draco.AddMember("bufferView", p.dracoBufferView->index, w.mAl);
+                    draco.AddMember("attributes", dracoAttrs, w.mAl);
+
+                    Value exts;
+                    exts.SetObject();
+                    exts.AddMember("KHR_draco_mesh_compression", draco, w.mAl);
+                    prim.AddMember("extensions", exts, w.mAl);
+                }
             }
             primitives.PushBack(prim, w.mAl);
         }
@@ -719,10 +745,30 @@ namespace glTF2 {
             if (this->mAsset.extensionsUsed.KHR_materials_unlit) {
               exts.PushBack(StringRef("KHR_materials_unlit"), mAl);
             }
+
+            if (this->mAsset.extensionsUsed.KHR_mesh_quantization) {
+              exts.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+            }
+
+            if (this->mAsset.extensionsUsed.KHR_draco_mesh_compression) {
+              exts.PushBack(StringRef("KHR_draco_mesh_compression"), mAl);
+            }
         }
 
         if (!exts.Empty())
             mDoc.AddMember("extensionsUsed", exts, mAl);
+
+        // the quantized and compressed attributes can't be read without their extension
+        Value required;
+        required.SetArray();
+        if (this->mAsset.extensionsUsed.KHR_mesh_quantization) {
+            required.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+        }
+        if (this->mAsset.extensionsUsed.KHR_draco_mesh_compression) {
+            required.PushBack(StringRef("KHR_draco_mesh_compression"), mAl);
+        }
+        if (!required.Empty())
+            mDoc.AddMember("extensionsRequired", required, mAl);
     }
 
     template<class T>
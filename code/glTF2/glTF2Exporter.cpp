@@ -55,11 +55,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exporter.hpp>
 #include <assimp/material.h>
 #include <assimp/scene.h>
+#include <assimp/config.h>
+#include <assimp/DefaultLogger.hpp>
 
 // Header files, standard library.
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <inttypes.h>
 
+#ifdef ASSIMP_GLTF2_USE_DRACO
+#   include <draco/compression/encode.h>
+#endif
+
 using namespace rapidjson;
 
 using namespace Assimp;
@@ -109,6 +117,7 @@ glTF2Exporter::glTF2Exporter(const char* filename, IOSystem* pIOSystem, const ai
 
     ExportMeshes();
     MergeMeshes();
+    ExportDequantizationNodes();
 
     ExportScene();
 
@@ -221,6 +230,144 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
     return acc;
 }
 
+/*
+ * Export integer vertex data as allowed by KHR_mesh_quantization. Vertex attributes need to be
+ * aligned to 4 bytes, so data holds the elements padded to a multiple of 4 bytes.
+ */
+template <typename T>
+inline Ref<Accessor> ExportQuantizedData(Asset& a, std::string& meshName, Ref<Buffer>& buffer,
+    size_t count, const std::vector<T>& data, AttribType::Value type, ComponentType compType, bool normalized)
+{
+    if (!count) {
+        return Ref<Accessor>();
+    }
+
+    const unsigned int numComps = AttribType::GetNumComponents(type);
+    const size_t elemSize = numComps * sizeof(T);
+    const size_t stride = (elemSize + 3) & ~size_t(3);
+    ai_assert(data.size() * sizeof(T) == count * stride);
+
+    size_t offset = buffer->byteLength;
+    const size_t padding = (4 - offset % 4) % 4;
+    offset += padding;
+    const size_t length = count * stride;
+    buffer->Grow(length + padding);
+    memcpy(buffer->GetPointer() + offset, data.data(), length);
+
+    // bufferView
+    Ref<BufferView> bv = a.bufferViews.Create(a.FindUniqueID(meshName, "view"));
+    bv->buffer = buffer;
+    bv->byteOffset = offset;
+    bv->byteLength = length;
+    bv->byteStride = stride != elemSize ? static_cast<unsigned int>(stride) : 0;
+    bv->target = BufferViewTarget_ARRAY_BUFFER;
+
+    // accessor
+    Ref<Accessor> acc = a.accessors.Create(a.FindUniqueID(meshName, "accessor"));
+    acc->bufferView = bv;
+    acc->byteOffset = 0;
+    acc->componentType = compType;
+    acc->count = count;
+    acc->type = type;
+    acc->normalized = normalized;
+
+    // the bounds are optional except for positions, which are not normalized
+    if (!normalized) {
+        const size_t compsPerElem = stride / sizeof(T);
+        acc->min.assign(numComps, static_cast<float>(data[0]));
+        acc->max.assign(numComps, static_cast<float>(data[0]));
+        for (size_t i = 0; i < count; ++i) {
+            for (unsigned int j = 0; j < numComps; ++j) {
+                const float value = static_cast<float>(data[i * compsPerElem + j]);
+                acc->min[j] = std::min(acc->min[j], value);
+                acc->max[j] = std::max(acc->max[j], value);
+            }
+        }
+    }
+
+    return acc;
+}
+
+// The quantized streams of a mesh which may be exported instead of its vertex streams
+struct QuantizedStreams {
+    bool positions;
+    bool normals;
+    bool textureCoords[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    bool colors[AI_MAX_NUMBER_OF_COLOR_SETS];
+};
+
+// Tests which quantized streams of a mesh still match its vertices, each within the error of
+// its attribute. The pre-processing of the exporter may have rebuilt the vertices, e.g. by
+// joining identical vertices, and steps like FlipUVs or GenNormals may have rewritten single
+// attributes after the quantization.
+static QuantizedStreams MatchQuantizedVertices(const aiMesh* aim)
+{
+    QuantizedStreams match = {};
+    const aiQuantizedVertices* quantized = aim->mQuantizedVertices;
+    if (nullptr == quantized || quantized->mNumVertices != aim->mNumVertices) {
+        return match;
+    }
+
+    // a little slack for the rounding of the recorded errors
+    const ai_real slack = ai_real(1.01), epsilon = ai_real(1e-6);
+    if (nullptr != quantized->mPositions && aim->HasPositions()) {
+        const ai_real tolerance = quantized->mMaxPositionError * slack + quantized->mPositionScale * epsilon;
+        match.positions = true;
+        for (unsigned int i = 0; i < aim->mNumVertices && match.positions; ++i) {
+            match.positions = (quantized->GetPosition(i) - aim->mVertices[i]).SquareLength() <= tolerance * tolerance;
+        }
+    }
+    if (nullptr != quantized->mNormals && aim->HasNormals()) {
+        const ai_real tolerance = std::cos(std::min(quantized->mMaxDirectionError * slack + ai_real(1e-4), ai_real(AI_MATH_PI)));
+        match.normals = true;
+        for (unsigned int i = 0; i < aim->mNumVertices && match.normals; ++i) {
+            const aiVector3D normal = aim->mNormals[i].SquareLength() > 0 ? aiVector3D(aim->mNormals[i]).Normalize() : aiVector3D();
+            match.normals = quantized->GetNormal(i) * normal >= tolerance;
+        }
+    }
+    for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+        if (nullptr == quantized->mTextureCoords[t] || !aim->HasTextureCoords(t)) {
+            continue;
+        }
+        const unsigned int numComponents = quantized->mNumUVComponents[t];
+        const ai_real tolerance = quantized->mMaxTextureCoordsError * slack + epsilon;
+        match.textureCoords[t] = true;
+        for (unsigned int i = 0; i < aim->mNumVertices && match.textureCoords[t]; ++i) {
+            const aiVector3D coords = quantized->GetTextureCoords(t, i);
+            for (unsigned int c = 0; c < numComponents; ++c) {
+                match.textureCoords[t] = match.textureCoords[t] && std::abs(coords[c] - aim->mTextureCoords[t][i][c]) <= tolerance;
+            }
+        }
+    }
+    for (unsigned int k = 0; k < AI_MAX_NUMBER_OF_COLOR_SETS; ++k) {
+        if (nullptr == quantized->mColors[k] || !aim->HasVertexColors(k)) {
+            continue;
+        }
+        // the quantized colors are clamped to [0,1]
+        const ai_real tolerance = quantized->mMaxColorError * slack + epsilon;
+        match.colors[k] = true;
+        for (unsigned int i = 0; i < aim->mNumVertices && match.colors[k]; ++i) {
+            const aiColor4D color = quantized->GetColor(k, i);
+            for (unsigned int c = 0; c < 4; ++c) {
+                const ai_real clamped = std::min(std::max(aim->mColors[k][i][c], ai_real(0)), ai_real(1));
+                match.colors[k] = match.colors[k] && std::abs(color[c] - clamped) <= tolerance;
+            }
+        }
+    }
+    return match;
+}
+
+// Marks the meshes of nodes with several meshes, they are merged into a single glTF mesh
+static void FindSharedNodeMeshes(const aiNode* n, std::vector<bool>& shared)
+{
+    for (unsigned int i = 0; n->mNumMeshes > 1 && i < n->mNumMeshes; ++i) {
+        shared[n->mMeshes[i]] = true;
+    }
+    for (unsigned int i = 0; i < n->mNumChildren; ++i) {
+        FindSharedNodeMeshes(n->mChildren[i], shared);
+    }
+}
+
 inline void SetSamplerWrap(SamplerWrap& wrap, aiTextureMapMode map)
 {
     switch (map) {
@@ -665,6 +812,166 @@ void ExportSkin(Asset& mAsset, const aiMesh* aimesh, Ref<Mesh>& meshRef, Ref<Buf
     delete[] vertexJointData;
 }
 
+// The exported scene may share its mesh buffers with the caller's scene (see
+// AI_CONFIG_EXPORT_SHARE_MESH_BUFFERS), so the streams glTF needs modified are copied first.
+
+// Returns the normalized normals of a mesh, as the validator can emit a warning otherwise
+static std::vector<aiVector3D> GetNormalizedNormals(const aiMesh* aim)
+{
+    std::vector<aiVector3D> normals(aim->mNormals, aim->mNormals + aim->mNumVertices);
+    for (aiVector3D& normal : normals) {
+        normal.Normalize();
+    }
+    return normals;
+}
+
+// Returns the texture coordinates of a channel with flipped v coordinates
+static std::vector<aiVector3D> GetFlippedTextureCoords(const aiMesh* aim, unsigned int channel)
+{
+    std::vector<aiVector3D> coords(aim->mTextureCoords[channel], aim->mTextureCoords[channel] + aim->mNumVertices);
+    if (aim->mNumUVComponents[channel] > 1) {
+        for (aiVector3D& uv : coords) {
+            uv.y = 1 - uv.y;
+        }
+    }
+    return coords;
+}
+
+#ifdef ASSIMP_GLTF2_USE_DRACO
+// Adds a vertex stream to a Draco mesh and returns the unique id of the new attribute
+template <typename T>
+static unsigned int AddDracoAttribute(draco::Mesh& mesh, draco::GeometryAttribute::Type type, const T* data, unsigned int numComps)
+{
+    draco::GeometryAttribute attribute;
+    attribute.Init(type, nullptr, numComps, draco::DT_FLOAT32, false, sizeof(float) * numComps, 0);
+    draco::PointAttribute* attr = mesh.attribute(mesh.AddAttribute(attribute, true, mesh.num_points()));
+
+    float value[4];
+    for (uint32_t i = 0; i < mesh.num_points(); ++i) {
+        for (unsigned int c = 0; c < numComps; ++c) {
+            value[c] = static_cast<float>(data[i][c]);
+        }
+        attr->SetAttributeValue(draco::AttributeValueIndex(i), value);
+    }
+    return attr->unique_id();
+}
+
+static void SetDracoQuantization(draco::Encoder& encoder, draco::GeometryAttribute::Type type, int bits)
+{
+    // no quantization keeps the attribute lossless
+    if (bits > 0) {
+        encoder.SetAttributeQuantization(type, std::min(bits, 30));
+    }
+}
+
+// Creates an accessor whose elements are stored in the compressed bufferView of its primitive
+static Ref<Accessor> CreateDracoAccessor(Asset& a, std::string& meshName, AttribType::Value type, ComponentType compType)
+{
+    Ref<Accessor> acc = a.accessors.Create(a.FindUniqueID(meshName, "accessor"));
+    acc->byteOffset = 0;
+    acc->componentType = compType;
+    acc->type = type;
+    return acc;
+}
+
+/*
+ * Exports the vertex streams and faces of a triangle mesh as a KHR_draco_mesh_compression
+ * primitive. Returns false for the meshes which keep the uncompressed streams.
+ */
+static bool ExportDracoPrimitive(Asset& a, const aiMesh* aim, std::string& meshName, Ref<Buffer>& buffer,
+    Mesh::Primitive& p, const ExportProperties& properties)
+{
+    // the skins aren't part of the compressed attributes
+    if (aim->mPrimitiveTypes != aiPrimitiveType_TRIANGLE || aim->HasBones() || 0 == aim->mNumFaces) {
+        return false;
+    }
+
+    draco::Mesh mesh;
+    mesh.set_num_points(aim->mNumVertices);
+    mesh.SetNumFaces(aim->mNumFaces);
+    for (unsigned int i = 0; i < aim->mNumFaces; ++i) {
+        draco::Mesh::Face face;
+        for (unsigned int j = 0; j < 3; ++j) {
+            face[j] = draco::PointIndex(aim->mFaces[i].mIndices[j]);
+        }
+        mesh.SetFace(draco::FaceIndex(i), face);
+    }
+
+    draco::Encoder encoder;
+    SetDracoQuantization(encoder, draco::GeometryAttribute::POSITION,
+        properties.GetPropertyInteger(AI_CONFIG_EXPORT_GLTF_DRACO_POSITION_BITS, AI_GLTF_DRACO_DEFAULT_POSITION_BITS));
+    SetDracoQuantization(encoder, draco::GeometryAttribute::NORMAL,
+        properties.GetPropertyInteger(AI_CONFIG_EXPORT_GLTF_DRACO_NORMAL_BITS, AI_GLTF_DRACO_DEFAULT_NORMAL_BITS));
+    SetDracoQuantization(encoder, draco::GeometryAttribute::TEX_COORD,
+        properties.GetPropertyInteger(AI_CONFIG_EXPORT_GLTF_DRACO_TEXCOORD_BITS, AI_GLTF_DRACO_DEFAULT_TEXCOORD_BITS));
+    SetDracoQuantization(encoder, draco::GeometryAttribute::COLOR,
+        properties.GetPropertyInteger(AI_CONFIG_EXPORT_GLTF_DRACO_COLOR_BITS, AI_GLTF_DRACO_DEFAULT_COLOR_BITS));
+
+    p.dracoAttributes["POSITION"] = AddDracoAttribute(mesh, draco::GeometryAttribute::POSITION, aim->mVertices, 3);
+    Ref<Accessor> v = CreateDracoAccessor(a, meshName, AttribType::VEC3, ComponentType_FLOAT);
+    v->min.assign(3, 0.0f);
+    v->max.assign(3, 0.0f);
+    for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+        for (unsigned int c = 0; c < 3; ++c) {
+            const float value = static_cast<float>(aim->mVertices[i][c]);
+            v->min[c] = 0 == i ? value : std::min(v->min[c], value);
+            v->max[c] = 0 == i ? value : std::max(v->max[c], value);
+        }
+    }
+    p.attributes.position.push_back(v);
+
+    if (aim->HasNormals()) {
+        p.dracoAttributes["NORMAL"] = AddDracoAttribute(mesh, draco::GeometryAttribute::NORMAL, GetNormalizedNormals(aim).data(), 3);
+        p.attributes.normal.push_back(CreateDracoAccessor(a, meshName, AttribType::VEC3, ComponentType_FLOAT));
+    }
+
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        if (!aim->HasTextureCoords(i) || 0 == aim->mNumUVComponents[i]) {
+            continue;
+        }
+
+        const bool isVec2 = 2 == aim->mNumUVComponents[i];
+        p.dracoAttributes["TEXCOORD_" + std::to_string(p.attributes.texcoord.size())] =
+            AddDracoAttribute(mesh, draco::GeometryAttribute::TEX_COORD, GetFlippedTextureCoords(aim, i).data(), isVec2 ? 2 : 3);
+        p.attributes.texcoord.push_back(CreateDracoAccessor(a, meshName, isVec2 ? AttribType::VEC2 : AttribType::VEC3, ComponentType_FLOAT));
+    }
+
+    for (unsigned int i = 0; i < aim->GetNumColorChannels(); ++i) {
+        p.dracoAttributes["COLOR_" + std::to_string(i)] = AddDracoAttribute(mesh, draco::GeometryAttribute::COLOR, aim->mColors[i], 4);
+        p.attributes.color.push_back(CreateDracoAccessor(a, meshName, AttribType::VEC4, ComponentType_FLOAT));
+    }
+
+    draco::EncoderBuffer encoded;
+    const draco::Status status = encoder.EncodeMeshToBuffer(mesh, &encoded);
+    if (!status.ok()) {
+        throw DeadlyExportError("glTF2: Draco compression of mesh " + meshName + " failed: " + status.error_msg_string());
+    }
+
+    // the decoder may have to reorder the points, the accessors describe the decoded streams
+    const size_t numPoints = encoder.num_encoded_points();
+    for (Mesh::AccessorList* list : { &p.attributes.position, &p.attributes.normal, &p.attributes.texcoord, &p.attributes.color }) {
+        for (Ref<Accessor>& acc : *list) {
+            acc->count = numPoints;
+        }
+    }
+    p.indices = CreateDracoAccessor(a, meshName, AttribType::SCALAR, ComponentType_UNSIGNED_INT);
+    p.indices->count = encoder.num_encoded_faces() * 3;
+
+    // bufferView, aligned to 4 bytes as the uncompressed vertex attributes
+    const size_t padding = (4 - buffer->byteLength % 4) % 4;
+    buffer->Grow(padding);
+    p.dracoBufferView = a.bufferViews.Create(a.FindUniqueID(meshName, "view"));
+    p.dracoBufferView->buffer = buffer;
+    p.dracoBufferView->byteLength = encoded.size();
+    p.dracoBufferView->byteStride = 0;
+    p.dracoBufferView->byteOffset = buffer->AppendData(reinterpret_cast<uint8_t*>(const_cast<char*>(encoded.data())), encoded.size());
+
+    p.mode = PrimitiveMode_TRIANGLES;
+    a.extensionsUsed.KHR_draco_mesh_compression = true;
+    return true;
+}
+#endif
+
 void glTF2Exporter::ExportMeshes()
 {
     typedef decltype(aiFace::mNumIndices) IndicesType;
@@ -698,8 +1005,25 @@ void glTF2Exporter::ExportMeshes()
     }
     //----------------------------------------
 
+    // Quantized positions are dequantized by the transform of a node holding the mesh, which
+    // doesn't work for meshes merged with others and for skinned meshes, which ignore it
+    std::vector<bool> sharedNodeMeshes(mScene->mNumMeshes, false);
+    if (mScene->mRootNode) {
+        FindSharedNodeMeshes(mScene->mRootNode, sharedNodeMeshes);
+    }
+
+    bool useDraco = mProperties->GetPropertyBool(AI_CONFIG_EXPORT_GLTF_DRACO_COMPRESSION, false);
+#ifndef ASSIMP_GLTF2_USE_DRACO
+    if (useDraco) {
+        ASSIMP_LOG_WARN("glTF2: assimp was built without ASSIMP_GLTF2_USE_DRACO, the meshes are exported uncompressed");
+        useDraco = false;
+    }
+#endif
+
 	for (unsigned int idx_mesh = 0; idx_mesh < mScene->mNumMeshes; ++idx_mesh) {
 		const aiMesh* aim = mScene->mMeshes[idx_mesh];
+        const aiQuantizedVertices* quantized = aim->mQuantizedVertices;
+        const QuantizedStreams matched = MatchQuantizedVertices(aim);
 
         std::string name = aim->mName.C_Str();
 
@@ -712,44 +1036,86 @@ void glTF2Exporter::ExportMeshes()
 
         p.material = mAsset->materials.Get(aim->mMaterialIndex);
 
+#ifdef ASSIMP_GLTF2_USE_DRACO
+        if (useDraco && ExportDracoPrimitive(*mAsset, aim, meshId, b, p, *mProperties)) {
+            continue;
+        }
+#endif
+
 		/******************* Vertices ********************/
-        Ref<Accessor> v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+        Ref<Accessor> v;
+        if (matched.positions && quantized->mPositionScale > 0 &&
+                !sharedNodeMeshes[idx_mesh] && !aim->HasBones()) {
+            std::vector<uint16_t> positions(aim->mNumVertices * 4, 0);
+            for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+                std::copy(quantized->mPositions + 3 * i, quantized->mPositions + 3 * i + 3, positions.begin() + 4 * i);
+            }
+            v = ExportQuantizedData(*mAsset, meshId, b, aim->mNumVertices, positions, AttribType::VEC3, ComponentType_UNSIGNED_SHORT, false);
+
+            const ai_real s = quantized->mPositionScale / 65535;
+            const aiVector3D& o = quantized->mPositionOffset;
+            mDequantizationTransforms[meshId] = aiMatrix4x4(s, 0, 0, o.x, 0, s, 0, o.y, 0, 0, s, o.z, 0, 0, 0, 1);
+            mAsset->extensionsUsed.KHR_mesh_quantization = true;
+        } else {
+            v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
+        }
 		if (v) p.attributes.position.push_back(v);
 
 		/******************** Normals ********************/
-        // Normalize all normals as the validator can emit a warning otherwise
-        if ( nullptr != aim->mNormals) {
-            for ( auto i = 0u; i < aim->mNumVertices; ++i ) {
-                aim->mNormals[ i ].Normalize();
+        Ref<Accessor> n;
+        if (matched.normals) {
+            // glTF has no octahedral encoding, the normals are stored as normalized shorts instead
+            std::vector<int16_t> normals(aim->mNumVertices * 4, 0);
+            for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+                const aiVector3D normal = quantized->GetNormal(i);
+                for (unsigned int c = 0; c < 3; ++c) {
+                    normals[4 * i + c] = static_cast<int16_t>(std::round(normal[c] * 32767));
+                }
             }
+            n = ExportQuantizedData(*mAsset, meshId, b, aim->mNumVertices, normals, AttribType::VEC3, ComponentType_SHORT, true);
+            mAsset->extensionsUsed.KHR_mesh_quantization = true;
+        } else if (aim->HasNormals()) {
+            std::vector<aiVector3D> normals = GetNormalizedNormals(aim);
+            n = ExportData(*mAsset, meshId, b, aim->mNumVertices, normals.data(), AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
         }
-
-		Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT);
         if (n) p.attributes.normal.push_back(n);
 
 		/************** Texture coordinates **************/
         for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
 			if (!aim->HasTextureCoords(i))
 				continue;
-			
-            // Flip UV y coords
-            if (aim -> mNumUVComponents[i] > 1) {
+
+            // normalized coordinates cover [0,1] only
+            if (matched.textureCoords[i] && 2 == quantized->mNumUVComponents[i] &&
+                    aiVector3D() == quantized->mTextureCoordsOffset[i] && aiVector3D(1, 1, 0) == quantized->mTextureCoordsScale[i]) {
+                std::vector<uint16_t> coords(quantized->mTextureCoords[i], quantized->mTextureCoords[i] + aim->mNumVertices * 2);
                 for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
-                    aim->mTextureCoords[i][j].y = 1 - aim->mTextureCoords[i][j].y;
+                    coords[2 * j + 1] = static_cast<uint16_t>(65535 - coords[2 * j + 1]);
                 }
-            }
-
-            if (aim->mNumUVComponents[i] > 0) {
+                Ref<Accessor> tc = ExportQuantizedData(*mAsset, meshId, b, aim->mNumVertices, coords, AttribType::VEC2, ComponentType_UNSIGNED_SHORT, true);
+                if (tc) p.attributes.texcoord.push_back(tc);
+                mAsset->extensionsUsed.KHR_mesh_quantization = true;
+            } else if (aim->mNumUVComponents[i] > 0) {
                 AttribType::Value type = (aim->mNumUVComponents[i] == 2) ? AttribType::VEC2 : AttribType::VEC3;
 
-				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, false);
+                // Flip UV y coords
+                std::vector<aiVector3D> coords = GetFlippedTextureCoords(aim, i);
+				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, coords.data(), AttribType::VEC3, type, ComponentType_FLOAT, false);
 				if (tc) p.attributes.texcoord.push_back(tc);
 			}
 		}
 
 		/*************** Vertex colors ****************/
 		for (unsigned int indexColorChannel = 0; indexColorChannel < aim->GetNumColorChannels(); ++indexColorChannel) {
-			Ref<Accessor> c = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mColors[indexColorChannel], AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT, false);
+			Ref<Accessor> c;
+            if (matched.colors[indexColorChannel]) {
+                // normalized bytes are part of glTF itself
+                const unsigned char* colors = quantized->mColors[indexColorChannel];
+                c = ExportQuantizedData(*mAsset, meshId, b, aim->mNumVertices, std::vector<uint8_t>(colors, colors + aim->mNumVertices * 4),
+                        AttribType::VEC4, ComponentType_UNSIGNED_BYTE, true);
+            } else {
+                c = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mColors[indexColorChannel], AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT, false);
+            }
 			if (c)
 				p.attributes.color.push_back(c);
 		}
@@ -882,6 +1248,34 @@ void glTF2Exporter::MergeMeshes()
     }
 }
 
+/*
+ * Move meshes with quantized positions to a child node, whose transform dequantizes the positions.
+ */
+void glTF2Exporter::ExportDequantizationNodes()
+{
+    const unsigned int numNodes = mAsset->nodes.Size();
+    for (unsigned int n = 0; n < numNodes; ++n) {
+        Ref<Node> node = mAsset->nodes.Get(n);
+        if (node->meshes.empty()) {
+            continue;
+        }
+
+        auto it = mDequantizationTransforms.find(node->meshes[0]->id);
+        if (it == mDequantizationTransforms.end()) {
+            continue;
+        }
+
+        std::string name = mAsset->FindUniqueID(node->name + "_dequantized", "node");
+        Ref<Node> child = mAsset->nodes.Create(name);
+        child->name = name;
+        child->parent = node;
+        child->matrix.isPresent = true;
+        CopyValue(it->second, child->matrix.value);
+        child->meshes.swap(node->meshes);
+        node->children.push_back(child);
+    }
+}
+
 /*
  * Export the root node of the node hierarchy.
  * Calls ExportNode for all children.
@@ -109,6 +109,7 @@ namespace Assimp
         void ExportMaterials();
         void ExportMeshes();
         void MergeMeshes();
+        void ExportDequantizationNodes();
         unsigned int ExportNodeHierarchy(const aiNode* n);
         unsigned int ExportNode(const aiNode* node, glTF2::Ref<glTF2::Node>& parent);
         void ExportScene();
@@ -120,6 +121,7 @@ namespace Assimp
         const aiScene* mScene;
         const ExportProperties* mProperties;
         std::map<std::string, unsigned int> mTexturesByPath;
+        std::map<std::string, aiMatrix4x4> mDequantizationTransforms;
         std::shared_ptr<glTF2::Asset> mAsset;
         std::vector<unsigned char> mBodyData;
     };
@@ -413,18 +413,18 @@ void glTF2Importer::ImportMeshes(glTF2::Asset& r)
 
             if (attr.position.size() > 0 && attr.position[0]) {
                 aim->mNumVertices = static_cast<unsigned int>(attr.position[0]->count);
-                attr.position[0]->ExtractData(aim->mVertices);
+                attr.position[0]->ExtractFloatData(aim->mVertices);
             }
 
             if (attr.normal.size() > 0 && attr.normal[0]) {
-                attr.normal[0]->ExtractData(aim->mNormals);
+                attr.normal[0]->ExtractFloatData(aim->mNormals);
 
                 // only extract tangents if normals are present
                 if (attr.tangent.size() > 0 && attr.tangent[0]) {
                     // generate bitangents from normals and tangents according to spec
                     Tangent *tangents = nullptr;
 
-                    attr.tangent[0]->ExtractData(tangents);
+                    attr.tangent[0]->ExtractFloatData(tangents);
 
                     aim->mTangents = new aiVector3D[aim->mNumVertices];
                     aim->mBitangents = new aiVector3D[aim->mNumVertices];
@@ -444,7 +444,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset& r)
                         "\" does not match the vertex count");
                     continue;
                 }
-                attr.color[c]->ExtractData(aim->mColors[c]);
+                attr.color[c]->ExtractFloatData(aim->mColors[c]);
             }
             for (size_t tc = 0; tc < attr.texcoord.size() && tc < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++tc) {
                 if (attr.texcoord[tc]->count != aim->mNumVertices) {
@@ -453,7 +453,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset& r)
                     continue;
                 }
 
-                attr.texcoord[tc]->ExtractData(aim->mTextureCoords[tc]);
+                attr.texcoord[tc]->ExtractFloatData(aim->mTextureCoords[tc]);
                 aim->mNumUVComponents[tc] = attr.texcoord[tc]->GetNumComponents();
 
                 aiVector3D* values = aim->mTextureCoords[tc];
@@ -473,7 +473,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset& r)
 
                     if (target.position.size() > 0) {
                         aiVector3D *positionDiff = nullptr;
-                        target.position[0]->ExtractData(positionDiff);
+                        target.position[0]->ExtractFloatData(positionDiff);
                         for(unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
                             aiAnimMesh.mVertices[vertexId] += positionDiff[vertexId];
                         }
@@ -481,7 +481,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset& r)
                     }
                     if (target.normal.size() > 0) {
                         aiVector3D *normalDiff = nullptr;
-                        target.normal[0]->ExtractData(normalDiff);
+                        target.normal[0]->ExtractFloatData(normalDiff);
                         for(unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
                             aiAnimMesh.mNormals[vertexId] += normalDiff[vertexId];
                         }
@@ -489,10 +489,10 @@ void glTF2Importer::ImportMeshes(glTF2::Asset& r)
                     }
                     if (target.tangent.size() > 0) {
                         Tangent *tangent = nullptr;
-                        attr.tangent[0]->ExtractData(tangent);
+                        attr.tangent[0]->ExtractFloatData(tangent);
 
                         aiVector3D *tangentDiff = nullptr;
-                        target.tangent[0]->ExtractData(tangentDiff);
+                        target.tangent[0]->ExtractFloatData(tangentDiff);
 
                         for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; ++vertexId) {
                             tangent[vertexId].xyz += tangentDiff[vertexId];
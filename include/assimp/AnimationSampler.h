@@ -0,0 +1,134 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file AnimationSampler.h
+ *  @brief Evaluates the node channels of an animation at arbitrary times.
+ */
+#pragma once
+#ifndef AI_ANIMATIONSAMPLER_H_INC
+#define AI_ANIMATIONSAMPLER_H_INC
+
+#include <assimp/types.h>
+
+#include <vector>
+
+struct aiAnimation;
+
+namespace Assimp {
+
+// --------------------------------------------------------------------------------------------
+/** Evaluates all node channels of an aiAnimation at a given time.
+ *
+ *  The result is one local transformation per channel, in the order of
+ *  aiAnimation::mChannels, ready to be copied to the aiNode::mTransformation of the
+ *  animated nodes. Positions and scalings are interpolated linearly, rotations with
+ *  aiQuaternion::Interpolate(). Times before the first or after the last key of a track
+ *  hold that key, the pre- and post-states of the channels are not applied. Tracks
+ *  without keys yield the identity.
+ *
+ *  The sampler remembers the current key of every track, so playing an animation forward
+ *  costs constant time per track and frame. Jumping backwards or far ahead falls back to
+ *  a binary search. Because of that state, a sampler must not be used by several threads
+ *  at once; create one per thread instead. The animation must outlive the sampler and
+ *  must not change while it is in use. Morph and mesh channels are ignored. */
+class ASSIMP_API AnimationSampler {
+public:
+    /** Local transformation of a node, split into its components. */
+    struct Transform {
+        aiVector3D position;
+        aiQuaternion rotation;
+        aiVector3D scaling;
+
+        Transform() :
+                scaling(1.f, 1.f, 1.f) {}
+
+        /** Composes scaling, rotation and translation like aiNode::mTransformation. */
+        aiMatrix4x4 GetMatrix() const {
+            return aiMatrix4x4(scaling, rotation, position);
+        }
+    };
+
+    explicit AnimationSampler(const aiAnimation* animation);
+
+    /** Number of transformations written per sampled frame. */
+    unsigned int GetNumChannels() const {
+        return static_cast<unsigned int>(mCursors.size());
+    }
+
+    /** Evaluates all channels at the given time, in ticks.
+     *  @param out Receives GetNumChannels() transformations. */
+    void Sample(double time, Transform* out);
+
+    /** Same as above, composing the transformations to matrices. */
+    void Sample(double time, aiMatrix4x4* out);
+
+    /** Resamples a whole clip at a fixed rate.
+     *  @param startTime Time of the first frame, in ticks.
+     *  @param step Distance between two frames, in ticks.
+     *  @param numFrames Number of frames to evaluate.
+     *  @param out Receives numFrames * GetNumChannels() transformations, frame after frame. */
+    void SampleClip(double startTime, double step, unsigned int numFrames, Transform* out);
+
+    /** Forgets the current keys, the next lookup uses a binary search. */
+    void Reset();
+
+private:
+    struct Cursor {
+        unsigned int position;
+        unsigned int rotation;
+        unsigned int scaling;
+    };
+
+    const aiAnimation* mAnimation;
+    std::vector<Cursor> mCursors;
+
+    // The interpolation of positions and scalings runs for all channels at once: the
+    // first half of the arrays holds the positions, the second half the scalings.
+    std::vector<aiVector3D> mStart;
+    std::vector<aiVector3D> mEnd;
+    std::vector<ai_real> mFactors;
+    std::vector<aiVector3D> mResult;
+    std::vector<Transform> mTransforms;
+};
+
+} // Namespace Assimp
+
+#endif // AI_ANIMATIONSAMPLER_H_INC
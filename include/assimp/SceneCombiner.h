@@ -52,7 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/types.h>
 #include <assimp/Defines.h>
 #include <stddef.h>
-#include <set>
+#include <unordered_set>
 #include <list>
 #include <stdint.h>
 
@@ -68,6 +68,7 @@ struct aiMetadata;
 struct aiBone;
 struct aiMesh;
 struct aiAnimMesh;
+struct aiQuantizedVertices;
 struct aiAnimation;
 struct aiNodeAnim;
 
@@ -190,7 +191,7 @@ struct SceneHelper
     unsigned int idlen;
 
     // hash table to quickly check whether a name is contained in the scene
-    std::set<unsigned int> hashes;
+    std::unordered_set<unsigned int> hashes;
 };
 
 // ---------------------------------------------------------------------------
@@ -343,6 +344,29 @@ public:
      */
     static void CopyScene(aiScene** dest,const aiScene* source,bool allocate = true);
 
+    // -------------------------------------------------------------------
+    /** Get a copy of a scene which shares the vertex streams and faces
+     *  of all meshes with the source scene.
+     *
+     *  Everything else is deep-copied, just like #CopyScene does. The
+     *  shared buffers are owned by the source scene: they must not be
+     *  modified or freed through the copy, and the copy must be deleted
+     *  with #DeleteSharedScene while the source scene is still alive.
+     *  @param dest Receives a pointer to the destination scene
+     *  @param src Source scene - remains unmodified.
+     */
+    static void CopySceneShared(aiScene** dest,const aiScene* source);
+
+    // -------------------------------------------------------------------
+    /** Delete a scene obtained from #CopySceneShared.
+     *
+     *  All mesh buffers still shared with the source scene are detached
+     *  before the copy is deleted.
+     *  @param copy Scene to be deleted
+     *  @param src Source scene the copy was created from
+     */
+    static void DeleteSharedScene(aiScene* copy,const aiScene* source);
+
 
     // -------------------------------------------------------------------
     /** Get a flat copy of a scene
@@ -367,6 +391,7 @@ public:
 
     // similar to Copy():
     static void Copy  (aiAnimMesh** dest, const aiAnimMesh* src);
+    static void Copy  (aiQuantizedVertices** dest, const aiQuantizedVertices* src);
     static void Copy  (aiMaterial** dest, const aiMaterial* src);
     static void Copy  (aiTexture** dest, const aiTexture* src);
     static void Copy  (aiAnimation** dest, const aiAnimation* src);
@@ -392,7 +417,15 @@ private:
 
     // -------------------------------------------------------------------
     // Add node identifiers to a hashing set
-    static void AddNodeHashes(aiNode* node, std::set<unsigned int>& hashes);
+    static void AddNodeHashes(aiNode* node, std::unordered_set<unsigned int>& hashes);
+
+    // -------------------------------------------------------------------
+    // Shared implementation of CopyScene() and CopySceneShared()
+    static void CopySceneImpl(aiScene* dest, const aiScene* source, bool shareMeshBuffers);
+
+    // -------------------------------------------------------------------
+    // Same as Copy(aiMesh**,...), optionally sharing vertex streams and faces
+    static void CopyMesh(aiMesh** dest, const aiMesh* src, bool shareBuffers);
 
 
     // -------------------------------------------------------------------
@@ -52,7 +52,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOSystem.hpp>
 
 namespace Assimp {
-    class ZipArchiveIOSystem : public IOSystem {
+    //! Files may be opened and read concurrently from several threads, each
+    //! thread working on its own streams. All streams must be closed before
+    //! the archive is destroyed.
+    class ASSIMP_API ZipArchiveIOSystem : public IOSystem {
     public:
         //! Open a Zip using the proffered IOSystem
         ZipArchiveIOSystem(IOSystem* pIOHandler, const char *pFilename, const char* pMode = "r");
@@ -75,6 +78,11 @@ namespace Assimp {
         //! Intended for use within Assimp library boundaries
         void getFileListExtension(std::vector<std::string>& rFileList, const std::string& extension) const;
 
+        //! Files larger than the threshold (in bytes, 16 MB by default) are
+        //! inflated on demand while they are read instead of being extracted
+        //! at once. Seeking backwards in them inflates them again.
+        void setStreamingThreshold(size_t threshold);
+
         static bool isZipArchive(IOSystem* pIOHandler, const char *pFilename);
         static bool isZipArchive(IOSystem* pIOHandler, const std::string& rFilename);
 
@@ -583,6 +583,223 @@ enum aiMorphingMethod
 #endif
 }; //! enum aiMorphingMethod
 
+// ---------------------------------------------------------------------------
+/** @brief A meshlet is a small cluster of triangles of a mesh.
+ *
+ *  Meshlets are generated by the #aiProcess_GenMeshlets step. The vertices of
+ *  a meshlet are the mVertexCount entries of aiMesh::mMeshletVertices starting
+ *  at mVertexOffset. They are indices into the vertex arrays of the mesh.
+ *  The triangles are the 3 * mTriangleCount entries of
+ *  aiMesh::mMeshletTriangles starting at mTriangleOffset. They are indices
+ *  into the vertices of the meshlet.
+ *
+ *  With #AI_CONFIG_PP_GM_CLUSTER_LOD the meshlets form a cluster-LOD
+ *  hierarchy. Level 0 covers the faces of the mesh, the coarser levels
+ *  follow in the same arrays. A renderer draws the meshlets whose error is
+ *  acceptable while the error of their parent is not. Meshlets simplified
+ *  together share their error and error sphere, so they all make the same
+ *  choice and no cracks appear between them.
+ */
+struct aiMeshlet
+{
+    /** Offset of the first vertex in aiMesh::mMeshletVertices */
+    unsigned int mVertexOffset;
+
+    /** Offset of the first triangle index in aiMesh::mMeshletTriangles */
+    unsigned int mTriangleOffset;
+
+    /** Number of vertices of the meshlet */
+    unsigned int mVertexCount;
+
+    /** Number of triangles of the meshlet */
+    unsigned int mTriangleCount;
+
+    /** Center and radius of a sphere enclosing all vertices of the meshlet */
+    C_STRUCT aiVector3D mCenter;
+    ai_real mRadius;
+
+    /** Normal cone of the meshlet. The normals n of all triangles
+     *  satisfy dot(n, mConeAxis) >= mConeCutoff. If the cutoff is
+     *  negative, the cone is wider than a hemisphere and the meshlet
+     *  can't be culled by its orientation. */
+    C_STRUCT aiVector3D mConeAxis;
+    ai_real mConeCutoff;
+
+    /** Level in the cluster-LOD hierarchy, 0 for the faces of the mesh */
+    unsigned int mLevel;
+
+    /** Estimated distance of the triangles to the faces of the mesh, and
+     *  the sphere to project it with. Level 0 has no error. */
+    C_STRUCT aiVector3D mErrorCenter;
+    ai_real mErrorRadius;
+    ai_real mError;
+
+    /** Error and sphere of the coarser meshlets replacing this one. The
+     *  error is negative for the roots of the hierarchy. */
+    C_STRUCT aiVector3D mParentErrorCenter;
+    ai_real mParentErrorRadius;
+    ai_real mParentError;
+
+#ifdef __cplusplus
+    aiMeshlet() AI_NO_EXCEPT
+    : mVertexOffset( 0 )
+    , mTriangleOffset( 0 )
+    , mVertexCount( 0 )
+    , mTriangleCount( 0 )
+    , mCenter()
+    , mRadius( 0 )
+    , mConeAxis()
+    , mConeCutoff( -1 )
+    , mLevel( 0 )
+    , mErrorCenter()
+    , mErrorRadius( 0 )
+    , mError( 0 )
+    , mParentErrorCenter()
+    , mParentErrorRadius( 0 )
+    , mParentError( -1 ) {
+        // empty
+    }
+#endif // __cplusplus
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Quantized copies of the vertex streams of a mesh.
+ *
+ *  The quantized streams are generated by the #aiProcessExt_QuantizeVertices
+ *  step, the float streams of the mesh are kept. Each array holds
+ *  mNumVertices elements and is NULL if the mesh has no such stream.
+ *  The largest error introduced per kind of stream is stored along with
+ *  the data.
+ */
+struct aiQuantizedVertices
+{
+    /** The number of vertices, the same as aiMesh::mNumVertices */
+    unsigned int mNumVertices;
+
+    /** Positions as unsigned normalized 16 bit integers, 3 per vertex,
+     *  relative to the bounding box of the mesh:
+     *  position = mPositionOffset + mPositionScale * q / 65535.
+     *  The scale is the same for all axes, so the dequantization is a
+     *  similarity transform which keeps normals intact. */
+    unsigned short* mPositions;
+    C_STRUCT aiVector3D mPositionOffset;
+    ai_real mPositionScale;
+
+    /** Normals in octahedral encoding, 2 signed normalized 16 bit
+     *  integers per vertex */
+    short* mNormals;
+
+    /** Tangents in octahedral encoding, 2 signed normalized 16 bit
+     *  integers per vertex */
+    short* mTangents;
+
+    /** Texture coordinates as unsigned normalized 16 bit integers,
+     *  mNumUVComponents per vertex, relative to the range of the channel:
+     *  coordinate = mTextureCoordsOffset + mTextureCoordsScale * q / 65535.
+     *  The range is [0,1] if all coordinates of the channel lie within it. */
+    unsigned short* mTextureCoords[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    unsigned int mNumUVComponents[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    C_STRUCT aiVector3D mTextureCoordsOffset[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    C_STRUCT aiVector3D mTextureCoordsScale[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+
+    /** Vertex colors as unsigned normalized 8 bit integers, 4 per vertex.
+     *  The components are clamped to [0,1]. */
+    unsigned char* mColors[AI_MAX_NUMBER_OF_COLOR_SETS];
+
+    /** Largest distance between a position and its quantized value */
+    ai_real mMaxPositionError;
+
+    /** Largest angle in radians between a normal or tangent and its
+     *  quantized value */
+    ai_real mMaxDirectionError;
+
+    /** Largest difference between a texture coordinate component and its
+     *  quantized value */
+    ai_real mMaxTextureCoordsError;
+
+    /** Largest difference between a color component and its quantized
+     *  value, not counting the clamping */
+    ai_real mMaxColorError;
+
+#ifdef __cplusplus
+    aiQuantizedVertices() AI_NO_EXCEPT
+    : mNumVertices( 0 )
+    , mPositions(nullptr)
+    , mPositionOffset()
+    , mPositionScale( 0 )
+    , mNormals(nullptr)
+    , mTangents(nullptr)
+    , mMaxPositionError( 0 )
+    , mMaxDirectionError( 0 )
+    , mMaxTextureCoordsError( 0 )
+    , mMaxColorError( 0 ) {
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+            mTextureCoords[a] = nullptr;
+            mNumUVComponents[a] = 0;
+        }
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+            mColors[a] = nullptr;
+        }
+    }
+
+    ~aiQuantizedVertices() {
+        delete [] mPositions;
+        delete [] mNormals;
+        delete [] mTangents;
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
+            delete [] mTextureCoords[a];
+        }
+        for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a) {
+            delete [] mColors[a];
+        }
+    }
+
+    //! Decodes a unit vector from its octahedral encoding
+    static aiVector3D DecodeDirection(const short* pEncoded) {
+        ai_real x = pEncoded[0] < -32767 ? ai_real( -1 ) : pEncoded[0] / ai_real( 32767 );
+        ai_real y = pEncoded[1] < -32767 ? ai_real( -1 ) : pEncoded[1] / ai_real( 32767 );
+        const ai_real z = 1 - (x < 0 ? -x : x) - (y < 0 ? -y : y);
+        const ai_real t = z < 0 ? -z : ai_real( 0 );
+        x += x >= 0 ? -t : t;
+        y += y >= 0 ? -t : t;
+        return aiVector3D(x, y, z).Normalize();
+    }
+
+    //! Returns the dequantized position of a vertex
+    aiVector3D GetPosition(unsigned int pIndex) const {
+        const unsigned short* q = mPositions + 3 * pIndex;
+        return mPositionOffset + aiVector3D(q[0], q[1], q[2]) * (mPositionScale / 65535);
+    }
+
+    //! Returns the dequantized normal of a vertex
+    aiVector3D GetNormal(unsigned int pIndex) const {
+        return DecodeDirection(mNormals + 2 * pIndex);
+    }
+
+    //! Returns the dequantized tangent of a vertex
+    aiVector3D GetTangent(unsigned int pIndex) const {
+        return DecodeDirection(mTangents + 2 * pIndex);
+    }
+
+    //! Returns the dequantized texture coordinates of a vertex
+    aiVector3D GetTextureCoords(unsigned int pChannel, unsigned int pIndex) const {
+        const unsigned int numComponents = mNumUVComponents[pChannel];
+        const unsigned short* q = mTextureCoords[pChannel] + numComponents * pIndex;
+        aiVector3D out = mTextureCoordsOffset[pChannel];
+        for (unsigned int c = 0; c < numComponents; ++c) {
+            out[c] += mTextureCoordsScale[pChannel][c] * q[c] / 65535;
+        }
+        return out;
+    }
+
+    //! Returns the dequantized color of a vertex
+    aiColor4D GetColor(unsigned int pChannel, unsigned int pIndex) const {
+        const unsigned char* q = mColors[pChannel] + 4 * pIndex;
+        return aiColor4D(q[0] / 255.f, q[1] / 255.f, q[2] / 255.f, q[3] / 255.f);
+    }
+#endif // __cplusplus
+};
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material.
 *
@@ -754,6 +971,60 @@ struct aiMesh
      *
      */
     C_STRUCT aiAABB mAABB;
+
+    /** The number of meshlets of this mesh, set by the
+     *  #aiProcess_GenMeshlets step. */
+    unsigned int mNumMeshlets;
+
+    /** The meshlets of this mesh, see #aiMeshlet. */
+    C_STRUCT aiMeshlet* mMeshlets;
+
+    /** The number of entries in mMeshletVertices. */
+    unsigned int mNumMeshletVertices;
+
+    /** The vertices of all meshlets, as indices into the vertex arrays. */
+    unsigned int* mMeshletVertices;
+
+    /** The number of entries in mMeshletTriangles, three per triangle. */
+    unsigned int mNumMeshletTriangleIndices;
+
+    /** The triangles of all meshlets, as indices into the vertices of
+     *  the meshlet. */
+    unsigned char* mMeshletTriangles;
+
+    /** The number of simplified versions of this mesh, set by the
+     *  #aiProcessExt_GenLODs step or by importers reading precomputed
+     *  LODs (see #AI_CONFIG_IMPORT_3DXML_LOD). */
+    unsigned int mNumLODs;
+
+    /** The simplified versions of this mesh as indices into
+     *  aiScene::mMeshes, ordered from the finest to the coarsest. The LOD
+     *  meshes themselves are not referenced by any node. Post-processing
+     *  steps which reorder the meshes keep the indices up to date, levels
+     *  are dropped if their mesh is split or joined with others. */
+    unsigned int* mLODs;
+
+    /** The number of bone influences stored per vertex in
+     *  mPackedBoneIndices and mPackedBoneWeights, set by the
+     *  #aiProcessExt_PackBoneWeights step. 0 if there are no packed
+     *  bone weights. */
+    unsigned int mNumBoneInfluences;
+
+    /** The bones influencing each vertex, as indices into mBones:
+     *  mNumBoneInfluences entries per vertex, vertex after vertex. The
+     *  influences of a vertex are sorted by descending weight, unused
+     *  entries are 0. */
+    unsigned short* mPackedBoneIndices;
+
+    /** The weights matching mPackedBoneIndices, quantized to bytes. The
+     *  weights of a vertex sum up to exactly 255, or are all 0 for
+     *  vertices without bones. */
+    unsigned char* mPackedBoneWeights;
+
+    /** Quantized copies of the vertex streams, set by the
+     *  #aiProcessExt_QuantizeVertices step. NULL if the vertices
+     *  are not quantized. */
+    C_STRUCT aiQuantizedVertices* mQuantizedVertices;
     
 #ifdef __cplusplus
 
@@ -797,6 +1068,18 @@ struct aiMesh
     , mAnimMeshes(nullptr)
     , mMethod( 0 )
     , mAABB()
+    , mNumMeshlets( 0 )
+    , mMeshlets(nullptr)
+    , mNumMeshletVertices( 0 )
+    , mMeshletVertices(nullptr)
+    , mNumMeshletTriangleIndices( 0 )
+    , mMeshletTriangles(nullptr)
+    , mNumLODs( 0 )
+    , mLODs(nullptr)
+    , mNumBoneInfluences( 0 )
+    , mPackedBoneIndices(nullptr)
+    , mPackedBoneWeights(nullptr)
+    , mQuantizedVertices(nullptr)
     , Vertices(&mVertices, &mNumVertices)
     , Normals(&mNormals, &mNumVertices)
     , Tangents(&mTangents, &mNumVertices)
@@ -849,6 +1132,13 @@ struct aiMesh
         }
 
         delete [] mFaces;
+        delete [] mMeshlets;
+        delete [] mMeshletVertices;
+        delete [] mMeshletTriangles;
+        delete [] mLODs;
+        delete [] mPackedBoneIndices;
+        delete [] mPackedBoneWeights;
+        delete mQuantizedVertices;
     }
 
     //! Check whether the mesh contains positions. Provided no special
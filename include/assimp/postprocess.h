@@ -316,6 +316,21 @@ enum aiPostProcessSteps
     */
     aiProcess_FixInfacingNormals = 0x2000,
 
+    // -------------------------------------------------------------------------
+    /** <hr>Partitions triangle meshes into meshlets.
+     *
+     *  A meshlet is a small cluster of adjacent triangles, described by
+     *  #aiMeshlet, with a bounding sphere and a normal cone for culling.
+     *  The meshlets are stored in aiMesh::mMeshlets. The original faces are
+     *  left untouched. Use the <tt>#AI_CONFIG_PP_GM_MAX_VERTICES</tt> and
+     *  <tt>#AI_CONFIG_PP_GM_MAX_TRIANGLES</tt> importer properties to set
+     *  the size of the meshlets. Specify #aiProcess_ImproveCacheLocality
+     *  as well for better vertex reuse within the meshlets. The
+     *  <tt>#AI_CONFIG_PP_GM_CLUSTER_LOD</tt> importer property adds
+     *  simplified levels of meshlets for a cluster-LOD hierarchy.
+    */
+    aiProcess_GenMeshlets = 0x4000,
+
     // -------------------------------------------------------------------------
     /** <hr>This step splits meshes with more than one primitive type in
      *  homogeneous sub-meshes.
@@ -581,6 +596,76 @@ enum aiPostProcessSteps
     aiProcess_GenBoundingBoxes = 0x80000000
 };
 
+// ---------------------------------------------------------------------------------------
+/** @enum  aiPostProcessStepsExt
+ *  @brief Defines the flags for additional post processing steps.
+ *
+ *  All bits of #aiPostProcessSteps are in use, so these steps are requested
+ *  by setting the #AI_CONFIG_PP_EXTENDED_STEPS importer property to a bitwise
+ *  combination of the flags below. They are executed as part of the regular
+ *  pipeline, together with the steps given to Importer::ReadFile() or
+ *  Importer::ApplyPostProcessing().
+ */
+enum aiPostProcessStepsExt
+{
+    // -------------------------------------------------------------------------
+    /** <hr>Generates simplified versions of all triangle meshes.
+     *
+     *  The meshes are decimated with a quadric error metric. Vertices are
+     *  only removed, never moved, so normals, UV seams, vertex colors and
+     *  bone weights of the remaining vertices are kept as they are. The
+     *  LOD meshes are appended to aiScene::mMeshes and listed in aiMesh::mLODs
+     *  of the mesh they were generated from.
+     *  Use #AI_CONFIG_PP_GL_NUM_LODS and #AI_CONFIG_PP_GL_RATIO to configure
+     *  the number of LODs and their triangle counts.
+     */
+    aiProcessExt_GenLODs = 0x1,
+
+    // -------------------------------------------------------------------------
+    /** <hr>Removes the animation keys which can be interpolated from the
+     *  keys around them.
+     *
+     *  Position and scaling keys are linearly interpolated, rotation keys
+     *  spherically. A key is only removed if the interpolated value stays
+     *  within the error bound of its track, so the animation is preserved
+     *  when it is played back with these interpolations. This can greatly
+     *  reduce the size of densely sampled animations, e.g. motion capture.
+     *  Use #AI_CONFIG_PP_RK_POSITION_ERROR, #AI_CONFIG_PP_RK_ROTATION_ERROR
+     *  and #AI_CONFIG_PP_RK_SCALING_ERROR to configure the error bounds.
+     */
+    aiProcessExt_ReduceKeyframes = 0x2,
+
+    // -------------------------------------------------------------------------
+    /** <hr>Packs the bone weights of all meshes into vertex-major streams,
+     *  as used for skinning on the GPU.
+     *
+     *  The heaviest influences of each vertex are stored in
+     *  aiMesh::mPackedBoneIndices and aiMesh::mPackedBoneWeights, with a
+     *  fixed number of influences per vertex. The weights are renormalized
+     *  and quantized to bytes. The bones themselves are left untouched, so
+     *  this step can be combined with #aiProcess_LimitBoneWeights and
+     *  #aiProcess_SplitByBoneCount. It runs after all steps which change
+     *  the vertices.
+     *  Use #AI_CONFIG_PP_PBW_NUM_INFLUENCES to configure the number of
+     *  influences per vertex.
+     */
+    aiProcessExt_PackBoneWeights = 0x4,
+
+    // -------------------------------------------------------------------------
+    /** <hr>Quantizes the vertex streams of all meshes into compact integer
+     *  representations.
+     *
+     *  Positions are stored as 16 bit integers relative to the bounding box
+     *  of the mesh, normals and tangents in 16 bit octahedral encoding,
+     *  texture coordinates as 16 bit integers and colors as 8 bit integers.
+     *  The result is stored in aiMesh::mQuantizedVertices along with the
+     *  largest error introduced, the float streams are kept. The glTF2
+     *  exporter writes the quantized streams using the KHR_mesh_quantization
+     *  extension. This step runs after all steps which change the vertices.
+     */
+    aiProcessExt_QuantizeVertices = 0x8
+};
+
 
 // ---------------------------------------------------------------------------------------
 /** @def aiProcess_ConvertToLeftHanded
@@ -0,0 +1,235 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include <assimp/AnimationSampler.h>
+#include <assimp/anim.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+class utAnimationSampler : public ::testing::Test {
+protected:
+    // Builds an animation whose channels have numKeys irregularly spaced keys per track,
+    // the scaling tracks have half as many keys.
+    static aiAnimation* MakeAnimation(unsigned int numChannels, unsigned int numKeys) {
+        aiAnimation* anim = new aiAnimation();
+        anim->mNumChannels = numChannels;
+        anim->mChannels = new aiNodeAnim*[numChannels];
+        for (unsigned int c = 0; c < numChannels; ++c) {
+            aiNodeAnim* channel = anim->mChannels[c] = new aiNodeAnim();
+            channel->mNodeName.Set("bone_" + std::to_string(c));
+            channel->mNumPositionKeys = channel->mNumRotationKeys = numKeys;
+            channel->mNumScalingKeys = numKeys / 2;
+            channel->mPositionKeys = new aiVectorKey[numKeys];
+            channel->mRotationKeys = new aiQuatKey[numKeys];
+            channel->mScalingKeys = new aiVectorKey[numKeys / 2];
+            for (unsigned int k = 0; k < numKeys; ++k) {
+                const double time = 2.0 * k + (k % 3) * 0.5;
+                const float phase = 0.1f * k + 0.01f * c;
+                channel->mPositionKeys[k] = aiVectorKey(time, aiVector3D(std::sin(phase), std::cos(phase), 0.5f * c));
+                channel->mRotationKeys[k] = aiQuatKey(time,
+                        aiQuaternion(aiVector3D(1.f, 2.f, 3.f).Normalize(), 0.2f * k + 0.01f * c));
+                if (k < numKeys / 2) {
+                    channel->mScalingKeys[k] = aiVectorKey(4.0 * k, aiVector3D(1.f + 0.5f * std::sin(phase), 1.f, 2.f));
+                }
+            }
+        }
+        anim->mDuration = 2.0 * numKeys;
+        return anim;
+    }
+
+    // Searches the keys from the start for every lookup, as a straightforward evaluator would
+    static AnimationSampler::Transform Evaluate(const aiNodeAnim* channel, double time) {
+        AnimationSampler::Transform result;
+        result.position = EvaluateVector(channel->mPositionKeys, channel->mNumPositionKeys, time, aiVector3D());
+        result.scaling = EvaluateVector(channel->mScalingKeys, channel->mNumScalingKeys, time, aiVector3D(1.f, 1.f, 1.f));
+        unsigned int k = 0;
+        const aiQuatKey* keys = channel->mRotationKeys;
+        const unsigned int numKeys = channel->mNumRotationKeys;
+        if (numKeys) {
+            while (k + 2 < numKeys && keys[k + 1].mTime <= time) {
+                ++k;
+            }
+            if (numKeys == 1 || time <= keys[k].mTime) {
+                result.rotation = keys[k].mValue;
+            } else if (time >= keys[k + 1].mTime) {
+                result.rotation = keys[k + 1].mValue;
+            } else {
+                const ai_real factor = static_cast<ai_real>((time - keys[k].mTime) / (keys[k + 1].mTime - keys[k].mTime));
+                aiQuaternion::Interpolate(result.rotation, keys[k].mValue, keys[k + 1].mValue, factor);
+            }
+        }
+        return result;
+    }
+
+    static aiVector3D EvaluateVector(const aiVectorKey* keys, unsigned int numKeys, double time, const aiVector3D& defaultValue) {
+        if (!numKeys) {
+            return defaultValue;
+        }
+        unsigned int k = 0;
+        while (k + 2 < numKeys && keys[k + 1].mTime <= time) {
+            ++k;
+        }
+        if (numKeys == 1 || time <= keys[k].mTime) {
+            return keys[k].mValue;
+        }
+        if (time >= keys[k + 1].mTime) {
+            return keys[k + 1].mValue;
+        }
+        const ai_real factor = static_cast<ai_real>((time - keys[k].mTime) / (keys[k + 1].mTime - keys[k].mTime));
+        return keys[k].mValue + (keys[k + 1].mValue - keys[k].mValue) * factor;
+    }
+
+    static void ExpectNear(const AnimationSampler::Transform& expected, const AnimationSampler::Transform& actual) {
+        EXPECT_NEAR(expected.position.x, actual.position.x, 1e-5f);
+        EXPECT_NEAR(expected.position.y, actual.position.y, 1e-5f);
+        EXPECT_NEAR(expected.position.z, actual.position.z, 1e-5f);
+        EXPECT_NEAR(expected.rotation.w, actual.rotation.w, 1e-5f);
+        EXPECT_NEAR(expected.rotation.x, actual.rotation.x, 1e-5f);
+        EXPECT_NEAR(expected.rotation.y, actual.rotation.y, 1e-5f);
+        EXPECT_NEAR(expected.rotation.z, actual.rotation.z, 1e-5f);
+        EXPECT_NEAR(expected.scaling.x, actual.scaling.x, 1e-5f);
+        EXPECT_NEAR(expected.scaling.y, actual.scaling.y, 1e-5f);
+        EXPECT_NEAR(expected.scaling.z, actual.scaling.z, 1e-5f);
+    }
+};
+
+TEST_F(utAnimationSampler, matchesReferenceInAnyOrder) {
+    std::unique_ptr<aiAnimation> anim(MakeAnimation(13, 40));
+    AnimationSampler sampler(anim.get());
+    ASSERT_EQ(13U, sampler.GetNumChannels());
+
+    // forward playback, a backward jump, a jump far ahead and times outside of the keys
+    const double times[] = { -5.0, 0.0, 0.3, 1.7, 2.0, 2.4, 9.1, 9.2, 3.3, 1.0, 55.5, 20.0, 81.0, 200.0, 79.9, 0.0 };
+    std::vector<AnimationSampler::Transform> out(sampler.GetNumChannels());
+    for (double time : times) {
+        sampler.Sample(time, out.data());
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+            ExpectNear(Evaluate(anim->mChannels[c], time), out[c]);
+        }
+    }
+}
+
+TEST_F(utAnimationSampler, holdsFirstAndLastKey) {
+    std::unique_ptr<aiAnimation> anim(MakeAnimation(1, 10));
+    const aiNodeAnim* channel = anim->mChannels[0];
+    AnimationSampler sampler(anim.get());
+    AnimationSampler::Transform out;
+
+    sampler.Sample(1000.0, &out);
+    EXPECT_EQ(channel->mPositionKeys[9].mValue, out.position);
+    EXPECT_EQ(channel->mRotationKeys[9].mValue, out.rotation);
+    EXPECT_EQ(channel->mScalingKeys[4].mValue, out.scaling);
+
+    sampler.Sample(-1000.0, &out);
+    EXPECT_EQ(channel->mPositionKeys[0].mValue, out.position);
+    EXPECT_EQ(channel->mRotationKeys[0].mValue, out.rotation);
+    EXPECT_EQ(channel->mScalingKeys[0].mValue, out.scaling);
+}
+
+TEST_F(utAnimationSampler, tracksWithoutKeysAreIdentity) {
+    std::unique_ptr<aiAnimation> anim(MakeAnimation(1, 10));
+    aiNodeAnim* channel = anim->mChannels[0];
+    channel->mNumRotationKeys = 0;
+    channel->mNumScalingKeys = 1;
+    AnimationSampler sampler(anim.get());
+    AnimationSampler::Transform out;
+    sampler.Sample(5.0, &out);
+    EXPECT_EQ(aiQuaternion(), out.rotation);
+    EXPECT_EQ(channel->mScalingKeys[0].mValue, out.scaling);
+
+    channel->mNumPositionKeys = 0;
+    aiMatrix4x4 matrix;
+    sampler.Sample(5.0, &matrix);
+    EXPECT_EQ(aiMatrix4x4(channel->mScalingKeys[0].mValue, aiQuaternion(), aiVector3D()), matrix);
+}
+
+TEST_F(utAnimationSampler, sampleClipMatchesSample) {
+    std::unique_ptr<aiAnimation> anim(MakeAnimation(21, 30));
+    AnimationSampler clipSampler(anim.get()), frameSampler(anim.get());
+    const unsigned int numFrames = 50, numChannels = clipSampler.GetNumChannels();
+    std::vector<AnimationSampler::Transform> clip(numFrames * numChannels), frame(numChannels);
+    clipSampler.SampleClip(-1.0, 1.25, numFrames, clip.data());
+    for (unsigned int f = 0; f < numFrames; ++f) {
+        frameSampler.Sample(-1.0 + 1.25 * f, frame.data());
+        for (unsigned int c = 0; c < numChannels; ++c) {
+            EXPECT_EQ(frame[c].position, clip[f * numChannels + c].position);
+            EXPECT_EQ(frame[c].rotation, clip[f * numChannels + c].rotation);
+            EXPECT_EQ(frame[c].scaling, clip[f * numChannels + c].scaling);
+        }
+    }
+}
+
+TEST_F(utAnimationSampler, benchmark1000Bones) {
+    typedef std::chrono::steady_clock Clock;
+    std::unique_ptr<aiAnimation> anim(MakeAnimation(1000, 600));
+    const unsigned int numFrames = 120, numChannels = anim->mNumChannels;
+    const double step = anim->mDuration / numFrames;
+
+    const Clock::time_point t0 = Clock::now();
+    std::vector<AnimationSampler::Transform> reference(numFrames * numChannels);
+    for (unsigned int f = 0; f < numFrames; ++f) {
+        for (unsigned int c = 0; c < numChannels; ++c) {
+            reference[f * numChannels + c] = Evaluate(anim->mChannels[c], step * f);
+        }
+    }
+    const Clock::time_point t1 = Clock::now();
+    std::vector<AnimationSampler::Transform> sampled(numFrames * numChannels);
+    AnimationSampler sampler(anim.get());
+    sampler.SampleClip(0.0, step, numFrames, sampled.data());
+    const Clock::time_point t2 = Clock::now();
+
+    for (size_t i = 0; i < sampled.size(); i += 97) {
+        ExpectNear(reference[i], sampled[i]);
+    }
+
+    const double linearMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    const double samplerMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    RecordProperty("linearMs", std::to_string(linearMs));
+    RecordProperty("samplerMs", std::to_string(samplerMs));
+}
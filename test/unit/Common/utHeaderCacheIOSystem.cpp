@@ -0,0 +1,138 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/HeaderCacheIOSystem.h"
+#include <assimp/MemoryIOWrapper.h>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// Counts the streams opened on the wrapped memory file system
+class CountingIOSystem : public MemoryIOSystem {
+public:
+    CountingIOSystem(const uint8_t* buff, size_t len)
+    : MemoryIOSystem(buff, len, nullptr)
+    , mNumOpened(0) {
+        // empty
+    }
+
+    IOStream* Open(const char* pFile, const char* pMode = "rb") override {
+        ++mNumOpened;
+        return MemoryIOSystem::Open(pFile, pMode);
+    }
+
+    unsigned int mNumOpened;
+};
+
+} // Namespace
+
+class utHeaderCacheIOSystem : public ::testing::Test {
+public:
+    void SetUp() override {
+        mData.resize(3 * HeaderCacheIOSystem::HeaderSize);
+        for (size_t i = 0; i < mData.size(); ++i) {
+            mData[i] = static_cast<uint8_t>(i * 7);
+        }
+    }
+
+protected:
+    std::vector<uint8_t> mData;
+};
+
+TEST_F(utHeaderCacheIOSystem, headerIsReadOnce) {
+    CountingIOSystem io(&mData[0], mData.size());
+    HeaderCacheIOSystem cache(AI_MEMORYIO_MAGIC_FILENAME, &io);
+
+    for (int i = 0; i < 10; ++i) {
+        IOStream* stream = cache.Open(AI_MEMORYIO_MAGIC_FILENAME);
+        ASSERT_NE(nullptr, stream);
+        EXPECT_EQ(mData.size(), stream->FileSize());
+
+        uint8_t buffer[200];
+        EXPECT_EQ(sizeof(buffer), stream->Read(buffer, 1, sizeof(buffer)));
+        EXPECT_EQ(0, memcmp(buffer, &mData[0], sizeof(buffer)));
+        cache.Close(stream);
+    }
+    EXPECT_EQ(1u, io.mNumOpened);
+    EXPECT_EQ(mData.size(), cache.FileSize());
+    EXPECT_TRUE(cache.Exists(AI_MEMORYIO_MAGIC_FILENAME));
+}
+
+TEST_F(utHeaderCacheIOSystem, readBeyondHeader) {
+    CountingIOSystem io(&mData[0], mData.size());
+    HeaderCacheIOSystem cache(AI_MEMORYIO_MAGIC_FILENAME, &io);
+
+    IOStream* stream = cache.Open(AI_MEMORYIO_MAGIC_FILENAME);
+    ASSERT_NE(nullptr, stream);
+
+    // seeking inside the file doesn't touch the wrapped system
+    const size_t offset = HeaderCacheIOSystem::HeaderSize - 10;
+    EXPECT_EQ(aiReturn_SUCCESS, stream->Seek(offset, aiOrigin_SET));
+    EXPECT_EQ(offset, stream->Tell());
+    EXPECT_EQ(1u, io.mNumOpened);
+
+    // crossing the end of the header falls back to the real stream
+    uint8_t buffer[100];
+    EXPECT_EQ(sizeof(buffer), stream->Read(buffer, 1, sizeof(buffer)));
+    EXPECT_EQ(0, memcmp(buffer, &mData[offset], sizeof(buffer)));
+    EXPECT_EQ(offset + sizeof(buffer), stream->Tell());
+    EXPECT_EQ(2u, io.mNumOpened);
+
+    cache.Close(stream);
+}
+
+TEST_F(utHeaderCacheIOSystem, otherFilesArePassedThrough) {
+    CountingIOSystem io(&mData[0], mData.size());
+    HeaderCacheIOSystem cache("some_other_file.bin", &io);
+
+    IOStream* stream = cache.Open(AI_MEMORYIO_MAGIC_FILENAME);
+    ASSERT_NE(nullptr, stream);
+    cache.Close(stream);
+    stream = cache.Open(AI_MEMORYIO_MAGIC_FILENAME);
+    ASSERT_NE(nullptr, stream);
+    cache.Close(stream);
+    EXPECT_EQ(2u, io.mNumOpened);
+}
@@ -0,0 +1,184 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/SceneNameIndex.h"
+
+#include <assimp/scene.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+class utSceneNameIndex : public ::testing::Test {
+protected:
+    static const unsigned int NumNodes = 20000;
+    static const unsigned int NumBones = 500;
+
+    // Builds a tree of NumNodes nodes, 8 children per node, and one mesh whose
+    // bones refer to NumBones nodes spread over the whole tree.
+    void SetUp() override {
+        scene.reset(new aiScene());
+        std::vector<aiNode*> nodes;
+        nodes.reserve(NumNodes);
+        for (unsigned int i = 0; i < NumNodes; ++i) {
+            aiNode* node = new aiNode("node_" + std::to_string(i));
+            if (!nodes.empty()) {
+                aiNode* parent = nodes[(i - 1) / 8];
+                parent->addChildren(1, &node);
+            }
+            nodes.push_back(node);
+        }
+        scene->mRootNode = nodes[0];
+
+        aiMesh* mesh = new aiMesh();
+        mesh->mNumBones = NumBones;
+        mesh->mBones = new aiBone*[NumBones];
+        for (unsigned int i = 0; i < NumBones; ++i) {
+            mesh->mBones[i] = new aiBone();
+            mesh->mBones[i]->mName = nodes[(i * 7919u) % NumNodes]->mName;
+        }
+        scene->mNumMeshes = 1;
+        scene->mMeshes = new aiMesh*[1];
+        scene->mMeshes[0] = mesh;
+    }
+
+    aiBone* FindBoneLinear(const aiString& name) const {
+        for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+            const aiMesh* mesh = scene->mMeshes[m];
+            for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+                if (mesh->mBones[b]->mName == name) {
+                    return mesh->mBones[b];
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<aiScene> scene;
+};
+
+TEST_F(utSceneNameIndex, lookupsMatchLinearSearch) {
+    const SceneNameIndex index(scene.get());
+    EXPECT_EQ(static_cast<size_t>(NumNodes), index.GetNumNodeNames());
+
+    const aiMesh* mesh = scene->mMeshes[0];
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        const aiString& name = mesh->mBones[b]->mName;
+        aiNode* node = index.FindNode(name);
+        ASSERT_NE(nullptr, node);
+        EXPECT_EQ(scene->mRootNode->FindNode(name), node);
+        EXPECT_EQ(FindBoneLinear(name), index.FindBone(name));
+        EXPECT_EQ(node, index.FindNode(name.C_Str()));
+    }
+    EXPECT_EQ(nullptr, index.FindNode("no_such_node"));
+    EXPECT_EQ(nullptr, index.FindBone("node_1"));
+}
+
+TEST_F(utSceneNameIndex, duplicateNamesResolveLikeFindNode) {
+    // rename a deep node and one of its ancestors' later siblings to the same name
+    aiNode* deep = scene->mRootNode->mChildren[0]->mChildren[0];
+    aiNode* late = scene->mRootNode->mChildren[7];
+    deep->mName.Set("twin");
+    late->mName.Set("twin");
+
+    const SceneNameIndex index(scene.get());
+    EXPECT_EQ(scene->mRootNode->FindNode("twin"), index.FindNode("twin"));
+    EXPECT_EQ(deep, index.FindNode("twin"));
+}
+
+TEST_F(utSceneNameIndex, cachedIndexIsInvalidated) {
+    const SceneNameIndex* index = &GetSceneNameIndex(scene.get());
+    EXPECT_EQ(index, &GetSceneNameIndex(scene.get()));
+    EXPECT_EQ(nullptr, index->FindNode("renamed"));
+
+    scene->mRootNode->mChildren[3]->mName.Set("renamed");
+    InvalidateSceneNameIndex(scene.get());
+    EXPECT_EQ(scene->mRootNode->mChildren[3], GetSceneNameIndex(scene.get()).FindNode("renamed"));
+}
+
+TEST_F(utSceneNameIndex, indexOfSceneWithoutPrivateDataIsReused) {
+    // as if the scene had been allocated by C code
+    void* priv = scene->mPrivate;
+    scene->mPrivate = nullptr;
+
+    const SceneNameIndex* index = &GetSceneNameIndex(scene.get());
+    EXPECT_EQ(index, &GetSceneNameIndex(scene.get()));
+    EXPECT_EQ(nullptr, index->FindNode("renamed"));
+
+    scene->mRootNode->mChildren[3]->mName.Set("renamed");
+    InvalidateSceneNameIndex(scene.get());
+    EXPECT_EQ(scene->mRootNode->mChildren[3], GetSceneNameIndex(scene.get()).FindNode("renamed"));
+
+    InvalidateSceneNameIndex(scene.get());
+    scene->mPrivate = priv;
+}
+
+TEST_F(utSceneNameIndex, benchmarkBoneLookups) {
+    typedef std::chrono::steady_clock Clock;
+    const aiMesh* mesh = scene->mMeshes[0];
+
+    // resolve every bone to its node, as the exporters do
+    const Clock::time_point t0 = Clock::now();
+    std::vector<const aiNode*> linear;
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        linear.push_back(scene->mRootNode->FindNode(mesh->mBones[b]->mName));
+    }
+    const Clock::time_point t1 = Clock::now();
+    std::vector<const aiNode*> indexed;
+    const SceneNameIndex index(scene.get());
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        indexed.push_back(index.FindNode(mesh->mBones[b]->mName));
+    }
+    const Clock::time_point t2 = Clock::now();
+
+    EXPECT_EQ(linear, indexed);
+
+    const double linearMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    const double indexedMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    RecordProperty("linearMs", std::to_string(linearMs));
+    // includes building the index
+    RecordProperty("indexedMs", std::to_string(indexedMs));
+}
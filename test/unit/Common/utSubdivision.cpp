@@ -0,0 +1,178 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/Subdivision.h>
+#include <assimp/StandardShapes.h>
+#include <assimp/scene.h>
+
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+class utSubdivision : public ::testing::Test {
+protected:
+    // One face per numIndices consecutive positions, in verbose format
+    static aiMesh* MakeMesh(const std::vector<aiVector3D>& positions, unsigned int numIndices) {
+        aiMesh* mesh = new aiMesh();
+        mesh->mPrimitiveTypes = numIndices == 3 ? aiPrimitiveType_TRIANGLE : aiPrimitiveType_POLYGON;
+        mesh->mNumVertices = static_cast<unsigned int>(positions.size());
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        std::copy(positions.begin(), positions.end(), mesh->mVertices);
+        mesh->mNumFaces = mesh->mNumVertices / numIndices;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            aiFace& face = mesh->mFaces[i];
+            face.mNumIndices = numIndices;
+            face.mIndices = new unsigned int[numIndices];
+            for (unsigned int j = 0; j < numIndices; ++j) {
+                face.mIndices[j] = i * numIndices + j;
+            }
+        }
+        return mesh;
+    }
+
+    static aiMesh* MakeCube() {
+        std::vector<aiVector3D> positions;
+        const unsigned int numIndices = StandardShapes::MakeHexahedron(positions, true);
+        return MakeMesh(positions, numIndices);
+    }
+
+    static aiMesh* MakeSphere(unsigned int tess) {
+        std::vector<aiVector3D> positions;
+        StandardShapes::MakeSphere(tess, positions);
+        return MakeMesh(positions, 3);
+    }
+
+    std::unique_ptr<Subdivider> subdivider{ Subdivider::Create(Subdivider::CATMULL_CLARKE) };
+};
+
+TEST_F(utSubdivision, quadCountGrowsPerLevel) {
+    std::unique_ptr<aiMesh> cube(MakeCube());
+    const unsigned int corners = cube->mNumFaces * 4;
+    for (unsigned int level = 1; level <= 3; ++level) {
+        aiMesh* out = nullptr;
+        subdivider->Subdivide(cube.get(), out, level);
+        ASSERT_NE(nullptr, out);
+        std::unique_ptr<aiMesh> result(out);
+
+        // the first level turns every corner into a quad, every further level splits each quad into four
+        const unsigned int expected = corners << (2 * (level - 1));
+        EXPECT_EQ(expected, result->mNumFaces);
+        EXPECT_EQ(expected * 4, result->mNumVertices);
+        for (unsigned int i = 0; i < result->mNumFaces; ++i) {
+            ASSERT_EQ(4u, result->mFaces[i].mNumIndices);
+        }
+    }
+}
+
+TEST_F(utSubdivision, closedMeshShrinksTowardsCenter) {
+    std::unique_ptr<aiMesh> cube(MakeCube());
+    aiMesh* out = nullptr;
+    subdivider->Subdivide(cube.get(), out, 2);
+    std::unique_ptr<aiMesh> result(out);
+
+    float extent = 0.f, corner = 0.f;
+    for (unsigned int i = 0; i < cube->mNumVertices; ++i) {
+        corner = std::max(corner, cube->mVertices[i].Length());
+    }
+    for (unsigned int i = 0; i < result->mNumVertices; ++i) {
+        const aiVector3D& v = result->mVertices[i];
+        extent = std::max(extent, v.Length());
+
+        // the cube is symmetric, so is its limit surface
+        EXPECT_LE(std::fabs(v.x), corner);
+        EXPECT_LE(std::fabs(v.y), corner);
+        EXPECT_LE(std::fabs(v.z), corner);
+    }
+    EXPECT_LT(extent, corner);
+}
+
+TEST_F(utSubdivision, multipleMeshesAreSmoothedTogether) {
+    // two halves of an open strip must match along their shared edge
+    std::vector<aiVector3D> left = {
+        aiVector3D(0, 0, 0), aiVector3D(1, 0, 0), aiVector3D(1, 1, 0), aiVector3D(0, 1, 0)
+    };
+    std::vector<aiVector3D> right = {
+        aiVector3D(1, 0, 0), aiVector3D(2, 0, 0), aiVector3D(2, 1, 0), aiVector3D(1, 1, 0)
+    };
+    aiMesh* in[] = { MakeMesh(left, 4), MakeMesh(right, 4) };
+    aiMesh* out[2] = { nullptr, nullptr };
+    subdivider->Subdivide(in, 2, out, 1, true);
+    ASSERT_NE(nullptr, out[0]);
+    ASSERT_NE(nullptr, out[1]);
+    std::unique_ptr<aiMesh> a(out[0]), b(out[1]);
+    EXPECT_EQ(4u, a->mNumFaces);
+    EXPECT_EQ(4u, b->mNumFaces);
+
+    // the edge point of the shared edge appears in both outputs
+    unsigned int shared = 0;
+    for (unsigned int i = 0; i < a->mNumVertices; ++i) {
+        for (unsigned int j = 0; j < b->mNumVertices; ++j) {
+            if (a->mVertices[i].Equal(b->mVertices[j], 1e-5f)) {
+                ++shared;
+                break;
+            }
+        }
+    }
+    EXPECT_GT(shared, 0u);
+}
+
+TEST_F(utSubdivision, benchmarkLevels) {
+    std::unique_ptr<aiMesh> sphere(MakeSphere(2));
+    for (unsigned int level = 1; level <= 4; ++level) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        aiMesh* out = nullptr;
+        subdivider->Subdivide(sphere.get(), out, level);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        ASSERT_NE(nullptr, out);
+        std::unique_ptr<aiMesh> result(out);
+
+        EXPECT_EQ((sphere->mNumFaces * 3) << (2 * (level - 1)), result->mNumFaces);
+        RecordProperty("level" + std::to_string(level) + "Ms", std::to_string(ms));
+    }
+}
@@ -0,0 +1,210 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/VectorKernels.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace Assimp;
+
+class utVectorKernels : public ::testing::Test {
+protected:
+    // Deterministic pseudo random vectors in [-range, range]
+    static std::vector<aiVector3D> MakeVectors(size_t count, float range) {
+        std::vector<aiVector3D> vectors(count);
+        unsigned int state = 12345u;
+        auto next = [&state, range]() {
+            state = state * 1664525u + 1013904223u;
+            return (static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.f - 1.f) * range;
+        };
+        for (aiVector3D& v : vectors) {
+            v.x = next();
+            v.y = next();
+            v.z = next();
+        }
+        return vectors;
+    }
+
+    static void ExpectNear(const aiVector3D& expected, const aiVector3D& actual) {
+        EXPECT_FLOAT_EQ(expected.x, actual.x);
+        EXPECT_FLOAT_EQ(expected.y, actual.y);
+        EXPECT_FLOAT_EQ(expected.z, actual.z);
+    }
+
+    static aiMatrix4x4 MakeTransform() {
+        aiMatrix4x4 rotation, translation, scaling;
+        aiMatrix4x4::Rotation(0.7f, aiVector3D(1.f, 2.f, 3.f).Normalize(), rotation);
+        aiMatrix4x4::Translation(aiVector3D(5.f, -3.f, 10.f), translation);
+        aiMatrix4x4::Scaling(aiVector3D(2.f, 0.5f, 3.f), scaling);
+        return translation * rotation * scaling;
+    }
+};
+
+// Counts around the SIMD widths exercise the scalar remainder of every code path
+TEST_F(utVectorKernels, transformPointsMatchesOperator) {
+    const aiMatrix4x4 m = MakeTransform();
+    for (size_t count = 0; count < 40; ++count) {
+        const std::vector<aiVector3D> in = MakeVectors(count, 100.f);
+        std::vector<aiVector3D> out(count);
+        TransformPoints(m, in.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            ExpectNear(m * in[i], out[i]);
+        }
+    }
+}
+
+TEST_F(utVectorKernels, transformDirectionsMatchesOperator) {
+    const aiMatrix3x3 m(MakeTransform());
+    for (size_t count = 0; count < 40; ++count) {
+        const std::vector<aiVector3D> in = MakeVectors(count, 1.f);
+        std::vector<aiVector3D> out(count), normalized(count);
+        TransformDirections(m, in.data(), out.data(), count, false);
+        TransformDirections(m, in.data(), normalized.data(), count, true);
+        for (size_t i = 0; i < count; ++i) {
+            ExpectNear(m * in[i], out[i]);
+            ExpectNear((m * in[i]).Normalize(), normalized[i]);
+        }
+    }
+}
+
+TEST_F(utVectorKernels, kernelsWorkInPlace) {
+    const aiMatrix4x4 m = MakeTransform();
+    const std::vector<aiVector3D> in = MakeVectors(1001, 10.f);
+    std::vector<aiVector3D> points = in, scaled = in;
+    TransformPoints(m, points.data(), points.data(), points.size());
+    ScaleVectors(aiVector3D(1.f, 1.f, -1.f), scaled.data(), scaled.data(), scaled.size());
+    for (size_t i = 0; i < in.size(); ++i) {
+        ExpectNear(m * in[i], points[i]);
+        EXPECT_EQ(aiVector3D(in[i].x, in[i].y, -in[i].z), scaled[i]);
+    }
+}
+
+TEST_F(utVectorKernels, scaleVectorsMatchesOperator) {
+    const aiVector3D scale(2.f, -0.5f, 3.f);
+    for (size_t count = 0; count < 40; ++count) {
+        const std::vector<aiVector3D> in = MakeVectors(count, 100.f);
+        std::vector<aiVector3D> out(count);
+        ScaleVectors(scale, in.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(aiVector3D(in[i].x * scale.x, in[i].y * scale.y, in[i].z * scale.z), out[i]);
+        }
+    }
+}
+
+TEST_F(utVectorKernels, interpolateVectorsMatchesOperator) {
+    for (size_t count = 0; count < 40; ++count) {
+        const std::vector<aiVector3D> start = MakeVectors(count, 100.f), end = MakeVectors(count + 7, 10.f);
+        std::vector<ai_real> factors(count);
+        for (size_t i = 0; i < count; ++i) {
+            factors[i] = static_cast<ai_real>(i % 5) * 0.25f;
+        }
+        std::vector<aiVector3D> out(count);
+        InterpolateVectors(start.data(), end.data(), factors.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(start[i] + (end[i] - start[i]) * factors[i], out[i]);
+        }
+    }
+}
+
+TEST_F(utVectorKernels, boundingBoxEnclosesAllPoints) {
+    for (size_t count = 1; count < 60; ++count) {
+        std::vector<aiVector3D> points = MakeVectors(count, 50.f);
+        // put the extremes at the last position, which is handled by the remainder loops
+        points.back() = aiVector3D(60.f, -70.f, 80.f);
+
+        aiVector3D min(999999.f, 999999.f, 999999.f), max(-999999.f, -999999.f, -999999.f);
+        ExtendBoundingBox(points.data(), count, min, max);
+
+        aiVector3D expectedMin = points[0], expectedMax = points[0];
+        for (const aiVector3D& p : points) {
+            expectedMin = aiVector3D(std::min(expectedMin.x, p.x), std::min(expectedMin.y, p.y), std::min(expectedMin.z, p.z));
+            expectedMax = aiVector3D(std::max(expectedMax.x, p.x), std::max(expectedMax.y, p.y), std::max(expectedMax.z, p.z));
+        }
+        EXPECT_EQ(expectedMin, min);
+        EXPECT_EQ(expectedMax, max);
+        EXPECT_EQ(80.f, max.z);
+        EXPECT_EQ(-70.f, min.y);
+    }
+}
+
+TEST_F(utVectorKernels, boundingBoxIsOnlyExtended) {
+    const std::vector<aiVector3D> points = MakeVectors(33, 1.f);
+    aiVector3D min(-5.f, -5.f, -5.f), max(5.f, 5.f, 5.f);
+    ExtendBoundingBox(points.data(), points.size(), min, max);
+    EXPECT_EQ(aiVector3D(-5.f, -5.f, -5.f), min);
+    EXPECT_EQ(aiVector3D(5.f, 5.f, 5.f), max);
+
+    // nothing to do for empty arrays
+    ExtendBoundingBox(nullptr, 0, min, max);
+    EXPECT_EQ(aiVector3D(-5.f, -5.f, -5.f), min);
+}
+
+TEST_F(utVectorKernels, boundingBoxSkipsNaNValues) {
+    for (size_t count = 1; count < 40; ++count) {
+        std::vector<aiVector3D> points = MakeVectors(count, 50.f);
+        // NaN values in the first block must not stick in the SIMD lanes
+        points[0] = aiVector3D(std::numeric_limits<float>::quiet_NaN());
+        if (count > 4) {
+            points[3].y = std::numeric_limits<float>::quiet_NaN();
+        }
+
+        aiVector3D min(999999.f, 999999.f, 999999.f), max(-999999.f, -999999.f, -999999.f);
+        aiVector3D expectedMin = min, expectedMax = max;
+        for (const aiVector3D& p : points) {
+            for (unsigned int c = 0; c < 3; ++c) {
+                if (p[c] < expectedMin[c]) {
+                    expectedMin[c] = p[c];
+                }
+                if (p[c] > expectedMax[c]) {
+                    expectedMax[c] = p[c];
+                }
+            }
+        }
+        ExtendBoundingBox(points.data(), count, min, max);
+        EXPECT_EQ(expectedMin, min);
+        EXPECT_EQ(expectedMax, max);
+    }
+}
@@ -0,0 +1,184 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/ZipArchiveIOSystem.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Assimp;
+
+class utZipArchiveIOSystem : public ::testing::Test {
+protected:
+    // Reads a whole file of the archive in chunks of the given size
+    static bool ReadFile(ZipArchiveIOSystem& archive, const char* name, size_t chunk, std::vector<uint8_t>& data) {
+        IOStream* stream = archive.Open(name);
+        if (nullptr == stream) {
+            return false;
+        }
+        data.resize(stream->FileSize());
+        size_t offset = 0;
+        while (offset < data.size()) {
+            const size_t read = stream->Read(&data[offset], 1, std::min(chunk, data.size() - offset));
+            if (0 == read) {
+                break;
+            }
+            offset += read;
+        }
+        archive.Close(stream);
+        return offset == data.size();
+    }
+
+    DefaultIOSystem mIOSystem;
+};
+
+TEST_F(utZipArchiveIOSystem, directory) {
+    ZipArchiveIOSystem archive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/Collada/duck.zae");
+    ASSERT_TRUE(archive.isOpen());
+
+    std::vector<std::string> files;
+    archive.getFileList(files);
+    ASSERT_EQ(3u, files.size());
+    EXPECT_EQ("duckzae.dae", files[0]);
+    EXPECT_EQ("duckzaeCM.png", files[1]);
+    EXPECT_EQ("manifest.xml", files[2]);
+
+    archive.getFileListExtension(files, "png");
+    ASSERT_EQ(1u, files.size());
+    EXPECT_EQ("duckzaeCM.png", files[0]);
+
+    EXPECT_TRUE(archive.Exists("manifest.xml"));
+    EXPECT_FALSE(archive.Exists("missing.xml"));
+    EXPECT_EQ(nullptr, archive.Open("missing.xml"));
+
+    EXPECT_TRUE(ZipArchiveIOSystem::isZipArchive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/Collada/duck.zae"));
+    EXPECT_FALSE(ZipArchiveIOSystem::isZipArchive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/Collada/duck.dae"));
+}
+
+TEST_F(utZipArchiveIOSystem, streamingMatchesExtraction) {
+    ZipArchiveIOSystem archive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/Collada/duck.zae");
+    ASSERT_TRUE(archive.isOpen());
+
+    std::vector<uint8_t> extracted, streamed;
+    ASSERT_TRUE(ReadFile(archive, "duckzae.dae", 1u << 20, extracted));
+    EXPECT_EQ(284557u, extracted.size());
+
+    // every file is streamed now
+    archive.setStreamingThreshold(0);
+    ASSERT_TRUE(ReadFile(archive, "duckzae.dae", 1000, streamed));
+    EXPECT_TRUE(extracted == streamed);
+
+    IOStream* stream = archive.Open("duckzae.dae");
+    ASSERT_NE(nullptr, stream);
+    EXPECT_EQ(extracted.size(), stream->FileSize());
+
+    // seeking forward skips data, seeking backward inflates again
+    uint8_t buffer[16];
+    ASSERT_EQ(aiReturn_SUCCESS, stream->Seek(200000, aiOrigin_SET));
+    ASSERT_EQ(16u, stream->Read(buffer, 1, 16));
+    EXPECT_EQ(0, memcmp(&extracted[200000], buffer, 16));
+    ASSERT_EQ(aiReturn_SUCCESS, stream->Seek(100, aiOrigin_SET));
+    EXPECT_EQ(100u, stream->Tell());
+    ASSERT_EQ(16u, stream->Read(buffer, 1, 16));
+    EXPECT_EQ(0, memcmp(&extracted[100], buffer, 16));
+    ASSERT_EQ(aiReturn_SUCCESS, stream->Seek(16, aiOrigin_END));
+    ASSERT_EQ(1u, stream->Read(buffer, 16, 2));
+    EXPECT_EQ(0, memcmp(&extracted[extracted.size() - 16], buffer, 16));
+    EXPECT_EQ(0u, stream->Read(buffer, 1, 16));
+    EXPECT_EQ(aiReturn_FAILURE, stream->Seek(extracted.size() + 1, aiOrigin_SET));
+    archive.Close(stream);
+}
+
+TEST_F(utZipArchiveIOSystem, streamOutlivesArchive) {
+    std::unique_ptr<ZipArchiveIOSystem> archive(new ZipArchiveIOSystem(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/Collada/duck.zae"));
+    ASSERT_TRUE(archive->isOpen());
+
+    std::vector<uint8_t> extracted;
+    ASSERT_TRUE(ReadFile(*archive, "duckzae.dae", 1u << 20, extracted));
+    archive->setStreamingThreshold(0);
+    std::unique_ptr<IOStream> stream(archive->Open("duckzae.dae"));
+    ASSERT_NE(nullptr, stream);
+
+    // like the DAE of a ZAE, the stream is closed after its archive
+    archive.reset();
+    std::vector<uint8_t> streamed(extracted.size());
+    ASSERT_EQ(streamed.size(), stream->Read(streamed.data(), 1, streamed.size()));
+    EXPECT_TRUE(extracted == streamed);
+    stream.reset();
+}
+
+TEST_F(utZipArchiveIOSystem, concurrentReads) {
+    ZipArchiveIOSystem archive(&mIOSystem, ASSIMP_TEST_MODELS_DIR "/Collada/duck.zae");
+    ASSERT_TRUE(archive.isOpen());
+    archive.setStreamingThreshold(100000);
+
+    std::vector<std::string> files;
+    archive.getFileList(files);
+    std::vector<std::vector<uint8_t> > reference(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        ASSERT_TRUE(ReadFile(archive, files[i].c_str(), 4096, reference[i]));
+    }
+
+    std::atomic<unsigned int> numMatching(0);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([&]() {
+            std::vector<uint8_t> data;
+            for (unsigned int pass = 0; pass < 5; ++pass) {
+                for (size_t i = 0; i < files.size(); ++i) {
+                    if (ReadFile(archive, files[i].c_str(), 4096, data) && data == reference[i]) {
+                        ++numMatching;
+                    }
+                }
+            }
+        }));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(4u * 5u * files.size(), numMatching.load());
+}
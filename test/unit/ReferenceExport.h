@@ -0,0 +1,95 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "UnitTestPCH.h"
+
+#include <assimp/cexport.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+// Splits exporter output into lines, skipping those carrying the assimp version or a timestamp
+inline std::vector<std::string> SplitReferenceLines(const std::string& data) {
+    static const char* const volatileTokens[] = {
+        "Open Asset Import Library", "assimp v", "<created>", "<modified>"
+    };
+
+    std::vector<std::string> lines;
+    std::istringstream in(data);
+    std::string line;
+    while (std::getline(in, line)) {
+        bool skip = false;
+        for (const char* token : volatileTokens) {
+            skip = skip || line.find(token) != std::string::npos;
+        }
+        if (!skip) {
+            lines.push_back(line);
+        }
+    }
+    return lines;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compares an exported blob line by line against a reference file in models/ReferenceExports,
+// ignoring the lines which carry the assimp version or a timestamp
+inline void ExpectMatchesReferenceExport(const aiExportDataBlob* blob, const std::string& name) {
+    ASSERT_NE(nullptr, blob);
+    std::ifstream file(std::string(ASSIMP_TEST_MODELS_DIR "/ReferenceExports/") + name, std::ios::binary);
+    ASSERT_TRUE(file.good()) << name;
+    std::ostringstream reference;
+    reference << file.rdbuf();
+
+    const std::vector<std::string> expected = SplitReferenceLines(reference.str());
+    const std::vector<std::string> actual = SplitReferenceLines(std::string(static_cast<const char*>(blob->data), blob->size));
+    ASSERT_EQ(expected.size(), actual.size()) << name;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], actual[i]) << name << ", line " << i;
+    }
+}
+
+} // Namespace Assimp
@@ -47,15 +47,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/mesh.h>
 #include <assimp/material.h>
 
+#include <algorithm>
+#include <climits>
+#include <string>
+#include <vector>
+
 namespace Assimp {
 
-class TestModelFacttory {
+class TestModelFactory {
 public:
-    TestModelFacttory() {
+    TestModelFactory() {
         // empty
     }
 
-    ~TestModelFacttory() {
+    ~TestModelFactory() {
         // empty
     }
 
@@ -100,6 +105,101 @@ public:
         delete *scene;
         *scene = nullptr;
     }
+
+    // Indexed grid of size x size quads in the xy plane, two triangles each, with u = 0.
+    // The vertices right of seam get their own copies at the seam, with u = 1 instead.
+    static aiMesh *createGridMesh( unsigned int size, unsigned int seam = UINT_MAX ) {
+        std::vector<aiVector3D> vertices, uvs;
+        std::vector<unsigned int> left((size + 1) * (size + 1)), right((size + 1) * (size + 1));
+        for (unsigned int y = 0; y <= size; ++y) {
+            for (unsigned int x = 0; x <= size; ++x) {
+                const unsigned int i = y * (size + 1) + x;
+                left[i] = right[i] = static_cast<unsigned int>(vertices.size());
+                vertices.push_back(aiVector3D((ai_real)x, (ai_real)y, 0));
+                uvs.push_back(aiVector3D(x > seam ? (ai_real)1 : (ai_real)0, 0, 0));
+                if (x == seam) {
+                    right[i] = static_cast<unsigned int>(vertices.size());
+                    vertices.push_back(aiVector3D((ai_real)x, (ai_real)y, 0));
+                    uvs.push_back(aiVector3D(1, 0, 0));
+                }
+            }
+        }
+
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = static_cast<unsigned int>(vertices.size());
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        std::copy(vertices.begin(), vertices.end(), mesh->mVertices);
+        mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+        std::copy(uvs.begin(), uvs.end(), mesh->mTextureCoords[0]);
+        mesh->mNumUVComponents[0] = 2;
+
+        mesh->mNumFaces = size * size * 2;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (unsigned int y = 0, f = 0; y < size; ++y) {
+            for (unsigned int x = 0; x < size; ++x) {
+                const std::vector<unsigned int> &map = x < seam ? left : right;
+                const unsigned int i = y * (size + 1) + x;
+                const unsigned int quad[2][3] = { { i, i + 1, i + size + 2 }, { i, i + size + 2, i + size + 1 } };
+                for (unsigned int t = 0; t < 2; ++t, ++f) {
+                    aiFace &face = mesh->mFaces[f];
+                    face.mNumIndices = 3;
+                    face.mIndices = new unsigned int[3];
+                    for (unsigned int k = 0; k < 3; ++k) {
+                        face.mIndices[k] = map[quad[t][k]];
+                    }
+                }
+            }
+        }
+        return mesh;
+    }
+
+    // A mesh with numVertices vertices and no faces, with a bone per entry of weights,
+    // each bone influencing the vertex 0 with the given weight
+    static aiMesh *createSkinnedMesh( unsigned int numVertices, const std::vector<float> &weights ) {
+        aiMesh *mesh = new aiMesh();
+        mesh->mNumVertices = numVertices;
+        mesh->mVertices = new aiVector3D[numVertices];
+        mesh->mNumBones = static_cast<unsigned int>(weights.size());
+        mesh->mBones = new aiBone*[mesh->mNumBones];
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            aiBone *bone = mesh->mBones[b] = new aiBone();
+            bone->mName.Set("bone" + std::to_string(b));
+            bone->mNumWeights = 1;
+            bone->mWeights = new aiVertexWeight[1];
+            bone->mWeights[0] = aiVertexWeight(0, weights[b]);
+        }
+        return mesh;
+    }
+
+    // A mesh with numVertices deterministic pseudo random vertices and no faces, all vertex
+    // streams are filled. The uvs are in [0, uvRange].
+    static aiMesh *createRandomVertexMesh( unsigned int numVertices, float uvRange ) {
+        aiMesh *mesh = new aiMesh();
+        mesh->mNumVertices = numVertices;
+        mesh->mVertices = new aiVector3D[numVertices];
+        mesh->mNormals = new aiVector3D[numVertices];
+        mesh->mTangents = new aiVector3D[numVertices];
+        mesh->mBitangents = new aiVector3D[numVertices];
+        mesh->mTextureCoords[0] = new aiVector3D[numVertices];
+        mesh->mNumUVComponents[0] = 2;
+        mesh->mColors[0] = new aiColor4D[numVertices];
+
+        unsigned int state = 12345u;
+        auto next = [&state]() {
+            state = state * 1664525u + 1013904223u;
+            return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+        };
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            mesh->mVertices[i] = aiVector3D(next() * 10.f - 5.f, next() * 2.f, next() * 0.5f + 100.f);
+            mesh->mNormals[i] = aiVector3D(next() - 0.5f, next() - 0.5f, next() - 0.5f).Normalize();
+            mesh->mTangents[i] = aiVector3D(next() - 0.5f, next() - 0.5f, next() - 0.5f).Normalize();
+            mesh->mBitangents[i] = mesh->mNormals[i] ^ mesh->mTangents[i];
+            mesh->mTextureCoords[0][i] = aiVector3D(next() * uvRange, next() * uvRange, 0.f);
+            mesh->mColors[0][i] = aiColor4D(next(), next(), next(), 1.f);
+        }
+        return mesh;
+    }
 };
 
 }
@@ -0,0 +1,217 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+#include "AbstractImportExportBase.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class ut3DXMLImportExport : public AbstractImportExportBase {
+public:
+    virtual bool importerTest() {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/3DXML/instances.3dxml", aiProcess_ValidateDataStructure );
+        return nullptr != scene;
+    }
+};
+
+TEST_F( ut3DXMLImportExport, import3DXMLFromFileTest ) {
+    EXPECT_TRUE( importerTest() );
+}
+
+TEST_F( ut3DXMLImportExport, importPreservedInstancesTest ) {
+    Assimp::Importer importer;
+    importer.SetPropertyInteger( AI_CONFIG_IMPORT_3DXML_PRESERVE_INSTANCES, 1 );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/3DXML/instances.3dxml", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    // The meshes of the assembly and of its part are not duplicated
+    EXPECT_EQ( 2u, scene->mNumMeshes );
+
+    const aiNode *first = scene->mRootNode->FindNode( "Assembly.1" );
+    const aiNode *second = scene->mRootNode->FindNode( "Assembly.2" );
+    ASSERT_NE( nullptr, first );
+    ASSERT_NE( nullptr, second );
+
+    // Both instances hold the shared meshes of the assembly
+    ASSERT_EQ( 1u, first->mNumMeshes );
+    ASSERT_EQ( 1u, second->mNumMeshes );
+    EXPECT_EQ( first->mMeshes[ 0 ], second->mMeshes[ 0 ] );
+
+    // Only the first one holds the children, the other one refers to it
+    EXPECT_EQ( 1u, first->mNumChildren );
+    EXPECT_EQ( 0u, second->mNumChildren );
+
+    int32_t prototype = -1, instance_of = -2;
+    ASSERT_NE( nullptr, first->mMetaData );
+    ASSERT_NE( nullptr, second->mMetaData );
+    EXPECT_TRUE( first->mMetaData->Get( "3DXML_PROTOTYPE", prototype ) );
+    EXPECT_TRUE( second->mMetaData->Get( "3DXML_INSTANCE_OF", instance_of ) );
+    EXPECT_EQ( prototype, instance_of );
+}
+
+TEST_F( ut3DXMLImportExport, importExpandedInstancesTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/3DXML/instances.3dxml", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    const aiNode *first = scene->mRootNode->FindNode( "Assembly.1" );
+    const aiNode *second = scene->mRootNode->FindNode( "Assembly.2" );
+    ASSERT_NE( nullptr, first );
+    ASSERT_NE( nullptr, second );
+
+    // Every instance gets its own copy of the children
+    EXPECT_EQ( 1u, first->mNumMeshes );
+    EXPECT_EQ( 1u, second->mNumMeshes );
+    EXPECT_EQ( 1u, first->mNumChildren );
+    EXPECT_EQ( 1u, second->mNumChildren );
+}
+
+TEST_F( ut3DXMLImportExport, importAllLODsTest ) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/3DXML/lods.3dxml", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    // The LODs follow their full resolution mesh, from the finest to the coarsest
+    ASSERT_EQ( 3u, scene->mNumMeshes );
+    const aiMesh *mesh = scene->mMeshes[ 0 ];
+    EXPECT_EQ( 2u, mesh->mNumFaces );
+    ASSERT_EQ( 2u, mesh->mNumLODs );
+    EXPECT_EQ( 1u, mesh->mLODs[ 0 ] );
+    EXPECT_EQ( 2u, mesh->mLODs[ 1 ] );
+    EXPECT_EQ( 2u, scene->mMeshes[ 1 ]->mNumFaces );
+    EXPECT_EQ( 1u, scene->mMeshes[ 2 ]->mNumFaces );
+    EXPECT_STREQ( "PartRep_LOD1", scene->mMeshes[ 1 ]->mName.C_Str() );
+
+    // Only the full resolution mesh is referenced by the nodes
+    ASSERT_EQ( 1u, scene->mRootNode->mNumMeshes );
+    EXPECT_EQ( 0u, scene->mRootNode->mMeshes[ 0 ] );
+}
+
+TEST_F( ut3DXMLImportExport, importFinestLODTest ) {
+    Assimp::Importer importer;
+    importer.SetPropertyInteger( AI_CONFIG_IMPORT_3DXML_LOD, 1 );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/3DXML/lods.3dxml", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    ASSERT_EQ( 1u, scene->mNumMeshes );
+    EXPECT_EQ( 2u, scene->mMeshes[ 0 ]->mNumFaces );
+    EXPECT_EQ( 0u, scene->mMeshes[ 0 ]->mNumLODs );
+}
+
+TEST_F( ut3DXMLImportExport, importCoarsestLODTest ) {
+    Assimp::Importer importer;
+    importer.SetPropertyInteger( AI_CONFIG_IMPORT_3DXML_LOD, 2 );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/3DXML/lods.3dxml", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    // The coarsest LOD replaces the full resolution faces
+    ASSERT_EQ( 1u, scene->mNumMeshes );
+    EXPECT_EQ( 1u, scene->mMeshes[ 0 ]->mNumFaces );
+    EXPECT_EQ( 0u, scene->mMeshes[ 0 ]->mNumLODs );
+}
+
+TEST_F( ut3DXMLImportExport, importStructureOnlyTest ) {
+    Assimp::Importer importer;
+    importer.SetPropertyInteger( AI_CONFIG_IMPORT_3DXML_STRUCTURE_ONLY, 1 );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/3DXML/instances.3dxml", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    EXPECT_EQ( 0u, scene->mNumMeshes );
+    EXPECT_NE( 0u, scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE );
+
+    // The whole product structure is still there
+    const aiNode *node = scene->mRootNode->FindNode( "Part.1" );
+    ASSERT_NE( nullptr, node );
+    ASSERT_NE( nullptr, node->mMetaData );
+    aiString reference;
+    EXPECT_TRUE( node->mMetaData->Get( "3DXML_REFERENCE", reference ) );
+    EXPECT_STREQ( "Part", reference.C_Str() );
+}
+
+TEST_F( ut3DXMLImportExport, importFilteredByNameTest ) {
+    Assimp::Importer importer;
+    importer.SetPropertyString( AI_CONFIG_IMPORT_3DXML_FILTER, "Part" );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/3DXML/instances.3dxml", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    // Only the representation of the part is loaded
+    EXPECT_EQ( 1u, scene->mNumMeshes );
+    EXPECT_EQ( 0u, scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE );
+
+    const aiNode *assembly = scene->mRootNode->FindNode( "Assembly.1" );
+    ASSERT_NE( nullptr, assembly );
+    EXPECT_EQ( 0u, assembly->mNumMeshes );
+    ASSERT_EQ( 1u, assembly->mNumChildren );
+    EXPECT_EQ( 1u, assembly->mChildren[ 0 ]->mNumMeshes );
+}
+
+TEST_F( ut3DXMLImportExport, importFilteredByIdTest ) {
+    Assimp::Importer importer;
+    importer.SetPropertyString( AI_CONFIG_IMPORT_3DXML_FILTER, "2" );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/3DXML/instances.3dxml", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    // The whole subtree of the selected reference is loaded
+    EXPECT_EQ( 2u, scene->mNumMeshes );
+
+    const aiNode *assembly = scene->mRootNode->FindNode( "Assembly.2" );
+    ASSERT_NE( nullptr, assembly );
+    EXPECT_EQ( 1u, assembly->mNumMeshes );
+    ASSERT_EQ( 1u, assembly->mNumChildren );
+    EXPECT_EQ( 1u, assembly->mChildren[ 0 ]->mNumMeshes );
+}
+
+TEST_F( ut3DXMLImportExport, importFilteredNothingTest ) {
+    Assimp::Importer importer;
+    importer.SetPropertyString( AI_CONFIG_IMPORT_3DXML_FILTER, "Unknown" );
+    const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/3DXML/instances.3dxml", aiProcess_ValidateDataStructure );
+    ASSERT_NE( nullptr, scene );
+
+    EXPECT_EQ( 0u, scene->mNumMeshes );
+    EXPECT_NE( 0u, scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE );
+    EXPECT_NE( nullptr, scene->mRootNode->FindNode( "Part.1" ) );
+}
@@ -42,9 +42,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "UnitTestPCH.h"
 #include "AbstractImportExportBase.h"
+#include "ReferenceExport.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
+#include <assimp/Exporter.hpp>
 
 using namespace Assimp;
 
@@ -73,3 +75,16 @@ public:
 TEST_F(utColladaZaeImportExport, importBlenFromFileTest) {
     EXPECT_TRUE(importerTest());
 }
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+TEST_F(utColladaImportExport, exportMatchesReference) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/concave_polygon.obj", 0);
+    ASSERT_NE(nullptr, scene);
+
+    Assimp::Exporter exporter;
+    ExpectMatchesReferenceExport(exporter.ExportToBlob(scene, "collada"), "concave_polygon.dae");
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractImportExportBase.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/Exporter.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/material.h>
 #include <assimp/scene.h>
@@ -196,6 +197,35 @@ TEST_F(utFBXImporterExporter, importCloseToIdentityTransforms) {
     ASSERT_TRUE(scene);
 }
 
+TEST_F(utFBXImporterExporter, importAnimationWithLayers) {
+    Assimp::Importer importer;
+    // Four nodes whose rotation, translation and scaling curves have different key times, partly
+    // spread over two animation layers. node3 has a rotation pivot and gets one channel per component.
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/animation_with_layers.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumAnimations);
+    const aiAnimation *anim = scene->mAnimations[0];
+    ASSERT_EQ(5u, anim->mNumChannels);
+
+    // number of distinct key times over all curves of the node
+    const char *names[] = { "node0", "node1", "node2", "node3_$AssimpFbx$_Translation", "node3_$AssimpFbx$_Rotation" };
+    const unsigned int numPositionKeys[] = { 22, 16, 17, 11, 1 };
+    const unsigned int numRotationKeys[] = { 22, 16, 17, 1, 11 };
+    for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+        const aiNodeAnim *channel = anim->mChannels[c];
+        EXPECT_STREQ(names[c], channel->mNodeName.C_Str());
+        EXPECT_EQ(numPositionKeys[c], channel->mNumPositionKeys);
+        EXPECT_EQ(numRotationKeys[c], channel->mNumRotationKeys);
+        for (unsigned int k = 1; k < channel->mNumPositionKeys; ++k) {
+            EXPECT_LT(channel->mPositionKeys[k - 1].mTime, channel->mPositionKeys[k].mTime);
+        }
+        for (unsigned int k = 1; k < channel->mNumRotationKeys; ++k) {
+            EXPECT_LT(channel->mRotationKeys[k - 1].mTime, channel->mRotationKeys[k].mTime);
+        }
+    }
+    EXPECT_DOUBLE_EQ(8.8, anim->mDuration);
+}
+
 TEST_F( utFBXImporterExporter, importPhongMaterial ) {
     Assimp::Importer importer;
     const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/FBX/phong_cube.fbx", aiProcess_ValidateDataStructure );
@@ -282,3 +312,40 @@ TEST_F(utFBXImporterExporter, fbxTokenizeTestTest) {
     //const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/transparentTest2.fbx", aiProcess_ValidateDataStructure);
     //EXPECT_NE(nullptr, scene);
 }
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+TEST_F(utFBXImporterExporter, exportCompressedArrays) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/WusonOBJ.obj", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    Assimp::ExportProperties raw;
+    raw.SetPropertyInteger(AI_CONFIG_EXPORT_FBX_COMPRESSION_THRESHOLD, 0);
+    Assimp::Exporter rawExporter;
+    const aiExportDataBlob *rawBlob = rawExporter.ExportToBlob(scene, "fbx", 0, &raw);
+    ASSERT_NE(nullptr, rawBlob);
+
+    Assimp::Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "fbx");
+    ASSERT_NE(nullptr, blob);
+    EXPECT_LT(blob->size, rawBlob->size);
+
+    // both files must describe the same geometry
+    Assimp::Importer rawImporter, compressedImporter;
+    const aiScene *rawScene = rawImporter.ReadFileFromMemory(rawBlob->data, rawBlob->size, aiProcess_ValidateDataStructure, "fbx");
+    const aiScene *compressedScene = compressedImporter.ReadFileFromMemory(blob->data, blob->size, aiProcess_ValidateDataStructure, "fbx");
+    ASSERT_NE(nullptr, rawScene);
+    ASSERT_NE(nullptr, compressedScene);
+    ASSERT_EQ(rawScene->mNumMeshes, compressedScene->mNumMeshes);
+    for (unsigned int i = 0; i < rawScene->mNumMeshes; ++i) {
+        const aiMesh *a = rawScene->mMeshes[i], *b = compressedScene->mMeshes[i];
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+        for (unsigned int v = 0; v < a->mNumVertices; ++v) {
+            EXPECT_EQ(a->mVertices[v], b->mVertices[v]);
+        }
+    }
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -0,0 +1,278 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include "PostProcessing/GenLODsProcess.h"
+#include "PostProcessing/OptimizeMeshes.h"
+#include "PostProcessing/SortByPTypeProcess.h"
+#include "PostProcessing/ValidateDataStructure.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/mesh.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utGenLODsProcess : public ::testing::Test {
+protected:
+    // Checks that the flat grid still covers its area without flipped triangles
+    static void ExpectCoversGrid(const aiMesh* lod, unsigned int size) {
+        ai_real area = 0;
+        for (unsigned int f = 0; f < lod->mNumFaces; ++f) {
+            const aiFace& face = lod->mFaces[f];
+            ASSERT_EQ(3u, face.mNumIndices);
+            const aiVector3D& p0 = lod->mVertices[face.mIndices[0]];
+            const aiVector3D normal = (lod->mVertices[face.mIndices[1]] - p0) ^ (lod->mVertices[face.mIndices[2]] - p0);
+            EXPECT_LT(0, normal.z);
+            area += normal.z / 2;
+        }
+        EXPECT_NEAR((ai_real)(size * size), area, 1e-3);
+    }
+};
+
+TEST_F(utGenLODsProcess, lodChainOnGrid) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createGridMesh(30));
+    GenLODsProcess process;
+    process.SetLODs(3, 0.5f);
+    const std::vector<aiMesh*> lods = process.GenerateLODs(mesh.get());
+    ASSERT_EQ(3u, lods.size());
+
+    unsigned int target = mesh->mNumFaces;
+    for (aiMesh* lod : lods) {
+        std::unique_ptr<aiMesh> guard(lod);
+        target /= 2;
+        EXPECT_LE(lod->mNumFaces, target);
+        EXPECT_GE(lod->mNumFaces, target * 3 / 4);
+        ExpectCoversGrid(lod, 30);
+
+        // vertices are removed but never moved
+        for (unsigned int v = 0; v < lod->mNumVertices; ++v) {
+            const aiVector3D& pos = lod->mVertices[v];
+            EXPECT_EQ(pos.x, std::floor(pos.x));
+            EXPECT_EQ(pos.y, std::floor(pos.y));
+            EXPECT_EQ(0, pos.z);
+        }
+    }
+}
+
+TEST_F(utGenLODsProcess, uvSeamIsKept) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createGridMesh(20, 10));
+    GenLODsProcess process;
+    process.SetLODs(2, 0.25f);
+    const std::vector<aiMesh*> lods = process.GenerateLODs(mesh.get());
+    ASSERT_EQ(2u, lods.size());
+
+    for (aiMesh* lod : lods) {
+        std::unique_ptr<aiMesh> guard(lod);
+        ASSERT_TRUE(lod->HasTextureCoords(0));
+        EXPECT_EQ(2u, lod->mNumUVComponents[0]);
+        ExpectCoversGrid(lod, 20);
+
+        // no triangle crosses the seam or mixes the texture coordinates of both sides
+        for (unsigned int f = 0; f < lod->mNumFaces; ++f) {
+            const aiFace& face = lod->mFaces[f];
+            const ai_real u = lod->mTextureCoords[0][face.mIndices[0]].x;
+            for (unsigned int k = 0; k < 3; ++k) {
+                const unsigned int v = face.mIndices[k];
+                EXPECT_EQ(u, lod->mTextureCoords[0][v].x);
+                EXPECT_TRUE(u > 0 ? lod->mVertices[v].x >= 10 : lod->mVertices[v].x <= 10);
+            }
+        }
+    }
+}
+
+TEST_F(utGenLODsProcess, boneWeightsFollowVertices) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createGridMesh(20));
+    mesh->mNumBones = 1;
+    mesh->mBones = new aiBone*[1];
+    aiBone* bone = mesh->mBones[0] = new aiBone();
+    bone->mName.Set("bone");
+    bone->mNumWeights = mesh->mNumVertices;
+    bone->mWeights = new aiVertexWeight[mesh->mNumVertices];
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        bone->mWeights[v] = aiVertexWeight(v, (mesh->mVertices[v].x + 1) / 32.f);
+    }
+
+    GenLODsProcess process;
+    process.SetLODs(1, 0.5f);
+    const std::vector<aiMesh*> lods = process.GenerateLODs(mesh.get());
+    ASSERT_EQ(1u, lods.size());
+    std::unique_ptr<aiMesh> lod(lods[0]);
+
+    ASSERT_EQ(1u, lod->mNumBones);
+    const aiBone* lodBone = lod->mBones[0];
+    EXPECT_STREQ("bone", lodBone->mName.C_Str());
+    ASSERT_EQ(lod->mNumVertices, lodBone->mNumWeights);
+    for (unsigned int w = 0; w < lodBone->mNumWeights; ++w) {
+        const aiVertexWeight& weight = lodBone->mWeights[w];
+        ASSERT_LT(weight.mVertexId, lod->mNumVertices);
+        EXPECT_FLOAT_EQ((lod->mVertices[weight.mVertexId].x + 1) / 32.f, weight.mWeight);
+    }
+}
+
+TEST_F(utGenLODsProcess, nonTriangleMeshesAreSkipped) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createGridMesh(4));
+    mesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
+    GenLODsProcess process;
+    EXPECT_TRUE(process.GenerateLODs(mesh.get()).empty());
+}
+
+TEST_F(utGenLODsProcess, importWithLODs) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, aiProcessExt_GenLODs);
+    importer.SetPropertyInteger(AI_CONFIG_PP_GL_NUM_LODS, 2);
+    const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType);
+    ASSERT_NE(nullptr, scene);
+
+    // the LODs are appended behind the meshes they were generated from
+    std::vector<char> isLOD(scene->mNumMeshes, 0);
+    unsigned int numLODs = 0;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh* mesh = scene->mMeshes[i];
+        unsigned int previous = mesh->mNumFaces;
+        for (unsigned int l = 0; l < mesh->mNumLODs; ++l) {
+            ASSERT_LT(i, mesh->mLODs[l]);
+            ASSERT_LT(mesh->mLODs[l], scene->mNumMeshes);
+            const aiMesh* lod = scene->mMeshes[mesh->mLODs[l]];
+            EXPECT_LT(lod->mNumFaces, previous);
+            EXPECT_EQ(mesh->mMaterialIndex, lod->mMaterialIndex);
+            previous = lod->mNumFaces;
+            isLOD[mesh->mLODs[l]] = 1;
+            ++numLODs;
+        }
+    }
+    EXPECT_LT(0u, numLODs);
+
+    // which are not referenced by the node graph
+    std::vector<const aiNode*> nodes(1, scene->mRootNode);
+    while (!nodes.empty()) {
+        const aiNode* node = nodes.back();
+        nodes.pop_back();
+        for (unsigned int m = 0; m < node->mNumMeshes; ++m) {
+            EXPECT_FALSE(isLOD[node->mMeshes[m]]);
+        }
+        nodes.insert(nodes.end(), node->mChildren, node->mChildren + node->mNumChildren);
+    }
+
+    // the LODs pass the validation
+    EXPECT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_ValidateDataStructure));
+}
+
+TEST_F(utGenLODsProcess, lodsSurviveMeshReordering) {
+    // an instanced mesh with lines and triangles, which SortByPType splits, and two
+    // grids with the same material in one node, which OptimizeMeshes could join
+    aiScene scene;
+    scene.mNumMaterials = 1;
+    scene.mMaterials = new aiMaterial*[1] { new aiMaterial() };
+    scene.mNumMeshes = 3;
+    scene.mMeshes = new aiMesh*[3];
+    aiMesh* mixed = scene.mMeshes[0] = TestModelFactory::createGridMesh(2);
+    mixed->mFaces[0].mNumIndices = 2;
+    mixed->mPrimitiveTypes |= aiPrimitiveType_LINE;
+    scene.mMeshes[1] = TestModelFactory::createGridMesh(20);
+    aiMesh* shifted = scene.mMeshes[2] = TestModelFactory::createGridMesh(30);
+    for (unsigned int i = 0; i < shifted->mNumVertices; ++i) {
+        shifted->mVertices[i].x += 100;
+    }
+
+    scene.mRootNode = new aiNode("root");
+    scene.mRootNode->mNumMeshes = 2;
+    scene.mRootNode->mMeshes = new unsigned int[2] { 1, 2 };
+    scene.mRootNode->mNumChildren = 2;
+    scene.mRootNode->mChildren = new aiNode*[2] { new aiNode("a"), new aiNode("b") };
+    for (unsigned int c = 0; c < 2; ++c) {
+        scene.mRootNode->mChildren[c]->mParent = scene.mRootNode;
+        scene.mRootNode->mChildren[c]->mNumMeshes = 1;
+        scene.mRootNode->mChildren[c]->mMeshes = new unsigned int[1] { 0 };
+    }
+
+    GenLODsProcess genLODs;
+    genLODs.SetLODs(2, 0.5f);
+    genLODs.Execute(&scene);
+    ASSERT_EQ(2u, scene.mMeshes[1]->mNumLODs);
+    ASSERT_EQ(2u, scene.mMeshes[2]->mNumLODs);
+
+    OptimizeMeshesProcess optimizeMeshes;
+    ASSERT_TRUE(optimizeMeshes.IsActive(aiProcess_OptimizeMeshes | aiProcess_SortByPType));
+    optimizeMeshes.Execute(&scene);
+    SortByPTypeProcess sortByPType;
+    sortByPType.Execute(&scene);
+    ValidateDSProcess validate;
+    EXPECT_NO_THROW(validate.Execute(&scene));
+
+    // both grids keep their LODs, which still lie within them
+    unsigned int numBases = 0;
+    for (unsigned int i = 0; i < scene.mNumMeshes; ++i) {
+        const aiMesh* mesh = scene.mMeshes[i];
+        if (!mesh->mNumLODs) {
+            continue;
+        }
+        ++numBases;
+        EXPECT_EQ(2u, mesh->mNumLODs);
+
+        ai_real minX = mesh->mVertices[0].x, maxX = mesh->mVertices[0].x;
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            minX = std::min(minX, mesh->mVertices[v].x);
+            maxX = std::max(maxX, mesh->mVertices[v].x);
+        }
+        unsigned int previous = mesh->mNumFaces;
+        for (unsigned int l = 0; l < mesh->mNumLODs; ++l) {
+            ASSERT_LT(mesh->mLODs[l], scene.mNumMeshes);
+            const aiMesh* lod = scene.mMeshes[mesh->mLODs[l]];
+            EXPECT_EQ(0u, lod->mNumLODs);
+            EXPECT_LT(lod->mNumFaces, previous);
+            previous = lod->mNumFaces;
+            for (unsigned int v = 0; v < lod->mNumVertices; ++v) {
+                EXPECT_LE(minX, lod->mVertices[v].x);
+                EXPECT_GE(maxX, lod->mVertices[v].x);
+            }
+        }
+    }
+    EXPECT_EQ(2u, numBases);
+}
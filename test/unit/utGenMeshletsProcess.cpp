@@ -0,0 +1,287 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include "PostProcessing/GenMeshletsProcess.h"
+#include "PostProcessing/MakeVerboseFormat.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/mesh.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utGenMeshletsProcess : public ::testing::Test {
+protected:
+    // Checks that the level 0 meshlets cover every face exactly once, with the same winding
+    static void ExpectFacesCovered(const aiMesh* mesh) {
+        typedef std::array<unsigned int, 3> Triangle;
+        auto canonical = [](unsigned int a, unsigned int b, unsigned int c) {
+            // rotate the smallest index to the front, which keeps the winding
+            Triangle t = { { a, b, c } };
+            std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+            return t;
+        };
+
+        std::vector<Triangle> faces, covered;
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            const unsigned int* idx = mesh->mFaces[f].mIndices;
+            faces.push_back(canonical(idx[0], idx[1], idx[2]));
+        }
+        for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+            const aiMeshlet& meshlet = mesh->mMeshlets[m];
+            if (0 != meshlet.mLevel) {
+                continue;
+            }
+            const unsigned int* vertices = mesh->mMeshletVertices + meshlet.mVertexOffset;
+            const unsigned char* triangles = mesh->mMeshletTriangles + meshlet.mTriangleOffset;
+            for (unsigned int t = 0; t < meshlet.mTriangleCount; ++t) {
+                covered.push_back(canonical(vertices[triangles[t * 3]], vertices[triangles[t * 3 + 1]],
+                    vertices[triangles[t * 3 + 2]]));
+            }
+        }
+        std::sort(faces.begin(), faces.end());
+        std::sort(covered.begin(), covered.end());
+        EXPECT_TRUE(faces == covered);
+    }
+
+    // The meshlets a renderer draws for an error threshold, and the area of their projection
+    // onto the xy plane. Overlaps and cracks between the meshlets change the area.
+    static double GetCutArea(const aiMesh* mesh, ai_real threshold, unsigned int& numTriangles) {
+        double area = 0;
+        numTriangles = 0;
+        for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+            const aiMeshlet& meshlet = mesh->mMeshlets[m];
+            if (meshlet.mError > threshold || (meshlet.mParentError >= 0 && meshlet.mParentError <= threshold)) {
+                continue;
+            }
+            const unsigned int* vertices = mesh->mMeshletVertices + meshlet.mVertexOffset;
+            const unsigned char* triangles = mesh->mMeshletTriangles + meshlet.mTriangleOffset;
+            for (unsigned int t = 0; t < meshlet.mTriangleCount; ++t) {
+                const aiVector3D& a = mesh->mVertices[vertices[triangles[t * 3]]];
+                const aiVector3D& b = mesh->mVertices[vertices[triangles[t * 3 + 1]]];
+                const aiVector3D& c = mesh->mVertices[vertices[triangles[t * 3 + 2]]];
+                area += 0.5 * ((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y));
+            }
+            numTriangles += meshlet.mTriangleCount;
+        }
+        return area;
+    }
+};
+
+TEST_F(utGenMeshletsProcess, meshletsCoverAllFacesWithinLimits) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createGridMesh(50));
+    GenMeshletsProcess process;
+    process.SetLimits(64, 124);
+    ASSERT_TRUE(process.GenerateMeshlets(mesh.get()));
+
+    ASSERT_LT(1u, mesh->mNumMeshlets);
+    for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+        const aiMeshlet& meshlet = mesh->mMeshlets[m];
+        EXPECT_LE(meshlet.mVertexCount, 64u);
+        EXPECT_LE(meshlet.mTriangleCount, 124u);
+        EXPECT_LT(0u, meshlet.mTriangleCount);
+    }
+    ExpectFacesCovered(mesh.get());
+
+    // the meshlets are compact, a grid patch of 64 vertices holds about 90 triangles
+    EXPECT_LT(mesh->mNumMeshlets, 2 * mesh->mNumFaces / 90);
+}
+
+TEST_F(utGenMeshletsProcess, boundsAndNormalCones) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createGridMesh(20));
+    GenMeshletsProcess process;
+    ASSERT_TRUE(process.GenerateMeshlets(mesh.get()));
+
+    for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+        const aiMeshlet& meshlet = mesh->mMeshlets[m];
+        for (unsigned int v = 0; v < meshlet.mVertexCount; ++v) {
+            const aiVector3D& pos = mesh->mVertices[mesh->mMeshletVertices[meshlet.mVertexOffset + v]];
+            EXPECT_LE((pos - meshlet.mCenter).Length(), meshlet.mRadius * 1.0001f);
+        }
+
+        // the grid is flat and faces +z
+        EXPECT_FLOAT_EQ(1.f, meshlet.mConeAxis.z);
+        EXPECT_NEAR(1.f, meshlet.mConeCutoff, 1e-5f);
+    }
+}
+
+TEST_F(utGenMeshletsProcess, regenerationReplacesMeshlets) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createGridMesh(20));
+    GenMeshletsProcess process;
+    process.SetLimits(64, 124);
+    ASSERT_TRUE(process.GenerateMeshlets(mesh.get()));
+    const unsigned int numLarge = mesh->mNumMeshlets;
+
+    process.SetLimits(16, 16);
+    ASSERT_TRUE(process.GenerateMeshlets(mesh.get()));
+    EXPECT_LT(numLarge, mesh->mNumMeshlets);
+    ExpectFacesCovered(mesh.get());
+}
+
+TEST_F(utGenMeshletsProcess, clusterLODHierarchy) {
+    // a height field with a UV seam
+    const unsigned int size = 40;
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createGridMesh(size, size / 2));
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        aiVector3D& pos = mesh->mVertices[i];
+        pos.z = static_cast<ai_real>(0.3 * std::sin(pos.x * 0.7) * std::cos(pos.y * 0.5));
+    }
+    GenMeshletsProcess process;
+    process.SetLimits(64, 124);
+    process.SetClusterLOD(true);
+    ASSERT_TRUE(process.GenerateMeshlets(mesh.get()));
+    ExpectFacesCovered(mesh.get());
+
+    std::vector<ai_real> errors(1, 0);
+    unsigned int maxLevel = 0;
+    for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+        const aiMeshlet& meshlet = mesh->mMeshlets[m];
+        EXPECT_LE(meshlet.mVertexCount, 64u);
+        EXPECT_LE(meshlet.mTriangleCount, 124u);
+        EXPECT_TRUE(meshlet.mParentError < 0 || meshlet.mParentError >= meshlet.mError);
+        EXPECT_LE(meshlet.mRadius, meshlet.mErrorRadius * 1.0001f);
+        maxLevel = std::max(maxLevel, meshlet.mLevel);
+        errors.push_back(meshlet.mError);
+        errors.push_back(meshlet.mParentError);
+    }
+    EXPECT_LT(1u, maxLevel);
+
+    // every threshold selects a crack free cut through the hierarchy
+    unsigned int numFinest = 0, numCoarsest = UINT_MAX;
+    for (const ai_real threshold : errors) {
+        if (threshold < 0) {
+            continue;
+        }
+        unsigned int numTriangles = 0;
+        EXPECT_NEAR(size * size, GetCutArea(mesh.get(), threshold, numTriangles), 1e-3);
+        numFinest = 0 == threshold ? numTriangles : numFinest;
+        numCoarsest = std::min(numCoarsest, numTriangles);
+    }
+    EXPECT_EQ(mesh->mNumFaces, numFinest);
+    EXPECT_LT(numCoarsest * 4, numFinest);
+}
+
+TEST_F(utGenMeshletsProcess, meshletsFollowVerboseVertices) {
+    std::unique_ptr<aiScene> scene(new aiScene());
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1];
+    aiMesh* mesh = scene->mMeshes[0] = TestModelFactory::createGridMesh(20, 10);
+    GenMeshletsProcess process;
+    process.SetLimits(64, 124);
+    process.SetClusterLOD(true);
+    ASSERT_TRUE(process.GenerateMeshlets(mesh));
+
+    std::vector<aiVector3D> positions, uvs;
+    for (unsigned int i = 0; i < mesh->mNumMeshletVertices; ++i) {
+        positions.push_back(mesh->mVertices[mesh->mMeshletVertices[i]]);
+        uvs.push_back(mesh->mTextureCoords[0][mesh->mMeshletVertices[i]]);
+    }
+
+    MakeVerboseFormatProcess verbose;
+    verbose.Execute(scene.get());
+    ASSERT_EQ(mesh->mNumFaces * 3, mesh->mNumVertices);
+
+    // the meshlet vertices refer to copies of the same vertices
+    ASSERT_EQ(positions.size(), mesh->mNumMeshletVertices);
+    for (unsigned int i = 0; i < mesh->mNumMeshletVertices; ++i) {
+        ASSERT_LT(mesh->mMeshletVertices[i], mesh->mNumVertices);
+        EXPECT_EQ(positions[i], mesh->mVertices[mesh->mMeshletVertices[i]]);
+        EXPECT_EQ(uvs[i], mesh->mTextureCoords[0][mesh->mMeshletVertices[i]]);
+    }
+}
+
+TEST_F(utGenMeshletsProcess, nonTriangleMeshesAreSkipped) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createGridMesh(2));
+    mesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
+    GenMeshletsProcess process;
+    EXPECT_FALSE(process.GenerateMeshlets(mesh.get()));
+    EXPECT_EQ(0u, mesh->mNumMeshlets);
+    EXPECT_EQ(nullptr, mesh->mMeshlets);
+}
+
+TEST_F(utGenMeshletsProcess, importWithMeshlets) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES, 32);
+    const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType |
+        aiProcess_ImproveCacheLocality | aiProcess_GenMeshlets);
+    ASSERT_NE(nullptr, scene);
+
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh* mesh = scene->mMeshes[i];
+        EXPECT_LT(0u, mesh->mNumMeshlets);
+        for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+            EXPECT_LE(mesh->mMeshlets[m].mVertexCount, 32u);
+        }
+        ExpectFacesCovered(mesh);
+    }
+
+    // the meshlets pass the validation
+    EXPECT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_ValidateDataStructure));
+}
+
+TEST_F(utGenMeshletsProcess, importWithClusterLOD) {
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_GM_CLUSTER_LOD, true);
+    const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj",
+        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType | aiProcess_GenMeshlets);
+    ASSERT_NE(nullptr, scene);
+
+    unsigned int maxLevel = 0;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh* mesh = scene->mMeshes[i];
+        for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+            maxLevel = std::max(maxLevel, mesh->mMeshlets[m].mLevel);
+        }
+        ExpectFacesCovered(mesh);
+    }
+    EXPECT_LT(0u, maxLevel);
+    EXPECT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_ValidateDataStructure));
+}
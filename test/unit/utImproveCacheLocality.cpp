@@ -41,4 +41,269 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 
-#include "UnitTestPCH.h"
\ No newline at end of file
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/ImproveCacheLocality.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <string>
+
+using namespace Assimp;
+
+class ImproveCacheLocalityTest : public ::testing::Test {
+public:
+    ImproveCacheLocalityTest()
+    : Test()
+    , mScene( nullptr )
+    , mProcess( nullptr ) {
+        // empty
+    }
+
+protected:
+    virtual void SetUp();
+    virtual void TearDown();
+
+    static aiMesh* makeShuffledGrid(unsigned int gridSize);
+
+    void run();
+    unsigned int countCacheMisses() const;
+    std::multiset<std::set<aiVector3D>> collectTriangles() const;
+
+protected:
+    static const unsigned int GridSize = 40;
+
+    Importer mImporter;
+    aiScene* mScene;
+    ImproveCacheLocalityProcess* mProcess;
+};
+
+aiMesh* ImproveCacheLocalityTest::makeShuffledGrid(unsigned int gridSize) {
+    // a regular grid with its triangles in random order
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = (gridSize + 1) * (gridSize + 1);
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+    mesh->mNumUVComponents[0] = 2;
+    for (unsigned int y = 0; y <= gridSize; ++y) {
+        for (unsigned int x = 0; x <= gridSize; ++x) {
+            const unsigned int i = y * (gridSize + 1) + x;
+            mesh->mVertices[i] = aiVector3D((ai_real)x, (ai_real)y, 0.0);
+            mesh->mTextureCoords[0][i] = aiVector3D((ai_real)x, (ai_real)y, 0.0);
+        }
+    }
+
+    std::vector<unsigned int> order(gridSize * gridSize * 2);
+    for (unsigned int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    unsigned int seed = 42;
+    for (size_t i = order.size() - 1; i > 0; --i) {
+        seed = seed * 1103515245 + 12345;
+        std::swap(order[i], order[(seed >> 8) % (i + 1)]);
+    }
+
+    mesh->mNumFaces = static_cast<unsigned int>(order.size());
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        const unsigned int quad = order[i] / 2, x = quad % gridSize, y = quad / gridSize;
+        const unsigned int i0 = y * (gridSize + 1) + x, i1 = i0 + 1, i2 = i0 + gridSize + 1, i3 = i2 + 1;
+        aiFace& face = mesh->mFaces[i];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        if (order[i] % 2) {
+            face.mIndices[0] = i0; face.mIndices[1] = i1; face.mIndices[2] = i3;
+        } else {
+            face.mIndices[0] = i0; face.mIndices[1] = i3; face.mIndices[2] = i2;
+        }
+    }
+
+    // a bone to check the vertex remapping
+    mesh->mNumBones = 1;
+    mesh->mBones = new aiBone*[1];
+    aiBone* bone = mesh->mBones[0] = new aiBone();
+    bone->mNumWeights = mesh->mNumVertices;
+    bone->mWeights = new aiVertexWeight[mesh->mNumVertices];
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        bone->mWeights[i] = aiVertexWeight(i, (float)i);
+    }
+    return mesh;
+}
+
+void ImproveCacheLocalityTest::SetUp() {
+    mProcess = new ImproveCacheLocalityProcess();
+    mScene = new aiScene();
+    mScene->mNumMeshes = 1;
+    mScene->mMeshes = new aiMesh*[1];
+    mScene->mMeshes[0] = makeShuffledGrid(GridSize);
+}
+
+void ImproveCacheLocalityTest::TearDown() {
+    delete mScene;
+    delete mProcess;
+}
+
+void ImproveCacheLocalityTest::run() {
+    mProcess->SetupProperties(&mImporter);
+    mProcess->Execute(mScene);
+}
+
+unsigned int ImproveCacheLocalityTest::countCacheMisses() const {
+    const aiMesh* mesh = mScene->mMeshes[0];
+    std::vector<unsigned int> cache;
+    unsigned int misses = 0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        for (unsigned int a = 0; a < 3; ++a) {
+            const unsigned int idx = mesh->mFaces[i].mIndices[a];
+            if (std::find(cache.begin(), cache.end(), idx) == cache.end()) {
+                ++misses;
+                cache.push_back(idx);
+                if (cache.size() > PP_ICL_PTCACHE_SIZE) {
+                    cache.erase(cache.begin());
+                }
+            }
+        }
+    }
+    return misses;
+}
+
+std::multiset<std::set<aiVector3D>> ImproveCacheLocalityTest::collectTriangles() const {
+    const aiMesh* mesh = mScene->mMeshes[0];
+    std::multiset<std::set<aiVector3D>> tris;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        std::set<aiVector3D> tri;
+        for (unsigned int a = 0; a < 3; ++a) {
+            tri.insert(mesh->mVertices[mesh->mFaces[i].mIndices[a]]);
+        }
+        tris.insert(tri);
+    }
+    return tris;
+}
+
+TEST_F(ImproveCacheLocalityTest, tipsifyReducesCacheMisses) {
+    const unsigned int missesIn = countCacheMisses();
+    const auto trisIn = collectTriangles();
+    run();
+    EXPECT_LT(countCacheMisses(), missesIn / 2);
+    EXPECT_EQ(trisIn, collectTriangles());
+}
+
+TEST_F(ImproveCacheLocalityTest, forsythReducesCacheMisses) {
+    mImporter.SetPropertyInteger(AI_CONFIG_PP_ICL_METHOD, PP_ICL_METHOD_FORSYTH);
+    const unsigned int missesIn = countCacheMisses();
+    const auto trisIn = collectTriangles();
+    run();
+    EXPECT_LT(countCacheMisses(), missesIn / 2);
+    EXPECT_EQ(trisIn, collectTriangles());
+}
+
+TEST_F(ImproveCacheLocalityTest, scatteredSharedVerticesAreOptimized) {
+    // a strip of quads whose triangles are ordered so that no vertex is used again while it
+    // is still in the cache. Every index is a cache miss, although the vertices are shared.
+    const unsigned int numQuads = 100;
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 2 * (numQuads + 1);
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    for (unsigned int i = 0; i <= numQuads; ++i) {
+        mesh->mVertices[2 * i] = aiVector3D((ai_real)i, 0.0, 0.0);
+        mesh->mVertices[2 * i + 1] = aiVector3D((ai_real)i, 1.0, 0.0);
+    }
+    mesh->mNumFaces = 2 * numQuads;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    unsigned int f = 0;
+    for (unsigned int odd = 0; odd < 2; ++odd) {
+        for (unsigned int upper = 0; upper < 2; ++upper) {
+            for (unsigned int q = odd; q < numQuads; q += 2) {
+                aiFace& face = mesh->mFaces[f++];
+                face.mNumIndices = 3;
+                face.mIndices = new unsigned int[3];
+                face.mIndices[0] = 2 * q;
+                face.mIndices[1] = upper ? 2 * q + 3 : 2 * q + 2;
+                face.mIndices[2] = upper ? 2 * q + 1 : 2 * q + 3;
+            }
+        }
+    }
+    delete mScene->mMeshes[0];
+    mScene->mMeshes[0] = mesh;
+
+    ASSERT_EQ(3 * mesh->mNumFaces, countCacheMisses());
+    const auto trisIn = collectTriangles();
+    run();
+    EXPECT_LT(countCacheMisses(), 3 * mesh->mNumFaces / 2);
+    EXPECT_EQ(trisIn, collectTriangles());
+}
+
+TEST_F(ImproveCacheLocalityTest, overdrawSortingKeepsTriangles) {
+    mImporter.SetPropertyBool(AI_CONFIG_PP_ICL_OPTIMIZE_OVERDRAW, true);
+    const auto trisIn = collectTriangles();
+    run();
+    EXPECT_EQ(trisIn, collectTriangles());
+}
+
+TEST_F(ImproveCacheLocalityTest, vertexFetchFollowsFirstUse) {
+    mImporter.SetPropertyBool(AI_CONFIG_PP_ICL_OPTIMIZE_VERTEX_FETCH, true);
+    const auto trisIn = collectTriangles();
+    run();
+    EXPECT_EQ(trisIn, collectTriangles());
+
+    // every vertex is either known or the next one in the buffer
+    const aiMesh* mesh = mScene->mMeshes[0];
+    unsigned int next = 0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        for (unsigned int a = 0; a < 3; ++a) {
+            const unsigned int idx = mesh->mFaces[i].mIndices[a];
+            ASSERT_LE(idx, next);
+            if (idx == next) {
+                ++next;
+            }
+        }
+    }
+
+    // the other vertex streams and the bone weights moved along
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_EQ(mesh->mVertices[i], mesh->mTextureCoords[0][i]);
+        const aiVertexWeight& w = mesh->mBones[0]->mWeights[i];
+        const aiVector3D& v = mesh->mVertices[w.mVertexId];
+        EXPECT_EQ(v.y * (GridSize + 1) + v.x, w.mWeight);
+    }
+}
+
+TEST_F(ImproveCacheLocalityTest, benchmarkMethods) {
+    struct Config {
+        const char* name;
+        int method;
+        bool optimizeVertexFetch;
+    };
+    const Config configs[] = {
+        { "tipsify", PP_ICL_METHOD_TIPSIFY, false },
+        { "forsyth", PP_ICL_METHOD_FORSYTH, false },
+        { "tipsifyVertexFetch", PP_ICL_METHOD_TIPSIFY, true },
+        { "forsythVertexFetch", PP_ICL_METHOD_FORSYTH, true }
+    };
+
+    // 180k triangles in random order
+    for (const Config& config : configs) {
+        delete mScene->mMeshes[0];
+        mScene->mMeshes[0] = makeShuffledGrid(300);
+        mImporter.SetPropertyInteger(AI_CONFIG_PP_ICL_METHOD, config.method);
+        mImporter.SetPropertyBool(AI_CONFIG_PP_ICL_OPTIMIZE_VERTEX_FETCH, config.optimizeVertexFetch);
+
+        const unsigned int numFaces = mScene->mMeshes[0]->mNumFaces;
+        const unsigned int missesIn = countCacheMisses();
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        run();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const unsigned int missesOut = countCacheMisses();
+
+        EXPECT_LT(missesOut, missesIn / 2);
+        const std::string name(config.name);
+        RecordProperty(name + "Ms", std::to_string(ms));
+        RecordProperty(name + "AcmrIn", std::to_string(missesIn / (double)numFaces));
+        RecordProperty(name + "AcmrOut", std::to_string(missesOut / (double)numFaces));
+    }
+}
@@ -59,7 +59,7 @@ class utIssues : public ::testing::Test {
 
 TEST_F( utIssues, OpacityBugWhenExporting_727 ) {
     float opacity;
-    aiScene *scene( TestModelFacttory::createDefaultTestModel( opacity ) );
+    aiScene *scene( TestModelFactory::createDefaultTestModel( opacity ) );
     Assimp::Importer importer;
     Assimp::Exporter exporter;
                 
@@ -140,3 +140,67 @@ TEST_F(MaterialSystemTest, testMaterialNameAccess) {
 
     delete mat;
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testManyPropertiesLookup) {
+    // enough texture slots to exceed the size at which the key index kicks in
+    for (int i = 0; i < 32; ++i) {
+        aiString s;
+        s.Set("tex" + std::to_string(i) + ".png");
+        pcMat->AddProperty(&s, AI_MATKEY_TEXTURE_DIFFUSE(i));
+        pcMat->AddProperty(&i, 1, AI_MATKEY_UVWSRC_DIFFUSE(i));
+    }
+
+    aiString s;
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get(AI_MATKEY_TEXTURE_DIFFUSE(17), s));
+    EXPECT_STREQ("tex17.png", s.data);
+    EXPECT_EQ(32u, pcMat->GetTextureCount(aiTextureType_DIFFUSE));
+    EXPECT_EQ(AI_FAILURE, pcMat->Get(AI_MATKEY_TEXTURE_SPECULAR(0), s));
+
+    // replacing a key must not add a new property
+    const unsigned int numProperties = pcMat->mNumProperties;
+    s.Set("replaced.png");
+    pcMat->AddProperty(&s, AI_MATKEY_TEXTURE_DIFFUSE(17));
+    EXPECT_EQ(numProperties, pcMat->mNumProperties);
+    s.Set("");
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get(AI_MATKEY_TEXTURE_DIFFUSE(17), s));
+    EXPECT_STREQ("replaced.png", s.data);
+
+    // appending and removing keys keeps lookups consistent
+    float f = 2.5f;
+    pcMat->AddProperty(&f, 1, AI_MATKEY_SHININESS);
+    f = 0.0f;
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get(AI_MATKEY_SHININESS, f));
+    EXPECT_EQ(2.5f, f);
+
+    EXPECT_EQ(AI_SUCCESS, pcMat->RemoveProperty(AI_MATKEY_TEXTURE_DIFFUSE(3)));
+    EXPECT_EQ(AI_FAILURE, pcMat->Get(AI_MATKEY_TEXTURE_DIFFUSE(3), s));
+    int uv = -1;
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get(AI_MATKEY_UVWSRC_DIFFUSE(31), uv));
+    EXPECT_EQ(31, uv);
+
+    pcMat->Clear();
+    EXPECT_EQ(AI_FAILURE, pcMat->Get(AI_MATKEY_UVWSRC_DIFFUSE(31), uv));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testManyPropertiesRewrittenInPlace) {
+    for (int i = 0; i < 32; ++i) {
+        pcMat->AddProperty(&i, 1, AI_MATKEY_UVWSRC_DIFFUSE(i));
+    }
+    int uv = -1;
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get(AI_MATKEY_UVWSRC_DIFFUSE(5), uv));
+    EXPECT_EQ(AI_FAILURE, pcMat->Get(AI_MATKEY_UVWSRC_SPECULAR(0), uv));
+
+    // loaders replace properties directly, keeping the array and the number of properties
+    aiMaterial other;
+    const int value = 42;
+    other.AddProperty(&value, 1, AI_MATKEY_UVWSRC_SPECULAR(0));
+    std::swap(pcMat->mProperties[5], other.mProperties[0]);
+
+    EXPECT_EQ(AI_FAILURE, pcMat->Get(AI_MATKEY_UVWSRC_DIFFUSE(5), uv));
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get(AI_MATKEY_UVWSRC_SPECULAR(0), uv));
+    EXPECT_EQ(42, uv);
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get(AI_MATKEY_UVWSRC_DIFFUSE(31), uv));
+    EXPECT_EQ(31, uv);
+}
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 #include "SceneDiffer.h"
 #include "AbstractImportExportBase.h"
+#include "ReferenceExport.h"
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 #include <assimp/Exporter.hpp>
@@ -482,3 +483,19 @@ TEST_F(utObjImportExport, import_with_line_continuations) {
     EXPECT_NEAR(vertices[2].y, 0.5f, threshold);
     EXPECT_NEAR(vertices[2].z, -0.5f, threshold);
 }
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+TEST_F(utObjImportExport, exportMatchesReference) {
+    ::Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/concave_polygon.obj", 0);
+    ASSERT_NE(nullptr, scene);
+
+    ::Assimp::Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "obj");
+    ExpectMatchesReferenceExport(blob, "concave_polygon.obj");
+    ASSERT_NE(nullptr, blob);
+    ExpectMatchesReferenceExport(blob->next, "concave_polygon.mtl");
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
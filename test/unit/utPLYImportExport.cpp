@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exporter.hpp>
 #include <assimp/scene.h>
 #include "AbstractImportExportBase.h"
+#include "ReferenceExport.h"
 #include <assimp/postprocess.h>
 
 using namespace ::Assimp;
@@ -181,3 +182,17 @@ TEST_F( utPLYImportExport, parseErrorTest ) {
     const aiScene *scene = importer.ReadFileFromMemory( test_file, strlen( test_file ), 0);
     EXPECT_NE( nullptr, scene );
 }
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+TEST_F(utPLYImportExport, exportMatchesReference) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/PLY/cube_uv.ply", 0);
+    ASSERT_NE(nullptr, scene);
+
+    Assimp::Exporter exporter;
+    ExpectMatchesReferenceExport(exporter.ExportToBlob(scene, "ply"), "cube_uv.ply");
+    ExpectMatchesReferenceExport(exporter.ExportToBlob(scene, "plyb"), "cube_uv_binary.ply");
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -0,0 +1,204 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include "PostProcessing/MakeVerboseFormat.h"
+#include "PostProcessing/PackBoneWeightsProcess.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utPackBoneWeightsProcess : public ::testing::Test {
+protected:
+    static unsigned int SumWeights(const aiMesh* mesh, unsigned int vertex) {
+        unsigned int sum = 0;
+        for (unsigned int i = 0; i < mesh->mNumBoneInfluences; ++i) {
+            sum += mesh->mPackedBoneWeights[vertex * mesh->mNumBoneInfluences + i];
+        }
+        return sum;
+    }
+};
+
+TEST_F(utPackBoneWeightsProcess, sortsAndQuantizesWeights) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createSkinnedMesh(1, { 1.f, 5.f, 2.f }));
+    PackBoneWeightsProcess process;
+    ASSERT_TRUE(process.PackMesh(mesh.get()));
+    ASSERT_EQ(4u, mesh->mNumBoneInfluences);
+
+    const unsigned short expectedIndices[4] = { 1, 2, 0, 0 };
+    // 159.375, 63.75 and 31.875 after renormalizing, the largest remainders are rounded up
+    const unsigned char expectedWeights[4] = { 159, 64, 32, 0 };
+    for (unsigned int i = 0; i < 4; ++i) {
+        EXPECT_EQ(expectedIndices[i], mesh->mPackedBoneIndices[i]);
+        EXPECT_EQ(expectedWeights[i], mesh->mPackedBoneWeights[i]);
+    }
+    EXPECT_EQ(255u, SumWeights(mesh.get(), 0));
+}
+
+TEST_F(utPackBoneWeightsProcess, keepsHeaviestInfluences) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createSkinnedMesh(1, { 0.05f, 0.3f, 0.1f, 0.05f, 0.3f, 0.2f }));
+    PackBoneWeightsProcess process;
+    ASSERT_TRUE(process.PackMesh(mesh.get()));
+
+    // equal weights keep the bone order, the two lightest bones are dropped
+    const unsigned short expectedIndices[4] = { 1, 4, 5, 2 };
+    for (unsigned int i = 0; i < 4; ++i) {
+        EXPECT_EQ(expectedIndices[i], mesh->mPackedBoneIndices[i]);
+        if (i > 0) {
+            EXPECT_GE(mesh->mPackedBoneWeights[i - 1], mesh->mPackedBoneWeights[i]);
+        }
+    }
+    EXPECT_EQ(255u, SumWeights(mesh.get(), 0));
+
+    // the bones are left untouched
+    ASSERT_EQ(6u, mesh->mNumBones);
+    EXPECT_EQ(1u, mesh->mBones[0]->mNumWeights);
+    EXPECT_FLOAT_EQ(0.05f, mesh->mBones[0]->mWeights[0].mWeight);
+}
+
+TEST_F(utPackBoneWeightsProcess, packsEightInfluences) {
+    std::vector<float> weights;
+    for (unsigned int b = 0; b < 10; ++b) {
+        weights.push_back(1.f);
+    }
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createSkinnedMesh(3, weights));
+    PackBoneWeightsProcess process;
+    process.SetNumInfluences(8);
+    ASSERT_TRUE(process.PackMesh(mesh.get()));
+    ASSERT_EQ(8u, mesh->mNumBoneInfluences);
+
+    // the rounding error goes to the first influences
+    for (unsigned int i = 0; i < 8; ++i) {
+        EXPECT_EQ(i, mesh->mPackedBoneIndices[i]);
+        EXPECT_EQ(i < 7 ? 32 : 31, mesh->mPackedBoneWeights[i]);
+    }
+    EXPECT_EQ(255u, SumWeights(mesh.get(), 0));
+
+    // vertices without bones have no influences
+    for (unsigned int i = 8; i < 3 * 8; ++i) {
+        EXPECT_EQ(0u, mesh->mPackedBoneIndices[i]);
+        EXPECT_EQ(0u, mesh->mPackedBoneWeights[i]);
+    }
+}
+
+TEST_F(utPackBoneWeightsProcess, skipsMeshesWithoutBones) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createSkinnedMesh(4, {}));
+    PackBoneWeightsProcess process;
+    EXPECT_FALSE(process.PackMesh(mesh.get()));
+    EXPECT_EQ(0u, mesh->mNumBoneInfluences);
+    EXPECT_EQ(nullptr, mesh->mPackedBoneIndices);
+    EXPECT_EQ(nullptr, mesh->mPackedBoneWeights);
+}
+
+TEST_F(utPackBoneWeightsProcess, followsVerboseVertices) {
+    std::unique_ptr<aiScene> scene(new aiScene());
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1];
+    aiMesh* mesh = scene->mMeshes[0] = TestModelFactory::createSkinnedMesh(3, { 1.f, 3.f });
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    for (unsigned int f = 0; f < 2; ++f) {
+        mesh->mFaces[f].mNumIndices = 3;
+        mesh->mFaces[f].mIndices = new unsigned int[3];
+        mesh->mFaces[f].mIndices[0] = f == 0 ? 0 : 2;
+        mesh->mFaces[f].mIndices[1] = 1;
+        mesh->mFaces[f].mIndices[2] = f == 0 ? 2 : 0;
+    }
+    PackBoneWeightsProcess process;
+    ASSERT_TRUE(process.PackMesh(mesh));
+
+    MakeVerboseFormatProcess verbose;
+    verbose.Execute(scene.get());
+    ASSERT_EQ(6u, mesh->mNumVertices);
+
+    // the copies of the skinned vertex keep its influences
+    for (unsigned int v = 0; v < 6; ++v) {
+        const bool skinned = v == 0 || v == 5;
+        EXPECT_EQ(skinned ? 255u : 0u, SumWeights(mesh, v));
+        EXPECT_EQ(skinned ? 1u : 0u, mesh->mPackedBoneIndices[v * mesh->mNumBoneInfluences]);
+    }
+}
+
+TEST_F(utPackBoneWeightsProcess, importWithPackedWeights) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, aiProcessExt_PackBoneWeights);
+    importer.SetPropertyInteger(AI_CONFIG_PP_PBW_NUM_INFLUENCES, 8);
+    const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/BVH/01_01.bvh", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    unsigned int numPacked = 0;
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh* mesh = scene->mMeshes[m];
+        if (!mesh->HasBones()) {
+            EXPECT_EQ(0u, mesh->mNumBoneInfluences);
+            continue;
+        }
+        ASSERT_EQ(8u, mesh->mNumBoneInfluences);
+        ++numPacked;
+
+        // every influence of the bones shows up in the packed streams
+        std::vector<unsigned int> numInfluences(mesh->mNumVertices, 0);
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            for (unsigned int w = 0; w < mesh->mBones[b]->mNumWeights; ++w) {
+                ++numInfluences[mesh->mBones[b]->mWeights[w].mVertexId];
+            }
+        }
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            EXPECT_EQ(numInfluences[v] ? 255u : 0u, SumWeights(mesh, v));
+            for (unsigned int i = 0; i < numInfluences[v] && i < 8; ++i) {
+                const aiBone* bone = mesh->mBones[mesh->mPackedBoneIndices[v * 8 + i]];
+                bool found = false;
+                for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+                    found = found || bone->mWeights[w].mVertexId == v;
+                }
+                EXPECT_TRUE(found);
+            }
+        }
+    }
+    EXPECT_LT(0u, numPacked);
+}
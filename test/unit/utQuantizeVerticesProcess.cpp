@@ -0,0 +1,151 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+#include "TestModelFactory.h"
+
+#include "PostProcessing/QuantizeVerticesProcess.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utQuantizeVerticesProcess : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utQuantizeVerticesProcess, positionsAreWithinError) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createRandomVertexMesh(1000, 1.f));
+    QuantizeVerticesProcess process;
+    ASSERT_TRUE(process.QuantizeMesh(mesh.get()));
+    const aiQuantizedVertices* quantized = mesh->mQuantizedVertices;
+    ASSERT_NE(nullptr, quantized);
+    ASSERT_EQ(1000u, quantized->mNumVertices);
+
+    // the scale is the largest extent, the x axis here
+    EXPECT_NEAR(10.f, quantized->mPositionScale, 0.1f);
+    EXPECT_LT(0.f, quantized->mMaxPositionError);
+    EXPECT_GE(quantized->mPositionScale / 65535 * std::sqrt(3.f) * 0.5f, quantized->mMaxPositionError);
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_GE(quantized->mMaxPositionError, (quantized->GetPosition(i) - mesh->mVertices[i]).Length());
+    }
+}
+
+TEST_F(utQuantizeVerticesProcess, directionsAreWithinError) {
+    std::unique_ptr<aiMesh> mesh(TestModelFactory::createRandomVertexMesh(1000, 1.f));
+
+    // the axes and the folded lower hemisphere are the edge cases of the octahedral encoding
+    const aiVector3D axes[6] = { aiVector3D(1, 0, 0), aiVector3D(-1, 0, 0), aiVector3D(0, 1, 0),
+        aiVector3D(0, -1, 0), aiVector3D(0, 0, 1), aiVector3D(0, 0, -1) };
+    for (unsigned int i = 0; i < 6; ++i) {
+        mesh->mNormals[i] = axes[i];
+    }
+
+    QuantizeVerticesProcess process;
+    ASSERT_TRUE(process.QuantizeMesh(mesh.get()));
+    const aiQuantizedVertices* quantized = mesh->mQuantizedVertices;
+    ASSERT_NE(nullptr, quantized->mNormals);
+    ASSERT_NE(nullptr, quantized->mTangents);
+    EXPECT_GT(1e-4f, quantized->mMaxDirectionError);
+
+    for (unsigned int i = 0; i < 6; ++i) {
+        EXPECT_NEAR(1.f, quantized->GetNormal(i) * axes[i], 1e-6f);
+    }
+    const float minCos = std::cos(quantized->mMaxDirectionError) - 1e-6f;
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_LE(minCos, quantized->GetNormal(i) * mesh->mNormals[i]);
+        EXPECT_LE(minCos, quantized->GetTangent(i) * mesh->mTangents[i]);
+    }
+}
+
+TEST_F(utQuantizeVerticesProcess, textureCoordsAndColors) {
+    // coordinates in [0,1] keep the unit range, others are mapped from their range
+    std::unique_ptr<aiMesh> unit(TestModelFactory::createRandomVertexMesh(100, 1.f)), tiled(TestModelFactory::createRandomVertexMesh(100, 4.f));
+    QuantizeVerticesProcess process;
+    ASSERT_TRUE(process.QuantizeMesh(unit.get()));
+    ASSERT_TRUE(process.QuantizeMesh(tiled.get()));
+
+    EXPECT_EQ(aiVector3D(), unit->mQuantizedVertices->mTextureCoordsOffset[0]);
+    EXPECT_EQ(aiVector3D(1.f, 1.f, 0.f), unit->mQuantizedVertices->mTextureCoordsScale[0]);
+    EXPECT_LT(1.f, tiled->mQuantizedVertices->mTextureCoordsScale[0].x);
+    EXPECT_EQ(2u, tiled->mQuantizedVertices->mNumUVComponents[0]);
+
+    for (const aiMesh* mesh : { unit.get(), tiled.get() }) {
+        const aiQuantizedVertices* quantized = mesh->mQuantizedVertices;
+        const aiVector3D& scale = quantized->mTextureCoordsScale[0];
+        EXPECT_GE(std::max(scale.x, scale.y) / 65535 * 0.5f + 1e-6f, quantized->mMaxTextureCoordsError);
+        EXPECT_GE(0.5f / 255 + 1e-6f, quantized->mMaxColorError);
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            const aiVector3D uv = quantized->GetTextureCoords(0, i);
+            EXPECT_NEAR(mesh->mTextureCoords[0][i].x, uv.x, quantized->mMaxTextureCoordsError + 1e-6f);
+            EXPECT_NEAR(mesh->mTextureCoords[0][i].y, uv.y, quantized->mMaxTextureCoordsError + 1e-6f);
+            const aiColor4D color = quantized->GetColor(0, i);
+            EXPECT_NEAR(mesh->mColors[0][i].r, color.r, quantized->mMaxColorError + 1e-6f);
+            EXPECT_EQ(1.f, color.a);
+        }
+    }
+}
+
+TEST_F(utQuantizeVerticesProcess, importWithQuantization) {
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, aiProcessExt_QuantizeVertices);
+    const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf",
+            aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices);
+    ASSERT_NE(nullptr, scene);
+
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh* mesh = scene->mMeshes[m];
+        const aiQuantizedVertices* quantized = mesh->mQuantizedVertices;
+        ASSERT_NE(nullptr, quantized);
+        ASSERT_EQ(mesh->mNumVertices, quantized->mNumVertices);
+        EXPECT_EQ(mesh->HasNormals(), nullptr != quantized->mNormals);
+        EXPECT_EQ(mesh->HasTextureCoords(0), nullptr != quantized->mTextureCoords[0]);
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            EXPECT_GE(quantized->mMaxPositionError, (quantized->GetPosition(i) - mesh->mVertices[i]).Length());
+        }
+    }
+}
@@ -0,0 +1,173 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2019, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/ReduceKeyframesProcess.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Assimp;
+
+class utReduceKeyframesProcess : public ::testing::Test {
+protected:
+    // Position keys sampled from func at the times 0, 1, ..., numKeys - 1
+    template <typename Func>
+    static aiNodeAnim* MakePositionTrack(unsigned int numKeys, Func func) {
+        aiNodeAnim* channel = new aiNodeAnim();
+        channel->mNodeName.Set("node");
+        channel->mNumPositionKeys = numKeys;
+        channel->mPositionKeys = new aiVectorKey[numKeys];
+        for (unsigned int k = 0; k < numKeys; ++k) {
+            channel->mPositionKeys[k] = aiVectorKey(k, func(static_cast<double>(k)));
+        }
+        return channel;
+    }
+
+    // Linear interpolation of a reduced track at the given time
+    static aiVector3D Evaluate(const aiNodeAnim* channel, double time) {
+        const aiVectorKey* keys = channel->mPositionKeys;
+        unsigned int k = 1;
+        while (k + 1 < channel->mNumPositionKeys && keys[k].mTime < time) {
+            ++k;
+        }
+        const ai_real factor = static_cast<ai_real>((time - keys[k - 1].mTime) / (keys[k].mTime - keys[k - 1].mTime));
+        return keys[k - 1].mValue + (keys[k].mValue - keys[k - 1].mValue) * factor;
+    }
+};
+
+TEST_F(utReduceKeyframesProcess, linearTrackKeepsEndpoints) {
+    std::unique_ptr<aiNodeAnim> channel(MakePositionTrack(100, [](double t) {
+        return aiVector3D(static_cast<ai_real>(2 * t), 1, static_cast<ai_real>(-t));
+    }));
+    ReduceKeyframesProcess process;
+    EXPECT_EQ(98u, process.ReduceChannel(channel.get()));
+    ASSERT_EQ(2u, channel->mNumPositionKeys);
+    EXPECT_EQ(0.0, channel->mPositionKeys[0].mTime);
+    EXPECT_EQ(99.0, channel->mPositionKeys[1].mTime);
+}
+
+TEST_F(utReduceKeyframesProcess, curveStaysWithinErrorBound) {
+    const auto curve = [](double t) {
+        return aiVector3D(static_cast<ai_real>(std::sin(t / 50)), static_cast<ai_real>(std::cos(t / 35)), 0);
+    };
+    std::unique_ptr<aiNodeAnim> channel(MakePositionTrack(500, curve));
+    ReduceKeyframesProcess process;
+    process.SetErrors(0.01f, 0.f, 0.f);
+    process.ReduceChannel(channel.get());
+    EXPECT_LT(channel->mNumPositionKeys, 100u);
+    EXPECT_GT(channel->mNumPositionKeys, 2u);
+
+    for (unsigned int k = 0; k < 500; ++k) {
+        EXPECT_LE((Evaluate(channel.get(), k) - curve(k)).Length(), 0.01f + 1e-5f);
+    }
+}
+
+TEST_F(utReduceKeyframesProcess, zeroErrorKeepsCurves) {
+    std::unique_ptr<aiNodeAnim> channel(MakePositionTrack(50, [](double t) {
+        return aiVector3D(static_cast<ai_real>(t * t), 0, 0);
+    }));
+    ReduceKeyframesProcess process;
+    process.SetErrors(0.f, 0.f, 0.f);
+    EXPECT_EQ(0u, process.ReduceChannel(channel.get()));
+    EXPECT_EQ(50u, channel->mNumPositionKeys);
+}
+
+TEST_F(utReduceKeyframesProcess, uniformRotationIsSlerped) {
+    std::unique_ptr<aiNodeAnim> channel(new aiNodeAnim());
+    channel->mNumRotationKeys = 60;
+    channel->mRotationKeys = new aiQuatKey[60];
+    for (unsigned int k = 0; k < 60; ++k) {
+        // a quarter turn around a tilted axis, at constant speed
+        channel->mRotationKeys[k] = aiQuatKey(k, aiQuaternion(aiVector3D(1, 1, 0).Normalize(), static_cast<ai_real>(k * AI_MATH_HALF_PI / 59)));
+    }
+    channel->mNumScalingKeys = 60;
+    channel->mScalingKeys = new aiVectorKey[60];
+    for (unsigned int k = 0; k < 60; ++k) {
+        // a single step in the middle
+        channel->mScalingKeys[k] = aiVectorKey(k, aiVector3D(k < 30 ? (ai_real)1 : (ai_real)2));
+    }
+
+    ReduceKeyframesProcess process;
+    process.ReduceChannel(channel.get());
+    EXPECT_EQ(2u, channel->mNumRotationKeys);
+    ASSERT_EQ(4u, channel->mNumScalingKeys);
+    EXPECT_EQ(29.0, channel->mScalingKeys[1].mTime);
+    EXPECT_EQ(30.0, channel->mScalingKeys[2].mTime);
+}
+
+TEST_F(utReduceKeyframesProcess, importWithReduction) {
+    Importer reference;
+    const aiScene* original = reference.ReadFile(ASSIMP_TEST_MODELS_DIR "/BVH/01_01.bvh", 0);
+    ASSERT_NE(nullptr, original);
+    ASSERT_LT(0u, original->mNumAnimations);
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, aiProcessExt_ReduceKeyframes);
+    importer.SetPropertyFloat(AI_CONFIG_PP_RK_POSITION_ERROR, 0.01f);
+    importer.SetPropertyFloat(AI_CONFIG_PP_RK_ROTATION_ERROR, 0.01f);
+    const aiScene* scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/BVH/01_01.bvh", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(original->mNumAnimations, scene->mNumAnimations);
+
+    size_t before = 0, after = 0;
+    for (unsigned int a = 0; a < scene->mNumAnimations; ++a) {
+        ASSERT_EQ(original->mAnimations[a]->mNumChannels, scene->mAnimations[a]->mNumChannels);
+        for (unsigned int c = 0; c < scene->mAnimations[a]->mNumChannels; ++c) {
+            const aiNodeAnim* in = original->mAnimations[a]->mChannels[c];
+            const aiNodeAnim* out = scene->mAnimations[a]->mChannels[c];
+            before += in->mNumPositionKeys + in->mNumRotationKeys;
+            after += out->mNumPositionKeys + out->mNumRotationKeys;
+
+            // the first and the last keys are always kept
+            if (in->mNumRotationKeys) {
+                ASSERT_LT(0u, out->mNumRotationKeys);
+                EXPECT_EQ(in->mRotationKeys[0].mTime, out->mRotationKeys[0].mTime);
+                EXPECT_EQ(in->mRotationKeys[in->mNumRotationKeys - 1].mTime, out->mRotationKeys[out->mNumRotationKeys - 1].mTime);
+            }
+        }
+    }
+    EXPECT_LT(after, before);
+}
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 #include "SceneDiffer.h"
 #include "AbstractImportExportBase.h"
+#include "ReferenceExport.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
@@ -171,4 +172,14 @@ TEST_F(utSTLImporterExporter, test_export_pointclouds) {
     delete properties;
 }
 
+TEST_F(utSTLImporterExporter, exportMatchesReference) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/PLY/cube_uv.ply", aiProcess_Triangulate);
+    ASSERT_NE(nullptr, scene);
+
+    Assimp::Exporter exporter;
+    ExpectMatchesReferenceExport(exporter.ExportToBlob(scene, "stl"), "cube_uv.stl");
+    ExpectMatchesReferenceExport(exporter.ExportToBlob(scene, "stlb"), "cube_uv_binary.stl");
+}
+
 #endif
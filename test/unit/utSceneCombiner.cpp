@@ -43,6 +43,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 #include <assimp/SceneCombiner.h>
 #include <assimp/mesh.h>
+#include <assimp/scene.h>
+#include "TestModelFactory.h"
 #include <memory>
 
 using namespace ::Assimp;
@@ -77,3 +79,47 @@ TEST_F( utSceneCombiner, CopySceneWithNullptr_AI_NO_EXCEPTion ) {
     EXPECT_NO_THROW( SceneCombiner::CopyScene( nullptr, nullptr ) );
     EXPECT_NO_THROW( SceneCombiner::CopySceneFlat( nullptr, nullptr ) );
 }
+
+TEST_F( utSceneCombiner, CopyScene_DeepCopiesMeshes_Test ) {
+    float opacity;
+    aiScene *src = TestModelFactory::createDefaultTestModel( opacity );
+
+    aiScene *dest = nullptr;
+    SceneCombiner::CopyScene( &dest, src );
+    ASSERT_NE( nullptr, dest );
+    ASSERT_EQ( src->mNumMeshes, dest->mNumMeshes );
+    ASSERT_EQ( src->mNumMaterials, dest->mNumMaterials );
+    EXPECT_NE( src->mMeshes[ 0 ]->mVertices, dest->mMeshes[ 0 ]->mVertices );
+    EXPECT_NE( src->mMeshes[ 0 ]->mFaces, dest->mMeshes[ 0 ]->mFaces );
+    EXPECT_EQ( src->mMeshes[ 0 ]->mVertices[ 1 ], dest->mMeshes[ 0 ]->mVertices[ 1 ] );
+    EXPECT_EQ( 2u, dest->mMeshes[ 0 ]->mFaces[ 0 ].mIndices[ 2 ] );
+
+    float destOpacity = 0.f;
+    EXPECT_EQ( AI_SUCCESS, dest->mMaterials[ 0 ]->Get( AI_MATKEY_OPACITY, destOpacity ) );
+    EXPECT_EQ( opacity, destOpacity );
+
+    delete dest;
+    TestModelFactory::releaseDefaultTestModel( &src );
+}
+
+TEST_F( utSceneCombiner, CopySceneShared_SharesMeshBuffers_Test ) {
+    float opacity;
+    aiScene *src = TestModelFactory::createDefaultTestModel( opacity );
+
+    aiScene *dest = nullptr;
+    SceneCombiner::CopySceneShared( &dest, src );
+    ASSERT_NE( nullptr, dest );
+    ASSERT_EQ( src->mNumMeshes, dest->mNumMeshes );
+    EXPECT_NE( src->mMeshes[ 0 ], dest->mMeshes[ 0 ] );
+    EXPECT_EQ( src->mMeshes[ 0 ]->mVertices, dest->mMeshes[ 0 ]->mVertices );
+    EXPECT_EQ( src->mMeshes[ 0 ]->mFaces, dest->mMeshes[ 0 ]->mFaces );
+    EXPECT_NE( src->mMaterials[ 0 ], dest->mMaterials[ 0 ] );
+    EXPECT_NE( src->mRootNode, dest->mRootNode );
+
+    // the source scene must stay intact after the copy is gone
+    SceneCombiner::DeleteSharedScene( dest, src );
+    EXPECT_EQ( aiVector3D( 0, 1, 0 ), src->mMeshes[ 0 ]->mVertices[ 1 ] );
+    EXPECT_EQ( 2u, src->mMeshes[ 0 ]->mFaces[ 0 ].mIndices[ 2 ] );
+
+    TestModelFactory::releaseDefaultTestModel( &src );
+}
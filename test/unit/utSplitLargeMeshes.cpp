@@ -41,10 +41,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 #include "UnitTestPCH.h"
+#include "TestModelFactory.h"
 
 #include <assimp/scene.h>
 #include "PostProcessing/SplitLargeMeshes.h"
 
+#include <chrono>
+
 using namespace std;
 using namespace Assimp;
 
@@ -54,7 +57,6 @@ public:
     virtual void TearDown();
 
 protected:
-
     SplitLargeMeshesProcess_Triangle* piProcessTriangle;
     SplitLargeMeshesProcess_Vertex* piProcessVertex;
 
@@ -165,3 +167,148 @@ TEST_F(SplitLargeMeshesTest, testTriangleSplit)
     }
     EXPECT_EQ(0, iOldFaceNum);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testBoneWeightsFollowVertices)
+{
+    std::vector< std::pair<aiMesh*, unsigned int> > avOut;
+
+    // the weight of each vertex encodes its x coordinate
+    aiMesh* pcMesh = TestModelFactory::createGridMesh(60);
+    pcMesh->mNumBones = 2;
+    pcMesh->mBones = new aiBone*[2];
+    for (unsigned int b = 0; b < 2; ++b) {
+        aiBone* bone = pcMesh->mBones[b] = new aiBone();
+        bone->mName.Set(b ? "odd" : "even");
+        bone->mNumWeights = pcMesh->mNumVertices / 2 + (b ? 0 : pcMesh->mNumVertices % 2);
+        bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+    }
+    for (unsigned int i = 0; i < pcMesh->mNumVertices; ++i) {
+        pcMesh->mBones[i % 2]->mWeights[i / 2] = aiVertexWeight(i, pcMesh->mVertices[i].x / 100.f);
+    }
+
+    const std::vector<aiVector3D> positions(pcMesh->mVertices, pcMesh->mVertices + pcMesh->mNumVertices);
+    piProcessVertex->SplitMesh(0, pcMesh, avOut);
+    ASSERT_LT(1U, avOut.size());
+
+    unsigned int iNumWeights = 0;
+    for (const auto& out : avOut) {
+        aiMesh* mesh = out.first;
+        EXPECT_LE(mesh->mNumVertices, 1000U);
+        EXPECT_EQ(2U, mesh->mNumBones);
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            const aiBone* bone = mesh->mBones[b];
+            for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+                const aiVertexWeight& weight = bone->mWeights[w];
+                ASSERT_LT(weight.mVertexId, mesh->mNumVertices);
+                EXPECT_FLOAT_EQ(mesh->mVertices[weight.mVertexId].x / 100.f, weight.mWeight);
+            }
+            iNumWeights += bone->mNumWeights;
+        }
+        delete mesh;
+    }
+    // vertices on the chunk borders are duplicated, together with their weights
+    EXPECT_LE((unsigned int)positions.size(), iNumWeights);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testMeshWithoutFacesIsKept)
+{
+    std::vector< std::pair<aiMesh*, unsigned int> > avOut;
+
+    // too many vertices, but no faces to distribute over sub-meshes
+    aiMesh* pcMesh = new aiMesh();
+    pcMesh->mNumVertices = 2000;
+    pcMesh->mVertices = new aiVector3D[pcMesh->mNumVertices];
+
+    piProcessVertex->SetLimit(1000);
+    piProcessVertex->SplitMesh(5, pcMesh, avOut);
+    ASSERT_EQ(1U, avOut.size());
+    EXPECT_EQ(pcMesh, avOut[0].first);
+    EXPECT_EQ(5U, avOut[0].second);
+    delete pcMesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testUpdateNode)
+{
+    // mesh 0 was split into two pieces, mesh 1 was dropped, mesh 2 was kept
+    std::vector< std::pair<aiMesh*, unsigned int> > avList;
+    avList.push_back(std::pair<aiMesh*, unsigned int>(nullptr, 0));
+    avList.push_back(std::pair<aiMesh*, unsigned int>(nullptr, 0));
+    avList.push_back(std::pair<aiMesh*, unsigned int>(nullptr, 2));
+
+    aiNode root;
+    root.mNumMeshes = 2;
+    root.mMeshes = new unsigned int[2] { 2, 0 };
+    root.mNumChildren = 1;
+    root.mChildren = new aiNode*[1] { new aiNode() };
+    root.mChildren[0]->mNumMeshes = 1;
+    root.mChildren[0]->mMeshes = new unsigned int[1] { 1 };
+
+    SplitLargeMeshesProcess_Triangle::UpdateNode(&root, avList);
+    ASSERT_EQ(3U, root.mNumMeshes);
+    EXPECT_EQ(2U, root.mMeshes[0]);
+    EXPECT_EQ(0U, root.mMeshes[1]);
+    EXPECT_EQ(1U, root.mMeshes[2]);
+    EXPECT_EQ(0U, root.mChildren[0]->mNumMeshes);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testManyChunksInSinglePass)
+{
+    std::vector< std::pair<aiMesh*, unsigned int> > avOut;
+
+    // about 500k vertices into chunks of 256 vertices
+    aiMesh* pcMesh = TestModelFactory::createGridMesh(700);
+    const unsigned int iNumFaces = pcMesh->mNumFaces;
+    piProcessVertex->SetLimit(256);
+
+    const auto start = std::chrono::steady_clock::now();
+    piProcessVertex->SplitMesh(0, pcMesh, avOut);
+    const auto end = std::chrono::steady_clock::now();
+    RecordProperty("splitMilliseconds", (int)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+
+    unsigned int iFaces = 0;
+    for (const auto& out : avOut) {
+        EXPECT_LE(out.first->mNumVertices, 256U);
+        iFaces += out.first->mNumFaces;
+        delete out.first;
+    }
+    EXPECT_LT(1000U, (unsigned int)avOut.size());
+    EXPECT_EQ(iNumFaces, iFaces);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testUnreferencedVerticesAreDropped)
+{
+    // too many vertices, but the referenced ones fit into a single piece
+    aiMesh* pcGrid = TestModelFactory::createGridMesh(10);
+    aiMesh* pcMesh = new aiMesh();
+    pcMesh->mPrimitiveTypes = pcGrid->mPrimitiveTypes;
+    pcMesh->mNumVertices = pcGrid->mNumVertices + 1000;
+    pcMesh->mVertices = new aiVector3D[pcMesh->mNumVertices];
+    std::copy(pcGrid->mVertices, pcGrid->mVertices + pcGrid->mNumVertices, pcMesh->mVertices);
+    std::swap(pcMesh->mNumFaces, pcGrid->mNumFaces);
+    std::swap(pcMesh->mFaces, pcGrid->mFaces);
+    const unsigned int iNumVertices = pcGrid->mNumVertices, iNumFaces = pcMesh->mNumFaces;
+    delete pcGrid;
+
+    aiScene scene;
+    scene.mNumMeshes = 1;
+    scene.mMeshes = new aiMesh*[1] { pcMesh };
+    scene.mRootNode = new aiNode();
+    scene.mRootNode->mNumMeshes = 1;
+    scene.mRootNode->mMeshes = new unsigned int[1] { 0 };
+
+    piProcessVertex->SetLimit(1000);
+    piProcessVertex->Execute(&scene);
+
+    // the mesh was replaced by its only piece
+    ASSERT_EQ(1U, scene.mNumMeshes);
+    EXPECT_NE(pcMesh, scene.mMeshes[0]);
+    EXPECT_EQ(iNumVertices, scene.mMeshes[0]->mNumVertices);
+    EXPECT_EQ(iNumFaces, scene.mMeshes[0]->mNumFaces);
+    ASSERT_EQ(1U, scene.mRootNode->mNumMeshes);
+    EXPECT_EQ(0U, scene.mRootNode->mMeshes[0]);
+}
@@ -45,6 +45,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 
 #include "PostProcessing/TriangulateProcess.h"
+#include "Common/PolyTools.h"
+
+#include <assimp/Importer.hpp>
 
 
 using namespace std;
@@ -139,3 +142,68 @@ TEST_F(TriangulateProcessTest, testTriangulation) {
     // we should have no valid normal vectors now necause we aren't a pure polygon mesh
     EXPECT_TRUE(pcMesh->mNormals == NULL);
 }
+
+// ------------------------------------------------------------------------------------------------
+// Triangulates a comb shaped polygon in the xy plane and returns the area covered by the triangles
+static double triangulateComb(unsigned int teeth, unsigned int sweepThreshold, unsigned int& numFaces) {
+    // a bar of width 2*teeth+1 with the teeth on top, in ccw winding
+    const float width = 2.f * teeth + 1.f;
+    std::vector<aiVector3D> points;
+    for (unsigned int k = 0; k < width; ++k) {
+        // collinear points along the bottom edge
+        points.push_back(aiVector3D((float)k, -1.f, 0.f));
+    }
+    points.push_back(aiVector3D(width, -1.f, 0.f));
+    points.push_back(aiVector3D(width, 1.f, 0.f));
+    for (unsigned int k = teeth; k-- > 0;) {
+        points.push_back(aiVector3D(2.f * k + 2.f, 1.f, 0.f));
+        points.push_back(aiVector3D(2.f * k + 2.f, 5.f, 0.f));
+        points.push_back(aiVector3D(2.f * k + 1.f, 5.f, 0.f));
+        points.push_back(aiVector3D(2.f * k + 1.f, 1.f, 0.f));
+    }
+    points.push_back(aiVector3D(0.f, 1.f, 0.f));
+
+    aiMesh mesh;
+    mesh.mPrimitiveTypes = aiPrimitiveType_POLYGON;
+    mesh.mNumVertices = static_cast<unsigned int>(points.size());
+    mesh.mVertices = new aiVector3D[mesh.mNumVertices];
+    std::copy(points.begin(), points.end(), mesh.mVertices);
+    mesh.mNumFaces = 1;
+    mesh.mFaces = new aiFace[1];
+    mesh.mFaces[0].mNumIndices = mesh.mNumVertices;
+    mesh.mFaces[0].mIndices = new unsigned int[mesh.mNumVertices];
+    for (unsigned int i = 0; i < mesh.mNumVertices; ++i) {
+        // reversed, so the face has cw winding
+        mesh.mFaces[0].mIndices[i] = mesh.mNumVertices - 1 - i;
+    }
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_TRI_SWEEP_THRESHOLD, sweepThreshold);
+    TriangulateProcess process;
+    process.SetupProperties(&importer);
+    EXPECT_TRUE(process.TriangulateMesh(&mesh));
+
+    double area = 0.0;
+    numFaces = mesh.mNumFaces;
+    for (unsigned int i = 0; i < mesh.mNumFaces; ++i) {
+        const aiFace& face = mesh.mFaces[i];
+        EXPECT_EQ(3U, face.mNumIndices);
+        const double a = GetArea2D(mesh.mVertices[face.mIndices[0]], mesh.mVertices[face.mIndices[1]], mesh.mVertices[face.mIndices[2]]);
+
+        // all triangles keep the cw winding of the input polygon
+        EXPECT_GE(a, 0.0);
+        area += a;
+    }
+    return area;
+}
+
+TEST_F(TriangulateProcessTest, testSweepMatchesEarCutting) {
+    unsigned int numEar = 0, numSweep = 0;
+    const double areaEar = triangulateComb(40, 0, numEar);
+    const double areaSweep = triangulateComb(40, 4, numSweep);
+
+    // 40 teeth of area 4 on a bar of area 2*81
+    EXPECT_NEAR(40 * 4.0 + 2 * 81.0, areaEar, 1e-3);
+    EXPECT_NEAR(areaEar, areaSweep, 1e-3);
+    EXPECT_EQ(numEar, numSweep);
+}
@@ -44,7 +44,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
-#include <ValidateDataStructure.h>
+#include <assimp/Exceptional.h>
+#include "PostProcessing/ValidateDataStructure.h"
 
 using namespace std;
 using namespace Assimp;
@@ -195,5 +196,60 @@ void ValidateDataStructureTest::TearDown()
 //965: ReportError("aiString::length is too large (%i, maximum is %lu)",
 //974: ReportError("aiString::data is invalid: the terminal zero is at a wrong offset");
 //979: ReportError("aiString::data is invalid. There is no terminal character");
+
+// ------------------------------------------------------------------------------------------------
+static std::string validationError(ValidateDSProcess* vds, aiScene* scene)
+{
+    try {
+        vds->Execute(scene);
+    } catch (const DeadlyImportError& e) {
+        return e.what();
+    }
+    return std::string();
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, testDuplicateCameraNames)
+{
+    scene->mFlags = AI_SCENE_FLAGS_INCOMPLETE;
+    scene->mNumCameras = 4;
+    scene->mCameras = new aiCamera*[4];
+    const char* names[] = { "a", "b", "c", "b" };
+    for (unsigned int i = 0; i < 4; ++i) {
+        scene->mCameras[i] = new aiCamera();
+        scene->mCameras[i]->mName.Set(names[i]);
+    }
+
+    const std::string error = validationError(vds, scene);
+    EXPECT_NE(std::string::npos, error.find("aiScene::mCameras[1] has the same name as aiScene::mNumCameras[3]")) << error;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, testFirstInvalidMeshIsReported)
+{
+    scene->mFlags = AI_SCENE_FLAGS_INCOMPLETE;
+    scene->mNumMeshes = 200;
+    scene->mMeshes = new aiMesh*[200];
+    for (unsigned int i = 0; i < 200; ++i) {
+        aiMesh* mesh = new aiMesh();
+        mesh->mName.Set("mesh" + std::to_string(i));
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = 3;
+        mesh->mVertices = new aiVector3D[3];
+        // meshes 60 and 150 have no faces
+        if (i != 60 && i != 150) {
+            mesh->mNumFaces = 1;
+            mesh->mFaces = new aiFace[1];
+            mesh->mFaces[0].mNumIndices = 3;
+            mesh->mFaces[0].mIndices = new unsigned int[3] { 0, 1, 2 };
+        }
+        scene->mMeshes[i] = mesh;
+    }
+
+    // validation runs in parallel, but must report the same error as a sequential run
+    for (int run = 0; run < 10; ++run) {
+        const std::string error = validationError(vds, scene);
+        EXPECT_NE(std::string::npos, error.find("Mesh mesh60 contains no faces")) << error;
+    }
 }
 
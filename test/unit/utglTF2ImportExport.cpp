@@ -40,12 +40,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "UnitTestPCH.h"
 #include "AbstractImportExportBase.h"
+#include "PostProcessing/MakeVerboseFormat.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/Exporter.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <array>
+#include <fstream>
+#include <iterator>
 
 using namespace Assimp;
 
@@ -368,6 +371,38 @@ TEST_F(utglTF2ImportExport, importglTF2FromMemory) {
     EXPECT_EQ( nullptr, Scene );*/
 }
 
+// A triangle which is Draco compressed, the accessors optionally point to uncompressed data as well
+static std::string MakeDracoCompressedTriangle(bool withFallback) {
+    const std::string fallback = withFallback ? "\"bufferView\": 0, " : "";
+    return "{ \"asset\": { \"version\": \"2.0\" },"
+        " \"extensionsUsed\": [ \"KHR_draco_mesh_compression\" ],"
+        " \"scenes\": [ { \"nodes\": [ 0 ] } ], \"nodes\": [ { \"mesh\": 0 } ],"
+        " \"meshes\": [ { \"name\": \"triangle\", \"primitives\": [ { \"attributes\": { \"POSITION\": 0 },"
+        " \"extensions\": { \"KHR_draco_mesh_compression\": { \"bufferView\": 1, \"attributes\": { \"POSITION\": 0 } } } } ] } ],"
+        " \"accessors\": [ { " + fallback + "\"componentType\": 5126, \"count\": 3, \"type\": \"VEC3\","
+        " \"min\": [ 0, 0, 0 ], \"max\": [ 1, 1, 0 ] } ],"
+        " \"bufferViews\": [ { \"buffer\": 0, \"byteLength\": 36 }, { \"buffer\": 0, \"byteLength\": 4 } ],"
+        " \"buffers\": [ { \"byteLength\": 36,"
+        " \"uri\": \"data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAA\" } ] }";
+}
+
+TEST_F(utglTF2ImportExport, importDracoCompressedMesh) {
+    // the compressed data is no valid Draco stream, and without the decoder there is nothing else to load
+    const std::string compressed = MakeDracoCompressedTriangle(false);
+    Assimp::Importer importer;
+    EXPECT_EQ(nullptr, importer.ReadFileFromMemory(compressed.c_str(), compressed.size(), aiProcess_ValidateDataStructure, "gltf"));
+
+#ifndef ASSIMP_GLTF2_USE_DRACO
+    // built without the Draco decoder, the mesh is loaded from its uncompressed fallback
+    const std::string withFallback = MakeDracoCompressedTriangle(true);
+    const aiScene *scene = importer.ReadFileFromMemory(withFallback.c_str(), withFallback.size(), aiProcess_ValidateDataStructure, "gltf");
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    ASSERT_EQ(3u, scene->mMeshes[0]->mNumVertices);
+    EXPECT_EQ(aiVector3D(0.f, 1.f, 0.f), scene->mMeshes[0]->mVertices[2]);
+#endif
+}
+
 TEST_F( utglTF2ImportExport, bug_import_simple_skin ) {
     Assimp::Importer importer;
     const aiScene *scene = importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/glTF2/simple_skin/simple_skin.gltf",
@@ -396,4 +431,236 @@ TEST_F( utglTF2ImportExport, crash_in_anim_mesh_destructor ) {
     ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "glb2", ASSIMP_TEST_MODELS_DIR "/glTF2/glTF-Sample-Models/AnimatedMorphCube-glTF/AnimatedMorphCube_out.glTF"));
 }
 
+TEST_F(utglTF2ImportExport, exportWithSharedMeshBuffersKeepsScene) {
+    // the mesh buffers are only shared if the exporters have no steps left to apply and
+    // the scene is in verbose format
+    const unsigned int flags = aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
+            aiProcess_SortByPType;
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", flags);
+    ASSERT_NE(nullptr, scene);
+    Assimp::MakeVerboseFormatProcess verbose;
+    verbose.Execute(const_cast<aiScene *>(scene));
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_TRUE(mesh->HasNormals());
+    ASSERT_TRUE(mesh->HasTextureCoords(0));
+
+    // the exporter normalizes the normals, longer ones tell if it wrote into the shared buffers
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        mesh->mNormals[i] *= 2.f;
+    }
+    const std::vector<aiVector3D> normals(mesh->mNormals, mesh->mNormals + mesh->mNumVertices);
+    const std::vector<aiVector3D> coords(mesh->mTextureCoords[0], mesh->mTextureCoords[0] + mesh->mNumVertices);
+
+    Assimp::ExportProperties properties;
+    properties.SetPropertyBool(AI_CONFIG_EXPORT_SHARE_MESH_BUFFERS, true);
+    Assimp::Exporter exporter;
+    for (const char *format : { "gltf2", "gltf" }) {
+        ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(scene, format, ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_shared_out.gltf",
+                0u, &properties));
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            EXPECT_EQ(normals[i], mesh->mNormals[i]);
+            EXPECT_EQ(coords[i], mesh->mTextureCoords[0][i]);
+        }
+    }
+}
+
+TEST_F(utglTF2ImportExport, exportQuantizedVertices) {
+    const unsigned int flags = aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
+            aiProcess_SortByPType | aiProcess_PreTransformVertices;
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", flags);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+
+    // only texture coordinates in [0,1] can be written as normalized integers
+    aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_TRUE(mesh->HasTextureCoords(0));
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        mesh->mTextureCoords[0][i].x /= 6.f;
+    }
+    importer.SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, aiProcessExt_QuantizeVertices);
+    ASSERT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_ValidateDataStructure));
+    const aiQuantizedVertices *quantized = mesh->mQuantizedVertices;
+    ASSERT_NE(nullptr, quantized);
+    EXPECT_EQ(aiVector3D(1.f, 1.f, 0.f), quantized->mTextureCoordsScale[0]);
+
+    Assimp::Exporter exporter;
+    ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "gltf2", ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_quantized_out.gltf"));
+
+    std::ifstream file(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_quantized_out.gltf");
+    const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(std::string::npos, json.find("\"extensionsRequired\""));
+    EXPECT_NE(std::string::npos, json.find("KHR_mesh_quantization"));
+
+    // the importer converts the integer attributes back, the dequantization is a node transform
+    Assimp::Importer reimporter;
+    const aiScene *reimported = reimporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_quantized_out.gltf",
+            aiProcess_ValidateDataStructure | aiProcess_PreTransformVertices);
+    ASSERT_NE(nullptr, reimported);
+    ASSERT_EQ(1u, reimported->mNumMeshes);
+    const aiMesh *result = reimported->mMeshes[0];
+    ASSERT_TRUE(result->HasNormals());
+    ASSERT_TRUE(result->HasTextureCoords(0));
+
+    const float positionError = quantized->mMaxPositionError + 1e-4f;
+    for (unsigned int i = 0; i < result->mNumVertices; ++i) {
+        bool found = false;
+        for (unsigned int j = 0; j < mesh->mNumVertices && !found; ++j) {
+            found = (result->mVertices[i] - mesh->mVertices[j]).Length() <= positionError &&
+                    result->mNormals[i] * mesh->mNormals[j] > 0.9999f &&
+                    (result->mTextureCoords[0][i] - mesh->mTextureCoords[0][j]).Length() < 1e-4f;
+        }
+        EXPECT_TRUE(found);
+    }
+}
+
+TEST_F(utglTF2ImportExport, exportAttributesRewrittenAfterQuantization) {
+    const unsigned int flags = aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
+            aiProcess_SortByPType | aiProcess_PreTransformVertices;
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", flags);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_TRUE(mesh->HasNormals());
+    ASSERT_TRUE(mesh->HasTextureCoords(0));
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        mesh->mTextureCoords[0][i].x /= 6.f;
+    }
+    importer.SetPropertyInteger(AI_CONFIG_PP_EXTENDED_STEPS, aiProcessExt_QuantizeVertices);
+    ASSERT_NE(nullptr, importer.ApplyPostProcessing(aiProcess_ValidateDataStructure));
+    ASSERT_NE(nullptr, mesh->mQuantizedVertices);
+
+    // like FlipUVs or GenNormals, rewrite the attributes after the quantization
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        mesh->mTextureCoords[0][i].x = 1.f - mesh->mTextureCoords[0][i].x;
+        mesh->mNormals[i] = -mesh->mNormals[i];
+    }
+
+    Assimp::Exporter exporter;
+    ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "gltf2", ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_rewritten_out.gltf"));
+
+    // the stale streams are replaced by the current attributes, the positions stay quantized
+    std::ifstream file(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_rewritten_out.gltf");
+    const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(std::string::npos, json.find("KHR_mesh_quantization"));
+
+    Assimp::Importer reimporter;
+    const aiScene *reimported = reimporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_rewritten_out.gltf",
+            aiProcess_ValidateDataStructure | aiProcess_PreTransformVertices);
+    ASSERT_NE(nullptr, reimported);
+    ASSERT_EQ(1u, reimported->mNumMeshes);
+    const aiMesh *result = reimported->mMeshes[0];
+    ASSERT_TRUE(result->HasNormals());
+    ASSERT_TRUE(result->HasTextureCoords(0));
+
+    const float positionError = mesh->mQuantizedVertices->mMaxPositionError + 1e-4f;
+    for (unsigned int i = 0; i < result->mNumVertices; ++i) {
+        bool found = false;
+        for (unsigned int j = 0; j < mesh->mNumVertices && !found; ++j) {
+            found = (result->mVertices[i] - mesh->mVertices[j]).Length() <= positionError &&
+                    result->mNormals[i] * mesh->mNormals[j] > 0.9999f &&
+                    (result->mTextureCoords[0][i] - mesh->mTextureCoords[0][j]).Length() < 1e-4f;
+        }
+        EXPECT_TRUE(found);
+    }
+}
+
+TEST_F(utglTF2ImportExport, exportDracoCompressedMesh) {
+    const unsigned int flags = aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
+            aiProcess_SortByPType | aiProcess_PreTransformVertices;
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", flags);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    const unsigned int numFaces = scene->mMeshes[0]->mNumFaces;
+    const std::vector<aiVector3D> vertices(scene->mMeshes[0]->mVertices, scene->mMeshes[0]->mVertices + scene->mMeshes[0]->mNumVertices);
+
+    Assimp::ExportProperties properties;
+    properties.SetPropertyBool(AI_CONFIG_EXPORT_GLTF_DRACO_COMPRESSION, true);
+    properties.SetPropertyInteger(AI_CONFIG_EXPORT_GLTF_DRACO_POSITION_BITS, 14);
+    Assimp::Exporter exporter;
+    ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "gltf2", ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_draco_out.gltf",
+            0u, &properties));
+
+    std::ifstream file(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_draco_out.gltf");
+    const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+#ifdef ASSIMP_GLTF2_USE_DRACO
+    EXPECT_NE(std::string::npos, json.find("\"extensionsRequired\""));
+    EXPECT_NE(std::string::npos, json.find("KHR_draco_mesh_compression"));
+#else
+    // built without the Draco encoder, the meshes are exported uncompressed
+    EXPECT_EQ(std::string::npos, json.find("KHR_draco_mesh_compression"));
+#endif
+
+    Assimp::Importer reimporter;
+    const aiScene *reimported = reimporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_draco_out.gltf",
+            aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, reimported);
+    ASSERT_EQ(1u, reimported->mNumMeshes);
+    const aiMesh *result = reimported->mMeshes[0];
+    EXPECT_EQ(numFaces, result->mNumFaces);
+    ASSERT_TRUE(result->HasTextureCoords(0));
+
+    // 14 bits quantize the box with an error far below 1e-3
+    for (unsigned int i = 0; i < result->mNumVertices; ++i) {
+        bool found = false;
+        for (size_t j = 0; j < vertices.size() && !found; ++j) {
+            found = (result->mVertices[i] - vertices[j]).Length() < 1e-3f;
+        }
+        EXPECT_TRUE(found);
+    }
+}
+
+#ifdef ASSIMP_GLTF2_USE_DRACO
+TEST_F(utglTF2ImportExport, dracoRoundTripKeepsAttributes) {
+    const unsigned int flags = aiProcess_ValidateDataStructure | aiProcess_JoinIdenticalVertices | aiProcess_Triangulate |
+            aiProcess_SortByPType | aiProcess_PreTransformVertices;
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", flags);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_TRUE(mesh->HasNormals());
+    ASSERT_TRUE(mesh->HasTextureCoords(0));
+
+    Assimp::ExportProperties properties;
+    properties.SetPropertyBool(AI_CONFIG_EXPORT_GLTF_DRACO_COMPRESSION, true);
+    properties.SetPropertyInteger(AI_CONFIG_EXPORT_GLTF_DRACO_POSITION_BITS, 14);
+    properties.SetPropertyInteger(AI_CONFIG_EXPORT_GLTF_DRACO_NORMAL_BITS, 12);
+    properties.SetPropertyInteger(AI_CONFIG_EXPORT_GLTF_DRACO_TEXCOORD_BITS, 14);
+    Assimp::Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "glb2", 0u, &properties);
+    ASSERT_NE(nullptr, blob);
+
+    // the meshes are only readable with a Draco decoder
+    const std::string glb(static_cast<const char *>(blob->data), blob->size);
+    EXPECT_NE(std::string::npos, glb.find("\"extensionsRequired\""));
+    EXPECT_NE(std::string::npos, glb.find("KHR_draco_mesh_compression"));
+
+    // decoded by Draco, the accessors have no uncompressed fallback
+    Assimp::Importer reimporter;
+    const aiScene *reimported = reimporter.ReadFileFromMemory(blob->data, blob->size, aiProcess_ValidateDataStructure, "glb");
+    ASSERT_NE(nullptr, reimported);
+    ASSERT_EQ(1u, reimported->mNumMeshes);
+    const aiMesh *result = reimported->mMeshes[0];
+    EXPECT_EQ(mesh->mNumFaces, result->mNumFaces);
+    ASSERT_TRUE(result->HasNormals());
+    ASSERT_TRUE(result->HasTextureCoords(0));
+
+    // Draco may reorder the points, so each one is matched against the source vertices
+    for (unsigned int i = 0; i < result->mNumVertices; ++i) {
+        bool found = false;
+        for (unsigned int j = 0; j < mesh->mNumVertices && !found; ++j) {
+            found = (result->mVertices[i] - mesh->mVertices[j]).Length() < 1e-3f &&
+                    (result->mNormals[i] - mesh->mNormals[j]).Length() < 1e-2f &&
+                    (result->mTextureCoords[0][i] - mesh->mTextureCoords[0][j]).Length() < 1e-3f;
+        }
+        EXPECT_TRUE(found);
+    }
+}
+#endif
+
 #endif // ASSIMP_BUILD_NO_EXPORT